@@ -31,10 +31,11 @@ import struct
 
 class AudioDebugLogger(object):
 
-    def __init__(self, queue, sampling_freq, output_base_name):
+    def __init__(self, queue, sampling_freq, output_base_name, channels=1):
 
         self._queue = queue
         self._sampling_freq = sampling_freq
+        self._channels = channels
         self._filebase = output_base_name
 
     def run(self):
@@ -54,7 +55,9 @@ class AudioDebugLogger(object):
 
         ints = struct.unpack(conversion_str, self._captured_bytes)
 
-        plot.plot(ints)
+        # One line per interleaved channel
+        for channel in range(self._channels):
+            plot.plot(ints[channel::self._channels])
         plot.grid()
         plot.savefig(self._filebase + ".png")
         plot.close()
@@ -63,7 +66,7 @@ class AudioDebugLogger(object):
 
         wav = wave.open(self._filebase + ".wav", "w")
 
-        wav.setparams((1,                   # nchannels
+        wav.setparams((self._channels,      # nchannels
                        2,                   # sampwidth
                        self._sampling_freq, # framerate
                        0,                   # nframes
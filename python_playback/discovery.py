@@ -0,0 +1,179 @@
+#! /usr/bin/env python3
+################################################################################
+# Copyright (c) 2017, Alan Barr
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# * Redistributions of source code must retain the above copyright notice, this
+#   list of conditions and the following disclaimer.
+#
+# * Redistributions in binary form must reproduce the above copyright notice,
+#   this list of conditions and the following disclaimer in the documentation
+#   and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+################################################################################
+
+import socket
+import struct
+import threading
+import time
+
+SAP_MULTICAST_IP = "224.2.127.254"
+SAP_PORT = 9875
+
+SAP_FLAG_IPV6 = 0x10
+SAP_FLAG_DELETE = 0x04
+SAP_FLAG_ENCRYPTED = 0x02
+SAP_FLAG_COMPRESSED = 0x01
+
+class SapDiscovery(object):
+    """Listens for SAP announcements from STM32 boards and keeps a table of the
+    streams currently being announced."""
+
+    def __init__(self, local_ip="0.0.0.0", timeout=60):
+
+        self._timeout = timeout
+        self._streams = {}
+        self._lock = threading.Lock()
+
+        self._rx_sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self._rx_sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        self._rx_sock.bind(("", SAP_PORT))
+        self._rx_sock.settimeout(0.5)
+
+        membership = struct.pack("4s4s",
+                                 socket.inet_aton(SAP_MULTICAST_IP),
+                                 socket.inet_aton(local_ip))
+        self._rx_sock.setsockopt(socket.IPPROTO_IP,
+                                 socket.IP_ADD_MEMBERSHIP,
+                                 membership)
+
+    @staticmethod
+    def _parse_sdp(sdp):
+        stream = {"attributes": {}}
+
+        for line in sdp.splitlines():
+            if len(line) < 2 or line[1] != "=":
+                continue
+
+            key, value = line[0], line[2:]
+
+            if key == "s":
+                stream["name"] = value
+            elif key == "c":
+                stream["ip"] = value.split()[-1]
+            elif key == "m":
+                stream["media"] = value
+            elif key == "a":
+                (name, _, attr_value) = value.partition(":")
+                stream["attributes"][name] = attr_value
+
+        attributes = stream["attributes"]
+        stream["rtsp_url"] = attributes.get("control")
+        stream["rtpmap"] = attributes.get("rtpmap")
+
+        if "x-mgmt-port" in attributes:
+            stream["mgmt_port"] = int(attributes["x-mgmt-port"])
+        else:
+            stream["mgmt_port"] = None
+
+        return stream
+
+    @classmethod
+    def parse_sap(cls, data):
+        """Returns (origin, msg_id_hash, is_deletion, stream) for a SAP packet,
+        or None if it can't be used."""
+
+        if len(data) < 8:
+            return None
+
+        (flags, auth_len, msg_id_hash) = struct.unpack("!BBH", data[:4])
+
+        if flags >> 5 != 1:
+            return None
+
+        if flags & (SAP_FLAG_IPV6 | SAP_FLAG_ENCRYPTED | SAP_FLAG_COMPRESSED):
+            return None
+
+        origin = socket.inet_ntoa(data[4:8])
+        payload = data[8 + auth_len * 4:]
+
+        # The payload type is optional, if present it is NULL terminated
+        if not payload.startswith(b"v=0"):
+            (payload_type, _, payload) = payload.partition(b"\0")
+            if payload_type != b"application/sdp":
+                return None
+
+        stream = cls._parse_sdp(payload.decode("ASCII", errors="replace"))
+
+        return (origin, msg_id_hash, bool(flags & SAP_FLAG_DELETE), stream)
+
+    def _socket_receiver(self):
+
+        while self._should_stop.is_set() == False:
+            try:
+                (data, _) = self._rx_sock.recvfrom(65535)
+            except socket.timeout:
+                continue
+
+            parsed = self.parse_sap(data)
+
+            if parsed is None:
+                continue
+
+            (origin, msg_id_hash, is_deletion, stream) = parsed
+
+            with self._lock:
+                if is_deletion:
+                    self._streams.pop(origin, None)
+                else:
+                    stream["msg_id_hash"] = msg_id_hash
+                    stream["last_seen"] = time.time()
+                    self._streams[origin] = stream
+
+    def streams(self):
+        """Returns the streams heard from within the timeout, keyed by the
+        announcing board's IP address."""
+
+        now = time.time()
+
+        with self._lock:
+            for origin in list(self._streams):
+                if now - self._streams[origin]["last_seen"] > self._timeout:
+                    del self._streams[origin]
+
+            return dict(self._streams)
+
+    def run(self):
+        self._should_stop = threading.Event()
+        self._rx_thread = threading.Thread(target=self._socket_receiver)
+        self._rx_thread.start()
+
+    def close(self):
+        self._should_stop.set()
+        self._rx_thread.join()
+        self._rx_sock.close()
+
+
+def discover(listen_time, local_ip="0.0.0.0"):
+    """Listens for announcements for listen_time seconds and returns what was
+    heard."""
+
+    discovery = SapDiscovery(local_ip=local_ip)
+    discovery.run()
+    time.sleep(listen_time)
+    discovery.close()
+
+    return discovery.streams()
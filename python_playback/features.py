@@ -0,0 +1,161 @@
+#! /usr/bin/env python3
+################################################################################
+# Copyright (c) 2017, Alan Barr
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# * Redistributions of source code must retain the above copyright notice, this
+#   list of conditions and the following disclaimer.
+#
+# * Redistributions in binary form must reproduce the above copyright notice,
+#   this list of conditions and the following disclaimer in the documentation
+#   and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+################################################################################
+
+import math
+import queue
+import struct
+import time
+
+import matplotlib.pyplot as plot
+
+from receiver import AudioReceiver, RTP_PAYLOAD_TYPE_MASK
+
+# Band energies sent instead of audio, with CONFIG_AUDIO_FEATURES
+RTP_FEATURES_PAYLOAD_TYPE = 98
+FEATURES_HEADER_LEN = 8
+FEATURES_STEP_DB = 0.5
+FEATURES_SCALE_THIRD_OCTAVE = 0
+FEATURES_SCALE_MEL = 1
+# The board's rate, the mel bands stopping at its Nyquist frequency
+FEATURES_SAMPLE_RATE_HZ = 16000
+# Nominal third octave centres are rounded, e.g. 100 Hz is really 99.2 Hz
+FEATURES_NOMINAL_TOLERANCE = 0.05
+
+
+def band_edges(scale, bands, low_hz, high_hz):
+    """Lower and upper edge of each band in Hz, worked out from the frame
+    header as the board does."""
+
+    if scale == FEATURES_SCALE_MEL:
+        high_hz = min(high_hz, FEATURES_SAMPLE_RATE_HZ / 2)
+        low_mel = 2595 * math.log10(1 + low_hz / 700)
+        high_mel = 2595 * math.log10(1 + high_hz / 700)
+        edges = [700 * (10 ** ((low_mel + (high_mel - low_mel) * n / bands) /
+                               2595) - 1)
+                 for n in range(bands + 1)]
+        return list(zip(edges[:-1], edges[1:]))
+
+    first = math.ceil(3 * math.log2(low_hz / 1000) - FEATURES_NOMINAL_TOLERANCE)
+
+    return [(1000 * 2 ** ((first + n - 0.5) / 3),
+             1000 * 2 ** ((first + n + 0.5) / 3)) for n in range(bands)]
+
+
+def decode(payload):
+    """Decodes a frame of features into a dictionary, with the level of each
+    band in dBFS. Returns None if the frame is malformed."""
+
+    if len(payload) < FEATURES_HEADER_LEN:
+        return None
+
+    (scale, bands, interval_ms, low_hz, high_hz) = struct.unpack(
+                                    "!BBHHH", payload[:FEATURES_HEADER_LEN])
+
+    if bands == 0 or len(payload) != FEATURES_HEADER_LEN + bands:
+        return None
+
+    return {"scale": scale,
+            "interval_ms": interval_ms,
+            "edges": band_edges(scale, bands, low_hz, high_hz),
+            "levels": [-level * FEATURES_STEP_DB
+                       for level in payload[FEATURES_HEADER_LEN:]]}
+
+
+class FeatureReceiver(AudioReceiver):
+    """Receives the board's feature frames, putting each decoded frame and
+    its RTP timestamp on the queues."""
+
+    def _handle_packet(self, data_bytes):
+
+        if data_bytes[1] & RTP_PAYLOAD_TYPE_MASK != RTP_FEATURES_PAYLOAD_TYPE:
+            return
+
+        header_len = self._get_rtp_header_len(data_bytes)
+
+        if header_len is None:
+            return
+
+        frame = decode(data_bytes[header_len:])
+
+        if frame is None:
+            return
+
+        (_, _, _, frame["timestamp"], _) = self._get_rtp_header(data_bytes)
+
+        for q in self._queues:
+            q.put(frame)
+
+
+class FeaturePlot(object):
+    """Live bar chart of the latest frame of band levels."""
+
+    def __init__(self, queue, floor_dbfs=-100):
+
+        self._queue = queue
+        self._floor_dbfs = floor_dbfs
+        self._bars = None
+
+    def _setup(self, frame):
+
+        centres = [math.sqrt(low * high) for (low, high) in frame["edges"]]
+        labels = ["{:.0f}".format(centre) for centre in centres]
+
+        (figure, axes) = plot.subplots()
+        self._bars = axes.bar(range(len(centres)),
+                              [self._floor_dbfs] * len(centres))
+        axes.set_xticks(range(len(centres)))
+        axes.set_xticklabels(labels, rotation=90)
+        axes.set_xlabel("Band centre (Hz)")
+        axes.set_ylabel("Level (dBFS)")
+        axes.set_ylim(self._floor_dbfs, 0)
+        axes.grid(axis="y")
+        figure.tight_layout()
+
+    def run(self, run_time):
+
+        plot.ion()
+        end = time.time() + run_time
+
+        while time.time() < end:
+            frame = None
+
+            # Only the latest is drawn
+            while self._queue.qsize():
+                frame = self._queue.get()
+
+            if frame is not None:
+                if self._bars is None or len(self._bars) != len(frame["levels"]):
+                    plot.close("all")
+                    self._setup(frame)
+
+                for (bar, level) in zip(self._bars, frame["levels"]):
+                    bar.set_y(self._floor_dbfs)
+                    bar.set_height(max(level - self._floor_dbfs, 0))
+
+            plot.pause(0.05)
+
+        plot.close("all")
@@ -30,10 +30,12 @@ import queue
 import argparse
 
 from receiver import AudioReceiver
+from features import FeatureReceiver, FeaturePlot
 from debug_logger import AudioDebugLogger
 from debug_generator import AudioDebugGenerator
 from playback import AudioPlayback
 from stm32 import Stm32AudioSource
+from discovery import discover
 
 
 def stream(sink_ip,
@@ -41,7 +43,8 @@ def stream(sink_ip,
            device_ip=None,
            device_port=None,
            run_time=5,
-           save=False):
+           save=False,
+           channels=1):
 
     sampling_freq = 16000
 
@@ -72,7 +75,8 @@ def stream(sink_ip,
     audio_source.start()
 
     playback = AudioPlayback(queue=audio_queue,
-                             sampling_freq=sampling_freq)
+                             sampling_freq=sampling_freq,
+                             channels=channels)
     playback.start()
 
     while run_time:
@@ -86,12 +90,38 @@ def stream(sink_ip,
     if save:
         audio_logger = AudioDebugLogger(queue=debug_queue,
                                         output_base_name="samples",
-                                        sampling_freq=sampling_freq)
+                                        sampling_freq=sampling_freq,
+                                        channels=channels)
         audio_logger.run()
         audio_logger.save_plot()
         audio_logger.save_wave_file()
 
 
+def stream_features(sink_ip,
+                    sink_port,
+                    device_ip,
+                    device_port,
+                    run_time=5):
+
+    feature_queue = queue.Queue()
+
+    receiver = FeatureReceiver(sink_ip=sink_ip,
+                               sink_port=sink_port,
+                               queues=[feature_queue])
+    receiver.run()
+
+    source = Stm32AudioSource(stm32_ip=device_ip,
+                              stm32_port=device_port,
+                              sink_ip=sink_ip,
+                              sink_port=sink_port)
+    source.start()
+
+    FeaturePlot(queue=feature_queue).run(run_time)
+
+    receiver.close()
+    source.stop()
+
+
 if __name__ == "__main__":
 
     parser = argparse.ArgumentParser(description="""
@@ -127,6 +157,19 @@ if __name__ == "__main__":
                              "Be mindful of the running time when using this "
                              "option.")
 
+    parser.add_argument("--channels",
+                        nargs="?",
+                        type=int,
+                        default=1,
+                        help="Interleaved channels in the stream, as "
+                             "CONFIG_AUDIO_CHANNELS on the board.")
+
+    parser.add_argument("--features",
+                        action="store_true",
+                        help="Plot the band energies streamed by a board "
+                             "built with CONFIG_AUDIO_FEATURES, rather than "
+                             "playing audio.")
+
     parser.add_argument("--run-time",
                         nargs="?",
                         type=int,
@@ -134,13 +177,86 @@ if __name__ == "__main__":
                         help="Run for specified number of seconds. "
                              "Actual run time will be slightly longer than this.")
 
+    parser.add_argument("--discover",
+                        nargs="?",
+                        type=int,
+                        const=15,
+                        help="List the streams announced over SAP within the "
+                             "given number of seconds, then exit.")
+
+    parser.add_argument("--auto-subscribe",
+                        action="store_true",
+                        help="Stream from the first board announced over SAP "
+                             "rather than --device-ip/--device-port.")
+
+    parser.add_argument("--stats",
+                        action="store_true",
+                        help="Print the statistics of the board at "
+                             "--device-ip/--device-port, then exit.")
+
     cli_args = parser.parse_args()
 
     print(cli_args)
 
+    if cli_args.discover:
+        streams = discover(listen_time=cli_args.discover,
+                           local_ip=cli_args.local_ip or "0.0.0.0")
+
+        for (origin, stream) in sorted(streams.items()):
+            print("{}: \"{}\" {} rtsp: {} mgmt port: {}".format(
+                    origin,
+                    stream.get("name"),
+                    stream.get("rtpmap"),
+                    stream.get("rtsp_url"),
+                    stream.get("mgmt_port")))
+
+        if not streams:
+            print("No streams announced")
+
+        exit(0)
+
+    if cli_args.stats:
+        source = Stm32AudioSource(stm32_ip=cli_args.device_ip,
+                                  stm32_port=cli_args.device_port,
+                                  sink_ip=None,
+                                  sink_port=None)
+
+        for (key, value) in sorted(source.stats().items()):
+            print("{}: {}".format(key, value))
+
+        exit(0)
+
+    if cli_args.auto_subscribe:
+        streams = discover(listen_time=15,
+                           local_ip=cli_args.local_ip or "0.0.0.0")
+        announced = [(ip, s) for (ip, s) in sorted(streams.items())
+                     if s.get("mgmt_port")]
+
+        if not announced:
+            print("No streams announced")
+            exit(1)
+
+        (cli_args.device_ip, stream) = announced[0]
+        cli_args.device_port = stream["mgmt_port"]
+        print("Subscribing to {}:{}".format(cli_args.device_ip,
+                                            cli_args.device_port))
+
+    if cli_args.features:
+        if not cli_args.device_ip:
+            print("--features needs a board to stream from")
+            exit(1)
+
+        stream_features(sink_ip=cli_args.local_ip,
+                        sink_port=cli_args.local_port,
+                        device_ip=cli_args.device_ip,
+                        device_port=cli_args.device_port,
+                        run_time=cli_args.run_time)
+        exit(0)
+
     stream(sink_ip=cli_args.local_ip,
            sink_port=cli_args.local_port,
            device_ip=cli_args.device_ip,
            device_port=cli_args.device_port,
            save=cli_args.save_samples,
-           run_time=cli_args.run_time)
+           run_time=cli_args.run_time,
+           channels=cli_args.channels)
@@ -33,13 +33,15 @@ import math
 
 class AudioPlayback(object):
 
-    def __init__(self, queue, sampling_freq, frame_count=None, is_blocking=False):
+    def __init__(self, queue, sampling_freq, frame_count=None, is_blocking=False,
+                 channels=1):
 
         self.frame_count = frame_count if frame_count is not None else sampling_freq/10
         self.frame_count = int(self.frame_count)
 
         self.is_blocking = is_blocking
         self.sampling_freq = sampling_freq
+        self.channels = channels
 
         self._queue = queue
 
@@ -53,14 +55,14 @@ class AudioPlayback(object):
             cb = self._streaming_callback
 
         # Empty audio frame to insert when no data
-        self._empty_frame = self.frame_count * struct.pack("h", 0)
+        self._empty_frame = self.frame_count * self.channels * struct.pack("h", 0)
 
         self.pyaudio = pyaudio.PyAudio()
 
         self._fresh_buffering()
 
         self.stream = self.pyaudio.open(format=pyaudio.paInt16,
-                                        channels=1,
+                                        channels=self.channels,
                                         rate=self.sampling_freq,
                                         output=True,
                                         stream_callback=cb,
@@ -83,7 +85,7 @@ class AudioPlayback(object):
         self.last_time = time.time()
 
         new_frame = b""
-        missing_bytes = frame_count * 2
+        missing_bytes = frame_count * self.channels * 2
 
         if len(self._leftover_bytes):
             new_frame += self._leftover_bytes
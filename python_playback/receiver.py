@@ -31,6 +31,12 @@ import struct
 
 RTP_HEADER_LEN = 12
 UINT16_LEN = 2
+# RFC 3389 comfort noise, sent by the board instead of silent payloads
+RTP_CN_PAYLOAD_TYPE = 97
+RTP_PAYLOAD_TYPE_MASK = 0x7F
+RTP_CSRC_COUNT_MASK = 0x0F
+RTP_EXTENSION = 0x10
+RTP_EXTENSION_HEADER_LEN = 4
 
 class AudioReceiver(object):
 
@@ -48,13 +54,32 @@ class AudioReceiver(object):
         return (b1, b2, sequence, timestamp, ssrc)
 
     @staticmethod
-    def _get_rtp_payload(rx_data):
+    def _get_rtp_header_len(rx_data):
+        """Length of the fixed header, CSRCs and any header extension, such
+        as the board's audio level."""
+        length = RTP_HEADER_LEN + 4 * (rx_data[0] & RTP_CSRC_COUNT_MASK)
 
-        len_uint16s = int(len(rx_data[RTP_HEADER_LEN:]) / UINT16_LEN)
+        if rx_data[0] & RTP_EXTENSION:
+            if len(rx_data) < length + RTP_EXTENSION_HEADER_LEN:
+                return None
+            (words,) = struct.unpack("!H", rx_data[length + 2:length + 4])
+            length += RTP_EXTENSION_HEADER_LEN + 4 * words
+
+        if len(rx_data) < length:
+            return None
+
+        return length
+
+    @staticmethod
+    def _get_rtp_payload(rx_data, header_len):
+
+        len_uint16s = int(len(rx_data[header_len:]) / UINT16_LEN)
 
         conversion_str = "!"  + "h" * len_uint16s
 
-        payload_ints = struct.unpack(conversion_str, rx_data[RTP_HEADER_LEN:])
+        payload_ints = struct.unpack(conversion_str,
+                                     rx_data[header_len:
+                                             header_len + len_uint16s * UINT16_LEN])
     
         payload_bytes = b""
         for sample in payload_ints:
@@ -62,15 +87,33 @@ class AudioReceiver(object):
 
         return (payload_ints, payload_bytes)
     
+    def _handle_packet(self, data_bytes):
+
+        parsed = {}
+
+        if data_bytes[1] & RTP_PAYLOAD_TYPE_MASK == RTP_CN_PAYLOAD_TYPE:
+            return
+
+        header_len = self._get_rtp_header_len(data_bytes)
+
+        if header_len is None:
+            return
+
+        (parsed["ints"], parsed["bytes"]) = self._get_rtp_payload(data_bytes,
+                                                                  header_len)
+
+        for q in self._queues:
+            q.put(parsed["bytes"])
+
     def _socket_receiver(self):
 
         while self._should_stop.is_set() == False:
-            parsed = {}
             (data_bytes, (src_ip, src_port)) = self._rx_sock.recvfrom(65535)
-            (parsed["ints"], parsed["bytes"]) = self._get_rtp_payload(data_bytes)
 
-            for q in self._queues:
-                q.put(parsed["bytes"])
+            if len(data_bytes) < RTP_HEADER_LEN:
+                continue
+
+            self._handle_packet(data_bytes)
 
     def run(self):
         self._should_stop = threading.Event()
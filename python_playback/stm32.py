@@ -57,5 +57,28 @@ class Stm32AudioSource(object):
         sock.send(cmd.encode("ASCII"))
         sock.close()
 
+    def stats(self, timeout=5):
+        """ Returns the board's statistics as a dictionary of strings. """
 
+        sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        sock.settimeout(timeout)
+        sock.connect((self.ip, self.port))
+        sock.send("stats".encode("ASCII"))
+
+        # The reply is terminated by an empty line
+        reply = b""
+        while not reply.endswith(b"\n\n"):
+            data = sock.recv(1024)
+            if not data:
+                break
+            reply += data
+
+        sock.close()
+
+        stats = {}
+        for line in reply.decode("ASCII").splitlines():
+            if line:
+                (key, _, value) = line.partition(" ")
+                stats[key] = value
 
+        return stats
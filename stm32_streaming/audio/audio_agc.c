@@ -0,0 +1,241 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "audio_agc.h"
+
+/* Full scale of a sample, squared, i.e. the 0 dBFS mean square */
+#define AUDIO_AGC_FULL_SCALE_ENERGY     (32768.0f * 32768.0f)
+#define AUDIO_AGC_FULL_SCALE            32768.0f
+
+/* The limiter is considered released once its gain recovers to this */
+#define AUDIO_AGC_LIMITER_RELEASED      0.9999f
+
+/******************************************************************************/
+/* Internal Functions                                                         */
+/******************************************************************************/
+
+/* One pole smoothing coefficient, for updates every periodMs */
+static float audioAgcCoeff(float timeConstantMs, float periodMs)
+{
+    if (timeConstantMs <= 0)
+    {
+        return 1;
+    }
+
+    return 1 - expf(-periodMs / timeConstantMs);
+}
+
+static float audioAgcDbToGain(float db)
+{
+    return powf(10, db / 20);
+}
+
+static float audioAgcGainToDb(float gain)
+{
+    return 20 * log10f(gain);
+}
+
+/* Picks the gain for the next block from its mean square */
+static float audioAgcTargetGain(audioAgc *agc, float meanSquare)
+{
+    float gain = 0;
+
+    if (meanSquare < agc->gateMeanSquare)
+    {
+        agc->gatedBlocks++;
+        return agc->gain;
+    }
+
+    agc->level += (meanSquare - agc->level) *
+                  (meanSquare > agc->level ? agc->attackCoeff :
+                                             agc->releaseCoeff);
+
+    gain = sqrtf(agc->targetMeanSquare / agc->level);
+
+    if (gain < agc->minGain)
+    {
+        return agc->minGain;
+    }
+    else if (gain > agc->maxGain)
+    {
+        return agc->maxGain;
+    }
+
+    return gain;
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+/* Starts at 0 dB gain, or the nearest to it within the gain range */
+StatusCode audioAgcInit(audioAgc *agc, const audioAgcConfig *config)
+{
+    float blockMs = 0;
+
+    if (config->sampleRate <= 0 || config->blockSamples == 0 ||
+        config->minGainDb > config->maxGainDb ||
+        config->limiterDbfs > 0 ||
+        config->lookaheadSamples > AUDIO_AGC_MAX_LOOKAHEAD)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    memset(agc, 0, sizeof(*agc));
+    agc->config = *config;
+
+    blockMs = config->blockSamples * 1000 / config->sampleRate;
+
+    agc->targetMeanSquare = AUDIO_AGC_FULL_SCALE_ENERGY *
+                            powf(10, config->targetDbfs / 10);
+    agc->gateMeanSquare = AUDIO_AGC_FULL_SCALE_ENERGY *
+                          powf(10, config->gateDbfs / 10);
+    agc->minGain = audioAgcDbToGain(config->minGainDb);
+    agc->maxGain = audioAgcDbToGain(config->maxGainDb);
+    agc->attackCoeff = audioAgcCoeff(config->attackMs, blockMs);
+    agc->releaseCoeff = audioAgcCoeff(config->releaseMs, blockMs);
+    agc->limiterThreshold = AUDIO_AGC_FULL_SCALE *
+                            audioAgcDbToGain(config->limiterDbfs);
+    agc->limiterReleaseCoeff = audioAgcCoeff(config->limiterReleaseMs,
+                                             1000 / config->sampleRate);
+
+    agc->gain = agc->maxGain < 1 ? agc->maxGain :
+                agc->minGain > 1 ? agc->minGain : 1;
+    agc->level = agc->targetMeanSquare / (agc->gain * agc->gain);
+    agc->limiterGain = 1;
+    agc->minLimiterGain = 1;
+
+    return STATUS_OK;
+}
+
+/* The output is delayed by lookaheadSamples. The gain is ramped across the
+ * block to its new value, so there is no step. The limiter gain drops
+ * straight to whatever the loudest sample in the look-ahead window needs, so
+ * that sample is already attenuated by the time it is output, then
+ * recovers exponentially. */
+void audioAgcProcess(audioAgc *agc, float *samples, uint32_t count)
+{
+    const uint32_t length = agc->config.lookaheadSamples + 1;
+    float meanSquare = 0;
+    float target = 0;
+    float step = 0;
+    float sample = 0;
+    float peak = 0;
+    float limit = 0;
+    bool limited = false;
+    uint32_t index = 0;
+    uint32_t window = 0;
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    for (index = 0; index < count; index++)
+    {
+        meanSquare += samples[index] * samples[index];
+    }
+
+    target = audioAgcTargetGain(agc, meanSquare / count);
+    step = (target - agc->gain) / count;
+
+    for (index = 0; index < count; index++)
+    {
+        agc->gain += step;
+        sample = samples[index] * agc->gain;
+
+        agc->delay[agc->position] = sample;
+        agc->magnitude[agc->position] = fabsf(sample);
+
+        peak = 0;
+
+        for (window = 0; window < length; window++)
+        {
+            if (agc->magnitude[window] > peak)
+            {
+                peak = agc->magnitude[window];
+            }
+        }
+
+        limit = peak > agc->limiterThreshold ? agc->limiterThreshold / peak : 1;
+
+        if (limit < agc->limiterGain)
+        {
+            if (agc->limiterGain == 1)
+            {
+                agc->limiterEngagements++;
+            }
+
+            agc->limiterGain = limit;
+        }
+        else
+        {
+            agc->limiterGain += (limit - agc->limiterGain) *
+                                agc->limiterReleaseCoeff;
+
+            if (agc->limiterGain > AUDIO_AGC_LIMITER_RELEASED)
+            {
+                agc->limiterGain = 1;
+            }
+        }
+
+        if (agc->limiterGain < 1)
+        {
+            limited = true;
+
+            if (agc->limiterGain < agc->minLimiterGain)
+            {
+                agc->minLimiterGain = agc->limiterGain;
+            }
+        }
+
+        /* The oldest sample, from lookaheadSamples ago */
+        agc->position = agc->position + 1 == length ? 0 : agc->position + 1;
+        samples[index] = agc->delay[agc->position] * agc->limiterGain;
+    }
+
+    /* Don't let rounding in the ramp accumulate */
+    agc->gain = target;
+
+    agc->blocks++;
+
+    if (limited)
+    {
+        agc->limitedBlocks++;
+    }
+}
+
+void audioAgcGetStats(const audioAgc *agc, audioAgcStats *stats)
+{
+    stats->blocks = agc->blocks;
+    stats->limitedBlocks = agc->limitedBlocks;
+    stats->limiterEngagements = agc->limiterEngagements;
+    stats->gatedBlocks = agc->gatedBlocks;
+    stats->gainDb = audioAgcGainToDb(agc->gain);
+    stats->maxReductionDb = audioAgcGainToDb(1 / agc->minLimiterGain);
+}
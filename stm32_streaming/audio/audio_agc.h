@@ -0,0 +1,116 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_AGC_H__
+#define __AUDIO_AGC_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "status_code.h"
+
+/* Longest look-ahead the limiter supports, in samples */
+#define AUDIO_AGC_MAX_LOOKAHEAD     64
+
+typedef struct {
+    float sampleRate;
+    /* Samples passed to each audioAgcProcess() call. The level is measured,
+     * and the gain updated, once per block. */
+    uint32_t blockSamples;
+
+    /* Mean square level the gain steers towards, dB relative to full scale */
+    float targetDbfs;
+    /* Range of the gain. Equal values give a fixed gain, leaving just the
+     * limiter. */
+    float minGainDb;
+    float maxGainDb;
+    /* Blocks quieter than this hold the gain, so background noise isn't
+     * brought up to the target level */
+    float gateDbfs;
+    /* Time constants of the level detector, as it rises and falls */
+    float attackMs;
+    float releaseMs;
+
+    /* Peaks above this are limited, dB relative to full scale */
+    float limiterDbfs;
+    /* Delay giving the limiter time to turn the gain down before a peak
+     * arrives. Added to the latency of the stream. */
+    uint32_t lookaheadSamples;
+    float limiterReleaseMs;
+} audioAgcConfig;
+
+typedef struct {
+    uint32_t blocks;
+    /* Blocks where the limiter reduced the gain */
+    uint32_t limitedBlocks;
+    /* Times the limiter started reducing the gain */
+    uint32_t limiterEngagements;
+    /* Blocks below the gate */
+    uint32_t gatedBlocks;
+    /* Current AGC gain, excluding the limiter */
+    float gainDb;
+    /* Deepest limiter gain reduction */
+    float maxReductionDb;
+} audioAgcStats;
+
+/* Automatic gain control followed by a look-ahead brickwall limiter, run in
+ * place on blocks of samples scaled to the int16 range. Output peaks never
+ * exceed limiterDbfs, so the conversion to int16 need never clip. Has no OS
+ * or hardware dependencies. */
+typedef struct {
+    audioAgcConfig config;
+
+    /* Precomputed from the config */
+    float targetMeanSquare;
+    float gateMeanSquare;
+    float minGain;
+    float maxGain;
+    float attackCoeff;
+    float releaseCoeff;
+    float limiterThreshold;
+    float limiterReleaseCoeff;
+
+    /* Smoothed mean square level */
+    float level;
+    float gain;
+    float limiterGain;
+    float minLimiterGain;
+
+    /* Samples waiting to be output, and their magnitudes */
+    float delay[AUDIO_AGC_MAX_LOOKAHEAD + 1];
+    float magnitude[AUDIO_AGC_MAX_LOOKAHEAD + 1];
+    uint32_t position;
+
+    uint32_t blocks;
+    uint32_t limitedBlocks;
+    uint32_t limiterEngagements;
+    uint32_t gatedBlocks;
+} audioAgc;
+
+StatusCode audioAgcInit(audioAgc *agc, const audioAgcConfig *config);
+void audioAgcProcess(audioAgc *agc, float *samples, uint32_t count);
+void audioAgcGetStats(const audioAgc *agc, audioAgcStats *stats);
+
+#endif /* Header Guard */
@@ -0,0 +1,167 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "audio_beam.h"
+
+#define AUDIO_BEAM_PDM_RATE_HZ      (MP45DT02_RAW_FREQ_KHZ * 1000.0f)
+
+#define AUDIO_BEAM_PI               3.14159265f
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+/* positions are along the line, in metres, for each of channels microphones */
+StatusCode audioBeamInit(audioBeam *beam,
+                         uint32_t channels,
+                         const float *positions,
+                         float steerDegrees)
+{
+    if (channels == 0 || channels > AUDIO_BEAM_MAX_CHANNELS)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    memset(beam, 0, sizeof(*beam));
+
+    beam->channels = channels;
+    memcpy(beam->positions, positions, channels * sizeof(*positions));
+
+    return audioBeamSteer(beam, steerDegrees);
+}
+
+/* Sound from steerDegrees reaches the microphones furthest along the line
+ * first, so they are delayed the most. Fails, leaving the delays as they were,
+ * if the array is too wide for the delay line. */
+StatusCode audioBeamSteer(audioBeam *beam, float steerDegrees)
+{
+    uint32_t delayBits[AUDIO_BEAM_MAX_CHANNELS];
+    float lead = 0;
+    float earliest = 0;
+    uint32_t channel = 0;
+
+    if (steerDegrees < -90 || steerDegrees > 90)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    lead = sinf(steerDegrees * AUDIO_BEAM_PI / 180) *
+           AUDIO_BEAM_PDM_RATE_HZ / AUDIO_BEAM_SPEED_OF_SOUND;
+
+    for (channel = 0; channel < beam->channels; channel++)
+    {
+        if (channel == 0 || beam->positions[channel] * lead < earliest)
+        {
+            earliest = beam->positions[channel] * lead;
+        }
+    }
+
+    for (channel = 0; channel < beam->channels; channel++)
+    {
+        delayBits[channel] = lroundf(beam->positions[channel] * lead - earliest);
+
+        if (delayBits[channel] > AUDIO_BEAM_MAX_DELAY_WORDS *
+                                 MP45DT02_I2S_WORD_SIZE_BITS)
+        {
+            return STATUS_ERROR_API;
+        }
+    }
+
+    memcpy(beam->delayBits, delayBits, sizeof(delayBits));
+    beam->steerDegrees = steerDegrees;
+
+    return STATUS_OK;
+}
+
+/* Takes a block of the channel's PDM words, MSB first, and returns it
+ * delayed. Valid until the next call for the channel. */
+const uint16_t *audioBeamDelay(audioBeam *beam,
+                               uint32_t channel,
+                               const uint16_t *pdm)
+{
+    uint16_t *line = beam->line[channel];
+    uint16_t *delayed = beam->delayed[channel];
+    uint32_t start = AUDIO_BEAM_MAX_DELAY_WORDS * MP45DT02_I2S_WORD_SIZE_BITS -
+                     beam->delayBits[channel];
+    uint32_t word = start / MP45DT02_I2S_WORD_SIZE_BITS;
+    uint32_t shift = start % MP45DT02_I2S_WORD_SIZE_BITS;
+    uint32_t index = 0;
+
+    memcpy(&line[AUDIO_BEAM_MAX_DELAY_WORDS],
+           pdm,
+           MP45DT02_I2S_SAMPLE_SIZE_2B * sizeof(*pdm));
+
+    if (shift == 0)
+    {
+        memcpy(delayed,
+               &line[word],
+               MP45DT02_I2S_SAMPLE_SIZE_2B * sizeof(*delayed));
+    }
+    else
+    {
+        for (index = 0; index < MP45DT02_I2S_SAMPLE_SIZE_2B; index++)
+        {
+            delayed[index] = (uint16_t)(line[word + index] << shift |
+                                        line[word + index + 1] >>
+                                            (MP45DT02_I2S_WORD_SIZE_BITS -
+                                             shift));
+        }
+    }
+
+    /* Keep the end of the block for the next */
+    memmove(line,
+            &line[MP45DT02_I2S_SAMPLE_SIZE_2B],
+            AUDIO_BEAM_MAX_DELAY_WORDS * sizeof(*line));
+
+    return delayed;
+}
+
+/* Averages the decimated blocks of every microphone into output, which may
+ * be the first of them */
+void audioBeamSum(const audioBeam *beam,
+                  float32_t *const *blocks,
+                  uint32_t samples,
+                  float32_t *output)
+{
+    float32_t scale = 1.0f / beam->channels;
+    float32_t sum = 0;
+    uint32_t channel = 0;
+    uint32_t index = 0;
+
+    for (index = 0; index < samples; index++)
+    {
+        sum = 0;
+
+        for (channel = 0; channel < beam->channels; channel++)
+        {
+            sum += blocks[channel][index];
+        }
+
+        output[index] = sum * scale;
+    }
+}
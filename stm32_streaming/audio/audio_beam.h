@@ -0,0 +1,77 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_BEAM_H__
+#define __AUDIO_BEAM_H__
+
+#include <stdint.h>
+#include "arm_math.h"
+#include "status_code.h"
+#include "mp45dt02_processing.h"
+
+/* Microphones the beamformer can combine */
+#define AUDIO_BEAM_MAX_CHANNELS     4
+
+/* Longest delay applied to a microphone, in PDM words. 16 words is 250 us at
+ * 1.024 MHz, or 86 mm of path across the array. */
+#define AUDIO_BEAM_MAX_DELAY_WORDS  16
+
+#define AUDIO_BEAM_SPEED_OF_SOUND   343.0f
+
+/* Delay and sum beamformer for a line of microphones. Each microphone's PDM
+ * is delayed by a whole number of bits, so that sound from the steered
+ * direction lines up, before it is decimated. At 1.024 MHz a bit is under a
+ * microsecond, finer than any fractional delay affordable after decimation.
+ * The decimated blocks are then averaged into one channel. Has no OS or
+ * hardware dependencies. */
+typedef struct {
+    uint32_t channels;
+    /* Of each microphone along the line, metres */
+    float positions[AUDIO_BEAM_MAX_CHANNELS];
+    /* From broadside, towards the microphones furthest along the line */
+    float steerDegrees;
+    uint32_t delayBits[AUDIO_BEAM_MAX_CHANNELS];
+    /* The end of the previous blocks, then the current one, of each
+     * microphone */
+    uint16_t line[AUDIO_BEAM_MAX_CHANNELS]
+                 [AUDIO_BEAM_MAX_DELAY_WORDS + MP45DT02_I2S_SAMPLE_SIZE_2B];
+    uint16_t delayed[AUDIO_BEAM_MAX_CHANNELS][MP45DT02_I2S_SAMPLE_SIZE_2B];
+} audioBeam;
+
+StatusCode audioBeamInit(audioBeam *beam,
+                         uint32_t channels,
+                         const float *positions,
+                         float steerDegrees);
+StatusCode audioBeamSteer(audioBeam *beam, float steerDegrees);
+const uint16_t *audioBeamDelay(audioBeam *beam,
+                               uint32_t channel,
+                               const uint16_t *pdm);
+void audioBeamSum(const audioBeam *beam,
+                  float32_t *const *blocks,
+                  uint32_t samples,
+                  float32_t *output);
+
+#endif /* Header Guard */
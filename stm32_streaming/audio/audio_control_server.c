@@ -27,35 +27,452 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdlib.h>
+#include <math.h>
 #include "audio_control_server.h"
 #include "ch.h"
 #include "hal.h"
+#include "chprintf.h"
+#include "memstreams.h"
 #include "lwip/ip_addr.h"
 #include "lwip/api.h"
 #include "lwip/ip.h"
 #include "lwip/ip_addr.h"
 #include "lwip/err.h"
 #include "audio_tx.h"
+#include "audio_eq.h"
+#include "mp45dt02_processing.h"
+#include "rtsp_server.h"
+#include "sap_announcer.h"
+#include "network.h"
+#include "settings.h"
+#include "config.h"
 
 /* Indexes into the expected management control string */
 #define INDEX_IP    6
 #define INDEX_PORT  15
 
+/* Longest message which will be parsed, sized for RTSP requests */
+#define AUDIO_CONTROL_RX_BUFFER_SIZE    512
+
+/* Longest reply which can be sent, sized for the stats output */
+#define AUDIO_CONTROL_TX_BUFFER_SIZE    1024
+
+/* Time given for the reply to leave before a reboot */
+#define AUDIO_CONTROL_REBOOT_DELAY      MS2ST(100)
+
+/* Sent before the net command erases flash, which stalls the board, and the
+ * time given for it to leave first */
+#define AUDIO_CONTROL_NET_STALL_REPLY   "storing, board stalls for 1-2 s\n"
+#define AUDIO_CONTROL_NET_STALL_DELAY   MS2ST(100)
+
+/* Event signalled to the control thread when LWIP has something for us */
+#define AUDIO_CONTROL_EVENT             EVENT_MASK(0)
+
+/* How often idle clients are checked for when nothing else is happening */
+#define AUDIO_CONTROL_POLL_INTERVAL     S2ST(1)
+
+/* The server accepts connections for several protocols */
+typedef enum {
+    AUDIO_CONTROL_LISTENER_MGMT,
+    AUDIO_CONTROL_LISTENER_RTSP,
+    AUDIO_CONTROL_LISTENER_COUNT
+} audioControlListenerId;
+
+typedef struct {
+    struct netconn *conn;
+    /* Connections waiting to be accepted on conn */
+    int32_t acceptEvents;
+} audioControlListener;
+
+typedef enum {
+    /* Slot is free */
+    CLIENT_STATE_FREE,
+    /* LWIP has reported events for a connection we haven't accepted yet */
+    CLIENT_STATE_PENDING,
+    /* Connection accepted and being serviced */
+    CLIENT_STATE_ACTIVE
+} audioControlClientState;
+
+typedef struct {
+    audioControlClientState state;
+    struct netconn *conn;
+    /* Which listener accepted the connection, i.e. the protocol it speaks */
+    audioControlListenerId listener;
+    /* Receive events signalled by LWIP and not yet consumed. While this is
+     * positive netconn_recv() will not block. */
+    int32_t rxEvents;
+    /* Time of the last activity, used to drop half open connections */
+    systime_t lastActivity;
+} audioControlClient;
+
+/* An RTSP request may arrive split across TCP segments, so what has been
+ * received is held until the blank line ending its headers */
+typedef struct {
+    char data[AUDIO_CONTROL_RX_BUFFER_SIZE];
+    uint16_t length;
+} audioControlRequest;
+
 static struct {
     AudioControlConfig config;
-    THD_WORKING_AREA(workingArea, 1024);
+    THD_WORKING_AREA(workingArea, 2048);
     thread_t *thread;
+
+    audioControlListener listeners[AUDIO_CONTROL_LISTENER_COUNT];
+
+    /* Fixed pool of clients - bounds the memory a flood of connections can
+     * consume. Shared with the LWIP thread, so accessed under lock. */
+    audioControlClient clients[CONFIG_AUDIO_MGMT_MAX_CLIENTS];
+
+    /* Clients are serviced one at a time, so can share a receive buffer */
+    char recvData[AUDIO_CONTROL_RX_BUFFER_SIZE];
+    /* Partial RTSP requests, by client slot. Only touched by the control
+     * thread, so kept out of the locked client pool. */
+    audioControlRequest requests[CONFIG_AUDIO_MGMT_MAX_CLIENTS];
+    char sendData[AUDIO_CONTROL_TX_BUFFER_SIZE];
 } audioControlThdData;
 
+static StatusCode audioControlReply(struct netconn *clientConn,
+                                    const char *data,
+                                    uint32_t length)
+{
+    size_t written = 0;
+
+    /* Never block the control thread on a slow client */
+    if (ERR_OK != netconn_write_partly(clientConn,
+                                       data,
+                                       length,
+                                       NETCONN_COPY | NETCONN_DONTBLOCK,
+                                       &written) ||
+        written != length)
+    {
+        return STATUS_ERROR_LIBRARY_LWIP;
+    }
+
+    return STATUS_OK;
+}
+
+static uint32_t audioControlActiveClients(void)
+{
+    uint32_t index = 0;
+    uint32_t count = 0;
+
+    for (index = 0; index < CONFIG_AUDIO_MGMT_MAX_CLIENTS; index++)
+    {
+        if (audioControlThdData.clients[index].state == CLIENT_STATE_ACTIVE)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/* stats - replies with "key value" lines, terminated by an empty line */
+static StatusCode audioControlStats(struct netconn *clientConn)
+{
+    MemoryStream stream;
+    BaseSequentialStream *chp = (BaseSequentialStream *)&stream;
+
+    /* Leave room for the terminating empty line */
+    msObjectInit(&stream,
+                 (uint8_t *)audioControlThdData.sendData,
+                 AUDIO_CONTROL_TX_BUFFER_SIZE - 1,
+                 0);
+
+    chprintf(chp, "uptime_ms %u\n", ST2MS(chVTGetSystemTimeX()));
+    chprintf(chp, "mgmt_clients %u\n", audioControlActiveClients());
+    networkPrintStats(chp);
+    sapAnnouncerPrintStats(chp);
+    audioTxPrintStats(chp);
+
+    audioControlThdData.sendData[stream.eos++] = '\n';
+
+    return audioControlReply(clientConn, audioControlThdData.sendData, stream.eos);
+}
+
+/* Withdraws the SAP announcement ahead of the board's address changing or it
+ * going away. Not worth losing the client over. */
+static void audioControlSapShutdown(void)
+{
+    StatusCode status = sapAnnouncerShutdown();
+
+    if (status != STATUS_OK)
+    {
+        PRINT("SAP shutdown failed with %s", statusCodeToString(status));
+    }
+}
+
+/* net dhcp
+ * net static <ip> <netmask> <gateway>  - dotted decimal
+ * Settings are stored in flash and used from the next boot. Erasing the
+ * sector stalls everything running from flash, so the client is warned
+ * before it starts, then sent "ok" once it's done. */
+static StatusCode audioControlNet(struct netconn *clientConn, char *buffer)
+{
+    settingsNetwork network;
+    ip_addr_t addr[3];
+    char *token = NULL;
+    char *save = NULL;
+    uint32_t index = 0;
+
+    settingsGetNetwork(&network);
+
+    /* Skip "net" */
+    token = strtok_r(buffer, " \r\n", &save);
+    token = strtok_r(NULL, " \r\n", &save);
+
+    if (token == NULL)
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+    else if (strcmp(token, "dhcp") == 0)
+    {
+        network.dhcp = true;
+    }
+    else if (strcmp(token, "static") == 0)
+    {
+        for (index = 0; index < 3; index++)
+        {
+            token = strtok_r(NULL, " \r\n", &save);
+
+            if (token == NULL || !ipaddr_aton(token, &addr[index]))
+            {
+                SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+            }
+        }
+
+        network.dhcp    = false;
+        network.ipAddr  = addr[0].addr;
+        network.netmask = addr[1].addr;
+        network.gateway = addr[2].addr;
+    }
+    else
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    PRINT("Storing network settings, DHCP %u", network.dhcp);
+    SC_ASSERT(audioControlReply(clientConn,
+                                AUDIO_CONTROL_NET_STALL_REPLY,
+                                strlen(AUDIO_CONTROL_NET_STALL_REPLY)));
+    /* The announced address is about to change */
+    audioControlSapShutdown();
+    chThdSleep(AUDIO_CONTROL_NET_STALL_DELAY);
+    SC_ASSERT(settingsSetNetwork(&network));
+
+    return audioControlReply(clientConn, "ok\n", strlen("ok\n"));
+}
+
+static void audioControlReboot(struct netconn *clientConn)
+{
+    PRINT("Rebooting",0);
+    audioControlReply(clientConn, "ok\n", strlen("ok\n"));
+    audioControlSapShutdown();
+    chThdSleep(AUDIO_CONTROL_REBOOT_DELAY);
+    NVIC_SystemReset();
+}
+
+/* eq  - replies with a line per band, "<band> <type> <hz> <gain db> <q>
+ *       <b0> <b1> <b2> <a1> <a2>", terminated by an empty line
+ * eq <band> <type> ...  - see audioEqParseBand()
+ * Not stored, bands return to config.h on reboot. */
+static StatusCode audioControlEq(struct netconn *clientConn, char *buffer)
+{
+    MemoryStream stream;
+    BaseSequentialStream *chp = (BaseSequentialStream *)&stream;
+    audioEqBand band;
+    char *token = NULL;
+    char *save = NULL;
+    char *end = NULL;
+    uint32_t index = 0;
+
+    /* Skip "eq" */
+    token = strtok_r(buffer, " \r\n", &save);
+    token = strtok_r(NULL, " \r\n", &save);
+
+    if (token == NULL)
+    {
+        msObjectInit(&stream,
+                     (uint8_t *)audioControlThdData.sendData,
+                     AUDIO_CONTROL_TX_BUFFER_SIZE - 1,
+                     0);
+
+        for (index = 0; index < AUDIO_EQ_MAX_BANDS; index++)
+        {
+            mp45dt02GetEqBand(index, &band);
+            chprintf(chp, "%u %s %.1f %.1f %.3f %f %f %f %f %f\n",
+                     index,
+                     audioEqTypeName(band.type),
+                     band.frequency,
+                     band.gainDb,
+                     band.q,
+                     band.coeffs[0],
+                     band.coeffs[1],
+                     band.coeffs[2],
+                     band.coeffs[3],
+                     band.coeffs[4]);
+        }
+
+        audioControlThdData.sendData[stream.eos++] = '\n';
+
+        return audioControlReply(clientConn,
+                                 audioControlThdData.sendData,
+                                 stream.eos);
+    }
+
+    index = strtoul(token, &end, 10);
+
+    if (*end != '\0' || save == NULL)
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    if (STATUS_OK != audioEqParseBand(save, &band) ||
+        STATUS_OK != mp45dt02SetEqBand(index, &band))
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    PRINT("EQ band %u set to %s", index, audioEqTypeName(band.type));
+
+    return audioControlReply(clientConn, "ok\n", strlen("ok\n"));
+}
+
+/* beam <degrees>  - steer the beamformer, from broadside towards the last
+ *                   channel. Not stored. */
+static StatusCode audioControlBeam(struct netconn *clientConn, char *buffer)
+{
+    char *token = NULL;
+    char *save = NULL;
+    char *end = NULL;
+    float steerDegrees = 0;
+
+    /* Skip "beam" */
+    token = strtok_r(buffer, " \r\n", &save);
+    token = strtok_r(NULL, " \r\n", &save);
+
+    if (token == NULL)
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    steerDegrees = strtof(token, &end);
+
+    if (*end != '\0' || STATUS_OK != mp45dt02SetBeamSteer(steerDegrees))
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    PRINT("Beam steered to %d degrees", (int)steerDegrees);
+
+    return audioControlReply(clientConn, "ok\n", strlen("ok\n"));
+}
+
+/* trigger  - replies "level <dbfs|off> vad <on|off> hangover <ms>"
+ * trigger [level <dbfs|off>] [vad <on|off>] [hangover <ms>]  - changes those
+ *          given. Not stored, settings return to config.h on reboot. */
+static StatusCode audioControlTrigger(struct netconn *clientConn, char *buffer)
+{
+    MemoryStream stream;
+    BaseSequentialStream *chp = (BaseSequentialStream *)&stream;
+    audioTriggerSettings settings;
+    char *token = NULL;
+    char *value = NULL;
+    char *save = NULL;
+    char *end = NULL;
+
+    if (STATUS_OK != audioTxGetTrigger(&settings))
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    /* Skip "trigger" */
+    token = strtok_r(buffer, " \r\n", &save);
+    token = strtok_r(NULL, " \r\n", &save);
+
+    if (token == NULL)
+    {
+        msObjectInit(&stream,
+                     (uint8_t *)audioControlThdData.sendData,
+                     AUDIO_CONTROL_TX_BUFFER_SIZE - 1,
+                     0);
+
+        if (isnan(settings.levelDbfs))
+        {
+            chprintf(chp, "level off");
+        }
+        else
+        {
+            chprintf(chp, "level %.1f", settings.levelDbfs);
+        }
+
+        chprintf(chp, " vad %s hangover %u\n",
+                 settings.vad ? "on" : "off",
+                 settings.hangoverMs);
+
+        return audioControlReply(clientConn,
+                                 audioControlThdData.sendData,
+                                 stream.eos);
+    }
+
+    /* Pairs of setting and value */
+    while (token != NULL)
+    {
+        if (NULL == (value = strtok_r(NULL, " \r\n", &save)))
+        {
+            SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+        }
+
+        end = "";
+
+        if (strcmp(token, "level") == 0)
+        {
+            settings.levelDbfs = strcmp(value, "off") == 0 ?
+                                 NAN : strtof(value, &end);
+        }
+        else if (strcmp(token, "vad") == 0 && strcmp(value, "on") == 0)
+        {
+            settings.vad = true;
+        }
+        else if (strcmp(token, "vad") == 0 && strcmp(value, "off") == 0)
+        {
+            settings.vad = false;
+        }
+        else if (strcmp(token, "hangover") == 0)
+        {
+            settings.hangoverMs = strtoul(value, &end, 10);
+        }
+        else
+        {
+            SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+        }
+
+        if (*end != '\0')
+        {
+            SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+        }
+
+        token = strtok_r(NULL, " \r\n", &save);
+    }
+
+    if (STATUS_OK != audioTxSetTrigger(&settings))
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    PRINT("Trigger settings changed",0);
+
+    return audioControlReply(clientConn, "ok\n", strlen("ok\n"));
+}
+
 /* start "8 hex ip" "4 hex port" */
 /* start c0a8019a 1234 */
+/* stop, stats, reboot, net, eq, beam, trigger ... */
 static StatusCode audioContolProcessRx(const AudioControlConfig *config,
                                        struct netconn *clientConn,
                                        char *buffer, 
                                        uint16_t length)
 {
-    (void)clientConn;
-
     audioTxRtpConfig audioCfg;
 
     memset(&audioCfg, 0, sizeof(audioCfg));
@@ -64,10 +481,36 @@ static StatusCode audioContolProcessRx(const AudioControlConfig *config,
     if (strncmp(buffer, "stop", strlen("stop")) == 0)
     {
         PRINT("Stopping audio stream",0);
+        rtspServerPreempt();
         audioTxRtpTeardown();
         BOARD_LED_ORANGE_CLEAR();
         return STATUS_OK;
     }
+    else if (strncmp(buffer, "stats", strlen("stats")) == 0)
+    {
+        return audioControlStats(clientConn);
+    }
+    else if (strncmp(buffer, "net ", strlen("net ")) == 0)
+    {
+        return audioControlNet(clientConn, buffer);
+    }
+    else if (strncmp(buffer, "eq", strlen("eq")) == 0)
+    {
+        return audioControlEq(clientConn, buffer);
+    }
+    else if (strncmp(buffer, "beam", strlen("beam")) == 0)
+    {
+        return audioControlBeam(clientConn, buffer);
+    }
+    else if (strncmp(buffer, "trigger", strlen("trigger")) == 0)
+    {
+        return audioControlTrigger(clientConn, buffer);
+    }
+    else if (strncmp(buffer, "reboot", strlen("reboot")) == 0)
+    {
+        audioControlReboot(clientConn);
+        return STATUS_OK;
+    }
     /* start */
     else
     {
@@ -89,7 +532,7 @@ static StatusCode audioContolProcessRx(const AudioControlConfig *config,
 
         for (index = INDEX_IP; index < INDEX_IP+8; index++)
         {
-            if (!isdigit((int)buffer[index]) && !isalpha((int)buffer[index]))
+            if (!isxdigit((int)buffer[index]))
             {
                 SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
             }
@@ -104,7 +547,7 @@ static StatusCode audioContolProcessRx(const AudioControlConfig *config,
 
         for (index = INDEX_PORT; index < INDEX_PORT + 4; index++)
         {
-            if (!isdigit((int)buffer[index]) && !isalpha((int)buffer[index]))
+            if (!isxdigit((int)buffer[index]))
             {
                 SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
             }
@@ -122,6 +565,8 @@ static StatusCode audioContolProcessRx(const AudioControlConfig *config,
               ip4_addr4(&audioCfg.ipDest.addr),
               audioCfg.remoteRtpPort);
 
+        /* The stream has one owner, so any RTSP session is ended first */
+        rtspServerPreempt();
         audioTxRtpSetup(&audioCfg);
         audioTxRtpPlay();
 
@@ -133,125 +578,408 @@ static StatusCode audioContolProcessRx(const AudioControlConfig *config,
     return STATUS_OK;
 }
 
-static THD_FUNCTION(audioControlThd, arg) 
-{
-    StatusCode rtn = STATUS_OK;
-    struct netconn *serverConn = NULL;
-    struct netconn *clientConn = NULL;
-    struct netbuf *recvBuf = NULL;
-    char *recvData = NULL;
-    uint16_t recvLength = 0;
-    AudioControlConfig *config = (AudioControlConfig*)arg;
-
-    chRegSetThreadName(__FUNCTION__);
+/******************************************************************************/
+/* Client Slots                                                               */
+/******************************************************************************/
 
-    /* Create the socket */
-    serverConn = netconn_new(NETCONN_TCP);
+/* Must be called with the system locked */
+static audioControlClient *audioControlFindClientS(struct netconn *conn)
+{
+    uint32_t index = 0;
 
-    if (serverConn == NULL)
+    for (index = 0; index < CONFIG_AUDIO_MGMT_MAX_CLIENTS; index++)
     {
-        chThdExit(STATUS_ERROR_LIBRARY_LWIP);
+        if (audioControlThdData.clients[index].state != CLIENT_STATE_FREE &&
+            audioControlThdData.clients[index].conn == conn)
+        {
+            return &audioControlThdData.clients[index];
+        }
     }
 
-    /* Bind the socket */
-    if (ERR_OK != netconn_bind(serverConn,
-                               IP_ADDR_ANY,
-                               config->localMgmtPort))
+    return NULL;
+}
+
+/* Must be called with the system locked */
+static audioControlClient *audioControlAllocClientS(struct netconn *conn)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < CONFIG_AUDIO_MGMT_MAX_CLIENTS; index++)
     {
-        rtn = STATUS_ERROR_LIBRARY_LWIP;
-        goto server_socket_close;
+        if (audioControlThdData.clients[index].state == CLIENT_STATE_FREE)
+        {
+            memset(&audioControlThdData.clients[index], 0,
+                   sizeof(audioControlThdData.clients[index]));
+            audioControlThdData.clients[index].state = CLIENT_STATE_PENDING;
+            audioControlThdData.clients[index].conn = conn;
+            return &audioControlThdData.clients[index];
+        }
     }
 
-    /* Listen for incomming connections */
-    if (ERR_OK != netconn_listen(serverConn))
+    return NULL;
+}
+
+/* Called from the LWIP thread whenever something happens on one of our
+ * connections. Accepted connections inherit this callback from the server
+ * connection, so events can arrive for a client before netconn_accept() has
+ * returned it to us - these are recorded in a pending slot. */
+static void audioControlNetconnCb(struct netconn *conn,
+                                  enum netconn_evt evt,
+                                  u16_t len)
+{
+    int32_t *events = NULL;
+    audioControlClient *client = NULL;
+    uint32_t index = 0;
+
+    (void)len;
+
+    if (evt != NETCONN_EVT_RCVPLUS && evt != NETCONN_EVT_RCVMINUS)
     {
-        rtn = STATUS_ERROR_LIBRARY_LWIP;
-        goto server_socket_close;
+        return;
     }
 
-    while (1)
+    chSysLock();
+
+    for (index = 0; index < AUDIO_CONTROL_LISTENER_COUNT; index++)
     {
-        if (ERR_OK != netconn_accept(serverConn, &clientConn))
+        if (conn == audioControlThdData.listeners[index].conn)
         {
-            rtn = STATUS_ERROR_LIBRARY_LWIP;
-            goto server_socket_close;
+            events = &audioControlThdData.listeners[index].acceptEvents;
         }
+    }
 
-        if (clientConn == NULL)
+    if (events == NULL)
+    {
+        if (NULL == (client = audioControlFindClientS(conn)))
         {
-            rtn = STATUS_ERROR_LIBRARY_LWIP;
-            goto server_socket_close;
+            client = audioControlAllocClientS(conn);
         }
 
-        PRINT("New management connection from: %u.%u.%u.%u",
-              ip4_addr1(&clientConn->pcb.ip->remote_ip.addr),
-              ip4_addr2(&clientConn->pcb.ip->remote_ip.addr),
-              ip4_addr3(&clientConn->pcb.ip->remote_ip.addr),
-              ip4_addr4(&clientConn->pcb.ip->remote_ip.addr));
-
-        if (ERR_OK != netconn_recv(clientConn, &recvBuf))
+        /* No free slot - the connection will be refused on accept */
+        if (client != NULL)
         {
-            rtn = STATUS_ERROR_LIBRARY_LWIP;
-            goto client_socket_close;
+            events = &client->rxEvents;
         }
+    }
 
-        if (recvBuf == NULL)
+    if (events != NULL)
+    {
+        if (evt == NETCONN_EVT_RCVPLUS)
         {
-            rtn = STATUS_ERROR_LIBRARY_LWIP;
-            goto client_socket_close;
+            (*events)++;
         }
-
-        if (ERR_OK != netbuf_data(recvBuf, (void**)&recvData, &recvLength))
+        else
         {
-            rtn = STATUS_ERROR_LIBRARY_LWIP;
-            goto client_socket_close;
+            (*events)--;
         }
+    }
+
+    if (audioControlThdData.thread != NULL)
+    {
+        chEvtSignalI(audioControlThdData.thread, AUDIO_CONTROL_EVENT);
+    }
+
+    chSchRescheduleS();
+    chSysUnlock();
+}
+
+static void audioControlCloseConn(struct netconn *conn)
+{
+    if (ERR_OK != netconn_close(conn))
+    {
+        PRINT("close failed", 0);
+    }
+
+    if (ERR_OK != netconn_delete(conn))
+    {
+        PRINT("delete failed", 0);
+    }
+}
+
+static void audioControlDropClient(audioControlClient *client)
+{
+    if (client->listener == AUDIO_CONTROL_LISTENER_RTSP)
+    {
+        rtspServerClientClosed(client->conn);
+    }
+
+    /* The slot keeps hold of the connection until it is deleted, so any late
+     * events from LWIP are still attributed to it. */
+    audioControlCloseConn(client->conn);
+
+    chSysLock();
+    memset(client, 0, sizeof(*client));
+    chSysUnlock();
+}
+
+/* Returns false if nothing could be accepted */
+static bool audioControlAccept(audioControlListenerId listener)
+{
+    struct netconn *clientConn = NULL;
+    audioControlClient *client = NULL;
+    ip_addr_t remoteIp;
+    u16_t remotePort = 0;
+
+    if (ERR_OK != netconn_accept(audioControlThdData.listeners[listener].conn,
+                                 &clientConn) ||
+        clientConn == NULL)
+    {
+        PRINT("Management accept failed", 0);
+        return false;
+    }
+
+    chSysLock();
+    if (NULL == (client = audioControlFindClientS(clientConn)))
+    {
+        client = audioControlAllocClientS(clientConn);
+    }
+
+    if (client != NULL)
+    {
+        client->state = CLIENT_STATE_ACTIVE;
+        client->listener = listener;
+        client->lastActivity = chVTGetSystemTimeX();
+    }
+    chSysUnlock();
+
+    if (client == NULL)
+    {
+        PRINT("Refusing management connection - all %u slots in use",
+              CONFIG_AUDIO_MGMT_MAX_CLIENTS);
+        audioControlCloseConn(clientConn);
+        return true;
+    }
+
+    audioControlThdData.requests[client - audioControlThdData.clients].length = 0;
+
+    ip_addr_set_zero(&remoteIp);
+    netconn_peer(clientConn, &remoteIp, &remotePort);
+
+    PRINT("New %s connection from: %u.%u.%u.%u",
+          listener == AUDIO_CONTROL_LISTENER_RTSP ? "RTSP" : "management",
+          ip4_addr1(&remoteIp.addr),
+          ip4_addr2(&remoteIp.addr),
+          ip4_addr3(&remoteIp.addr),
+          ip4_addr4(&remoteIp.addr));
+
+    return true;
+}
+
+/* Adds what was received to the client's request, then handles each complete
+ * request, keeping any part of the next */
+static StatusCode audioControlRtspRx(audioControlClient *client,
+                                     struct netbuf *recvBuf)
+{
+    audioControlRequest *request =
+            &audioControlThdData.requests[client - audioControlThdData.clients];
+    uint16_t space = AUDIO_CONTROL_RX_BUFFER_SIZE - 1 - request->length;
+    uint16_t length = 0;
+    char *end = NULL;
+    char next = '\0';
+
+    if (netbuf_len(recvBuf) > space)
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    request->length += netbuf_copy(recvBuf, request->data + request->length, space);
+    request->data[request->length] = '\0';
+
+    while (NULL != (end = strstr(request->data, "\r\n\r\n")))
+    {
+        end += strlen("\r\n\r\n");
+        length = end - request->data;
+
+        next = *end;
+        *end = '\0';
+        SC_ASSERT(rtspServerProcessRx(client->conn, request->data, length));
+        *end = next;
+
+        request->length -= length;
+        memmove(request->data, end, request->length + 1);
+    }
+
+    return STATUS_OK;
+}
+
+/* Services one receive event. Any problem with the client, including
+ * malformed input, only costs that client its connection. */
+static void audioControlServiceClient(const AudioControlConfig *config,
+                                      audioControlClient *client)
+{
+    StatusCode rtn = STATUS_OK;
+    struct netbuf *recvBuf = NULL;
+    char *recvData = audioControlThdData.recvData;
+    uint16_t recvLength = 0;
+    err_t lwipErr = ERR_OK;
 
-        rtn = audioContolProcessRx(config, clientConn, recvData, recvLength);
+    client->lastActivity = chVTGetSystemTimeX();
+
+    /* Remote end closing or a connection error is reported here */
+    if (ERR_OK != (lwipErr = netconn_recv(client->conn, &recvBuf)) ||
+        recvBuf == NULL)
+    {
+        audioControlDropClient(client);
+        return;
+    }
+
+    if (client->listener == AUDIO_CONTROL_LISTENER_RTSP)
+    {
+        rtn = audioControlRtspRx(client, recvBuf);
+        netbuf_delete(recvBuf);
+    }
+    else
+    {
+        /* Leave room to terminate the string */
+        recvLength = netbuf_copy(recvBuf, recvData,
+                                 AUDIO_CONTROL_RX_BUFFER_SIZE - 1);
+        recvData[recvLength] = '\0';
+        netbuf_delete(recvBuf);
+
+        rtn = audioContolProcessRx(config, client->conn, recvData, recvLength);
+    }
+
+    if (rtn != STATUS_OK)
+    {
+        PRINT("Dropping management connection: %s", statusCodeToString(rtn));
+        audioControlDropClient(client);
+    }
+}
+
+static void audioControlCheckTimeouts(void)
+{
+    uint32_t index = 0;
+    audioControlClient *client = NULL;
+    systime_t now = chVTGetSystemTimeX();
 
-        /* A badly parsed message shouldn't break us from the server loop. */
-        if (rtn == STATUS_ERROR_EXTERNAL_INPUT)
+    for (index = 0; index < CONFIG_AUDIO_MGMT_MAX_CLIENTS; index++)
+    {
+        client = &audioControlThdData.clients[index];
+
+        if (client->state == CLIENT_STATE_ACTIVE &&
+            (systime_t)(now - client->lastActivity) >
+                S2ST(CONFIG_AUDIO_MGMT_TIMEOUT_S))
         {
-            rtn = STATUS_OK;
+            PRINT("Management connection timed out", 0);
+            audioControlDropClient(client);
         }
+    }
+}
 
-        netbuf_delete(recvBuf);
+/* Returns true if the counter was positive, i.e. work is waiting */
+static bool audioControlHasEvents(const int32_t *events)
+{
+    bool rtn = false;
+
+    chSysLock();
+    rtn = *events > 0;
+    chSysUnlock();
+
+    return rtn;
+}
+
+static StatusCode audioControlListen(audioControlListenerId listener,
+                                     uint16_t port)
+{
+    struct netconn *conn = NULL;
+
+    /* Accepted client connections inherit the callback */
+    if (NULL == (conn = netconn_new_with_callback(NETCONN_TCP,
+                                                  audioControlNetconnCb)))
+    {
+        return STATUS_ERROR_LIBRARY_LWIP;
+    }
+
+    audioControlThdData.listeners[listener].conn = conn;
 
-    client_socket_close:
-        if (clientConn)
+    /* Bind the socket */
+    if (ERR_OK != netconn_bind(conn, IP_ADDR_ANY, port))
+    {
+        return STATUS_ERROR_LIBRARY_LWIP;
+    }
+
+    /* Listen for incomming connections */
+    if (ERR_OK != netconn_listen(conn))
+    {
+        return STATUS_ERROR_LIBRARY_LWIP;
+    }
+
+    return STATUS_OK;
+}
+
+static THD_FUNCTION(audioControlThd, arg) 
+{
+    StatusCode rtn = STATUS_OK;
+    uint32_t index = 0;
+    audioControlClient *client = NULL;
+    AudioControlConfig *config = (AudioControlConfig*)arg;
+
+    chRegSetThreadName(__FUNCTION__);
+
+    rtn = audioControlListen(AUDIO_CONTROL_LISTENER_MGMT,
+                             config->localMgmtPort);
+
+    if (rtn == STATUS_OK)
+    {
+        rtn = audioControlListen(AUDIO_CONTROL_LISTENER_RTSP,
+                                 config->localRtspPort);
+    }
+
+    if (rtn != STATUS_OK)
+    {
+        goto server_socket_close;
+    }
+
+    while (chThdShouldTerminateX() == false)
+    {
+        chEvtWaitAnyTimeout(AUDIO_CONTROL_EVENT, AUDIO_CONTROL_POLL_INTERVAL);
+
+        for (index = 0; index < AUDIO_CONTROL_LISTENER_COUNT; index++)
         {
-            if (ERR_OK != netconn_close(clientConn))
+            while (audioControlHasEvents(
+                        &audioControlThdData.listeners[index].acceptEvents))
             {
-                PRINT("close failed", 0);
-                rtn = STATUS_ERROR_LIBRARY_LWIP;
+                if (audioControlAccept(index) == false)
+                {
+                    break;
+                }
             }
+        }
+
+        /* One message per client per pass, so a chatty client can't starve
+         * the others. */
+        for (index = 0; index < CONFIG_AUDIO_MGMT_MAX_CLIENTS; index++)
+        {
+            client = &audioControlThdData.clients[index];
 
-            if (ERR_OK != netconn_delete(clientConn))
+            if (client->state == CLIENT_STATE_ACTIVE &&
+                audioControlHasEvents(&client->rxEvents))
             {
-                PRINT("close failed", 0);
-                rtn = STATUS_ERROR_LIBRARY_LWIP;
-            }
+                audioControlServiceClient(config, client);
 
-            clientConn = NULL;
+                /* Come back around for anything left over */
+                chEvtSignal(chThdGetSelfX(), AUDIO_CONTROL_EVENT);
+            }
         }
 
-        if (rtn != STATUS_OK)
-        {
-            PRINT("Breaking from audio control server",0);
-            break;
-        }
+        audioControlCheckTimeouts();
     }
 
-server_socket_close:
-    /* Close the socket */
-    if (ERR_OK != netconn_close(serverConn))
+    for (index = 0; index < CONFIG_AUDIO_MGMT_MAX_CLIENTS; index++)
     {
-
+        if (audioControlThdData.clients[index].state == CLIENT_STATE_ACTIVE)
+        {
+            audioControlDropClient(&audioControlThdData.clients[index]);
+        }
     }
 
-    if (ERR_OK != netconn_delete(serverConn))
+server_socket_close:
+    for (index = 0; index < AUDIO_CONTROL_LISTENER_COUNT; index++)
     {
-
+        if (audioControlThdData.listeners[index].conn != NULL)
+        {
+            audioControlCloseConn(audioControlThdData.listeners[index].conn);
+        }
     }
 
     chThdExit(rtn);
@@ -264,8 +992,15 @@ server_socket_close:
 
 StatusCode audioControlInit(AudioControlConfig *config)
 {
+   rtspServerConfig rtspConfig;
+
    audioControlThdData.config = *config;
 
+   memset(&rtspConfig, 0, sizeof(rtspConfig));
+   rtspConfig.localAudioSourcePort = config->localAudioSourcePort;
+   rtspConfig.sessionTimeoutS = CONFIG_AUDIO_MGMT_TIMEOUT_S;
+   rtspServerInit(&rtspConfig);
+
    audioControlThdData.thread = chThdCreateStatic(
                                     audioControlThdData.workingArea,
                                     sizeof(audioControlThdData.workingArea),
@@ -279,6 +1014,7 @@ StatusCode audioControlInit(AudioControlConfig *config)
 StatusCode audioControlShutdown(void)
 {
     chThdTerminate(audioControlThdData.thread);
+    chEvtSignal(audioControlThdData.thread, AUDIO_CONTROL_EVENT);
     chThdWait(audioControlThdData.thread);
     memset(&audioControlThdData, 0, sizeof(audioControlThdData));
 
@@ -31,6 +31,7 @@
 
 typedef struct {
     uint16_t localMgmtPort;
+    uint16_t localRtspPort;
     uint16_t localAudioSourcePort;
 } AudioControlConfig;
 
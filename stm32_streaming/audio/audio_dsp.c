@@ -0,0 +1,765 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include "audio_dsp.h"
+
+/******************************************************************************/
+/* CMSIS Float Kernel                                                         */
+/******************************************************************************/
+#if AUDIO_DSP_CMSIS_F32_ENABLED
+
+/* Words and outputs of each 1 ms the block is filtered in */
+#define AUDIO_DSP_CMSIS_CHUNK_WORDS (MP45DT02_EXPANDED_BUFFER_SIZE / \
+                                     MP45DT02_I2S_WORD_SIZE_BITS)
+#define AUDIO_DSP_CMSIS_CHUNK_PCM   (MP45DT02_EXPANDED_BUFFER_SIZE / \
+                                     MP45DT02_FIR_DECIMATION_FACTOR)
+
+/* 
+ * outBuffer: Array of floats, where each element is derived from an input in
+ *            inBuffer.
+ *            It must be of length MP45DT02_EXPANDED_BUFFER_SIZE
+ * inBuffer: Array of I2S data that is to be expanded to a more useful datatype
+ *           by this function.
+ *           It must be of length AUDIO_DSP_CMSIS_CHUNK_WORDS
+ */
+static void expand(float32_t *outBuffer,
+                   const uint16_t *inBuffer)
+{
+    uint32_t bitIndex = 0;
+    uint16_t modifiedCurrentWord = 0;
+
+    /* Move each bit from each uint16_t word to an element of output array. */
+    for(bitIndex=0;
+        bitIndex < MP45DT02_EXPANDED_BUFFER_SIZE;
+        bitIndex++)
+    {
+        if (bitIndex % 16 == 0)
+        {
+            modifiedCurrentWord = inBuffer[bitIndex/MP45DT02_I2S_WORD_SIZE_BITS];
+        }
+
+        if (modifiedCurrentWord & 0x8000)
+        {
+            outBuffer[bitIndex] = INT16_MAX;
+        }
+        else 
+        {
+            outBuffer[bitIndex] = INT16_MIN;
+        }
+
+        modifiedCurrentWord = modifiedCurrentWord << 1;
+    }
+}
+
+static StatusCode audioDspCmsisF32Init(audioDsp *dsp)
+{
+    if (ARM_MATH_SUCCESS != arm_fir_decimate_init_f32(
+                                            &dsp->data.cmsisF32.decimateInstance,
+                                            FIR_COEFFS_LEN,
+                                            MP45DT02_FIR_DECIMATION_FACTOR,
+                                            firCoeffs,
+                                            dsp->data.cmsisF32.state,
+                                            MP45DT02_EXPANDED_BUFFER_SIZE))
+    {
+        return STATUS_ERROR_LIBRARY;
+    }
+
+    return STATUS_OK;
+}
+
+static void audioDspCmsisF32Process(audioDsp *dsp,
+                                    const uint16_t *pdm,
+                                    float32_t *pcm)
+{
+    uint32_t chunk = 0;
+
+    for (chunk = 0; chunk < MP45DT02_RAW_SAMPLE_DURATION_MS; chunk++)
+    {
+        expand(dsp->data.cmsisF32.expanded,
+               pdm + chunk * AUDIO_DSP_CMSIS_CHUNK_WORDS);
+
+        arm_fir_decimate_f32(&dsp->data.cmsisF32.decimateInstance,
+                             dsp->data.cmsisF32.expanded,
+                             pcm + chunk * AUDIO_DSP_CMSIS_CHUNK_PCM,
+                             MP45DT02_EXPANDED_BUFFER_SIZE);
+    }
+}
+
+#endif /* AUDIO_DSP_CMSIS_F32_ENABLED */
+
+/******************************************************************************/
+/* Polyphase LUT Kernel                                                       */
+/******************************************************************************/
+#if AUDIO_DSP_POLYPHASE_LUT_ENABLED
+
+#if FIR_COEFFS_LEN % MP45DT02_I2S_WORD_SIZE_BITS != 0 || \
+    MP45DT02_FIR_DECIMATION_FACTOR % MP45DT02_I2S_WORD_SIZE_BITS != 0
+#error "Taps and decimation factor must be whole I2S words"
+#endif
+
+/* The partial sums, firNibbleSums, are generated by utils/fir_design.py from
+ * firCoeffs, so are shared by every instance rather than built by each */
+static StatusCode audioDspPolyphaseLutInit(audioDsp *dsp)
+{
+    /* Alternating bits are what the microphone sends for silence */
+    memset(dsp->data.polyphaseLut.history,
+           0xAA,
+           sizeof(dsp->data.polyphaseLut.history));
+
+    return STATUS_OK;
+}
+
+/* Word index relative to the start of the block, negative for history */
+static inline uint16_t audioDspPolyphaseLutWord(const audioDsp *dsp,
+                                                const uint16_t *pdm,
+                                                int32_t index)
+{
+    if (index < 0)
+    {
+        return dsp->data.polyphaseLut.history[AUDIO_DSP_HISTORY_WORDS + index];
+    }
+
+    return pdm[index];
+}
+
+/* Like CMSIS, the newest input for output n is input n * decimation factor, the
+ * MSB of a word. The taps are therefore looked up from the 16 words before it
+ * shifted left a bit, with the MSB of the following word shifted in. */
+static void audioDspPolyphaseLutProcess(audioDsp *dsp,
+                                        const uint16_t *pdm,
+                                        float32_t *pcm)
+{
+    const float32_t (*lut)[16] = NULL;
+    int32_t newest = 0;
+    uint32_t output = 0;
+    uint32_t word = 0;
+    uint16_t previous = 0;
+    uint16_t next = 0;
+    uint16_t shifted = 0;
+    float32_t acc = 0;
+
+    for (output = 0; output < MP45DT02_DECIMATED_BUFFER_SIZE; output++)
+    {
+        newest = output * MP45DT02_FIR_DECIMATION_FACTOR /
+                 MP45DT02_I2S_WORD_SIZE_BITS;
+        previous = audioDspPolyphaseLutWord(dsp,
+                                            pdm,
+                                            newest - AUDIO_DSP_HISTORY_WORDS);
+        lut = firNibbleSums;
+        acc = 0;
+
+        for (word = 0; word < AUDIO_DSP_HISTORY_WORDS; word++)
+        {
+            next = audioDspPolyphaseLutWord(dsp,
+                                            pdm,
+                                            newest - AUDIO_DSP_HISTORY_WORDS +
+                                            word + 1);
+            shifted = (previous << 1) | (next >> 15);
+
+            acc += lut[0][(shifted >> 12) & 0xF] +
+                   lut[1][(shifted >> 8) & 0xF] +
+                   lut[2][(shifted >> 4) & 0xF] +
+                   lut[3][shifted & 0xF];
+
+            lut += 4;
+            previous = next;
+        }
+
+        pcm[output] = acc;
+    }
+
+    memcpy(dsp->data.polyphaseLut.history,
+           pdm + MP45DT02_I2S_SAMPLE_SIZE_2B - AUDIO_DSP_HISTORY_WORDS,
+           sizeof(dsp->data.polyphaseLut.history));
+}
+
+#endif /* AUDIO_DSP_POLYPHASE_LUT_ENABLED */
+
+/******************************************************************************/
+/* Symmetric LUT Kernel                                                       */
+/******************************************************************************/
+#if AUDIO_DSP_SYMMETRIC_LUT_ENABLED
+
+#if FIR_COEFFS_FOLDED_LEN * 2 != FIR_COEFFS_LEN
+#error "The symmetric kernel needs the folded coefficients"
+#endif
+
+/* The taps are in groups of 4 mirrored pairs, each pair having 0, 1 or 2 of
+ * its bits set, so each group indexes one of the 81 entries of its table in
+ * firFoldedTernarySums by that ternary number, the first tap's digit the most
+ * significant. These give the digits of the two groups in a byte of the older
+ * word and, mirrored, in a byte of the newer, the first group's in the upper
+ * byte. A digit is at most 2 so adding an older and newer entry gives both
+ * groups' indexes, without carries. */
+#define AUDIO_DSP_OLDER_DIGITS(x)   (27 * (((x) >> 3) & 1) + 9 * (((x) >> 2) & 1) + \
+                                     3 * (((x) >> 1) & 1) + ((x) & 1))
+#define AUDIO_DSP_NEWER_DIGITS(x)   (27 * ((x) & 1) + 9 * (((x) >> 1) & 1) +      \
+                                     3 * (((x) >> 2) & 1) + (((x) >> 3) & 1))
+#define AUDIO_DSP_OLDER_BYTE(b)     (AUDIO_DSP_OLDER_DIGITS((b) >> 4) << 8 |     \
+                                     AUDIO_DSP_OLDER_DIGITS((b) & 0xF))
+#define AUDIO_DSP_NEWER_BYTE(b)     (AUDIO_DSP_NEWER_DIGITS((b) & 0xF) << 8 |    \
+                                     AUDIO_DSP_NEWER_DIGITS((b) >> 4))
+
+#define AUDIO_DSP_BYTES_4(M, b)     M(b), M((b) + 1), M((b) + 2), M((b) + 3)
+#define AUDIO_DSP_BYTES_16(M, b)    AUDIO_DSP_BYTES_4(M, b),                     \
+                                    AUDIO_DSP_BYTES_4(M, (b) + 4),               \
+                                    AUDIO_DSP_BYTES_4(M, (b) + 8),               \
+                                    AUDIO_DSP_BYTES_4(M, (b) + 12)
+#define AUDIO_DSP_BYTES_64(M, b)    AUDIO_DSP_BYTES_16(M, b),                    \
+                                    AUDIO_DSP_BYTES_16(M, (b) + 16),             \
+                                    AUDIO_DSP_BYTES_16(M, (b) + 32),             \
+                                    AUDIO_DSP_BYTES_16(M, (b) + 48)
+#define AUDIO_DSP_BYTES_256(M)      AUDIO_DSP_BYTES_64(M, 0),                    \
+                                    AUDIO_DSP_BYTES_64(M, 64),                   \
+                                    AUDIO_DSP_BYTES_64(M, 128),                  \
+                                    AUDIO_DSP_BYTES_64(M, 192)
+
+static const uint16_t audioDspOlderDigits[256] = {
+    AUDIO_DSP_BYTES_256(AUDIO_DSP_OLDER_BYTE)
+};
+
+static const uint16_t audioDspNewerDigits[256] = {
+    AUDIO_DSP_BYTES_256(AUDIO_DSP_NEWER_BYTE)
+};
+
+static StatusCode audioDspSymmetricLutInit(audioDsp *dsp)
+{
+    memset(dsp->data.symmetricLut.history,
+           0xAA,
+           sizeof(dsp->data.symmetricLut.history));
+
+    return STATUS_OK;
+}
+
+static inline uint16_t audioDspSymmetricLutWord(const audioDsp *dsp,
+                                                const uint16_t *pdm,
+                                                int32_t index)
+{
+    if (index < 0)
+    {
+        return dsp->data.symmetricLut.history[AUDIO_DSP_HISTORY_WORDS + index];
+    }
+
+    return pdm[index];
+}
+
+/* The taps are gathered into 16 words, as for the polyphase kernel. Tap n and
+ * tap FIR_COEFFS_LEN - 1 - n share a coefficient, so word n is paired with
+ * word 15 - n, bit 15 - b of the older with bit b of the newer. Each pair of
+ * words is 4 lookups of the digits and 4 of the sums, 32 sums an output. */
+static void audioDspSymmetricLutProcess(audioDsp *dsp,
+                                        const uint16_t *pdm,
+                                        float32_t *pcm)
+{
+    uint16_t window[AUDIO_DSP_HISTORY_WORDS];
+    const float32_t (*lut)[81] = NULL;
+    int32_t oldest = 0;
+    uint32_t output = 0;
+    uint32_t word = 0;
+    uint16_t previous = 0;
+    uint16_t next = 0;
+    uint16_t older = 0;
+    uint16_t newer = 0;
+    uint32_t digits = 0;
+    float32_t acc = 0;
+
+    for (output = 0; output < MP45DT02_DECIMATED_BUFFER_SIZE; output++)
+    {
+        oldest = output * MP45DT02_FIR_DECIMATION_FACTOR /
+                 MP45DT02_I2S_WORD_SIZE_BITS - AUDIO_DSP_HISTORY_WORDS;
+        previous = audioDspSymmetricLutWord(dsp, pdm, oldest);
+
+        for (word = 0; word < AUDIO_DSP_HISTORY_WORDS; word++)
+        {
+            next = audioDspSymmetricLutWord(dsp, pdm, oldest + word + 1);
+            window[word] = (previous << 1) | (next >> 15);
+            previous = next;
+        }
+
+        lut = firFoldedTernarySums;
+        acc = 0;
+
+        for (word = 0; word < AUDIO_DSP_HISTORY_WORDS / 2; word++)
+        {
+            older = window[word];
+            newer = window[AUDIO_DSP_HISTORY_WORDS - 1 - word];
+
+            digits = audioDspOlderDigits[older >> 8] +
+                     audioDspNewerDigits[newer & 0xFF];
+            acc += lut[0][digits >> 8] + lut[1][digits & 0xFF];
+
+            digits = audioDspOlderDigits[older & 0xFF] +
+                     audioDspNewerDigits[newer >> 8];
+            acc += lut[2][digits >> 8] + lut[3][digits & 0xFF];
+
+            lut += 4;
+        }
+
+        pcm[output] = acc;
+    }
+
+    memcpy(dsp->data.symmetricLut.history,
+           pdm + MP45DT02_I2S_SAMPLE_SIZE_2B - AUDIO_DSP_HISTORY_WORDS,
+           sizeof(dsp->data.symmetricLut.history));
+}
+
+#endif /* AUDIO_DSP_SYMMETRIC_LUT_ENABLED */
+
+/******************************************************************************/
+/* Q15 SMLAD Kernel                                                           */
+/******************************************************************************/
+#if AUDIO_DSP_Q15_SMLAD_ENABLED
+
+/* Largest q15 coefficient after scaling */
+#define AUDIO_DSP_Q15_MAX               32767
+
+/* Dual signed 16 bit multiply, accumulated into 32 bits. Uses the Cortex-M4
+ * instruction where available. The C version wraps on overflow, as SMLAD
+ * does, so the two are bit exact. */
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#define audioDspSmlad(x, y, acc)        __SMLAD((x), (y), (acc))
+#else
+static inline uint32_t audioDspSmlad(uint32_t x, uint32_t y, uint32_t acc)
+{
+    return acc +
+           (uint32_t)((int32_t)(int16_t)x * (int16_t)y) +
+           (uint32_t)((int32_t)(int16_t)(x >> 16) * (int16_t)(y >> 16));
+}
+#endif
+
+/* Each bit is +/-1 in q15, so these are both bits of a pair packed for
+ * SMLAD, indexed by the older bit then the newer */
+static const uint32_t audioDspQ15BitPairs[4] = {
+    0xFFFFFFFF, /* -1, -1 */
+    0x0001FFFF, /* -1, +1 */
+    0xFFFF0001, /* +1, -1 */
+    0x00010001, /* +1, +1 */
+};
+
+static StatusCode audioDspQ15SmladInit(audioDsp *dsp)
+{
+    float32_t largest = 0;
+    float32_t gain = 1;
+    float32_t scaled = 0;
+    int32_t coeff = 0;
+    int32_t sum = 0;
+    uint32_t tap = 0;
+
+    for (tap = 0; tap < FIR_COEFFS_LEN; tap++)
+    {
+        if (firCoeffs[tap] > largest)
+        {
+            largest = firCoeffs[tap];
+        }
+        else if (-firCoeffs[tap] > largest)
+        {
+            largest = -firCoeffs[tap];
+        }
+    }
+
+    if (largest == 0)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    /* Power of 2 so the output scaling is exact */
+    while (largest * gain * 2 <= AUDIO_DSP_Q15_MAX)
+    {
+        gain *= 2;
+    }
+
+    for (tap = 0; tap < FIR_COEFFS_LEN; tap++)
+    {
+        scaled = firCoeffs[tap] * gain;
+        coeff = (int32_t)(scaled >= 0 ? scaled + 0.5f : scaled - 0.5f);
+        sum += coeff;
+
+        if (tap % 2 == 0)
+        {
+            dsp->data.q15Smlad.coeffPairs[tap / 2] = (uint16_t)coeff;
+        }
+        else
+        {
+            dsp->data.q15Smlad.coeffPairs[tap / 2] |= (uint32_t)coeff << 16;
+        }
+    }
+
+    /* A bit is INT16_MAX or INT16_MIN, or 32767.5 * (+/-1) - 0.5 */
+    dsp->data.q15Smlad.scale = 32767.5f / gain;
+    dsp->data.q15Smlad.offset = -0.5f * sum / gain;
+
+    memset(dsp->data.q15Smlad.history,
+           0xAA,
+           sizeof(dsp->data.q15Smlad.history));
+
+    return STATUS_OK;
+}
+
+static inline uint16_t audioDspQ15SmladWord(const audioDsp *dsp,
+                                            const uint16_t *pdm,
+                                            int32_t index)
+{
+    if (index < 0)
+    {
+        return dsp->data.q15Smlad.history[AUDIO_DSP_HISTORY_WORDS + index];
+    }
+
+    return pdm[index];
+}
+
+/* The taps are gathered into 16 words, as for the polyphase kernel, then
+ * taken 2 bits at a time, 8 SMLADs a word. */
+static void audioDspQ15SmladProcess(audioDsp *dsp,
+                                    const uint16_t *pdm,
+                                    float32_t *pcm)
+{
+    const uint32_t *coeffPairs = NULL;
+    int32_t oldest = 0;
+    uint32_t output = 0;
+    uint32_t word = 0;
+    uint16_t previous = 0;
+    uint16_t next = 0;
+    uint16_t bits = 0;
+    uint32_t acc = 0;
+
+    for (output = 0; output < MP45DT02_DECIMATED_BUFFER_SIZE; output++)
+    {
+        oldest = output * MP45DT02_FIR_DECIMATION_FACTOR /
+                 MP45DT02_I2S_WORD_SIZE_BITS - AUDIO_DSP_HISTORY_WORDS;
+        previous = audioDspQ15SmladWord(dsp, pdm, oldest);
+        coeffPairs = dsp->data.q15Smlad.coeffPairs;
+        acc = 0;
+
+        for (word = 0; word < AUDIO_DSP_HISTORY_WORDS; word++)
+        {
+            next = audioDspQ15SmladWord(dsp, pdm, oldest + word + 1);
+            bits = (previous << 1) | (next >> 15);
+
+            acc = audioDspSmlad(audioDspQ15BitPairs[(bits >> 14) & 0x3],
+                                coeffPairs[0], acc);
+            acc = audioDspSmlad(audioDspQ15BitPairs[(bits >> 12) & 0x3],
+                                coeffPairs[1], acc);
+            acc = audioDspSmlad(audioDspQ15BitPairs[(bits >> 10) & 0x3],
+                                coeffPairs[2], acc);
+            acc = audioDspSmlad(audioDspQ15BitPairs[(bits >> 8) & 0x3],
+                                coeffPairs[3], acc);
+            acc = audioDspSmlad(audioDspQ15BitPairs[(bits >> 6) & 0x3],
+                                coeffPairs[4], acc);
+            acc = audioDspSmlad(audioDspQ15BitPairs[(bits >> 4) & 0x3],
+                                coeffPairs[5], acc);
+            acc = audioDspSmlad(audioDspQ15BitPairs[(bits >> 2) & 0x3],
+                                coeffPairs[6], acc);
+            acc = audioDspSmlad(audioDspQ15BitPairs[bits & 0x3],
+                                coeffPairs[7], acc);
+
+            coeffPairs += 8;
+            previous = next;
+        }
+
+        pcm[output] = (int32_t)acc * dsp->data.q15Smlad.scale +
+                      dsp->data.q15Smlad.offset;
+    }
+
+    memcpy(dsp->data.q15Smlad.history,
+           pdm + MP45DT02_I2S_SAMPLE_SIZE_2B - AUDIO_DSP_HISTORY_WORDS,
+           sizeof(dsp->data.q15Smlad.history));
+}
+
+#endif /* AUDIO_DSP_Q15_SMLAD_ENABLED */
+
+/******************************************************************************/
+/* CIC Kernel                                                                 */
+/******************************************************************************/
+#if AUDIO_DSP_CIC_ENABLED
+
+/* Cutoff of the FIR after the CIC, as firCoeffs */
+#define AUDIO_DSP_CIC_CUTOFF_HZ     6000.0f
+#define AUDIO_DSP_CIC_RATE_HZ       (MP45DT02_RAW_FREQ_KHZ * 1000.0f / \
+                                     AUDIO_DSP_CIC_DECIMATION)
+/* Gain of the CIC at DC, AUDIO_DSP_CIC_DECIMATION ^ AUDIO_DSP_CIC_ORDER */
+#define AUDIO_DSP_CIC_GAIN          65536.0f
+
+/* PCM outputs of each 1 ms */
+#define AUDIO_DSP_CIC_CHUNK_PCM     (MP45DT02_EXPANDED_BUFFER_SIZE / \
+                                     MP45DT02_FIR_DECIMATION_FACTOR)
+
+/* Blackman windowed sinc, scaled so a bit comes out as the +/-32767.5 part of
+ * INT16_MAX or INT16_MIN, like every other kernel. The CIC's droop, about
+ * 0.5 dB at the cutoff, is not compensated. */
+static StatusCode audioDspCicInit(audioDsp *dsp)
+{
+    const float32_t fc = AUDIO_DSP_CIC_CUTOFF_HZ / AUDIO_DSP_CIC_RATE_HZ;
+    const float32_t centre = (AUDIO_DSP_CIC_FIR_TAPS - 1) / 2.0f;
+    float32_t *coeffs = dsp->data.cic.coeffs;
+    float32_t sum = 0;
+    float32_t x = 0;
+    float32_t w = 0;
+    uint32_t tap = 0;
+
+    for (tap = 0; tap < AUDIO_DSP_CIC_FIR_TAPS; tap++)
+    {
+        x = 2 * (float32_t)M_PI * fc * (tap - centre);
+        w = 2 * (float32_t)M_PI * tap / (AUDIO_DSP_CIC_FIR_TAPS - 1);
+
+        coeffs[tap] = (x == 0 ? 1 : sinf(x) / x) *
+                      (0.42f - 0.5f * cosf(w) + 0.08f * cosf(2 * w));
+        sum += coeffs[tap];
+    }
+
+    for (tap = 0; tap < AUDIO_DSP_CIC_FIR_TAPS; tap++)
+    {
+        coeffs[tap] *= 32767.5f / (AUDIO_DSP_CIC_GAIN * sum);
+    }
+
+    if (ARM_MATH_SUCCESS != arm_fir_decimate_init_f32(
+                                    &dsp->data.cic.decimateInstance,
+                                    AUDIO_DSP_CIC_FIR_TAPS,
+                                    MP45DT02_FIR_DECIMATION_FACTOR /
+                                    AUDIO_DSP_CIC_DECIMATION,
+                                    coeffs,
+                                    dsp->data.cic.state,
+                                    AUDIO_DSP_CIC_CHUNK_SIZE))
+    {
+        return STATUS_ERROR_LIBRARY;
+    }
+
+    return STATUS_OK;
+}
+
+/* Each word is one CIC output. The integrators run at the PDM rate, each bit
+ * +/-1, and the combs once a word. */
+static void audioDspCicProcess(audioDsp *dsp,
+                               const uint16_t *pdm,
+                               float32_t *pcm)
+{
+    uint32_t *integrators = dsp->data.cic.integrators;
+    uint32_t *combs = dsp->data.cic.combs;
+    uint32_t chunk = 0;
+    uint32_t word = 0;
+    uint32_t output = 0;
+    int32_t bit = 0;
+    uint16_t bits = 0;
+    uint32_t value = 0;
+    uint32_t previous = 0;
+    uint32_t stage = 0;
+
+    for (chunk = 0; chunk < MP45DT02_RAW_SAMPLE_DURATION_MS; chunk++)
+    {
+        for (word = 0; word < AUDIO_DSP_CIC_CHUNK_SIZE; word++)
+        {
+            bits = *pdm++;
+
+            for (bit = MP45DT02_I2S_WORD_SIZE_BITS - 1; bit >= 0; bit--)
+            {
+                integrators[0] += (bits >> bit) & 1 ? 1 : -1;
+                integrators[1] += integrators[0];
+                integrators[2] += integrators[1];
+                integrators[3] += integrators[2];
+            }
+
+            value = integrators[AUDIO_DSP_CIC_ORDER - 1];
+
+            for (stage = 0; stage < AUDIO_DSP_CIC_ORDER; stage++)
+            {
+                previous = combs[stage];
+                combs[stage] = value;
+                value -= previous;
+            }
+
+            dsp->data.cic.decimated[word] = (int32_t)value;
+        }
+
+        arm_fir_decimate_f32(&dsp->data.cic.decimateInstance,
+                             dsp->data.cic.decimated,
+                             pcm,
+                             AUDIO_DSP_CIC_CHUNK_SIZE);
+
+        /* The rest of INT16_MAX or INT16_MIN */
+        for (output = 0; output < AUDIO_DSP_CIC_CHUNK_PCM; output++)
+        {
+            pcm[output] -= 0.5f;
+        }
+
+        pcm += AUDIO_DSP_CIC_CHUNK_PCM;
+    }
+}
+
+#endif /* AUDIO_DSP_CIC_ENABLED */
+
+/******************************************************************************/
+/* Two Microphones on One Data Line                                           */
+/******************************************************************************/
+
+/* Separates the odd bits of x, counting from bit 0, into the upper half word
+ * and the even bits into the lower, keeping their order. The inverse of a
+ * perfect outer shuffle, from Hacker's Delight. */
+static inline uint32_t audioDspUnshuffle(uint32_t x)
+{
+    uint32_t t = 0;
+
+    t = (x ^ (x >> 1)) & 0x22222222; x = x ^ t ^ (t << 1);
+    t = (x ^ (x >> 2)) & 0x0C0C0C0C; x = x ^ t ^ (t << 2);
+    t = (x ^ (x >> 4)) & 0x00F000F0; x = x ^ t ^ (t << 4);
+    t = (x ^ (x >> 8)) & 0x0000FF00; x = x ^ t ^ (t << 8);
+
+    return x;
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+StatusCode audioDspInit(audioDsp *dsp, audioDspKernel kernel)
+{
+    memset(dsp, 0, sizeof(*dsp));
+    dsp->kernel = kernel;
+
+    switch (kernel)
+    {
+#if AUDIO_DSP_CMSIS_F32_ENABLED
+        case AUDIO_DSP_KERNEL_CMSIS_F32:
+            return audioDspCmsisF32Init(dsp);
+#endif
+#if AUDIO_DSP_POLYPHASE_LUT_ENABLED
+        case AUDIO_DSP_KERNEL_POLYPHASE_LUT:
+            return audioDspPolyphaseLutInit(dsp);
+#endif
+#if AUDIO_DSP_SYMMETRIC_LUT_ENABLED
+        case AUDIO_DSP_KERNEL_SYMMETRIC_LUT:
+            return audioDspSymmetricLutInit(dsp);
+#endif
+#if AUDIO_DSP_Q15_SMLAD_ENABLED
+        case AUDIO_DSP_KERNEL_Q15_SMLAD:
+            return audioDspQ15SmladInit(dsp);
+#endif
+#if AUDIO_DSP_CIC_ENABLED
+        case AUDIO_DSP_KERNEL_CIC:
+            return audioDspCicInit(dsp);
+#endif
+        default:
+            return STATUS_ERROR_API;
+    }
+}
+
+/* pdm:  MP45DT02_I2S_SAMPLE_SIZE_2B words, MSB first
+ * pcm:  MP45DT02_DECIMATED_BUFFER_SIZE samples, scaled to the int16_t range */
+void audioDspProcess(audioDsp *dsp,
+                     const uint16_t *pdm,
+                     float32_t *pcm)
+{
+    switch (dsp->kernel)
+    {
+#if AUDIO_DSP_CMSIS_F32_ENABLED
+        case AUDIO_DSP_KERNEL_CMSIS_F32:
+            audioDspCmsisF32Process(dsp, pdm, pcm);
+            break;
+#endif
+#if AUDIO_DSP_POLYPHASE_LUT_ENABLED
+        case AUDIO_DSP_KERNEL_POLYPHASE_LUT:
+            audioDspPolyphaseLutProcess(dsp, pdm, pcm);
+            break;
+#endif
+#if AUDIO_DSP_SYMMETRIC_LUT_ENABLED
+        case AUDIO_DSP_KERNEL_SYMMETRIC_LUT:
+            audioDspSymmetricLutProcess(dsp, pdm, pcm);
+            break;
+#endif
+#if AUDIO_DSP_Q15_SMLAD_ENABLED
+        case AUDIO_DSP_KERNEL_Q15_SMLAD:
+            audioDspQ15SmladProcess(dsp, pdm, pcm);
+            break;
+#endif
+#if AUDIO_DSP_CIC_ENABLED
+        case AUDIO_DSP_KERNEL_CIC:
+            audioDspCicProcess(dsp, pdm, pcm);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+/* Splits the words read from two microphones sharing a data line, with the
+ * I2S clock at twice theirs, into the PDM words of each. The bits alternate
+ * between the microphones, first then second, MSB first.
+ * interleaved: words words, an even number
+ * first, second: words / 2 words each */
+void audioDspDeinterleave(const uint16_t *interleaved,
+                          uint32_t words,
+                          uint16_t *first,
+                          uint16_t *second)
+{
+    uint32_t index = 0;
+    uint32_t pair = 0;
+
+    for (index = 0; index < words / 2; index++)
+    {
+        pair = audioDspUnshuffle((uint32_t)interleaved[2 * index] << 16 |
+                                 interleaved[2 * index + 1]);
+
+        first[index] = pair >> 16;
+        second[index] = pair & 0xFFFF;
+    }
+}
+
+/* Interleaves channels blocks of samples each, into frames */
+void audioDspInterleave(float32_t *const *blocks,
+                        uint32_t channels,
+                        uint32_t samples,
+                        float32_t *interleaved)
+{
+    uint32_t channel = 0;
+    uint32_t index = 0;
+
+    for (index = 0; index < samples; index++)
+    {
+        for (channel = 0; channel < channels; channel++)
+        {
+            *interleaved++ = blocks[channel][index];
+        }
+    }
+}
+
+const char *audioDspKernelName(audioDspKernel kernel)
+{
+    switch (kernel)
+    {
+        case AUDIO_DSP_KERNEL_CMSIS_F32:
+            return "cmsis_f32";
+        case AUDIO_DSP_KERNEL_POLYPHASE_LUT:
+            return "polyphase_lut";
+        case AUDIO_DSP_KERNEL_SYMMETRIC_LUT:
+            return "symmetric_lut";
+        case AUDIO_DSP_KERNEL_Q15_SMLAD:
+            return "q15_smlad";
+        case AUDIO_DSP_KERNEL_CIC:
+            return "cic";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,161 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_DSP_H__
+#define __AUDIO_DSP_H__
+
+#include <stdint.h>
+#include "arm_math.h"
+#include "status_code.h"
+#include "autogen_fir_coeffs.h"
+#include "mp45dt02_processing.h"
+
+/* Kernels can be left out of a build, so their state takes no memory, by
+ * defining AUDIO_DSP_<KERNEL>_ENABLED as 0 */
+#ifndef AUDIO_DSP_CMSIS_F32_ENABLED
+#define AUDIO_DSP_CMSIS_F32_ENABLED         1
+#endif
+
+#ifndef AUDIO_DSP_POLYPHASE_LUT_ENABLED
+#define AUDIO_DSP_POLYPHASE_LUT_ENABLED     1
+#endif
+
+#ifndef AUDIO_DSP_SYMMETRIC_LUT_ENABLED
+#define AUDIO_DSP_SYMMETRIC_LUT_ENABLED     1
+#endif
+
+#ifndef AUDIO_DSP_Q15_SMLAD_ENABLED
+#define AUDIO_DSP_Q15_SMLAD_ENABLED         1
+#endif
+
+#ifndef AUDIO_DSP_CIC_ENABLED
+#define AUDIO_DSP_CIC_ENABLED               1
+#endif
+
+/* PDM history the polyphase kernels keep between blocks, covering all the
+ * taps of the newest output */
+#define AUDIO_DSP_HISTORY_WORDS     (FIR_COEFFS_LEN / MP45DT02_I2S_WORD_SIZE_BITS)
+
+/* The CIC kernel's first stage decimates by a word, 1.024 MHz to 64 kHz, and
+ * its FIR the rest of the way */
+#define AUDIO_DSP_CIC_ORDER         4
+#define AUDIO_DSP_CIC_DECIMATION    MP45DT02_I2S_WORD_SIZE_BITS
+#define AUDIO_DSP_CIC_FIR_TAPS      64
+/* CIC outputs of each 1 ms the block is filtered in */
+#define AUDIO_DSP_CIC_CHUNK_SIZE    (MP45DT02_RAW_FREQ_KHZ / \
+                                     AUDIO_DSP_CIC_DECIMATION)
+
+/* Implementations of the PDM to PCM conversion. All but the CIC produce the
+ * same output, to within rounding, but trade off speed, memory and accuracy. */
+typedef enum {
+    /* Each bit expanded to a float, then CMSIS FIR decimation */
+    AUDIO_DSP_KERNEL_CMSIS_F32,
+    /* Only the retained outputs are computed, straight from the packed
+     * words, summing precomputed partial products for each nibble from a
+     * table in flash */
+    AUDIO_DSP_KERNEL_POLYPHASE_LUT,
+    /* As the polyphase LUT kernel, but each bit is paired with its mirror
+     * image in the symmetric FIR, and 4 pairs at a time index a table in
+     * flash, so half the lookups */
+    AUDIO_DSP_KERNEL_SYMMETRIC_LUT,
+    /* Fixed point. Pairs of taps are multiplied and accumulated by one SMLAD
+     * instruction, on cores with the DSP extension, or equivalent C. */
+    AUDIO_DSP_KERNEL_Q15_SMLAD,
+    /* A 4th order CIC, integer adds only, then a short FIR designed at init
+     * and CMSIS FIR decimation. Not the same response as firCoeffs. */
+    AUDIO_DSP_KERNEL_CIC,
+    AUDIO_DSP_KERNEL_COUNT
+} audioDspKernel;
+
+/* Converts blocks of PDM data, as read from the MP45DT02 over I2S, into PCM.
+ * Has no OS or hardware dependencies. */
+typedef struct {
+    audioDspKernel kernel;
+
+    union {
+#if AUDIO_DSP_CMSIS_F32_ENABLED
+        struct {
+            arm_fir_decimate_instance_f32 decimateInstance;
+            float32_t state[FIR_COEFFS_LEN + MP45DT02_EXPANDED_BUFFER_SIZE - 1];
+            float32_t expanded[MP45DT02_EXPANDED_BUFFER_SIZE];
+        } cmsisF32;
+#endif
+#if AUDIO_DSP_POLYPHASE_LUT_ENABLED
+        struct {
+            /* The table is firNibbleSums, shared and kept in flash */
+            uint16_t history[AUDIO_DSP_HISTORY_WORDS];
+        } polyphaseLut;
+#endif
+#if AUDIO_DSP_SYMMETRIC_LUT_ENABLED
+        struct {
+            /* The table is firFoldedTernarySums, shared and kept in flash */
+            uint16_t history[AUDIO_DSP_HISTORY_WORDS];
+        } symmetricLut;
+#endif
+#if AUDIO_DSP_Q15_SMLAD_ENABLED
+        struct {
+            /* firCoeffs in q15, scaled up by a power of 2 to make the most of
+             * the 16 bits, and packed in pairs for SMLAD. The older tap of
+             * each pair is in the lower half word. */
+            uint32_t coeffPairs[FIR_COEFFS_LEN / 2];
+            /* Converts the accumulator to the int16_t range */
+            float32_t scale;
+            float32_t offset;
+            uint16_t history[AUDIO_DSP_HISTORY_WORDS];
+        } q15Smlad;
+#endif
+#if AUDIO_DSP_CIC_ENABLED
+        struct {
+            /* Unsigned, so wrapping is defined. The output fits in 32 bits,
+             * so it is still exact. */
+            uint32_t integrators[AUDIO_DSP_CIC_ORDER];
+            /* Previous input of each comb */
+            uint32_t combs[AUDIO_DSP_CIC_ORDER];
+            arm_fir_decimate_instance_f32 decimateInstance;
+            float32_t coeffs[AUDIO_DSP_CIC_FIR_TAPS];
+            float32_t state[AUDIO_DSP_CIC_FIR_TAPS + AUDIO_DSP_CIC_CHUNK_SIZE - 1];
+            float32_t decimated[AUDIO_DSP_CIC_CHUNK_SIZE];
+        } cic;
+#endif
+        uint32_t unused;
+    } data;
+} audioDsp;
+
+StatusCode audioDspInit(audioDsp *dsp, audioDspKernel kernel);
+const char *audioDspKernelName(audioDspKernel kernel);
+void audioDspProcess(audioDsp *dsp,
+                     const uint16_t *pdm,
+                     float32_t *pcm);
+void audioDspDeinterleave(const uint16_t *interleaved,
+                          uint32_t words,
+                          uint16_t *first,
+                          uint16_t *second);
+void audioDspInterleave(float32_t *const *blocks,
+                        uint32_t channels,
+                        uint32_t samples,
+                        float32_t *interleaved);
+
+#endif /* Header Guard */
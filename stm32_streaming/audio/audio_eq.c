@@ -0,0 +1,319 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <math.h>
+#include "audio_eq.h"
+
+/* Used when a band is given without one */
+#define AUDIO_EQ_DEFAULT_Q          0.707f
+
+static const char *audioEqTypeNames[] = {
+    [AUDIO_EQ_OFF]          = "off",
+    [AUDIO_EQ_HIGHPASS]     = "highpass",
+    [AUDIO_EQ_PEAKING]      = "peaking",
+    [AUDIO_EQ_LOW_SHELF]    = "lowshelf",
+    [AUDIO_EQ_HIGH_SHELF]   = "highshelf",
+    [AUDIO_EQ_BIQUAD]       = "biquad",
+};
+
+#define AUDIO_EQ_TYPES  (sizeof(audioEqTypeNames) / sizeof(audioEqTypeNames[0]))
+
+/* Poles of 1 - a1 z^-1 - a2 z^-2 inside the unit circle */
+static bool audioEqStable(const float32_t *coeffs)
+{
+    float32_t a1 = coeffs[3];
+    float32_t a2 = coeffs[4];
+
+    return fabsf(a2) < 1 && fabsf(a1) < 1 - a2;
+}
+
+/* From the Audio EQ Cookbook, R. Bristow-Johnson. Fills band->coeffs. */
+static StatusCode audioEqDesign(audioEqBand *band, float32_t sampleRate)
+{
+    float32_t w0 = 0;
+    float32_t cosW0 = 0;
+    float32_t alpha = 0;
+    float32_t a = 0;
+    float32_t rootA = 0;
+    float32_t b[3];
+    float32_t den[3];
+    uint32_t index = 0;
+
+    if (band->type == AUDIO_EQ_OFF)
+    {
+        memset(band->coeffs, 0, sizeof(band->coeffs));
+        band->coeffs[0] = 1;
+        return STATUS_OK;
+    }
+
+    if (band->type == AUDIO_EQ_BIQUAD)
+    {
+        return audioEqStable(band->coeffs) ? STATUS_OK : STATUS_ERROR_API;
+    }
+
+    if (band->frequency <= 0 || band->frequency >= sampleRate / 2 ||
+        band->q <= 0)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    w0 = 2 * (float32_t)M_PI * band->frequency / sampleRate;
+    cosW0 = cosf(w0);
+    alpha = sinf(w0) / (2 * band->q);
+    a = powf(10, band->gainDb / 40);
+    rootA = 2 * sqrtf(a) * alpha;
+
+    switch (band->type)
+    {
+        case AUDIO_EQ_HIGHPASS:
+            b[0] = (1 + cosW0) / 2;
+            b[1] = -(1 + cosW0);
+            b[2] = (1 + cosW0) / 2;
+            den[0] = 1 + alpha;
+            den[1] = -2 * cosW0;
+            den[2] = 1 - alpha;
+            break;
+        case AUDIO_EQ_PEAKING:
+            b[0] = 1 + alpha * a;
+            b[1] = -2 * cosW0;
+            b[2] = 1 - alpha * a;
+            den[0] = 1 + alpha / a;
+            den[1] = -2 * cosW0;
+            den[2] = 1 - alpha / a;
+            break;
+        case AUDIO_EQ_LOW_SHELF:
+            b[0] = a * ((a + 1) - (a - 1) * cosW0 + rootA);
+            b[1] = 2 * a * ((a - 1) - (a + 1) * cosW0);
+            b[2] = a * ((a + 1) - (a - 1) * cosW0 - rootA);
+            den[0] = (a + 1) + (a - 1) * cosW0 + rootA;
+            den[1] = -2 * ((a - 1) + (a + 1) * cosW0);
+            den[2] = (a + 1) + (a - 1) * cosW0 - rootA;
+            break;
+        case AUDIO_EQ_HIGH_SHELF:
+            b[0] = a * ((a + 1) + (a - 1) * cosW0 + rootA);
+            b[1] = -2 * a * ((a - 1) + (a + 1) * cosW0);
+            b[2] = a * ((a + 1) + (a - 1) * cosW0 - rootA);
+            den[0] = (a + 1) - (a - 1) * cosW0 + rootA;
+            den[1] = 2 * ((a - 1) - (a + 1) * cosW0);
+            den[2] = (a + 1) - (a - 1) * cosW0 - rootA;
+            break;
+        default:
+            return STATUS_ERROR_API;
+    }
+
+    for (index = 0; index < 3; index++)
+    {
+        band->coeffs[index] = b[index] / den[0];
+    }
+
+    band->coeffs[3] = -den[1] / den[0];
+    band->coeffs[4] = -den[2] / den[0];
+
+    return STATUS_OK;
+}
+
+/* Bands which are off are left out of the cascade */
+static void audioEqRebuild(audioEq *eq)
+{
+    uint32_t index = 0;
+
+    eq->stages = 0;
+
+    for (index = 0; index < AUDIO_EQ_MAX_BANDS; index++)
+    {
+        if (eq->bands[index].type != AUDIO_EQ_OFF)
+        {
+            memcpy(&eq->coeffs[eq->stages * AUDIO_EQ_COEFFS_PER_STAGE],
+                   eq->bands[index].coeffs,
+                   sizeof(eq->bands[index].coeffs));
+            eq->stages++;
+        }
+    }
+
+    /* Clears the state too */
+    arm_biquad_cascade_df2T_init_f32(&eq->instance,
+                                     eq->stages,
+                                     eq->coeffs,
+                                     eq->state);
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+/* All bands start off */
+void audioEqInit(audioEq *eq, float32_t sampleRate)
+{
+    uint32_t index = 0;
+
+    memset(eq, 0, sizeof(*eq));
+    eq->sampleRate = sampleRate;
+
+    for (index = 0; index < AUDIO_EQ_MAX_BANDS; index++)
+    {
+        audioEqDesign(&eq->bands[index], sampleRate);
+    }
+
+    audioEqRebuild(eq);
+}
+
+/* Replaces a band. The filter state is reset, so there may be a click. */
+StatusCode audioEqSetBand(audioEq *eq, uint32_t index, const audioEqBand *band)
+{
+    audioEqBand designed = *band;
+
+    if (index >= AUDIO_EQ_MAX_BANDS)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    if (STATUS_OK != audioEqDesign(&designed, eq->sampleRate))
+    {
+        return STATUS_ERROR_API;
+    }
+
+    eq->bands[index] = designed;
+    audioEqRebuild(eq);
+
+    return STATUS_OK;
+}
+
+/* Includes the coefficients designed for the band */
+void audioEqGetBand(const audioEq *eq, uint32_t index, audioEqBand *band)
+{
+    *band = eq->bands[index % AUDIO_EQ_MAX_BANDS];
+}
+
+/* In place */
+void audioEqProcess(audioEq *eq, float32_t *samples, uint32_t count)
+{
+    if (eq->stages == 0)
+    {
+        return;
+    }
+
+    arm_biquad_cascade_df2T_f32(&eq->instance, samples, samples, count);
+}
+
+/* Parses a band from space separated text, which is modified:
+ *   off
+ *   highpass <hz> [q]
+ *   peaking|lowshelf|highshelf <hz> <gain db> [q]
+ *   biquad <b0> <b1> <b2> <a1> <a2>
+ * The biquad coefficients are in CMSIS form, a1 and a2 negated. */
+StatusCode audioEqParseBand(char *text, audioEqBand *band)
+{
+    float32_t values[AUDIO_EQ_COEFFS_PER_STAGE];
+    char *token = NULL;
+    char *save = NULL;
+    char *end = NULL;
+    uint32_t count = 0;
+    uint32_t type = 0;
+
+    memset(band, 0, sizeof(*band));
+
+    if (NULL == (token = strtok_r(text, " \r\n", &save)))
+    {
+        return STATUS_ERROR_API;
+    }
+
+    for (type = 0; type < AUDIO_EQ_TYPES; type++)
+    {
+        if (strcmp(token, audioEqTypeNames[type]) == 0)
+        {
+            break;
+        }
+    }
+
+    if (type == AUDIO_EQ_TYPES)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    while (NULL != (token = strtok_r(NULL, " \r\n", &save)))
+    {
+        if (count == AUDIO_EQ_COEFFS_PER_STAGE)
+        {
+            return STATUS_ERROR_API;
+        }
+
+        values[count++] = strtof(token, &end);
+
+        if (*end != '\0')
+        {
+            return STATUS_ERROR_API;
+        }
+    }
+
+    band->type = (audioEqType)type;
+    band->q = AUDIO_EQ_DEFAULT_Q;
+
+    switch (band->type)
+    {
+        case AUDIO_EQ_OFF:
+            return count == 0 ? STATUS_OK : STATUS_ERROR_API;
+        case AUDIO_EQ_HIGHPASS:
+            if (count < 1 || count > 2)
+            {
+                return STATUS_ERROR_API;
+            }
+
+            band->frequency = values[0];
+            band->q = count > 1 ? values[1] : band->q;
+            return STATUS_OK;
+        case AUDIO_EQ_BIQUAD:
+            if (count != AUDIO_EQ_COEFFS_PER_STAGE)
+            {
+                return STATUS_ERROR_API;
+            }
+
+            memcpy(band->coeffs, values, sizeof(band->coeffs));
+            return STATUS_OK;
+        default:
+            if (count < 2 || count > 3)
+            {
+                return STATUS_ERROR_API;
+            }
+
+            band->frequency = values[0];
+            band->gainDb = values[1];
+            band->q = count > 2 ? values[2] : band->q;
+            return STATUS_OK;
+    }
+}
+
+const char *audioEqTypeName(audioEqType type)
+{
+    if ((uint32_t)type >= AUDIO_EQ_TYPES)
+    {
+        return "unknown";
+    }
+
+    return audioEqTypeNames[type];
+}
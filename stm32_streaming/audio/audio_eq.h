@@ -0,0 +1,81 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_EQ_H__
+#define __AUDIO_EQ_H__
+
+#include <stdint.h>
+#include "arm_math.h"
+#include "status_code.h"
+
+/* Bands in the cascade. Band 0 is normally the DC blocker. */
+#define AUDIO_EQ_MAX_BANDS          4
+
+/* b0, b1, b2, a1, a2 as CMSIS expects, a1 and a2 negated */
+#define AUDIO_EQ_COEFFS_PER_STAGE   5
+
+typedef enum {
+    AUDIO_EQ_OFF,
+    /* 2nd order high-pass, e.g. a DC blocker. Ignores gainDb. */
+    AUDIO_EQ_HIGHPASS,
+    AUDIO_EQ_PEAKING,
+    AUDIO_EQ_LOW_SHELF,
+    AUDIO_EQ_HIGH_SHELF,
+    /* Coefficients given directly */
+    AUDIO_EQ_BIQUAD
+} audioEqType;
+
+typedef struct {
+    audioEqType type;
+    float32_t frequency;
+    float32_t gainDb;
+    /* Peaking bandwidth, or the resonance of the others. 0.707 gives
+     * a Butterworth high-pass and the steepest shelf without overshoot. */
+    float32_t q;
+    /* AUDIO_EQ_BIQUAD only */
+    float32_t coeffs[AUDIO_EQ_COEFFS_PER_STAGE];
+} audioEqBand;
+
+/* Cascade of biquads, in transposed direct form II, run on each block of
+ * decimated audio. Bands that are off take no time. Has no OS or hardware
+ * dependencies. */
+typedef struct {
+    float32_t sampleRate;
+    audioEqBand bands[AUDIO_EQ_MAX_BANDS];
+    arm_biquad_cascade_df2T_instance_f32 instance;
+    float32_t coeffs[AUDIO_EQ_MAX_BANDS * AUDIO_EQ_COEFFS_PER_STAGE];
+    float32_t state[AUDIO_EQ_MAX_BANDS * 2];
+    uint32_t stages;
+} audioEq;
+
+void audioEqInit(audioEq *eq, float32_t sampleRate);
+StatusCode audioEqSetBand(audioEq *eq, uint32_t index, const audioEqBand *band);
+void audioEqGetBand(const audioEq *eq, uint32_t index, audioEqBand *band);
+void audioEqProcess(audioEq *eq, float32_t *samples, uint32_t count);
+StatusCode audioEqParseBand(char *text, audioEqBand *band);
+const char *audioEqTypeName(audioEqType type);
+
+#endif /* Header Guard */
@@ -0,0 +1,364 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "audio_features.h"
+
+#define AUDIO_FEATURES_FULL_SCALE_ENERGY    (32768.0f * 32768.0f)
+
+#define AUDIO_FEATURES_PI                   3.14159265f
+
+/* Third octaves are counted from the band centred on 1 kHz */
+#define AUDIO_FEATURES_THIRD_OCTAVE_REF_HZ  1000.0f
+
+/* Nominal centres are rounded, e.g. 100 Hz is really 99.2 Hz, so a range
+ * reaches this many third octaves further */
+#define AUDIO_FEATURES_NOMINAL_TOLERANCE    0.05f
+
+/* Lowest level a byte holds, as for silence */
+#define AUDIO_FEATURES_LEVEL_MAX            255
+
+/******************************************************************************/
+/* Internal Functions                                                         */
+/******************************************************************************/
+
+static float audioFeaturesMel(float hz)
+{
+    return 2595.0f * log10f(1 + hz / 700.0f);
+}
+
+static float audioFeaturesMelToHz(float mel)
+{
+    return 700.0f * (powf(10, mel / 2595.0f) - 1);
+}
+
+/* Edges of the bands in Hz, returning how many bands there are */
+static uint32_t audioFeaturesEdgesHz(const audioFeaturesConfig *config,
+                                     float *edgesHz)
+{
+    float highHz = fminf(config->highHz, config->sampleRate / 2);
+    float centreHz = 0;
+    float lowMel = 0;
+    float highMel = 0;
+    int32_t first = 0;
+    uint32_t bands = 0;
+    uint32_t band = 0;
+
+    if (config->scale == AUDIO_FEATURES_SCALE_MEL)
+    {
+        bands = config->bands;
+        lowMel = audioFeaturesMel(config->lowHz);
+        highMel = audioFeaturesMel(highHz);
+
+        for (band = 0; band <= bands; band++)
+        {
+            edgesHz[band] = audioFeaturesMelToHz(
+                                lowMel + (highMel - lowMel) * band / bands);
+        }
+
+        return bands;
+    }
+
+    /* Those centred in the range, each reaching a sixth of an octave either
+     * side of its centre, and below Nyquist */
+    first = (int32_t)ceilf(3 * log2f(config->lowHz /
+                                     AUDIO_FEATURES_THIRD_OCTAVE_REF_HZ) -
+                           AUDIO_FEATURES_NOMINAL_TOLERANCE);
+
+    edgesHz[0] = AUDIO_FEATURES_THIRD_OCTAVE_REF_HZ *
+                 powf(2, (first - 0.5f) / 3);
+
+    for (band = 0; band < AUDIO_FEATURES_MAX_BANDS; band++)
+    {
+        centreHz = AUDIO_FEATURES_THIRD_OCTAVE_REF_HZ *
+                   powf(2, (first + (int32_t)band) / 3.0f);
+        edgesHz[band + 1] = centreHz * powf(2, 1 / 6.0f);
+
+        if (3 * log2f(centreHz / config->highHz) >
+                AUDIO_FEATURES_NOMINAL_TOLERANCE ||
+            edgesHz[band + 1] > config->sampleRate / 2)
+        {
+            break;
+        }
+    }
+
+    return band;
+}
+
+/* The packed format of arm_rfft_fast_f32(): DC and Nyquist are real, and
+ * share the first pair. The others stand for their negative frequency too. */
+static float audioFeaturesBinPower(const float *spectrum, uint32_t bin)
+{
+    if (bin == 0)
+    {
+        return spectrum[0] * spectrum[0];
+    }
+    else if (bin == AUDIO_FEATURES_BINS - 1)
+    {
+        return spectrum[1] * spectrum[1];
+    }
+
+    return 2 * (spectrum[2 * bin] * spectrum[2 * bin] +
+                spectrum[2 * bin + 1] * spectrum[2 * bin + 1]);
+}
+
+/* Windows and transforms the latest frame, adding each band's power */
+static void audioFeaturesAnalyse(audioFeatures *features)
+{
+    uint32_t index = 0;
+    uint32_t band = 0;
+    uint32_t bin = 0;
+
+    for (index = 0; index < AUDIO_FEATURES_FFT_LENGTH; index++)
+    {
+        features->frame[index] = features->input[index] *
+                                 features->window[index];
+    }
+
+    arm_rfft_fast_f32(&features->fft, features->frame, features->spectrum, 0);
+
+    for (band = 0; band < features->bands; band++)
+    {
+        for (bin = features->edges[band];
+             bin < features->edges[band + 1];
+             bin++)
+        {
+            features->power[band] += audioFeaturesBinPower(features->spectrum,
+                                                           bin);
+        }
+    }
+}
+
+/* Each band's mean square over the frame, as a byte */
+static void audioFeaturesComplete(audioFeatures *features)
+{
+    float meanSquare = 0;
+    float level = 0;
+    uint32_t band = 0;
+
+    for (band = 0; band < features->bands; band++)
+    {
+        meanSquare = features->power[band] * features->scale /
+                     features->hops;
+
+        level = meanSquare > 0 ?
+                -10 * log10f(meanSquare / AUDIO_FEATURES_FULL_SCALE_ENERGY) /
+                AUDIO_FEATURES_STEP_DB :
+                AUDIO_FEATURES_LEVEL_MAX;
+
+        features->levels[band] = level < 0 ? 0 :
+                                 level > AUDIO_FEATURES_LEVEL_MAX ?
+                                    AUDIO_FEATURES_LEVEL_MAX :
+                                    (uint8_t)(level + 0.5f);
+    }
+
+    memset(features->power, 0, sizeof(features->power));
+    features->hops = 0;
+    features->frames++;
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+StatusCode audioFeaturesInit(audioFeatures *features,
+                             const audioFeaturesConfig *config)
+{
+    float edgesHz[AUDIO_FEATURES_MAX_BANDS + 1];
+    float binHz = 0;
+    float windowEnergy = 0;
+    uint32_t edge = 0;
+    uint32_t index = 0;
+
+    if (config->sampleRate <= 0 || config->blockSamples == 0 ||
+        AUDIO_FEATURES_HOP % config->blockSamples != 0 ||
+        config->channels == 0 || config->hopsPerFrame == 0 ||
+        config->lowHz == 0 || config->lowHz >= config->highHz ||
+        (config->scale == AUDIO_FEATURES_SCALE_MEL &&
+         (config->bands == 0 || config->bands > AUDIO_FEATURES_MAX_BANDS)))
+    {
+        return STATUS_ERROR_API;
+    }
+
+    memset(features, 0, sizeof(*features));
+    features->config = *config;
+
+    if (ARM_MATH_SUCCESS != arm_rfft_fast_init_f32(&features->fft,
+                                                   AUDIO_FEATURES_FFT_LENGTH))
+    {
+        return STATUS_ERROR_LIBRARY;
+    }
+
+    if (0 == (features->bands = audioFeaturesEdgesHz(config, edgesHz)))
+    {
+        return STATUS_ERROR_API;
+    }
+
+    /* Narrow bands get at least the one bin */
+    binHz = config->sampleRate / AUDIO_FEATURES_FFT_LENGTH;
+
+    for (index = 0; index <= features->bands; index++)
+    {
+        edge = (uint32_t)(edgesHz[index] / binHz + 0.5f);
+
+        if (index > 0 && edge <= features->edges[index - 1])
+        {
+            edge = features->edges[index - 1] + 1;
+        }
+
+        if (edge > AUDIO_FEATURES_BINS)
+        {
+            return STATUS_ERROR_API;
+        }
+
+        features->edges[index] = edge;
+    }
+
+    /* Periodic Hann */
+    for (index = 0; index < AUDIO_FEATURES_FFT_LENGTH; index++)
+    {
+        features->window[index] = 0.5f - 0.5f * cosf(2 * AUDIO_FEATURES_PI *
+                                                     index /
+                                                     AUDIO_FEATURES_FFT_LENGTH);
+        windowEnergy += features->window[index] * features->window[index];
+    }
+
+    /* By Parseval, so a band's power becomes the mean square of the signal
+     * in it */
+    features->scale = 1 / (AUDIO_FEATURES_FFT_LENGTH * windowEnergy);
+
+    return STATUS_OK;
+}
+
+/* samples are interleaved, count is the samples of each channel and must be
+ * the configured blockSamples. Returns true as a frame of features is
+ * completed, to be written with audioFeaturesWrite(). */
+bool audioFeaturesProcess(audioFeatures *features,
+                          const float *samples,
+                          uint32_t count)
+{
+    const uint32_t channels = features->config.channels;
+    float *input = &features->input[AUDIO_FEATURES_FFT_LENGTH - count];
+    float mix = 0;
+    uint32_t index = 0;
+    uint32_t channel = 0;
+
+    memmove(features->input,
+            &features->input[count],
+            (AUDIO_FEATURES_FFT_LENGTH - count) * sizeof(*features->input));
+
+    for (index = 0; index < count; index++)
+    {
+        mix = 0;
+
+        for (channel = 0; channel < channels; channel++)
+        {
+            mix += *samples++;
+        }
+
+        input[index] = mix / channels;
+    }
+
+    features->position += count;
+
+    if (features->position < AUDIO_FEATURES_HOP)
+    {
+        return false;
+    }
+
+    features->position = 0;
+
+    audioFeaturesAnalyse(features);
+
+    if (++features->hops < features->config.hopsPerFrame)
+    {
+        return false;
+    }
+
+    audioFeaturesComplete(features);
+
+    return true;
+}
+
+/* Writes the latest frame, returning its length or 0 if size is too small.
+ * The header lets the receiver work out the bands for itself. */
+uint32_t audioFeaturesWrite(const audioFeatures *features,
+                            uint8_t *data,
+                            uint32_t size)
+{
+    const audioFeaturesConfig *config = &features->config;
+    uint32_t length = audioFeaturesGetLength(features);
+    uint16_t intervalMs = (uint16_t)(config->hopsPerFrame *
+                                     AUDIO_FEATURES_HOP * 1000 /
+                                     config->sampleRate);
+
+    if (size < length)
+    {
+        return 0;
+    }
+
+    data[0] = (uint8_t)config->scale;
+    data[1] = (uint8_t)features->bands;
+    data[2] = intervalMs >> 8;
+    data[3] = intervalMs & 0xFF;
+    data[4] = config->lowHz >> 8;
+    data[5] = config->lowHz & 0xFF;
+    data[6] = config->highHz >> 8;
+    data[7] = config->highHz & 0xFF;
+
+    memcpy(&data[AUDIO_FEATURES_HEADER_LENGTH],
+           features->levels,
+           features->bands);
+
+    return length;
+}
+
+uint32_t audioFeaturesGetLength(const audioFeatures *features)
+{
+    return AUDIO_FEATURES_HEADER_LENGTH + features->bands;
+}
+
+void audioFeaturesGetStats(const audioFeatures *features,
+                           audioFeaturesStats *stats)
+{
+    uint8_t loudest = AUDIO_FEATURES_LEVEL_MAX;
+    uint32_t band = 0;
+
+    for (band = 0; band < features->bands; band++)
+    {
+        if (features->levels[band] < loudest)
+        {
+            loudest = features->levels[band];
+        }
+    }
+
+    stats->frames = features->frames;
+    stats->bands = features->bands;
+    stats->maxBandDbfs = features->frames ?
+                         -loudest * AUDIO_FEATURES_STEP_DB :
+                         -AUDIO_FEATURES_LEVEL_MAX * AUDIO_FEATURES_STEP_DB;
+}
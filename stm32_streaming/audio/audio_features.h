@@ -0,0 +1,126 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_FEATURES_H__
+#define __AUDIO_FEATURES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "arm_math.h"
+#include "status_code.h"
+
+/* Frames analysed, overlapping by half. 512 samples is 32 ms at 16 kHz, 31.25
+ * Hz per bin, enough to resolve third octaves from 100 Hz. */
+#define AUDIO_FEATURES_FFT_LENGTH       512
+#define AUDIO_FEATURES_HOP              (AUDIO_FEATURES_FFT_LENGTH / 2)
+#define AUDIO_FEATURES_BINS             (AUDIO_FEATURES_FFT_LENGTH / 2 + 1)
+
+#define AUDIO_FEATURES_MAX_BANDS        40
+
+/* Each band's level is a byte, in steps of this many dB below full scale */
+#define AUDIO_FEATURES_STEP_DB          0.5f
+
+/* Scale, band count, interval and frequency range, all network order */
+#define AUDIO_FEATURES_HEADER_LENGTH    8
+#define AUDIO_FEATURES_MAX_LENGTH       (AUDIO_FEATURES_HEADER_LENGTH + \
+                                         AUDIO_FEATURES_MAX_BANDS)
+
+typedef enum {
+    /* Bands a third of an octave wide, centred on 1000 * 2^(n/3) Hz */
+    AUDIO_FEATURES_SCALE_THIRD_OCTAVE,
+    /* Bands of equal width on the mel scale */
+    AUDIO_FEATURES_SCALE_MEL
+} audioFeaturesScale;
+
+typedef struct {
+    float sampleRate;
+    /* Samples per channel passed to each audioFeaturesProcess() call, a
+     * factor of AUDIO_FEATURES_HOP */
+    uint32_t blockSamples;
+    /* Interleaved channels, mixed together before analysis */
+    uint32_t channels;
+    audioFeaturesScale scale;
+    /* Mel bands, third octave bands are however many fit */
+    uint32_t bands;
+    /* Range the bands cover, Hz. For third octaves, those centred in it. */
+    uint16_t lowHz;
+    uint16_t highHz;
+    /* Hops averaged into each frame of features */
+    uint32_t hopsPerFrame;
+} audioFeaturesConfig;
+
+typedef struct {
+    /* Feature frames completed */
+    uint32_t frames;
+    uint32_t bands;
+    /* Loudest band of the latest frame */
+    float maxBandDbfs;
+} audioFeaturesStats;
+
+/* Band energies of a stream, averaged over a number of FFT frames, for
+ * sending instead of the audio. Each frame is windowed and transformed with
+ * arm_rfft_fast_f32(), and the power of the bins in each band summed. Bands
+ * don't overlap and each has at least one bin, so the lowest third octaves
+ * are as wide as a bin. Has no OS or hardware dependencies. */
+typedef struct {
+    audioFeaturesConfig config;
+    arm_rfft_fast_instance_f32 fft;
+
+    /* Precomputed from the config. Band n is bins edges[n] until
+     * edges[n + 1]. */
+    float window[AUDIO_FEATURES_FFT_LENGTH];
+    float scale;
+    uint32_t bands;
+    uint16_t edges[AUDIO_FEATURES_MAX_BANDS + 1];
+
+    /* Input samples, oldest first */
+    float input[AUDIO_FEATURES_FFT_LENGTH];
+    float frame[AUDIO_FEATURES_FFT_LENGTH];
+    float spectrum[AUDIO_FEATURES_FFT_LENGTH];
+
+    /* Power of each band, summed over the hops so far */
+    float power[AUDIO_FEATURES_MAX_BANDS];
+    uint32_t position;
+    uint32_t hops;
+
+    /* The latest complete frame, as sent */
+    uint8_t levels[AUDIO_FEATURES_MAX_BANDS];
+    uint32_t frames;
+} audioFeatures;
+
+StatusCode audioFeaturesInit(audioFeatures *features,
+                             const audioFeaturesConfig *config);
+bool audioFeaturesProcess(audioFeatures *features,
+                          const float *samples,
+                          uint32_t count);
+uint32_t audioFeaturesWrite(const audioFeatures *features,
+                            uint8_t *data,
+                            uint32_t size);
+uint32_t audioFeaturesGetLength(const audioFeatures *features);
+void audioFeaturesGetStats(const audioFeatures *features,
+                           audioFeaturesStats *stats);
+
+#endif /* Header Guard */
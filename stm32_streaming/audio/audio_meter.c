@@ -0,0 +1,136 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "audio_meter.h"
+
+#define AUDIO_METER_FULL_SCALE      32768.0f
+
+/* Samples within 0.1 dB of full scale are counted as clipped. An overloaded
+ * microphone doesn't quite reach full scale once filtered. */
+#define AUDIO_METER_CLIP_LEVEL      (0.9886f * AUDIO_METER_FULL_SCALE)
+
+/* Integration time of the RMS meter */
+#define AUDIO_METER_RMS_MS          300.0f
+
+/* Rate the peak meter falls at, dB per second */
+#define AUDIO_METER_PEAK_DECAY_DB_S 20.0f
+
+/******************************************************************************/
+/* Internal Functions                                                         */
+/******************************************************************************/
+
+static float audioMeterDbfs(float magnitude)
+{
+    float dbfs = 0;
+
+    if (magnitude <= 0)
+    {
+        return AUDIO_METER_FLOOR_DBFS;
+    }
+
+    dbfs = 20 * log10f(magnitude / AUDIO_METER_FULL_SCALE);
+
+    return dbfs < AUDIO_METER_FLOOR_DBFS ? AUDIO_METER_FLOOR_DBFS : dbfs;
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+void audioMeterInit(audioMeter *meter, float sampleRate, uint32_t blockSamples)
+{
+    float blockMs = blockSamples * 1000 / sampleRate;
+
+    memset(meter, 0, sizeof(*meter));
+
+    meter->rmsCoeff = 1 - expf(-blockMs / AUDIO_METER_RMS_MS);
+    meter->peakDecay = powf(10, -AUDIO_METER_PEAK_DECAY_DB_S * blockMs /
+                                (1000 * 20));
+}
+
+void audioMeterProcess(audioMeter *meter, const float *samples, uint32_t count)
+{
+    float energy = 0;
+    float peak = 0;
+    float magnitude = 0;
+    uint32_t clipped = 0;
+    uint32_t index = 0;
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    for (index = 0; index < count; index++)
+    {
+        magnitude = fabsf(samples[index]);
+        energy += samples[index] * samples[index];
+
+        if (magnitude > peak)
+        {
+            peak = magnitude;
+        }
+
+        if (magnitude >= AUDIO_METER_CLIP_LEVEL)
+        {
+            clipped++;
+        }
+    }
+
+    meter->meanSquare += (energy / count - meter->meanSquare) * meter->rmsCoeff;
+
+    meter->peak *= meter->peakDecay;
+
+    if (peak > meter->peak)
+    {
+        meter->peak = peak;
+    }
+
+    if (peak > meter->maxPeak)
+    {
+        meter->maxPeak = peak;
+    }
+
+    if (clipped != 0)
+    {
+        meter->clippedSamples += clipped;
+        meter->clippedBlocks++;
+    }
+
+    meter->blocks++;
+}
+
+void audioMeterGetStats(const audioMeter *meter, audioMeterStats *stats)
+{
+    stats->blocks = meter->blocks;
+    stats->rmsDbfs = audioMeterDbfs(sqrtf(meter->meanSquare));
+    stats->peakDbfs = audioMeterDbfs(meter->peak);
+    stats->maxPeakDbfs = audioMeterDbfs(meter->maxPeak);
+    stats->clippedSamples = meter->clippedSamples;
+    stats->clippedBlocks = meter->clippedBlocks;
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_METER_H__
+#define __AUDIO_METER_H__
+
+#include <stdint.h>
+
+/* Reported for silence, rather than -infinity */
+#define AUDIO_METER_FLOOR_DBFS      -120.0f
+
+typedef struct {
+    uint32_t blocks;
+    /* Smoothed RMS level, integrated over a few hundred ms like a VU meter */
+    float rmsDbfs;
+    /* Peak level, falling back slowly after each peak */
+    float peakDbfs;
+    /* Highest peak since the meter was initialised */
+    float maxPeakDbfs;
+    /* Samples at full scale, and the blocks containing them */
+    uint32_t clippedSamples;
+    uint32_t clippedBlocks;
+} audioMeterStats;
+
+/* Level and clipping meters run on blocks of samples scaled to the int16
+ * range. Cheap enough to always run. Has no OS or hardware dependencies. */
+typedef struct {
+    /* Precomputed per block */
+    float rmsCoeff;
+    float peakDecay;
+
+    float meanSquare;
+    float peak;
+    float maxPeak;
+
+    uint32_t blocks;
+    uint32_t clippedSamples;
+    uint32_t clippedBlocks;
+} audioMeter;
+
+void audioMeterInit(audioMeter *meter, float sampleRate, uint32_t blockSamples);
+void audioMeterProcess(audioMeter *meter, const float *samples, uint32_t count);
+void audioMeterGetStats(const audioMeter *meter, audioMeterStats *stats);
+
+#endif /* Header Guard */
@@ -0,0 +1,323 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "audio_ns.h"
+
+#define AUDIO_NS_FULL_SCALE_ENERGY  (32768.0f * 32768.0f)
+
+#define AUDIO_NS_PI                 3.14159265f
+
+/* Reported for silence, rather than -infinity */
+#define AUDIO_NS_FLOOR_DB           -120.0f
+
+/* Smoothing of each bin's power from frame to frame, for the noise tracking */
+#define AUDIO_NS_POWER_SMOOTHING    0.7f
+
+/* The minimum of the smoothed power sits below the mean of the noise */
+#define AUDIO_NS_NOISE_BIAS         2.0f
+
+/* Weight of the previous frame in the decision directed SNR estimate.
+ * Higher leaves less musical noise but smears onsets. */
+#define AUDIO_NS_PRIOR_WEIGHT       0.98f
+
+/******************************************************************************/
+/* Internal Functions                                                         */
+/******************************************************************************/
+
+static float audioNsDb(float ratio)
+{
+    return ratio > 0 ? fmaxf(10 * log10f(ratio), AUDIO_NS_FLOOR_DB) :
+                       AUDIO_NS_FLOOR_DB;
+}
+
+/* The packed format of arm_rfft_fast_f32(): DC and Nyquist are real, and
+ * share the first pair */
+static float audioNsBinPower(const float *spectrum, uint32_t bin)
+{
+    if (bin == 0)
+    {
+        return spectrum[0] * spectrum[0];
+    }
+    else if (bin == AUDIO_NS_BINS - 1)
+    {
+        return spectrum[1] * spectrum[1];
+    }
+
+    return spectrum[2 * bin] * spectrum[2 * bin] +
+           spectrum[2 * bin + 1] * spectrum[2 * bin + 1];
+}
+
+static void audioNsBinScale(float *spectrum, uint32_t bin, float gain)
+{
+    if (bin == 0)
+    {
+        spectrum[0] *= gain;
+    }
+    else if (bin == AUDIO_NS_BINS - 1)
+    {
+        spectrum[1] *= gain;
+    }
+    else
+    {
+        spectrum[2 * bin] *= gain;
+        spectrum[2 * bin + 1] *= gain;
+    }
+}
+
+/* Mean square of the signal, from the energy in each bin of a frame */
+static float audioNsMeanSquare(const float *bins)
+{
+    float energy = bins[0] + bins[AUDIO_NS_BINS - 1];
+    uint32_t bin = 0;
+
+    for (bin = 1; bin < AUDIO_NS_BINS - 1; bin++)
+    {
+        energy += 2 * bins[bin];
+    }
+
+    return 2 * energy / ((float)AUDIO_NS_FFT_LENGTH * AUDIO_NS_FFT_LENGTH);
+}
+
+/* Smooths each bin's power and tracks its minimum, rising slowly. Starts
+ * from the first frame with any signal. */
+static void audioNsTrackNoise(audioNs *ns)
+{
+    float power = 0;
+    uint32_t bin = 0;
+
+    for (bin = 0; bin < AUDIO_NS_BINS; bin++)
+    {
+        power = audioNsBinPower(ns->spectrum, bin);
+
+        if (ns->noise[bin] == 0)
+        {
+            ns->power[bin] = power;
+            ns->noise[bin] = power;
+            continue;
+        }
+
+        ns->power[bin] = AUDIO_NS_POWER_SMOOTHING * ns->power[bin] +
+                         (1 - AUDIO_NS_POWER_SMOOTHING) * power;
+
+        if (ns->power[bin] < ns->noise[bin])
+        {
+            ns->noise[bin] = ns->power[bin];
+        }
+        else
+        {
+            ns->noise[bin] *= ns->noiseRise;
+        }
+    }
+}
+
+/* Wiener gain from the decision directed estimate of each bin's SNR */
+static void audioNsApplyGain(audioNs *ns)
+{
+    float noise = 0;
+    float snr = 0;
+    float prior = 0;
+    float gain = 0;
+    uint32_t bin = 0;
+
+    for (bin = 0; bin < AUDIO_NS_BINS; bin++)
+    {
+        noise = AUDIO_NS_NOISE_BIAS * ns->noise[bin];
+        snr = noise > 0 ? audioNsBinPower(ns->spectrum, bin) / noise : 0;
+
+        prior = AUDIO_NS_PRIOR_WEIGHT * ns->priorSnr[bin] +
+                (1 - AUDIO_NS_PRIOR_WEIGHT) * fmaxf(snr - 1, 0);
+
+        gain = fmaxf(prior / (1 + prior), ns->minGain);
+
+        ns->priorSnr[bin] = gain * gain * snr;
+        ns->gain[bin] = gain;
+
+        audioNsBinScale(ns->spectrum, bin, gain);
+    }
+}
+
+static void audioNsStep(audioNs *ns)
+{
+    uint32_t index = 0;
+
+    switch (ns->step)
+    {
+        case 0:
+            arm_rfft_fast_f32(&ns->fft, ns->frame, ns->spectrum, 0);
+            break;
+        case 1:
+            audioNsTrackNoise(ns);
+            break;
+        case 2:
+            audioNsApplyGain(ns);
+            ns->frames++;
+            break;
+        case 3:
+            arm_rfft_fast_f32(&ns->fft, ns->spectrum, ns->frame, 1);
+            break;
+        default:
+            for (index = 0; index < AUDIO_NS_FFT_LENGTH; index++)
+            {
+                ns->overlap[index] += ns->frame[index] * ns->window[index];
+            }
+            break;
+    }
+
+    ns->step++;
+}
+
+/* Called as a hop has been output. The overlap has had every frame it will
+ * get for the next hop, and the input is complete for a new frame. */
+static void audioNsNextFrame(audioNs *ns)
+{
+    uint32_t index = 0;
+
+    memcpy(ns->output, ns->overlap, sizeof(ns->output));
+    memmove(ns->overlap,
+            &ns->overlap[AUDIO_NS_HOP],
+            (AUDIO_NS_FFT_LENGTH - AUDIO_NS_HOP) * sizeof(*ns->overlap));
+    memset(&ns->overlap[AUDIO_NS_FFT_LENGTH - AUDIO_NS_HOP],
+           0,
+           AUDIO_NS_HOP * sizeof(*ns->overlap));
+
+    for (index = 0; index < AUDIO_NS_FFT_LENGTH; index++)
+    {
+        ns->frame[index] = ns->input[index] * ns->window[index];
+    }
+
+    ns->step = 0;
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+StatusCode audioNsInit(audioNs *ns, const audioNsConfig *config)
+{
+    float hopS = 0;
+    uint32_t index = 0;
+
+    if (config->sampleRate <= 0 || config->blockSamples == 0 ||
+        AUDIO_NS_HOP % config->blockSamples != 0 ||
+        config->maxAttenuationDb < 0 || config->noiseRiseDbS < 0)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    memset(ns, 0, sizeof(*ns));
+    ns->config = *config;
+
+    if (ARM_MATH_SUCCESS != arm_rfft_fast_init_f32(&ns->fft,
+                                                   AUDIO_NS_FFT_LENGTH))
+    {
+        return STATUS_ERROR_LIBRARY;
+    }
+
+    /* Square root of a periodic Hann, for both analysis and synthesis. The
+     * squares of frames overlapping by half sum to 1. */
+    for (index = 0; index < AUDIO_NS_FFT_LENGTH; index++)
+    {
+        ns->window[index] = sinf(AUDIO_NS_PI * index / AUDIO_NS_FFT_LENGTH);
+    }
+
+    hopS = AUDIO_NS_HOP / config->sampleRate;
+
+    ns->minGain = powf(10, -config->maxAttenuationDb / 20);
+    ns->noiseRise = powf(10, config->noiseRiseDbS * hopS / 10);
+    ns->step = AUDIO_NS_STEPS;
+
+    return STATUS_OK;
+}
+
+/* count must be the configured blockSamples. The output is delayed by
+ * audioNsLatencySamples(). */
+void audioNsProcess(audioNs *ns, float *samples, uint32_t count)
+{
+    const uint32_t blocksPerHop = AUDIO_NS_HOP / ns->config.blockSamples;
+    uint32_t steps = 0;
+
+    memmove(ns->input,
+            &ns->input[count],
+            (AUDIO_NS_FFT_LENGTH - count) * sizeof(*ns->input));
+    memcpy(&ns->input[AUDIO_NS_FFT_LENGTH - count],
+           samples,
+           count * sizeof(*samples));
+
+    memcpy(samples, &ns->output[ns->position], count * sizeof(*samples));
+
+    ns->position += count;
+
+    if (ns->position == AUDIO_NS_HOP)
+    {
+        ns->position = 0;
+
+        /* Only if blocks were skipped */
+        while (ns->step < AUDIO_NS_STEPS)
+        {
+            audioNsStep(ns);
+        }
+
+        audioNsNextFrame(ns);
+    }
+
+    /* Spread evenly, so the steps are done by the last block of the hop */
+    steps = ((ns->position / count + 1) * AUDIO_NS_STEPS + blocksPerHop - 1) /
+            blocksPerHop;
+
+    while (ns->step < steps && ns->step < AUDIO_NS_STEPS)
+    {
+        audioNsStep(ns);
+    }
+}
+
+void audioNsGetStats(const audioNs *ns, audioNsStats *stats)
+{
+    float gain = 0;
+    uint32_t bin = 0;
+
+    for (bin = 0; bin < AUDIO_NS_BINS; bin++)
+    {
+        gain += ns->gain[bin];
+    }
+
+    stats->frames = ns->frames;
+    stats->noiseDbfs = audioNsDb(AUDIO_NS_NOISE_BIAS *
+                                 audioNsMeanSquare(ns->noise) /
+                                 AUDIO_NS_FULL_SCALE_ENERGY);
+    stats->gainDb = 2 * audioNsDb(gain / AUDIO_NS_BINS);
+    stats->latencySamples = audioNsLatencySamples(ns);
+}
+
+/* A frame's output is complete a hop after it has filled, and is output
+ * over the hop after that */
+uint32_t audioNsLatencySamples(const audioNs *ns)
+{
+    (void)ns;
+
+    return AUDIO_NS_FFT_LENGTH + AUDIO_NS_HOP;
+}
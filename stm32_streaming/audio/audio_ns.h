@@ -0,0 +1,108 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_NS_H__
+#define __AUDIO_NS_H__
+
+#include <stdint.h>
+#include "arm_math.h"
+#include "status_code.h"
+
+/* Frames analysed, overlapping by half. 256 samples is 16 ms at 16 kHz, 62.5
+ * Hz per bin. */
+#define AUDIO_NS_FFT_LENGTH         256
+#define AUDIO_NS_HOP                (AUDIO_NS_FFT_LENGTH / 2)
+#define AUDIO_NS_BINS               (AUDIO_NS_FFT_LENGTH / 2 + 1)
+
+/* Steps each frame is processed in, spread over the blocks of a hop */
+#define AUDIO_NS_STEPS              5
+
+typedef struct {
+    float sampleRate;
+    /* Samples passed to each audioNsProcess() call, a factor of
+     * AUDIO_NS_HOP */
+    uint32_t blockSamples;
+    /* Most a bin is turned down by, dB. Limits the musical noise left by
+     * turning bins up and down from frame to frame. */
+    float maxAttenuationDb;
+    /* Fastest the noise floor estimate rises, dB per second. It falls as
+     * fast as the level does. */
+    float noiseRiseDbS;
+} audioNsConfig;
+
+typedef struct {
+    uint32_t frames;
+    /* Estimated noise floor, over all bins */
+    float noiseDbfs;
+    /* Mean gain over the bins of the latest frame */
+    float gainDb;
+    /* The output lags the input by this */
+    uint32_t latencySamples;
+} audioNsStats;
+
+/* Spectral noise suppression, run in place on blocks of samples scaled to the
+ * int16 range. Each frame is windowed and transformed with
+ * arm_rfft_fast_f32(), and each bin scaled by a Wiener gain from its level
+ * over the tracked noise floor, before being transformed back and overlap
+ * added. The work on a frame is split into AUDIO_NS_STEPS, spread over the
+ * blocks arriving while the next frame fills, so no block does more than one
+ * FFT. Has no OS or hardware dependencies. */
+typedef struct {
+    audioNsConfig config;
+    arm_rfft_fast_instance_f32 fft;
+
+    /* Precomputed from the config */
+    float window[AUDIO_NS_FFT_LENGTH];
+    float minGain;
+    float noiseRise;
+
+    /* Input samples, oldest first, and the frame being worked on */
+    float input[AUDIO_NS_FFT_LENGTH];
+    float frame[AUDIO_NS_FFT_LENGTH];
+    float spectrum[AUDIO_NS_FFT_LENGTH];
+    /* Output still being added to by later frames, and that being output */
+    float overlap[AUDIO_NS_FFT_LENGTH];
+    float output[AUDIO_NS_HOP];
+
+    /* For each bin */
+    float power[AUDIO_NS_BINS];
+    float noise[AUDIO_NS_BINS];
+    /* Estimated speech to noise ratio of the previous frame */
+    float priorSnr[AUDIO_NS_BINS];
+    float gain[AUDIO_NS_BINS];
+
+    /* Samples into the hop, and the steps done on the frame */
+    uint32_t position;
+    uint32_t step;
+    uint32_t frames;
+} audioNs;
+
+StatusCode audioNsInit(audioNs *ns, const audioNsConfig *config);
+void audioNsProcess(audioNs *ns, float *samples, uint32_t count);
+void audioNsGetStats(const audioNs *ns, audioNsStats *stats);
+uint32_t audioNsLatencySamples(const audioNs *ns);
+
+#endif /* Header Guard */
@@ -0,0 +1,338 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "audio_packetizer.h"
+
+#define HTON16(H16)                 (__builtin_bswap16(H16))
+
+/* Full scale of a sample, squared, i.e. the 0 dBov mean square */
+#define FULL_SCALE_ENERGY           (32768.0f * 32768.0f)
+#define LEVEL_MAX                   127
+
+/******************************************************************************/
+/* Internal Functions                                                         */
+/******************************************************************************/
+
+static int16_t audioPacketizerSaturate(audioPacketizer *packetizer,
+                                       float sample)
+{
+    if (sample >= INT16_MAX)
+    {
+        packetizer->stats.clippedSamples++;
+        return INT16_MAX;
+    }
+    else if (sample <= INT16_MIN)
+    {
+        packetizer->stats.clippedSamples++;
+        return INT16_MIN;
+    }
+
+    return (int16_t)sample;
+}
+
+static void audioPacketizerRelease(audioPacketizer *packetizer)
+{
+    if (packetizer->payload.handle != NULL)
+    {
+        packetizer->config.releaseCb(packetizer->config.cbArg,
+                                     packetizer->payload.handle);
+    }
+
+    memset(&packetizer->payload, 0, sizeof(packetizer->payload));
+}
+
+/* Level of a mean square in -dBov, as carried by RFC 3389 comfort noise and
+ * the RFC 6464 audio level. 127 is silence. */
+static uint8_t audioPacketizerLevel(float meanSquare)
+{
+    float level = 0;
+
+    if (meanSquare <= 0)
+    {
+        return LEVEL_MAX;
+    }
+
+    level = -10.0f * log10f(meanSquare / FULL_SCALE_ENERGY);
+
+    if (level < 0)
+    {
+        return 0;
+    }
+    else if (level > LEVEL_MAX)
+    {
+        return LEVEL_MAX;
+    }
+
+    return (uint8_t)(level + 0.5f);
+}
+
+/* Fills in the header extension, written with the header. The audio level is
+ * known here, anything else is up to the extension callback. */
+static StatusCode audioPacketizerAddExtensions(audioPacketizer *packetizer,
+                                               uint8_t *data,
+                                               uint8_t level,
+                                               bool voice)
+{
+    StatusCode status = STATUS_OK;
+
+    if (packetizer->config.audioLevelId != 0)
+    {
+        status = rtpSetAudioLevel(data,
+                                  packetizer->config.audioLevelId,
+                                  level,
+                                  voice);
+    }
+
+    if (STATUS_OK == status && packetizer->config.extensionCb != NULL)
+    {
+        packetizer->config.extensionCb(packetizer->config.cbArg, data);
+    }
+
+    return status;
+}
+
+/* Sends the full audio payload, marker flags the start of a talkspurt */
+static void audioPacketizerSendPayload(audioPacketizer *packetizer,
+                                       bool marker)
+{
+    uint8_t level = audioPacketizerLevel(packetizer->payload.energy /
+                                         packetizer->payloadSamples);
+
+    /* Everything sent is speech, as far as the VAD is concerned */
+    if (STATUS_OK != rtpAddHeaderEx(packetizer->payload.start,
+                                    packetizer->packetLength,
+                                    packetizer->config.payloadType,
+                                    marker) ||
+        STATUS_OK != audioPacketizerAddExtensions(packetizer,
+                                                  packetizer->payload.start,
+                                                  level,
+                                                  packetizer->config.vadEnabled))
+    {
+        audioPacketizerRelease(packetizer);
+        return;
+    }
+
+    if (packetizer->config.sendCb(packetizer->config.cbArg,
+                                  packetizer->payload.handle,
+                                  packetizer->payload.start,
+                                  packetizer->packetLength))
+    {
+        packetizer->stats.audioPackets++;
+    }
+
+    if (marker)
+    {
+        packetizer->stats.talkspurts++;
+    }
+
+    packetizer->talkspurt = true;
+
+    /* Ownership passed with the send */
+    memset(&packetizer->payload, 0, sizeof(packetizer->payload));
+}
+
+static void audioPacketizerSendCn(audioPacketizer *packetizer)
+{
+    void *handle = NULL;
+    uint8_t *data = NULL;
+    uint8_t level = audioPacketizerLevel(vadGetNoiseFloor(&packetizer->vad));
+
+    if (NULL == (data = packetizer->config.getBufferCb(
+                                            packetizer->config.cbArg,
+                                            packetizer->cnPacketLength,
+                                            &handle)))
+    {
+        rtpSkip();
+        return;
+    }
+
+    data[packetizer->headerLength] = level;
+
+    if (STATUS_OK != rtpAddHeaderEx(data,
+                                    packetizer->cnPacketLength,
+                                    packetizer->config.cnPayloadType,
+                                    false) ||
+        STATUS_OK != audioPacketizerAddExtensions(packetizer,
+                                                  data,
+                                                  level,
+                                                  false))
+    {
+        packetizer->config.releaseCb(packetizer->config.cbArg, handle);
+        return;
+    }
+
+    if (packetizer->config.sendCb(packetizer->config.cbArg,
+                                  handle,
+                                  data,
+                                  packetizer->cnPacketLength))
+    {
+        packetizer->stats.cnPackets++;
+    }
+}
+
+/* Silence - comfort noise is sent as the talkspurt ends and then
+ * periodically, otherwise nothing. The buffer is kept for the next payload. */
+static void audioPacketizerSuppressPayload(audioPacketizer *packetizer)
+{
+    packetizer->stats.suppressedPayloads++;
+
+    if (packetizer->talkspurt ||
+        ++packetizer->cnAge >= packetizer->config.cnIntervalPayloads)
+    {
+        packetizer->talkspurt = false;
+        packetizer->cnAge = 0;
+        audioPacketizerSendCn(packetizer);
+    }
+    else
+    {
+        rtpSkip();
+    }
+
+    packetizer->payload.samples = 0;
+    packetizer->payload.energy = 0;
+}
+
+static void audioPacketizerPayloadFull(audioPacketizer *packetizer)
+{
+    if (packetizer->config.vadEnabled && !vadDecide(&packetizer->vad))
+    {
+        audioPacketizerSuppressPayload(packetizer);
+        return;
+    }
+
+    audioPacketizerSendPayload(packetizer, !packetizer->talkspurt);
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+void audioPacketizerInit(audioPacketizer *packetizer,
+                         const audioPacketizerConfig *config)
+{
+    memset(packetizer, 0, sizeof(*packetizer));
+    packetizer->config = *config;
+
+    if (packetizer->config.channels == 0)
+    {
+        packetizer->config.channels = 1;
+    }
+
+    packetizer->payloadSamples = AUDIO_PACKETIZER_PAYLOAD_SAMPLES *
+                                 packetizer->config.channels;
+
+    /* rtpInit() has already been called */
+    packetizer->headerLength = rtpGetHeaderLength();
+    packetizer->packetLength = packetizer->headerLength +
+                               packetizer->payloadSamples * sizeof(int16_t);
+    packetizer->cnPacketLength = AUDIO_PACKETIZER_CN_PACKET_LENGTH -
+                                 RTP_HEADER_LENGTH + packetizer->headerLength;
+
+    if (config->vadEnabled)
+    {
+        vadInit(&packetizer->vad, &config->vad);
+    }
+}
+
+/* Adds samples, scaled to the int16_t range, to the payload being built.
+ * count covers all channels, so is a whole number of frames. Packets are sent
+ * as payloads fill. */
+void audioPacketizerProcess(audioPacketizer *packetizer,
+                            const float *samples,
+                            uint32_t count)
+{
+    uint32_t space = 0;
+    uint32_t index = 0;
+    int16_t *sample = NULL;
+
+    while (count > 0)
+    {
+        if (packetizer->payload.start == NULL)
+        {
+            packetizer->payload.start = packetizer->config.getBufferCb(
+                                            packetizer->config.cbArg,
+                                            packetizer->packetLength,
+                                            &packetizer->payload.handle);
+
+            if (packetizer->payload.start == NULL)
+            {
+                memset(&packetizer->payload, 0, sizeof(packetizer->payload));
+                packetizer->stats.droppedSamples += count;
+                return;
+            }
+        }
+
+        space = packetizer->payloadSamples - packetizer->payload.samples;
+
+        if (space > count)
+        {
+            space = count;
+        }
+
+        if (packetizer->config.vadEnabled)
+        {
+            vadAccumulate(&packetizer->vad,
+                          samples,
+                          space,
+                          packetizer->config.channels);
+        }
+
+        /* Change to network order */
+        sample = (int16_t *)(packetizer->payload.start +
+                             packetizer->headerLength) +
+                 packetizer->payload.samples;
+
+        for (index = 0; index < space; index++)
+        {
+            packetizer->payload.energy += *samples * *samples;
+            *sample++ = HTON16(audioPacketizerSaturate(packetizer,
+                                                         *samples++));
+        }
+
+        packetizer->payload.samples += space;
+        count -= space;
+
+        if (packetizer->payload.samples == packetizer->payloadSamples)
+        {
+            audioPacketizerPayloadFull(packetizer);
+        }
+    }
+}
+
+/* Drops any partially filled payload */
+void audioPacketizerReset(audioPacketizer *packetizer)
+{
+    audioPacketizerRelease(packetizer);
+}
+
+/* The next payload sent starts a talkspurt, with the marker bit set, after a
+ * gap left by something other than the VAD */
+void audioPacketizerStartTalkspurt(audioPacketizer *packetizer)
+{
+    packetizer->talkspurt = false;
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_PACKETIZER_H__
+#define __AUDIO_PACKETIZER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rtp.h"
+#include "vad.h"
+
+/* Duration of samples carried by each RTP packet */
+#define AUDIO_PACKETIZER_PAYLOAD_DURATION_MS    20
+
+/* Sampling rate of the audio being packetized, Hz */
+#define AUDIO_PACKETIZER_SAMPLE_RATE_HZ         16000
+
+/* Samples of each channel, and so the RTP timestamp increment, per payload */
+#define AUDIO_PACKETIZER_PAYLOAD_SAMPLES    (AUDIO_PACKETIZER_SAMPLE_RATE_HZ / \
+                                             1000 *                            \
+                                             AUDIO_PACKETIZER_PAYLOAD_DURATION_MS)
+
+/* Length of a mono packet, including the fixed RTP header but not any header
+ * extension */
+#define AUDIO_PACKETIZER_PACKET_LENGTH      (RTP_HEADER_LENGTH +               \
+                                             AUDIO_PACKETIZER_PAYLOAD_SAMPLES *\
+                                             sizeof(int16_t))
+
+/* RFC 3389 comfort noise packet - just the noise level, no spectral
+ * information */
+#define AUDIO_PACKETIZER_CN_PACKET_LENGTH   (RTP_HEADER_LENGTH + 1)
+
+/* Provides a buffer of at least length bytes to build a packet in, and a
+ * handle to identify it by. Returns NULL if there isn't one. */
+typedef uint8_t *(*audioPacketizerGetBufferCb)(void *arg,
+                                               uint32_t length,
+                                               void **handle);
+/* Transmits, or queues for transmission, then releases a buffer. Returns true
+ * if it was sent or queued. */
+typedef bool (*audioPacketizerSendCb)(void *arg,
+                                      void *handle,
+                                      uint8_t *data,
+                                      uint32_t length);
+/* Releases a buffer without transmitting it */
+typedef void (*audioPacketizerReleaseCb)(void *arg, void *handle);
+/* Fills in header extension elements, other than the audio level, of a packet
+ * whose RTP header has just been written */
+typedef void (*audioPacketizerExtensionCb)(void *arg, uint8_t *data);
+
+typedef struct {
+    audioPacketizerGetBufferCb getBufferCb;
+    audioPacketizerSendCb sendCb;
+    audioPacketizerReleaseCb releaseCb;
+    /* Optional */
+    audioPacketizerExtensionCb extensionCb;
+    /* Passed to the callbacks */
+    void *cbArg;
+
+    /* RTP payload type of audio */
+    uint8_t payloadType;
+    /* Interleaved channels in the samples given, 0 is taken as 1. The VAD
+     * follows the first. */
+    uint8_t channels;
+
+    /* Suppress silent payloads, sending comfort noise instead */
+    bool vadEnabled;
+    vadConfig vad;
+    uint8_t cnPayloadType;
+    /* Payload periods between comfort noise updates during silence */
+    uint32_t cnIntervalPayloads;
+
+    /* RTP header extension ID of the RFC 6464 audio level, as given to
+     * rtpInit(). 0 leaves it out. */
+    uint8_t audioLevelId;
+} audioPacketizerConfig;
+
+typedef struct {
+    uint32_t audioPackets;
+    uint32_t cnPackets;
+    uint32_t suppressedPayloads;
+    uint32_t talkspurts;
+    /* Samples lost as no buffer was available */
+    uint32_t droppedSamples;
+    /* Samples beyond the int16 range, saturated */
+    uint32_t clippedSamples;
+} audioPacketizerStats;
+
+/* Builds RTP packets of L16 audio from blocks of samples. Has no OS or
+ * network stack dependencies, these are provided by the callbacks. */
+typedef struct {
+    audioPacketizerConfig config;
+
+    /* The payload being filled */
+    struct {
+        void *handle;
+        uint8_t *start;
+        /* Of all channels */
+        uint32_t samples;
+        /* Sum of squares of the samples, for the audio level */
+        float energy;
+    } payload;
+
+    /* Samples of all channels in a full payload */
+    uint32_t payloadSamples;
+    /* Lengths including the RTP header and any extension */
+    uint32_t headerLength;
+    uint32_t packetLength;
+    uint32_t cnPacketLength;
+
+    vadState vad;
+    /* In a talkspurt, i.e. the last payload was sent */
+    bool talkspurt;
+    /* Payload periods since comfort noise was last sent */
+    uint32_t cnAge;
+
+    audioPacketizerStats stats;
+} audioPacketizer;
+
+void audioPacketizerInit(audioPacketizer *packetizer,
+                         const audioPacketizerConfig *config);
+void audioPacketizerProcess(audioPacketizer *packetizer,
+                            const float *samples,
+                            uint32_t count);
+void audioPacketizerReset(audioPacketizer *packetizer);
+void audioPacketizerStartTalkspurt(audioPacketizer *packetizer);
+
+#endif /* Header Guard */
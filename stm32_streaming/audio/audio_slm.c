@@ -0,0 +1,309 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "audio_slm.h"
+
+#define AUDIO_SLM_FULL_SCALE_ENERGY (32768.0f * 32768.0f)
+
+/* Poles of the A and C weightings, IEC 61672-1 */
+#define AUDIO_SLM_POLE_1_HZ         20.598997f
+#define AUDIO_SLM_POLE_2_HZ         107.65265f
+#define AUDIO_SLM_POLE_3_HZ         737.86223f
+#define AUDIO_SLM_POLE_4_HZ         12194.217f
+
+/* Both weightings are 0 dB here */
+#define AUDIO_SLM_REFERENCE_HZ      1000.0f
+
+#define AUDIO_SLM_FAST_S            0.125f
+#define AUDIO_SLM_SLOW_S            1.0f
+
+/* Samples filtered at once, on the stack */
+#define AUDIO_SLM_CHUNK_SAMPLES     16
+
+/******************************************************************************/
+/* Internal Functions                                                         */
+/******************************************************************************/
+
+static float audioSlmDb(const audioSlm *slm, double meanSquare)
+{
+    float db = meanSquare > 0 ?
+               10 * log10f((float)(meanSquare / AUDIO_SLM_FULL_SCALE_ENERGY)) :
+               AUDIO_SLM_FLOOR_DB;
+
+    return fmaxf(db, AUDIO_SLM_FLOOR_DB) + slm->config.calibrationDb;
+}
+
+/* Angular frequency of an analogue pole, prewarped so the bilinear transform
+ * puts it back where it was */
+static float audioSlmPrewarp(float hz, float sampleRate)
+{
+    return 2 * sampleRate * tanf((float)M_PI * hz / sampleRate);
+}
+
+/* s^2 / ((s + p1)(s + p2)) by the bilinear transform, in the
+ * arm_biquad_cascade_df2T_f32() order of b0, b1, b2, a1, a2 */
+static void audioSlmHighPass(float32_t *coeffs,
+                             float pole1Hz,
+                             float pole2Hz,
+                             float sampleRate)
+{
+    float p1 = audioSlmPrewarp(pole1Hz, sampleRate);
+    float p2 = audioSlmPrewarp(pole2Hz, sampleRate);
+    float k = 2 * sampleRate;
+    float den = k * k + (p1 + p2) * k + p1 * p2;
+
+    coeffs[0] = k * k / den;
+    coeffs[1] = -2 * k * k / den;
+    coeffs[2] = k * k / den;
+    coeffs[3] = -2 * (p1 * p2 - k * k) / den;
+    coeffs[4] = -(k * k - (p1 + p2) * k + p1 * p2) / den;
+}
+
+/* The roll off of the pair of poles at 12.2 kHz, 1 / (1 + (f / f4)^2). The
+ * filter c + (1 - 2c) z^-1 + c z^-2 follows it closely, matching exactly at
+ * a quarter of the sample rate. */
+static void audioSlmLowPass(float32_t *coeffs, float sampleRate)
+{
+    float ratio = sampleRate / 4 / AUDIO_SLM_POLE_4_HZ;
+    float c = (1 - 1 / (1 + ratio * ratio)) / 2;
+
+    coeffs[0] = c;
+    coeffs[1] = 1 - 2 * c;
+    coeffs[2] = c;
+    coeffs[3] = 0;
+    coeffs[4] = 0;
+}
+
+/* Gain of a cascade at a frequency */
+static float audioSlmGain(const float32_t *coeffs,
+                          uint32_t stages,
+                          float hz,
+                          float sampleRate)
+{
+    float w = 2 * (float)M_PI * hz / sampleRate;
+    float gain = 1;
+    float numRe = 0;
+    float numIm = 0;
+    float denRe = 0;
+    float denIm = 0;
+    uint32_t stage = 0;
+    const float32_t *c = NULL;
+
+    for (stage = 0; stage < stages; stage++)
+    {
+        c = &coeffs[stage * AUDIO_SLM_COEFFS_PER_STAGE];
+
+        numRe = c[0] + c[1] * cosf(w) + c[2] * cosf(2 * w);
+        numIm = -c[1] * sinf(w) - c[2] * sinf(2 * w);
+        denRe = 1 - c[3] * cosf(w) - c[4] * cosf(2 * w);
+        denIm = c[3] * sinf(w) + c[4] * sinf(2 * w);
+
+        gain *= sqrtf((numRe * numRe + numIm * numIm) /
+                      (denRe * denRe + denIm * denIm));
+    }
+
+    return gain;
+}
+
+/* Scales the first stage so the cascade has no gain at 1 kHz */
+static void audioSlmNormalise(float32_t *coeffs,
+                              uint32_t stages,
+                              float sampleRate)
+{
+    float gain = audioSlmGain(coeffs,
+                              stages,
+                              AUDIO_SLM_REFERENCE_HZ,
+                              sampleRate);
+
+    coeffs[0] /= gain;
+    coeffs[1] /= gain;
+    coeffs[2] /= gain;
+}
+
+static void audioSlmComplete(audioSlm *slm)
+{
+    audioSlmLevels *levels = &slm->levels;
+
+    levels->periods++;
+    levels->laeq = audioSlmDb(slm, slm->aEnergy / slm->samples);
+    levels->lceq = audioSlmDb(slm, slm->cEnergy / slm->samples);
+    levels->lzeq = audioSlmDb(slm, slm->zEnergy / slm->samples);
+    levels->lafmax = audioSlmDb(slm, slm->fastMax);
+    levels->lasmax = audioSlmDb(slm, slm->slowMax);
+    levels->lcpeak = audioSlmDb(slm, (double)slm->cPeak * slm->cPeak);
+    levels->laf = audioSlmDb(slm, slm->fast);
+    levels->las = audioSlmDb(slm, slm->slow);
+    levels->laeqTotal = audioSlmDb(slm,
+                                   slm->aEnergyTotal / slm->samplesTotal);
+
+    slm->aEnergy = 0;
+    slm->cEnergy = 0;
+    slm->zEnergy = 0;
+    slm->fastMax = 0;
+    slm->slowMax = 0;
+    slm->cPeak = 0;
+    slm->samples = 0;
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+StatusCode audioSlmInit(audioSlm *slm, const audioSlmConfig *config)
+{
+    const float sampleRate = config->sampleRate;
+
+    if (sampleRate <= 4 * AUDIO_SLM_REFERENCE_HZ ||
+        config->blockSamples == 0 || config->periodMs == 0)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    memset(slm, 0, sizeof(*slm));
+    slm->config = *config;
+
+    slm->periodSamples = (uint32_t)(sampleRate * config->periodMs / 1000);
+
+    if (slm->periodSamples % config->blockSamples != 0)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    /* A: four zeros at the origin, poles 1 and 4 doubled */
+    audioSlmHighPass(&slm->aCoeffs[0],
+                     AUDIO_SLM_POLE_1_HZ,
+                     AUDIO_SLM_POLE_1_HZ,
+                     sampleRate);
+    audioSlmHighPass(&slm->aCoeffs[AUDIO_SLM_COEFFS_PER_STAGE],
+                     AUDIO_SLM_POLE_2_HZ,
+                     AUDIO_SLM_POLE_3_HZ,
+                     sampleRate);
+    audioSlmLowPass(&slm->aCoeffs[2 * AUDIO_SLM_COEFFS_PER_STAGE], sampleRate);
+    audioSlmNormalise(slm->aCoeffs, AUDIO_SLM_STAGES, sampleRate);
+
+    /* C: two zeros at the origin, poles 1 and 4 doubled */
+    audioSlmHighPass(&slm->cCoeffs[0],
+                     AUDIO_SLM_POLE_1_HZ,
+                     AUDIO_SLM_POLE_1_HZ,
+                     sampleRate);
+    audioSlmLowPass(&slm->cCoeffs[AUDIO_SLM_COEFFS_PER_STAGE], sampleRate);
+    audioSlmNormalise(slm->cCoeffs, AUDIO_SLM_STAGES - 1, sampleRate);
+
+    arm_biquad_cascade_df2T_init_f32(&slm->aInstance,
+                                     AUDIO_SLM_STAGES,
+                                     slm->aCoeffs,
+                                     slm->aState);
+    arm_biquad_cascade_df2T_init_f32(&slm->cInstance,
+                                     AUDIO_SLM_STAGES - 1,
+                                     slm->cCoeffs,
+                                     slm->cState);
+
+    slm->fastCoeff = 1 - expf(-1 / (AUDIO_SLM_FAST_S * sampleRate));
+    slm->slowCoeff = 1 - expf(-1 / (AUDIO_SLM_SLOW_S * sampleRate));
+
+    slm->levels.laeq = audioSlmDb(slm, 0);
+    slm->levels.lceq = slm->levels.laeq;
+    slm->levels.lzeq = slm->levels.laeq;
+    slm->levels.lafmax = slm->levels.laeq;
+    slm->levels.lasmax = slm->levels.laeq;
+    slm->levels.lcpeak = slm->levels.laeq;
+    slm->levels.laf = slm->levels.laeq;
+    slm->levels.las = slm->levels.laeq;
+    slm->levels.laeqTotal = slm->levels.laeq;
+
+    return STATUS_OK;
+}
+
+/* count must be the configured blockSamples. Returns true as a period
+ * completes, with its levels ready for audioSlmGetLevels(). */
+bool audioSlmProcess(audioSlm *slm, const float *samples, uint32_t count)
+{
+    float32_t a[AUDIO_SLM_CHUNK_SAMPLES];
+    float32_t c[AUDIO_SLM_CHUNK_SAMPLES];
+    float aEnergy = 0;
+    float cEnergy = 0;
+    float zEnergy = 0;
+    float square = 0;
+    uint32_t chunk = 0;
+    uint32_t index = 0;
+
+    while (count > 0)
+    {
+        chunk = count < AUDIO_SLM_CHUNK_SAMPLES ? count :
+                                                  AUDIO_SLM_CHUNK_SAMPLES;
+
+        arm_biquad_cascade_df2T_f32(&slm->aInstance,
+                                    (float32_t *)samples,
+                                    a,
+                                    chunk);
+        arm_biquad_cascade_df2T_f32(&slm->cInstance,
+                                    (float32_t *)samples,
+                                    c,
+                                    chunk);
+
+        for (index = 0; index < chunk; index++)
+        {
+            square = a[index] * a[index];
+            aEnergy += square;
+            cEnergy += c[index] * c[index];
+            zEnergy += samples[index] * samples[index];
+
+            slm->fast += slm->fastCoeff * (square - slm->fast);
+            slm->slow += slm->slowCoeff * (square - slm->slow);
+
+            slm->fastMax = fmaxf(slm->fastMax, slm->fast);
+            slm->slowMax = fmaxf(slm->slowMax, slm->slow);
+            slm->cPeak = fmaxf(slm->cPeak, fabsf(c[index]));
+        }
+
+        samples += chunk;
+        count -= chunk;
+        slm->samples += chunk;
+    }
+
+    /* Summed per block in single precision, which is plenty for a block */
+    slm->aEnergy += aEnergy;
+    slm->cEnergy += cEnergy;
+    slm->zEnergy += zEnergy;
+    slm->aEnergyTotal += aEnergy;
+
+    if (slm->samples < slm->periodSamples)
+    {
+        return false;
+    }
+
+    slm->samplesTotal += slm->samples;
+    audioSlmComplete(slm);
+
+    return true;
+}
+
+void audioSlmGetLevels(const audioSlm *slm, audioSlmLevels *levels)
+{
+    *levels = slm->levels;
+}
@@ -0,0 +1,120 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_SLM_H__
+#define __AUDIO_SLM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "arm_math.h"
+#include "status_code.h"
+
+/* Biquads making up the A weighting, C needing one fewer */
+#define AUDIO_SLM_STAGES            3
+#define AUDIO_SLM_COEFFS_PER_STAGE  5
+
+/* Reported for silence, rather than -infinity */
+#define AUDIO_SLM_FLOOR_DB          -120.0f
+
+typedef struct {
+    float sampleRate;
+    /* Samples passed to each audioSlmProcess() call */
+    uint32_t blockSamples;
+    /* Added to levels relative to full scale, e.g. to give dB SPL */
+    float calibrationDb;
+    /* Levels are reported every period */
+    uint32_t periodMs;
+} audioSlmConfig;
+
+/* Levels over the latest complete period, dB. Equivalent continuous levels
+ * (Leq) are the mean square over the period. Fast and slow are exponentially
+ * time weighted, over 125 ms and 1 s. */
+typedef struct {
+    /* Periods completed */
+    uint32_t periods;
+    float laeq;
+    float lceq;
+    /* Without frequency weighting */
+    float lzeq;
+    /* Highest fast and slow A weighted levels within the period */
+    float lafmax;
+    float lasmax;
+    /* Highest C weighted instantaneous level, a sine peaking 3 dB over its
+     * Leq */
+    float lcpeak;
+    /* As the period ended */
+    float laf;
+    float las;
+    /* Since the meter was initialised */
+    float laeqTotal;
+} audioSlmLevels;
+
+/* Sound level meter in the manner of IEC 61672, run on blocks of samples
+ * scaled to the int16 range. A and C weighting are each a cascade of
+ * biquads, run with arm_biquad_cascade_df2T_f32(). The poles below 1 kHz are
+ * placed by the bilinear transform, prewarped. Those at 12.2 kHz lie beyond
+ * Nyquist, so their roll off is approximated by a linear phase three tap
+ * filter, within 0.5 dB to 6.3 kHz. Has no OS or hardware dependencies. */
+typedef struct {
+    audioSlmConfig config;
+
+    arm_biquad_cascade_df2T_instance_f32 aInstance;
+    arm_biquad_cascade_df2T_instance_f32 cInstance;
+    float32_t aCoeffs[AUDIO_SLM_STAGES * AUDIO_SLM_COEFFS_PER_STAGE];
+    float32_t cCoeffs[AUDIO_SLM_STAGES * AUDIO_SLM_COEFFS_PER_STAGE];
+    float32_t aState[AUDIO_SLM_STAGES * 2];
+    float32_t cState[AUDIO_SLM_STAGES * 2];
+
+    /* Precomputed from the config */
+    float fastCoeff;
+    float slowCoeff;
+    uint32_t periodSamples;
+
+    /* Time weighted mean squares */
+    float fast;
+    float slow;
+
+    /* Over the period so far */
+    double aEnergy;
+    double cEnergy;
+    double zEnergy;
+    float fastMax;
+    float slowMax;
+    float cPeak;
+    uint32_t samples;
+
+    /* Over every period */
+    double aEnergyTotal;
+    uint64_t samplesTotal;
+
+    audioSlmLevels levels;
+} audioSlm;
+
+StatusCode audioSlmInit(audioSlm *slm, const audioSlmConfig *config);
+bool audioSlmProcess(audioSlm *slm, const float *samples, uint32_t count);
+void audioSlmGetLevels(const audioSlm *slm, audioSlmLevels *levels);
+
+#endif /* Header Guard */
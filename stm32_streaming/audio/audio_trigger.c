@@ -0,0 +1,532 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "audio_trigger.h"
+
+#define AUDIO_TRIGGER_FULL_SCALE_ENERGY (32768.0f * 32768.0f)
+
+/* Reported for silence, rather than -infinity */
+#define AUDIO_TRIGGER_FLOOR_DB          -120.0f
+
+#define AUDIO_TRIGGER_ADPCM_INDEX_MAX   88
+#define AUDIO_TRIGGER_ADPCM_SIGN        0x8
+
+/* IMA ADPCM quantiser step sizes, and the change in index each code makes */
+static const int16_t audioTriggerAdpcmSteps[AUDIO_TRIGGER_ADPCM_INDEX_MAX + 1] =
+{
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41,
+    45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190,
+    209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499,
+    2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845,
+    8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+    22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t audioTriggerAdpcmIndexSteps[16] =
+{
+    -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+/******************************************************************************/
+/* Internal Functions                                                         */
+/******************************************************************************/
+
+static int16_t audioTriggerSaturate(float sample)
+{
+    if (sample >= INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    else if (sample <= INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+
+    return (int16_t)sample;
+}
+
+/* Moves the prediction and step on by a code, as both ends do */
+static void audioTriggerAdpcmUpdate(audioTriggerAdpcm *state, uint8_t code)
+{
+    int32_t step = audioTriggerAdpcmSteps[state->index];
+    int32_t delta = step >> 3;
+    int32_t predicted = state->predicted;
+    int32_t index = state->index + audioTriggerAdpcmIndexSteps[code];
+
+    if (code & 4)
+    {
+        delta += step;
+    }
+    if (code & 2)
+    {
+        delta += step >> 1;
+    }
+    if (code & 1)
+    {
+        delta += step >> 2;
+    }
+
+    predicted += code & AUDIO_TRIGGER_ADPCM_SIGN ? -delta : delta;
+
+    if (predicted > INT16_MAX)
+    {
+        predicted = INT16_MAX;
+    }
+    else if (predicted < INT16_MIN)
+    {
+        predicted = INT16_MIN;
+    }
+
+    if (index < 0)
+    {
+        index = 0;
+    }
+    else if (index > AUDIO_TRIGGER_ADPCM_INDEX_MAX)
+    {
+        index = AUDIO_TRIGGER_ADPCM_INDEX_MAX;
+    }
+
+    state->predicted = predicted;
+    state->index = index;
+}
+
+static uint8_t audioTriggerAdpcmEncode(audioTriggerAdpcm *state, int16_t sample)
+{
+    int32_t step = audioTriggerAdpcmSteps[state->index];
+    int32_t difference = sample - state->predicted;
+    uint8_t code = 0;
+
+    if (difference < 0)
+    {
+        code = AUDIO_TRIGGER_ADPCM_SIGN;
+        difference = -difference;
+    }
+
+    if (difference >= step)
+    {
+        code |= 4;
+        difference -= step;
+    }
+
+    step >>= 1;
+
+    if (difference >= step)
+    {
+        code |= 2;
+        difference -= step;
+    }
+
+    step >>= 1;
+
+    if (difference >= step)
+    {
+        code |= 1;
+    }
+
+    audioTriggerAdpcmUpdate(state, code);
+
+    return code;
+}
+
+static uint8_t *audioTriggerSlot(audioTrigger *trigger, uint32_t index)
+{
+    return trigger->config.storage +
+           (index % trigger->slots) * trigger->slotLength;
+}
+
+/* Frees the oldest slot, which will never be passed on */
+static void audioTriggerEvict(audioTrigger *trigger)
+{
+    trigger->head = (trigger->head + 1) % trigger->slots;
+    trigger->held--;
+
+    /* Only if the ring filled faster than it drained, leaving a gap */
+    if (trigger->pending > 0)
+    {
+        trigger->pending--;
+        trigger->starting = true;
+    }
+
+    trigger->stats.droppedPayloads++;
+
+    if (trigger->config.dropCb != NULL)
+    {
+        trigger->config.dropCb(trigger->config.cbArg);
+    }
+}
+
+/* Starts collecting a payload, into the next free slot unless it can be
+ * passed straight through */
+static void audioTriggerStartPayload(audioTrigger *trigger)
+{
+    uint8_t *slot = NULL;
+    uint32_t channel = 0;
+
+    trigger->passing = trigger->triggered && trigger->held == 0;
+    trigger->energy = 0;
+
+    if (trigger->passing)
+    {
+        return;
+    }
+
+    if (trigger->held == trigger->slots)
+    {
+        audioTriggerEvict(trigger);
+    }
+
+    if (!trigger->config.adpcm)
+    {
+        return;
+    }
+
+    slot = audioTriggerSlot(trigger, trigger->head + trigger->held);
+
+    for (channel = 0; channel < trigger->config.channels; channel++)
+    {
+        memcpy(slot, &trigger->encoder[channel].predicted, sizeof(int16_t));
+        slot[2] = trigger->encoder[channel].index;
+        slot[3] = 0;
+        slot += AUDIO_TRIGGER_ADPCM_HEADER_LENGTH;
+    }
+}
+
+/* Adds samples to the slot being filled */
+static void audioTriggerStore(audioTrigger *trigger,
+                              const float *samples,
+                              uint32_t count)
+{
+    uint8_t *slot = audioTriggerSlot(trigger, trigger->head + trigger->held);
+    uint32_t channels = trigger->config.channels;
+    uint32_t position = trigger->samples;
+    uint32_t index = 0;
+    int16_t sample = 0;
+    uint8_t code = 0;
+    uint8_t *data = NULL;
+
+    if (!trigger->config.adpcm)
+    {
+        for (index = 0; index < count; index++)
+        {
+            sample = audioTriggerSaturate(samples[index]);
+            memcpy(slot + (position + index) * sizeof(int16_t),
+                   &sample,
+                   sizeof(int16_t));
+        }
+
+        return;
+    }
+
+    data = slot + channels * AUDIO_TRIGGER_ADPCM_HEADER_LENGTH;
+
+    for (index = 0; index < count; index++, position++)
+    {
+        code = audioTriggerAdpcmEncode(&trigger->encoder[position % channels],
+                                       audioTriggerSaturate(samples[index]));
+
+        if (position % 2 == 0)
+        {
+            data[position / 2] = code;
+        }
+        else
+        {
+            data[position / 2] |= code << 4;
+        }
+    }
+}
+
+/* Decides whether the completed payload fires the trigger */
+static void audioTriggerEndPayload(audioTrigger *trigger)
+{
+    const audioTriggerSettings *settings = &trigger->config.settings;
+    float meanSquare = trigger->energy / trigger->samples /
+                       AUDIO_TRIGGER_FULL_SCALE_ENERGY;
+    bool speech = vadDecide(&trigger->vad);
+    bool levelFired = false;
+    bool vadFired = false;
+
+    trigger->stats.levelDbfs = meanSquare > 0 ?
+                               fmaxf(10 * log10f(meanSquare),
+                                     AUDIO_TRIGGER_FLOOR_DB) :
+                               AUDIO_TRIGGER_FLOOR_DB;
+
+    levelFired = !isnan(settings->levelDbfs) &&
+                 trigger->stats.levelDbfs >= settings->levelDbfs;
+    vadFired = settings->vad && speech;
+
+    trigger->stats.levelFires += levelFired;
+    trigger->stats.vadFires += vadFired;
+
+    if (trigger->passing)
+    {
+        trigger->stats.sentPayloads++;
+    }
+    else
+    {
+        trigger->held++;
+
+        if (trigger->triggered)
+        {
+            trigger->pending++;
+        }
+    }
+
+    trigger->samples = 0;
+
+    if (levelFired || vadFired)
+    {
+        if (!trigger->triggered)
+        {
+            trigger->triggered = true;
+            trigger->stats.events++;
+
+            /* Otherwise it runs on from the audio still being passed on */
+            if (trigger->pending == 0)
+            {
+                trigger->starting = true;
+            }
+
+            trigger->pending = trigger->held;
+        }
+
+        trigger->hangover = trigger->hangoverPayloads;
+    }
+    else if (trigger->triggered)
+    {
+        if (trigger->hangover > 0)
+        {
+            trigger->hangover--;
+        }
+
+        if (trigger->hangover == 0)
+        {
+            trigger->triggered = false;
+        }
+    }
+}
+
+/* Passes on the oldest slot, if it is due */
+static void audioTriggerDrain(audioTrigger *trigger)
+{
+    audioTriggerAdpcm decoder[AUDIO_TRIGGER_MAX_CHANNELS];
+    const uint8_t *slot = NULL;
+    const uint8_t *data = NULL;
+    uint32_t channels = trigger->config.channels;
+    uint32_t total = trigger->config.payloadSamples * channels;
+    uint32_t chunk = AUDIO_TRIGGER_CHUNK_SAMPLES / channels * channels;
+    uint32_t position = 0;
+    uint32_t index = 0;
+    uint32_t channel = 0;
+    int16_t sample = 0;
+    uint8_t code = 0;
+
+    if (trigger->pending == 0)
+    {
+        return;
+    }
+
+    slot = audioTriggerSlot(trigger, trigger->head);
+    data = slot;
+
+    if (trigger->config.adpcm)
+    {
+        for (channel = 0; channel < channels; channel++)
+        {
+            memcpy(&decoder[channel].predicted, data, sizeof(int16_t));
+            decoder[channel].index = data[2];
+            data += AUDIO_TRIGGER_ADPCM_HEADER_LENGTH;
+        }
+    }
+
+    /* Behind the latest samples by the slots after this and the payload
+     * being collected */
+    trigger->delaySamples = (trigger->held - 1) *
+                            trigger->config.payloadSamples +
+                            trigger->samples / channels;
+
+    for (position = 0; position < total; position += chunk)
+    {
+        if (chunk > total - position)
+        {
+            chunk = total - position;
+        }
+
+        for (index = 0; index < chunk; index++)
+        {
+            if (trigger->config.adpcm)
+            {
+                code = data[(position + index) / 2];
+                code = (position + index) % 2 == 0 ? code & 0xF : code >> 4;
+                audioTriggerAdpcmUpdate(&decoder[(position + index) % channels],
+                                        code);
+                sample = decoder[(position + index) % channels].predicted;
+            }
+            else
+            {
+                memcpy(&sample,
+                       data + (position + index) * sizeof(int16_t),
+                       sizeof(int16_t));
+            }
+
+            trigger->chunk[index] = sample;
+        }
+
+        trigger->config.outputCb(trigger->config.cbArg,
+                                 trigger->chunk,
+                                 chunk,
+                                 trigger->starting);
+        trigger->starting = false;
+    }
+
+    trigger->head = (trigger->head + 1) % trigger->slots;
+    trigger->held--;
+    trigger->pending--;
+    trigger->delaySamples = 0;
+    trigger->stats.sentPayloads++;
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+StatusCode audioTriggerInit(audioTrigger *trigger,
+                            const audioTriggerConfig *config)
+{
+    if (config->channels == 0 ||
+        config->channels > AUDIO_TRIGGER_MAX_CHANNELS ||
+        config->payloadSamples == 0 || config->payloadSamples % 2 != 0 ||
+        config->sampleRate == 0 || config->storage == NULL ||
+        config->outputCb == NULL)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    memset(trigger, 0, sizeof(*trigger));
+    trigger->config = *config;
+
+    trigger->slotLength = AUDIO_TRIGGER_SLOT_LENGTH(config->payloadSamples,
+                                                    config->channels,
+                                                    config->adpcm);
+    trigger->slots = config->storageLength / trigger->slotLength;
+
+    if (trigger->slots == 0)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    vadInit(&trigger->vad, &config->vad);
+    audioTriggerSetSettings(trigger, &config->settings);
+
+    return STATUS_OK;
+}
+
+/* samples scaled to the int16_t range, count covering all channels so a whole
+ * number of frames. Passes on at most one held payload per call. */
+void audioTriggerProcess(audioTrigger *trigger,
+                         const float *samples,
+                         uint32_t count)
+{
+    uint32_t total = trigger->config.payloadSamples * trigger->config.channels;
+    uint32_t space = 0;
+    uint32_t index = 0;
+
+    while (count > 0)
+    {
+        if (trigger->samples == 0)
+        {
+            audioTriggerStartPayload(trigger);
+        }
+
+        space = total - trigger->samples;
+
+        if (space > count)
+        {
+            space = count;
+        }
+
+        for (index = 0; index < space; index++)
+        {
+            trigger->energy += samples[index] * samples[index];
+        }
+
+        vadAccumulate(&trigger->vad, samples, space, trigger->config.channels);
+
+        if (trigger->passing)
+        {
+            trigger->config.outputCb(trigger->config.cbArg,
+                                     samples,
+                                     space,
+                                     trigger->starting);
+            trigger->starting = false;
+        }
+        else
+        {
+            audioTriggerStore(trigger, samples, space);
+        }
+
+        trigger->samples += space;
+        samples += space;
+        count -= space;
+
+        if (trigger->samples == total)
+        {
+            audioTriggerEndPayload(trigger);
+        }
+    }
+
+    audioTriggerDrain(trigger);
+}
+
+void audioTriggerSetSettings(audioTrigger *trigger,
+                             const audioTriggerSettings *settings)
+{
+    uint32_t payloadMs = trigger->config.payloadSamples * 1000 /
+                         trigger->config.sampleRate;
+
+    trigger->config.settings = *settings;
+    trigger->hangoverPayloads = payloadMs ? settings->hangoverMs / payloadMs :
+                                            0;
+}
+
+/* Samples of each channel between the end of the samples being passed on
+ * and the end of the latest given, e.g. for their capture time. 0 unless
+ * held payloads are being passed on. */
+uint32_t audioTriggerGetDelaySamples(const audioTrigger *trigger)
+{
+    return trigger->delaySamples;
+}
+
+void audioTriggerGetStats(const audioTrigger *trigger,
+                          audioTriggerStats *stats)
+{
+    *stats = trigger->stats;
+    stats->triggered = trigger->triggered;
+    stats->slots = trigger->slots;
+    stats->heldSlots = trigger->held;
+}
@@ -0,0 +1,162 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __AUDIO_TRIGGER_H__
+#define __AUDIO_TRIGGER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "vad.h"
+#include "status_code.h"
+
+/* Interleaved channels the ring can hold */
+#define AUDIO_TRIGGER_MAX_CHANNELS          4
+
+/* Each channel's IMA ADPCM state at the start of a stored payload: the
+ * predicted sample and step index, padded */
+#define AUDIO_TRIGGER_ADPCM_HEADER_LENGTH   4
+
+/* Samples of all channels decoded at a time to pass on */
+#define AUDIO_TRIGGER_CHUNK_SAMPLES         64
+
+/* Bytes a payload of samples (per channel) takes in the ring */
+#define AUDIO_TRIGGER_SLOT_LENGTH(SAMPLES, CHANNELS, ADPCM)                 \
+    ((ADPCM) ? (CHANNELS) * (AUDIO_TRIGGER_ADPCM_HEADER_LENGTH +            \
+                             (SAMPLES) / 2) :                               \
+               (CHANNELS) * (SAMPLES) * 2)
+
+/* Passes on count samples, interleaved frames of all channels. start flags
+ * the first samples of an event. */
+typedef void (*audioTriggerOutputCb)(void *arg,
+                                     const float *samples,
+                                     uint32_t count,
+                                     bool start);
+/* A payload period which will never be passed on */
+typedef void (*audioTriggerDropCb)(void *arg);
+
+/* May be changed while running */
+typedef struct {
+    /* Fire on a payload whose mean square reaches this, dBFS. NAN never
+     * fires on level. */
+    float levelDbfs;
+    /* Fire on payloads the VAD takes as speech */
+    bool vad;
+    /* Keep passing audio on for this long after the last payload to fire */
+    uint32_t hangoverMs;
+} audioTriggerSettings;
+
+typedef struct {
+    uint32_t sampleRate;
+    /* Samples of each channel the trigger decides on at a time, an even
+     * number. Those passed on start at multiples of this. */
+    uint32_t payloadSamples;
+    uint32_t channels;
+    /* Store the pre-roll as 4 bit IMA ADPCM, rather than 16 bit */
+    bool adpcm;
+    /* Ring of payloads held back, a whole number of slots of
+     * AUDIO_TRIGGER_SLOT_LENGTH() */
+    uint8_t *storage;
+    uint32_t storageLength;
+    vadConfig vad;
+    audioTriggerSettings settings;
+    audioTriggerOutputCb outputCb;
+    audioTriggerDropCb dropCb;
+    void *cbArg;
+} audioTriggerConfig;
+
+typedef struct {
+    bool triggered;
+    uint32_t events;
+    /* Payloads which fired on level, or the VAD */
+    uint32_t levelFires;
+    uint32_t vadFires;
+    /* Payloads passed on, and never to be */
+    uint32_t sentPayloads;
+    uint32_t droppedPayloads;
+    /* Ring capacity, and how many are held */
+    uint32_t slots;
+    uint32_t heldSlots;
+    /* Mean square of the latest payload */
+    float levelDbfs;
+} audioTriggerStats;
+
+typedef struct {
+    int16_t predicted;
+    uint8_t index;
+} audioTriggerAdpcm;
+
+/* Holds the stream back in a ring of payloads. Nothing is passed on until a
+ * payload's level or the VAD fires, then the ring is passed on oldest first
+ * as a pre-roll, followed by live audio until the hangover expires. The ring
+ * is drained a payload per audioTriggerProcess() call, so the pre-roll goes
+ * out over several calls rather than in one burst, then live audio passes
+ * straight through. Has no OS or network stack dependencies. */
+typedef struct {
+    audioTriggerConfig config;
+
+    uint32_t slotLength;
+    uint32_t slots;
+    /* Oldest held slot, and the slots held, the oldest pending of which are
+     * to be passed on */
+    uint32_t head;
+    uint32_t held;
+    uint32_t pending;
+
+    /* The payload being collected, passed straight through rather than
+     * stored */
+    bool passing;
+    uint32_t samples;
+    float energy;
+    vadState vad;
+    audioTriggerAdpcm encoder[AUDIO_TRIGGER_MAX_CHANNELS];
+
+    bool triggered;
+    /* The next samples passed on start an event */
+    bool starting;
+    uint32_t hangover;
+    uint32_t hangoverPayloads;
+
+    /* Samples of each channel between those being passed on and the latest
+     * given */
+    uint32_t delaySamples;
+
+    float chunk[AUDIO_TRIGGER_CHUNK_SAMPLES];
+
+    audioTriggerStats stats;
+} audioTrigger;
+
+StatusCode audioTriggerInit(audioTrigger *trigger,
+                            const audioTriggerConfig *config);
+void audioTriggerProcess(audioTrigger *trigger,
+                         const float *samples,
+                         uint32_t count);
+void audioTriggerSetSettings(audioTrigger *trigger,
+                             const audioTriggerSettings *settings);
+uint32_t audioTriggerGetDelaySamples(const audioTrigger *trigger);
+void audioTriggerGetStats(const audioTrigger *trigger,
+                          audioTriggerStats *stats);
+
+#endif /* Header Guard */
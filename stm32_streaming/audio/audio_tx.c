@@ -26,32 +26,179 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <math.h>
 #include "ch.h"
 #include "hal.h"
+#include "chprintf.h"
 #include "rtp.h"
 #include "random.h"
 #include "audio_tx.h"
+#include "audio_packetizer.h"
+#include "audio_features.h"
+#include "audio_trigger.h"
 #include "debug.h"
+#include "memory_sections.h"
 #include "mp45dt02_processing.h"
+#include "config.h"
 #include "lwip/ip_addr.h"
 #include "lwip/api.h"
 #include "lwip/err.h"
+#include "lwip/pbuf.h"
+#include "lwip/udp.h"
+#include "lwip/tcpip.h"
+
+/* Payloads end with a block, which their capture time relies on */
+#if AUDIO_PACKETIZER_PAYLOAD_DURATION_MS % MP45DT02_RAW_SAMPLE_DURATION_MS != 0
+#error "MP45DT02_RAW_SAMPLE_DURATION_MS must divide the payload duration"
+#endif
+
+/******************************************************************************/
+/* Silence Suppression */
+/******************************************************************************/
+
+/* VAD tuning, energies are mean squares of samples */
+#define VAD_ENERGY_RATIO                    4.0f
+#define VAD_LOW_ENERGY_RATIO                2.0f
+#define VAD_ZCR_THRESHOLD                   0.25f
+#define VAD_MIN_ENERGY                      4.0f
+#define VAD_HANGOVER_PAYLOADS               (CONFIG_AUDIO_VAD_HANGOVER_MS / \
+                                             AUDIO_PACKETIZER_PAYLOAD_DURATION_MS)
+
+/* Payload periods between comfort noise updates during silence */
+#define CN_INTERVAL_PAYLOADS                (CONFIG_AUDIO_VAD_CN_INTERVAL_MS / \
+                                             AUDIO_PACKETIZER_PAYLOAD_DURATION_MS)
 
 /******************************************************************************/
-/* Output Buffer - 20 ms worth of processed audio data */
+/* Features */
 /******************************************************************************/
 
-/* Duration of samples to collect */
-#define AUDIO_PAYLOAD_DURATION_MS           20
+#if CONFIG_AUDIO_FEATURES && \
+    AUDIO_FEATURES_HOP % MP45DT02_DECIMATED_BUFFER_SIZE != 0
+#error "CONFIG_AUDIO_FEATURES needs its hop to be a whole number of blocks"
+#endif
+
+/* The band energies are measured after the AGC, which would move them */
+#if CONFIG_AUDIO_FEATURES && CONFIG_AUDIO_AGC
+#error "CONFIG_AUDIO_FEATURES needs CONFIG_AUDIO_AGC cleared"
+#endif
+
+#define FEATURES_HOPS_PER_FRAME             (CONFIG_AUDIO_FEATURES_INTERVAL_MS * \
+                                             AUDIO_TX_SAMPLE_RATE_HZ / 1000 / \
+                                             AUDIO_FEATURES_HOP)
+
+/* Samples analysed for each frame, from the start of its first FFT */
+#define FEATURES_FRAME_SAMPLES              (FEATURES_HOPS_PER_FRAME * \
+                                             AUDIO_FEATURES_HOP + \
+                                             AUDIO_FEATURES_FFT_LENGTH - \
+                                             AUDIO_FEATURES_HOP)
+
+/* The features are worked on every block, so are kept with the DSP */
+#if CONFIG_AUDIO_DSP_CCM
+#define FEATURES_MEMORY                     MEMORY_CCM
+#else
+#define FEATURES_MEMORY
+#endif
+
+#if CONFIG_AUDIO_FEATURES
+/* Band energies sent instead of the audio. Restarts with each session. */
+static struct {
+    audioFeatures features;
+    time_measurement_t time;
+} audioTxFeatures FEATURES_MEMORY;
+#endif
 
-/* Size of the buffer holding output data */
-#define AUDIO_PAYLOAD_BUFFER_SIZE_BYTES     (MP45DT02_DECIMATED_BUFFER_SIZE * \
-                                             AUDIO_PAYLOAD_DURATION_MS      / \
-                                             MP45DT02_RAW_SAMPLE_DURATION_MS * \
-                                             sizeof(uint16_t))
+/******************************************************************************/
+/* Trigger */
+/******************************************************************************/
+
+#if CONFIG_AUDIO_TRIGGER && (CONFIG_AUDIO_FEATURES || CONFIG_AUDIO_SLM_ONLY)
+#error "CONFIG_AUDIO_TRIGGER needs audio to be sent"
+#endif
+
+/* The trigger level and VAD see the audio after the AGC, which would lift
+ * quiet payloads over the level */
+#if CONFIG_AUDIO_TRIGGER && CONFIG_AUDIO_AGC
+#error "CONFIG_AUDIO_TRIGGER needs CONFIG_AUDIO_AGC cleared"
+#endif
+
+/* Channels of the stream, as mp45dt02GetChannels() */
+#define TRIGGER_CHANNELS                    (CONFIG_AUDIO_BEAM ? 1 :          \
+                                             CONFIG_AUDIO_I2S_PORTS *         \
+                                             CONFIG_AUDIO_MICS_PER_PORT)
+
+#define TRIGGER_STORAGE_LENGTH              (CONFIG_AUDIO_TRIGGER_PREROLL_MS / \
+                                             AUDIO_PACKETIZER_PAYLOAD_DURATION_MS * \
+                                             AUDIO_TRIGGER_SLOT_LENGTH(       \
+                                                AUDIO_PACKETIZER_PAYLOAD_SAMPLES, \
+                                                TRIGGER_CHANNELS,             \
+                                                CONFIG_AUDIO_TRIGGER_ADPCM))
+
+#if CONFIG_AUDIO_TRIGGER
+/* Holds the stream back until an event. The settings are kept across
+ * sessions, and changed by the control thread under the mutex. The storage is
+ * only touched once a payload, so is left in SRAM, keeping CCM for the DSP. */
+static struct {
+    audioTrigger trigger;
+    audioTriggerSettings settings;
+    mutex_t mutex;
+    time_measurement_t time;
+    uint8_t storage[TRIGGER_STORAGE_LENGTH];
+} audioTxTrigger;
+#endif
+
+/******************************************************************************/
+/* Sound Levels */
+/******************************************************************************/
 
-#define TX_BUFFER_LENGTH                    (RTP_HEADER_LENGTH + \
-                                             AUDIO_PAYLOAD_BUFFER_SIZE_BYTES)
+#if (CONFIG_AUDIO_SLM_RTCP || CONFIG_AUDIO_SLM_ONLY) && !CONFIG_AUDIO_SLM
+#error "CONFIG_AUDIO_SLM_RTCP and CONFIG_AUDIO_SLM_ONLY need CONFIG_AUDIO_SLM"
+#endif
+
+/* Without the reports nothing would be sent to the stream RTSP and SAP
+ * describe */
+#if CONFIG_AUDIO_SLM_ONLY && !CONFIG_AUDIO_SLM_RTCP
+#error "CONFIG_AUDIO_SLM_ONLY needs CONFIG_AUDIO_SLM_RTCP"
+#endif
+
+/* RTCP APP packet carrying each second's levels, after the empty receiver
+ * report a compound packet has to start with. The data is the period count,
+ * then LAeq, LCeq, LAFmax, LASmax, LCpeak, LAF and LAS as signed hundredths
+ * of a dB, padded to a whole number of words. */
+#define LEVELS_RTCP_NAME                    "LEVL"
+#define LEVELS_RTCP_SUBTYPE                 0
+#define LEVELS_RTCP_VALUES                  7
+#define LEVELS_RTCP_APP_LENGTH              (RTCP_APP_HEADER_LENGTH + 4 + \
+                                             LEVELS_RTCP_VALUES * 2 + 2)
+#define LEVELS_RTCP_LENGTH                  (RTCP_RR_LENGTH + \
+                                             LEVELS_RTCP_APP_LENGTH)
+
+/******************************************************************************/
+/* Transmission */
+/******************************************************************************/
+
+/* Packets which may be waiting for the tcpip thread at once when using the raw
+ * API. Each holds a tcpip message from MEMP_NUM_TCPIP_MSG_API for the session,
+ * and must fit in TCPIP_MBOX_SIZE. */
+#define AUDIO_TX_RAW_QUEUE_LENGTH           4
+
+/* A packet built in the processing thread, and sent by the tcpip thread */
+typedef struct {
+    /* Prebuilt message which runs audioTxRawSend() for this packet */
+    struct tcpip_callback_msg *msg;
+    /* Packet to send. Set while queued, cleared by the tcpip thread once sent. */
+    struct pbuf *pbuf;
+    /* Realtime counter as the packet was queued */
+    rtcnt_t queued;
+    /* Connection sent from, and the remote UDP port */
+    struct netconn *conn;
+    uint16_t port;
+} audioTxRawPacket;
+
+typedef enum {
+    AUDIO_TX_STATE_IDLE,
+    AUDIO_TX_STATE_READY,
+    AUDIO_TX_STATE_PLAYING
+} audioTxState;
 
 typedef struct {
     /* API */
@@ -59,26 +206,57 @@ typedef struct {
 
     /* Private */
 
-    /* The Remote UDP connection to send audio data towards */
+    /* Management requests may arrive from several clients, so track where we
+     * are to keep setup/teardown balanced. */
+    audioTxState state;
+
+    /* The Remote UDP connection to send audio data towards, and the one
+     * after it RTCP is sent from, as advertised in the RTSP SETUP reply */
     struct netconn *connRtp;
-    
-    struct {
-        /* The current LWIP buffer being used for transmission */
-        struct netbuf *lwipBuffer;
-        /* The first bytes of the buffer with MP45DT02 data */
-        uint8_t *dataStart;
-        uint8_t *dataCurrent;
-
-        struct {
-            uint32_t failedNetbufNew;
-            uint32_t failedNetbufAlloc;
-            uint32_t failedSend;
-        } debug;
-    } audio;
+    struct netconn *connRtcp;
+
+    /* Builds the packets, in buffers provided by the callbacks below */
+    audioPacketizer packetizer;
+
+    /* UDP port RTCP is sent to, following the RTP port */
+    uint16_t remoteRtcpPort;
+
+    /* Raw API packets, used in turn */
+    audioTxRawPacket rawQueue[AUDIO_TX_RAW_QUEUE_LENGTH];
+    uint32_t rawNext;
+
+    /* Time spent by the processing thread sending each packet */
+    time_measurement_t sendTime;
+
+    /* Realtime counter ticks from a packet being handed to lwIP until it has
+     * been sent. The same as sendTime for netconn, which waits. */
+    uint64_t sendLatencyTotal;
+    rtcnt_t sendLatencyWorst;
+    uint32_t sendLatencyCount;
+
+    /* Feature frames sent, with CONFIG_AUDIO_FEATURES */
+    uint32_t featurePackets;
+    uint32_t featureBytes;
+
+    /* Level reports sent, with CONFIG_AUDIO_SLM_RTCP */
+    uint32_t levelPackets;
 
 } audioTxSession;
 
+/* Kept outside of the session so they survive across sessions */
+typedef struct {
+    uint32_t packetsSent;
+    uint32_t failedNetbufNew;
+    uint32_t failedNetbufAlloc;
+    uint32_t failedSend;
+    /* Raw API packets dropped as the tcpip thread had fallen behind */
+    uint32_t failedQueue;
+    /* System time the first packet since boot was sent, 0 if none yet */
+    systime_t firstPacketTime;
+} audioTxStatistics;
+
 static audioTxSession activeAudioSession;
+static audioTxStatistics audioTxStats;
 
 /******************************************************************************/
 /* Internal Functions                                                         */
@@ -94,101 +272,610 @@ static StatusCode audioRtpGetRandomCb(uint32_t *random)
     return STATUS_OK;
 }
 
-static void audioTxHandleFullMp45dt02Buffer(float *data,
-                                            uint16_t samples)       
+/* (audioPacketizerGetBufferCb) */
+static uint8_t *audioTxGetBufferCb(void *arg, uint32_t length, void **handle)
 {
-    uint32_t index = 0;
-    int16_t *sample = NULL;
-    err_t lwipErr = ERR_OK;
+    struct netbuf *buffer = NULL;
+    uint8_t *data = NULL;
 
-    /**************************************************************************/ 
-    /* Check if we need a new buffer                                          */
-    /**************************************************************************/ 
-    if (activeAudioSession.audio.lwipBuffer == NULL)
+    (void)arg;
+
+    if (NULL == (buffer = netbuf_new()))
     {
-        activeAudioSession.audio.lwipBuffer = netbuf_new();
+        audioTxStats.failedNetbufNew++;
+        return NULL;
+    }
 
-        if (activeAudioSession.audio.lwipBuffer == NULL)
-        {
-            activeAudioSession.audio.debug.failedNetbufNew++;
-            PRINT("NULL",0);
-            return;
-        }
+    if (NULL == (data = netbuf_alloc(buffer, length)))
+    {
+        netbuf_delete(buffer);
+        audioTxStats.failedNetbufAlloc++;
+        return NULL;
+    }
 
-        activeAudioSession.audio.dataStart =
-                    netbuf_alloc(activeAudioSession.audio.lwipBuffer, 
-                                 TX_BUFFER_LENGTH);
+    *handle = buffer;
 
-        if (activeAudioSession.audio.dataStart == NULL)
-        {
-            netbuf_delete(activeAudioSession.audio.lwipBuffer);
-            activeAudioSession.audio.lwipBuffer = NULL;
-            activeAudioSession.audio.debug.failedNetbufAlloc++;
-            return;
-        }
+    return data;
+}
+
+/* Records the outcome of a packet handed to lwIP at the realtime counter
+ * queued */
+static bool audioTxSent(err_t lwipErr, rtcnt_t queued)
+{
+    rtcnt_t latency = chSysGetRealtimeCounterX() - queued;
+
+    if (ERR_OK != lwipErr)
+    {
+        audioTxStats.failedSend++;
+        return false;
+    }
+
+    audioTxStats.packetsSent++;
 
-        activeAudioSession.audio.dataCurrent =  
-            activeAudioSession.audio.dataStart + RTP_HEADER_LENGTH;
+    activeAudioSession.sendLatencyTotal += latency;
+    activeAudioSession.sendLatencyCount++;
+    if (latency > activeAudioSession.sendLatencyWorst)
+    {
+        activeAudioSession.sendLatencyWorst = latency;
     }
 
-    /*****************s********************************************************/ 
-    /* Change to network order                                                */
-    /**************************************************************************/ 
-    for (index = 0, sample = (int16_t *)activeAudioSession.audio.dataCurrent;
-         index < samples;
-         index++)
+    if (audioTxStats.firstPacketTime == 0)
+    {
+        audioTxStats.firstPacketTime = chVTGetSystemTimeX();
+        PRINT("First packet sent %u ms after boot",
+              ST2MS(audioTxStats.firstPacketTime));
+    }
+
+    return true;
+}
+
+/* Sends a packet from audioTxGetBufferCb() to port, blocking until the tcpip
+ * thread has sent it */
+static bool audioTxSendTo(void *handle, struct netconn *conn, uint16_t port)
+{
+    struct netbuf *buffer = handle;
+    rtcnt_t queued;
+    bool sent = false;
+
+    chTMStartMeasurementX(&activeAudioSession.sendTime);
+
+    queued = chSysGetRealtimeCounterX();
+
+    sent = audioTxSent(netconn_sendto(conn,
+                                      buffer,
+                                      &activeAudioSession.config.ipDest,
+                                      port),
+                       queued);
+
+    netbuf_delete(buffer);
+
+    chTMStopMeasurementX(&activeAudioSession.sendTime);
+
+    return sent;
+}
+
+/* (audioPacketizerSendCb) */
+static bool audioTxSendCb(void *arg, void *handle, uint8_t *data, uint32_t length)
+{
+    (void)arg;
+    (void)data;
+    (void)length;
+
+    return audioTxSendTo(handle,
+                         activeAudioSession.connRtp,
+                         activeAudioSession.config.remoteRtpPort);
+}
+
+/* (audioPacketizerReleaseCb) */
+static void audioTxReleaseCb(void *arg, void *handle)
+{
+    (void)arg;
+
+    netbuf_delete((struct netbuf *)handle);
+}
+
+/* (audioPacketizerGetBufferCb) Raw API packets are plain pbufs, with room left
+ * ahead of the data for the UDP, IP and link headers */
+static uint8_t *audioTxRawGetBufferCb(void *arg, uint32_t length, void **handle)
+{
+    struct pbuf *pbuf = NULL;
+
+    (void)arg;
+
+    if (NULL == (pbuf = pbuf_alloc(PBUF_TRANSPORT, length, PBUF_RAM)))
     {
-        *sample++ = htons((int16_t)(*data++));
+        audioTxStats.failedNetbufAlloc++;
+        return NULL;
     }
 
-    activeAudioSession.audio.dataCurrent += samples * 2;
+    *handle = pbuf;
 
-    /**************************************************************************/ 
-    /* Transmit if full                                                       */
-    /**************************************************************************/ 
-    if (activeAudioSession.audio.dataCurrent >= 
-            (activeAudioSession.audio.dataStart + TX_BUFFER_LENGTH))
+    return pbuf->payload;
+}
+
+/* (tcpip_callback_fn) Runs in the tcpip thread. Packets are sent in the order
+ * they were queued, and before any later netconn call such as the
+ * netconn_delete() in audioTxRtpTeardown(). */
+static void audioTxRawSend(void *ctx)
+{
+    audioTxRawPacket *packet = ctx;
+
+    audioTxSent(udp_sendto(packet->conn->pcb.udp,
+                           packet->pbuf,
+                           &activeAudioSession.config.ipDest,
+                           packet->port),
+                packet->queued);
+
+    pbuf_free(packet->pbuf);
+    packet->pbuf = NULL;
+}
+
+/* Queues a packet from audioTxRawGetBufferCb() to be sent from conn to port
+ * by the tcpip thread, without waiting for it to be sent */
+static bool audioTxRawSendTo(void *handle, struct netconn *conn, uint16_t port)
+{
+    audioTxRawPacket *packet =
+                    &activeAudioSession.rawQueue[activeAudioSession.rawNext];
+    bool queued = false;
+
+    chTMStartMeasurementX(&activeAudioSession.sendTime);
+
+    /* Still queued from a full lap ago */
+    if (packet->pbuf != NULL)
     {
-        if (activeAudioSession.audio.dataCurrent >
-            (activeAudioSession.audio.dataStart + TX_BUFFER_LENGTH))
+        audioTxStats.failedQueue++;
+        pbuf_free((struct pbuf *)handle);
+    }
+    else
+    {
+        packet->pbuf = handle;
+        packet->queued = chSysGetRealtimeCounterX();
+        packet->conn = conn;
+        packet->port = port;
+
+        if (ERR_OK != tcpip_trycallback(packet->msg))
         {
-            PRINT_CRITICAL("Overrun %u > %u ", 
-                            activeAudioSession.audio.dataCurrent,
-                            activeAudioSession.audio.dataStart + TX_BUFFER_LENGTH);
+            packet->pbuf = NULL;
+            audioTxStats.failedQueue++;
+            pbuf_free((struct pbuf *)handle);
         }
-    
-        if (STATUS_OK != rtpAddHeader(activeAudioSession.audio.dataStart,
-                                   TX_BUFFER_LENGTH))
+        else
         {
-            PRINT_CRITICAL("Rtp Add Header failed", 0);
+            activeAudioSession.rawNext = (activeAudioSession.rawNext + 1) %
+                                         AUDIO_TX_RAW_QUEUE_LENGTH;
+            queued = true;
         }
+    }
+
+    chTMStopMeasurementX(&activeAudioSession.sendTime);
+
+    return queued;
+}
+
+/* (audioPacketizerSendCb) */
+static bool audioTxRawSendCb(void *arg, void *handle, uint8_t *data, uint32_t length)
+{
+    (void)arg;
+    (void)data;
+    (void)length;
+
+    return audioTxRawSendTo(handle,
+                            activeAudioSession.connRtp,
+                            activeAudioSession.config.remoteRtpPort);
+}
+
+/* (audioPacketizerReleaseCb) */
+static void audioTxRawReleaseCb(void *arg, void *handle)
+{
+    (void)arg;
+
+    pbuf_free((struct pbuf *)handle);
+}
+
+/* System ticks as 32.32 fixed point NTP format seconds */
+static uint64_t audioTxTicksToNtp(systime_t ticks)
+{
+    return (uint64_t)(ticks / CH_CFG_ST_FREQUENCY) << 32 |
+           ((uint64_t)(ticks % CH_CFG_ST_FREQUENCY) << 32) /
+           CH_CFG_ST_FREQUENCY;
+}
+
+/* Fills in the header extension of a packet sent as the last block of
+ * duration ticks of audio is processed. The audio started being captured
+ * that long, and the processing's latency, before that block arrived. */
+static void audioTxSetExtensions(uint8_t *data, systime_t duration)
+{
+    systime_t captured = mp45dt02GetBlockTime() - duration -
+                         US2ST(mp45dt02GetLatencyUs());
+
+    if (CONFIG_AUDIO_CAPTURE_TIME_EXT_ID != 0)
+    {
+        rtpSetAbsCaptureTime(data,
+                             CONFIG_AUDIO_CAPTURE_TIME_EXT_ID,
+                             audioTxTicksToNtp(captured));
+    }
+
+    if (CONFIG_AUDIO_DSP_OVERRUNS_EXT_ID != 0)
+    {
+        rtpSetDspOverruns(data,
+                          CONFIG_AUDIO_DSP_OVERRUNS_EXT_ID,
+                          mp45dt02GetOverruns());
+    }
+}
+
+/* (audioPacketizerExtensionCb) */
+static void audioTxExtensionCb(void *arg, uint8_t *data)
+{
+    systime_t duration = MS2ST(AUDIO_PACKETIZER_PAYLOAD_DURATION_MS);
+
+    (void)arg;
+
+#if CONFIG_AUDIO_TRIGGER
+    /* Pre-roll payloads ended a while before the latest block */
+    duration += US2ST((uint64_t)audioTriggerGetDelaySamples(
+                                            &audioTxTrigger.trigger) *
+                      1000000 / AUDIO_TX_SAMPLE_RATE_HZ);
+#endif
+
+    audioTxSetExtensions(data, duration);
+}
+
+#if CONFIG_AUDIO_FEATURES
+/* Sends the latest frame of features through the packetizer's callbacks, so
+ * either API works as it does for audio */
+static void audioTxSendFeatures(void)
+{
+    const audioPacketizerConfig *config =
+                                &activeAudioSession.packetizer.config;
+    uint32_t headerLength = rtpGetHeaderLength();
+    uint32_t length = headerLength +
+                      audioFeaturesGetLength(&audioTxFeatures.features);
+    void *handle = NULL;
+    uint8_t *data = NULL;
+
+    if (NULL == (data = config->getBufferCb(config->cbArg, length, &handle)))
+    {
+        rtpSkip();
+        return;
+    }
+
+    audioFeaturesWrite(&audioTxFeatures.features,
+                       data + headerLength,
+                       length - headerLength);
+
+    if (STATUS_OK != rtpAddHeaderEx(data,
+                                    length,
+                                    AUDIO_TX_FEATURES_PAYLOAD_TYPE,
+                                    false))
+    {
+        config->releaseCb(config->cbArg, handle);
+        return;
+    }
+
+    audioTxSetExtensions(data,
+                         US2ST((uint64_t)FEATURES_FRAME_SAMPLES * 1000000 /
+                               AUDIO_TX_SAMPLE_RATE_HZ));
+
+    if (config->sendCb(config->cbArg, handle, data, length))
+    {
+        activeAudioSession.featurePackets++;
+        activeAudioSession.featureBytes += length;
+    }
+}
+#endif
+
+#if CONFIG_AUDIO_TRIGGER
+/* (audioTriggerOutputCb) */
+static void audioTxTriggerOutputCb(void *arg,
+                                   const float *samples,
+                                   uint32_t count,
+                                   bool start)
+{
+    (void)arg;
+
+    if (start)
+    {
+        audioPacketizerStartTalkspurt(&activeAudioSession.packetizer);
+    }
+
+    audioPacketizerProcess(&activeAudioSession.packetizer, samples, count);
+}
+
+/* (audioTriggerDropCb) The timestamp moves on past audio never sent */
+static void audioTxTriggerDropCb(void *arg)
+{
+    (void)arg;
+
+    rtpSkip();
+}
+#endif
+
+#if CONFIG_AUDIO_SLM_RTCP
+/* Writes a level as signed hundredths of a dB, big endian */
+static uint8_t *audioTxWriteLevel(uint8_t *data, float levelDb)
+{
+    int16_t centiDb = (int16_t)lroundf(levelDb * 100.0f);
+
+    data[0] = (uint16_t)centiDb >> 8;
+    data[1] = (uint16_t)centiDb & 0xFF;
+
+    return data + 2;
+}
+
+/* Sends the levels in an RTCP RR and APP packet from the RTCP port, in a
+ * buffer from the packetizer's callbacks as with features */
+static void audioTxSendLevels(const audioSlmLevels *levels)
+{
+    const audioPacketizerConfig *config =
+                                &activeAudioSession.packetizer.config;
+    void *handle = NULL;
+    uint8_t *data = NULL;
+    uint8_t *app = NULL;
+    uint8_t *value = NULL;
+    bool sent = false;
+
+    if (NULL == (data = config->getBufferCb(config->cbArg,
+                                            LEVELS_RTCP_LENGTH,
+                                            &handle)))
+    {
+        return;
+    }
 
-        if (ERR_OK != (lwipErr = netconn_sendto(
-                                    activeAudioSession.connRtp,
-                                    activeAudioSession.audio.lwipBuffer,
-                                    &activeAudioSession.config.ipDest,
-                                    activeAudioSession.config.remoteRtpPort)))
+    memset(data, 0, LEVELS_RTCP_LENGTH);
+
+    app = data + RTCP_RR_LENGTH;
+    value = app + RTCP_APP_HEADER_LENGTH;
+    value[0] = levels->periods >> 24;
+    value[1] = levels->periods >> 16;
+    value[2] = levels->periods >> 8;
+    value[3] = levels->periods & 0xFF;
+    value = audioTxWriteLevel(value + 4, levels->laeq);
+    value = audioTxWriteLevel(value, levels->lceq);
+    value = audioTxWriteLevel(value, levels->lafmax);
+    value = audioTxWriteLevel(value, levels->lasmax);
+    value = audioTxWriteLevel(value, levels->lcpeak);
+    value = audioTxWriteLevel(value, levels->laf);
+    value = audioTxWriteLevel(value, levels->las);
+
+    if (STATUS_OK != rtcpAddEmptyReceiverReport(data) ||
+        STATUS_OK != rtcpAddAppHeader(app,
+                                      LEVELS_RTCP_APP_LENGTH,
+                                      LEVELS_RTCP_SUBTYPE,
+                                      LEVELS_RTCP_NAME))
+    {
+        config->releaseCb(config->cbArg, handle);
+        return;
+    }
+
+    if (CONFIG_AUDIO_TX_RAW_API)
+    {
+        sent = audioTxRawSendTo(handle,
+                                activeAudioSession.connRtcp,
+                                activeAudioSession.remoteRtcpPort);
+    }
+    else
+    {
+        sent = audioTxSendTo(handle,
+                             activeAudioSession.connRtcp,
+                             activeAudioSession.remoteRtcpPort);
+    }
+
+    if (sent)
+    {
+        activeAudioSession.levelPackets++;
+    }
+}
+#endif
+
+#if CONFIG_AUDIO_SLM
+/* (mp45dt02LevelsCb) */
+static void audioTxLevelsCb(const audioSlmLevels *levels)
+{
+#if CONFIG_AUDIO_SLM_RTCP
+    audioTxSendLevels(levels);
+#else
+    (void)levels;
+#endif
+}
+#endif
+
+static void audioTxHandleFullMp45dt02Buffer(float *data,
+                                            uint16_t samples)       
+{
+#if CONFIG_AUDIO_SLM_ONLY
+    /* Only the levels are sent */
+    (void)data;
+    (void)samples;
+#elif CONFIG_AUDIO_TRIGGER
+    chMtxLock(&audioTxTrigger.mutex);
+    chTMStartMeasurementX(&audioTxTrigger.time);
+    audioTriggerProcess(&audioTxTrigger.trigger, data, samples);
+    chTMStopMeasurementX(&audioTxTrigger.time);
+    chMtxUnlock(&audioTxTrigger.mutex);
+#elif CONFIG_AUDIO_FEATURES
+    bool complete = false;
+
+    chTMStartMeasurementX(&audioTxFeatures.time);
+    complete = audioFeaturesProcess(&audioTxFeatures.features,
+                                    data,
+                                    samples / mp45dt02GetChannels());
+    chTMStopMeasurementX(&audioTxFeatures.time);
+
+    if (complete)
+    {
+        audioTxSendFeatures();
+    }
+#else
+    audioPacketizerProcess(&activeAudioSession.packetizer, data, samples);
+#endif
+}
+
+#if CONFIG_AUDIO_FEATURES
+static void audioTxFeaturesInit(void)
+{
+    audioFeaturesConfig config;
+    StatusCode status = STATUS_OK;
+
+    memset(&config, 0, sizeof(config));
+    config.sampleRate = AUDIO_TX_SAMPLE_RATE_HZ;
+    config.blockSamples = MP45DT02_DECIMATED_BUFFER_SIZE;
+    config.channels = mp45dt02GetChannels();
+    config.scale = CONFIG_AUDIO_FEATURES_SCALE;
+    config.bands = CONFIG_AUDIO_FEATURES_MEL_BANDS;
+    config.lowHz = CONFIG_AUDIO_FEATURES_LOW_HZ;
+    config.highHz = CONFIG_AUDIO_FEATURES_HIGH_HZ;
+    config.hopsPerFrame = FEATURES_HOPS_PER_FRAME;
+
+    if (STATUS_OK != (status = audioFeaturesInit(&audioTxFeatures.features,
+                                                 &config)))
+    {
+        PRINT_CRITICAL("audioFeaturesInit failed with %s",
+                       statusCodeToString(status));
+    }
+
+    chTMObjectInit(&audioTxFeatures.time);
+}
+#endif
+
+#if CONFIG_AUDIO_TRIGGER
+/* Starts the session with an empty pre-roll */
+static void audioTxTriggerSetup(void)
+{
+    audioTriggerConfig config;
+    StatusCode status = STATUS_OK;
+
+    memset(&config, 0, sizeof(config));
+    config.sampleRate = AUDIO_TX_SAMPLE_RATE_HZ;
+    config.payloadSamples = AUDIO_PACKETIZER_PAYLOAD_SAMPLES;
+    config.channels = mp45dt02GetChannels();
+    config.adpcm = CONFIG_AUDIO_TRIGGER_ADPCM;
+    config.storage = audioTxTrigger.storage;
+    config.storageLength = sizeof(audioTxTrigger.storage);
+    config.vad.energyRatio = VAD_ENERGY_RATIO;
+    config.vad.lowEnergyRatio = VAD_LOW_ENERGY_RATIO;
+    config.vad.zcrThreshold = VAD_ZCR_THRESHOLD;
+    config.vad.minEnergy = VAD_MIN_ENERGY;
+    config.vad.hangoverFrames = VAD_HANGOVER_PAYLOADS;
+    config.outputCb = audioTxTriggerOutputCb;
+    config.dropCb = audioTxTriggerDropCb;
+
+    chMtxLock(&audioTxTrigger.mutex);
+
+    config.settings = audioTxTrigger.settings;
+    status = audioTriggerInit(&audioTxTrigger.trigger, &config);
+
+    chMtxUnlock(&audioTxTrigger.mutex);
+
+    if (STATUS_OK != status)
+    {
+        PRINT_CRITICAL("audioTriggerInit failed with %s",
+                       statusCodeToString(status));
+    }
+
+    chTMObjectInit(&audioTxTrigger.time);
+}
+#endif
+
+static void audioTxRawQueueInit(void)
+{
+    uint32_t index;
+
+    for (index = 0; index < AUDIO_TX_RAW_QUEUE_LENGTH; index++)
+    {
+        audioTxRawPacket *packet = &activeAudioSession.rawQueue[index];
+
+        if (NULL == (packet->msg = tcpip_callbackmsg_new(audioTxRawSend,
+                                                         packet)))
         {
-            activeAudioSession.audio.debug.failedSend++;
+            PRINT_CRITICAL("RTP tcpip message alloc failed",0);
         }
+    }
 
-        netbuf_delete(activeAudioSession.audio.lwipBuffer);
-        memset(&activeAudioSession.audio, 0, sizeof(activeAudioSession.audio));
+    activeAudioSession.rawNext = 0;
+}
+
+static void audioTxRawQueueShutdown(void)
+{
+    uint32_t index;
+
+    for (index = 0; index < AUDIO_TX_RAW_QUEUE_LENGTH; index++)
+    {
+        tcpip_callbackmsg_delete(activeAudioSession.rawQueue[index].msg);
     }
+}
+
+static void audioTxPacketizerInit(void)
+{
+    audioPacketizerConfig config;
 
-    return;
+    memset(&config, 0, sizeof(config));
+    if (CONFIG_AUDIO_TX_RAW_API)
+    {
+        config.getBufferCb      = audioTxRawGetBufferCb;
+        config.sendCb           = audioTxRawSendCb;
+        config.releaseCb        = audioTxRawReleaseCb;
+    }
+    else
+    {
+        config.getBufferCb      = audioTxGetBufferCb;
+        config.sendCb           = audioTxSendCb;
+        config.releaseCb        = audioTxReleaseCb;
+    }
+    config.extensionCb          = audioTxExtensionCb;
+    config.payloadType          = AUDIO_TX_RTP_PAYLOAD_TYPE;
+    config.channels             = mp45dt02GetChannels();
+
+    /* Events are sent whole */
+    config.vadEnabled           = CONFIG_AUDIO_VAD && !CONFIG_AUDIO_TRIGGER;
+    config.vad.energyRatio      = VAD_ENERGY_RATIO;
+    config.vad.lowEnergyRatio   = VAD_LOW_ENERGY_RATIO;
+    config.vad.zcrThreshold     = VAD_ZCR_THRESHOLD;
+    config.vad.minEnergy        = VAD_MIN_ENERGY;
+    config.vad.hangoverFrames   = VAD_HANGOVER_PAYLOADS;
+    config.cnPayloadType        = AUDIO_TX_CN_PAYLOAD_TYPE;
+    config.cnIntervalPayloads   = CN_INTERVAL_PAYLOADS;
+    config.audioLevelId         = CONFIG_AUDIO_LEVEL_EXT_ID;
+
+    audioPacketizerInit(&activeAudioSession.packetizer, &config);
 }
 
 /******************************************************************************/
 /* External Functions                                                         */
 /******************************************************************************/
 
+/* Called once at boot */
+StatusCode audioTxInit(void)
+{
+#if CONFIG_AUDIO_FEATURES
+    /* May be in CCM, which isn't cleared at startup, and the stats can be
+     * read before the first session */
+    memset(&audioTxFeatures, 0, sizeof(audioTxFeatures));
+#endif
+
+#if CONFIG_AUDIO_TRIGGER
+    chMtxObjectInit(&audioTxTrigger.mutex);
+
+    audioTxTrigger.settings.levelDbfs = CONFIG_AUDIO_TRIGGER_LEVEL_DBFS;
+    audioTxTrigger.settings.vad = CONFIG_AUDIO_TRIGGER_VAD;
+    audioTxTrigger.settings.hangoverMs = CONFIG_AUDIO_TRIGGER_HANGOVER_MS;
+#endif
+
+    return STATUS_OK;
+}
+
 void audioTxRtpSetup(audioTxRtpConfig *setupConfig)
 {
     rtpConfig config;
     err_t lwipErr = ERR_OK;
 
+    /* A new destination replaces any existing session */
+    if (activeAudioSession.state != AUDIO_TX_STATE_IDLE)
+    {
+        audioTxRtpTeardown();
+    }
+
     activeAudioSession.config = *setupConfig;
+    activeAudioSession.remoteRtcpPort = setupConfig->remoteRtpPort + 1;
 
     if (NULL == (activeAudioSession.connRtp = netconn_new(NETCONN_UDP)))
     {
@@ -202,45 +889,370 @@ void audioTxRtpSetup(audioTxRtpConfig *setupConfig)
         PRINT_CRITICAL("RTP UDP Bind Failed LWIP Error: %d", lwipErr);
     }
 
-    memset(&config, 0, sizeof(config));
+    if (NULL == (activeAudioSession.connRtcp = netconn_new(NETCONN_UDP)))
+    {
+        PRINT_CRITICAL("RTCP UDP Netconn failed",0);
+    }
+
+    if (ERR_OK != (lwipErr = netconn_bind(activeAudioSession.connRtcp,
+                                          IP_ADDR_ANY,
+                                          activeAudioSession.config.localRtpPort + 1)))
+    {
+        PRINT_CRITICAL("RTCP UDP Bind Failed LWIP Error: %d", lwipErr);
+    }
+
+    if (CONFIG_AUDIO_TX_RAW_API)
+    {
+        audioTxRawQueueInit();
+    }
+
+    chTMObjectInit(&activeAudioSession.sendTime);
 
-    config.getRandomCb = audioRtpGetRandomCb;
-    config.periodicTimestampIncr = 16000 / 1000 * 20;
+    audioTxGetRtpConfig(&config);
 
     if (STATUS_OK != rtpInit(&config))
     {
         PRINT_CRITICAL("RTP Init Failed",0);
     }
+
+    audioTxPacketizerInit();
+
+#if CONFIG_AUDIO_FEATURES
+    audioTxFeaturesInit();
+#endif
+
+#if CONFIG_AUDIO_TRIGGER
+    audioTxTriggerSetup();
+#endif
+
+    activeAudioSession.state = AUDIO_TX_STATE_READY;
 }
 
 void audioTxRtpTeardown(void)
 {
-    mp45dt02Shutdown();
+    if (activeAudioSession.state == AUDIO_TX_STATE_IDLE)
+    {
+        return;
+    }
+
+    audioTxRtpPause();
 
     if (STATUS_OK != rtpShutdown())
     {
         PRINT_CRITICAL("RTP Shutdown failed",0);
     }
 
+    /* Also waits for any raw API packets still queued to be sent */
     if (ERR_OK != (netconn_delete(activeAudioSession.connRtp)))
     {
         PRINT_CRITICAL("NETCONN Delete failed",0);
     }
+
+    if (ERR_OK != (netconn_delete(activeAudioSession.connRtcp)))
+    {
+        PRINT_CRITICAL("NETCONN Delete failed",0);
+    }
+
+    if (CONFIG_AUDIO_TX_RAW_API)
+    {
+        audioTxRawQueueShutdown();
+    }
+
+    memset(&activeAudioSession, 0, sizeof(activeAudioSession));
+}
+
+/* The RTP parameters every session is created with. Also used to describe
+ * the stream to other parties e.g. in SDP. */
+void audioTxGetRtpConfig(rtpConfig *config)
+{
+    rtpExtensionElement *extension = config->extensions;
+
+    memset(config, 0, sizeof(*config));
+
+    config->getRandomCb = audioRtpGetRandomCb;
+    config->clockRate = AUDIO_TX_SAMPLE_RATE_HZ;
+
+    if (CONFIG_AUDIO_FEATURES)
+    {
+        config->payloadType = AUDIO_TX_FEATURES_PAYLOAD_TYPE;
+        config->periodicTimestampIncr = FEATURES_HOPS_PER_FRAME *
+                                        AUDIO_FEATURES_HOP;
+    }
+    else
+    {
+        config->payloadType = AUDIO_TX_RTP_PAYLOAD_TYPE;
+        config->periodicTimestampIncr = AUDIO_PACKETIZER_PAYLOAD_SAMPLES;
+    }
+
+    /* Has no meaning for features */
+    if (CONFIG_AUDIO_LEVEL_EXT_ID != 0 && !CONFIG_AUDIO_FEATURES)
+    {
+        extension->id = CONFIG_AUDIO_LEVEL_EXT_ID;
+        extension->length = RTP_AUDIO_LEVEL_LENGTH;
+        extension->uri = RTP_AUDIO_LEVEL_URI;
+        /* The voice activity flag is only meaningful with the VAD */
+        extension->attributes = CONFIG_AUDIO_VAD ? "vad=on" : "vad=off";
+        extension++;
+    }
+
+    if (CONFIG_AUDIO_CAPTURE_TIME_EXT_ID != 0)
+    {
+        extension->id = CONFIG_AUDIO_CAPTURE_TIME_EXT_ID;
+        extension->length = RTP_ABS_CAPTURE_TIME_LENGTH;
+        extension->uri = RTP_ABS_CAPTURE_TIME_URI;
+        extension++;
+    }
+
+    if (CONFIG_AUDIO_DSP_OVERRUNS_EXT_ID != 0)
+    {
+        extension->id = CONFIG_AUDIO_DSP_OVERRUNS_EXT_ID;
+        extension->length = RTP_DSP_OVERRUNS_LENGTH;
+        extension->uri = RTP_DSP_OVERRUNS_URI;
+        extension++;
+    }
 }
 
 void audioTxRtpPlay(void)
 {
     mp45dt02Config micConfig;
 
+    if (activeAudioSession.state != AUDIO_TX_STATE_READY)
+    {
+        return;
+    }
+
     memset(&micConfig, 0, sizeof(micConfig));
 
     micConfig.fullbufferCb = audioTxHandleFullMp45dt02Buffer;
+#if CONFIG_AUDIO_SLM
+    micConfig.levelsCb = audioTxLevelsCb;
+#endif
 
     mp45dt02Init(&micConfig);
+
+    activeAudioSession.state = AUDIO_TX_STATE_PLAYING;
 }
 
 void audioTxRtpPause(void)
 {
+    if (activeAudioSession.state != AUDIO_TX_STATE_PLAYING)
+    {
+        return;
+    }
+
     mp45dt02Shutdown();
+
+    /* Drop any partially filled payload */
+    audioPacketizerReset(&activeAudioSession.packetizer);
+
+    activeAudioSession.state = AUDIO_TX_STATE_READY;
+}
+
+/* Writes statistics as "key value" lines */
+void audioTxPrintStats(BaseSequentialStream *stream)
+{
+    const audioPacketizer *packetizer = &activeAudioSession.packetizer;
+    const audioPacketizerStats *session = &packetizer->stats;
+    mp45dt02DspStats dsp;
+#if CONFIG_AUDIO_FEATURES
+    audioFeaturesStats features;
+#endif
+#if CONFIG_AUDIO_TRIGGER
+    audioTriggerStats trigger;
+#endif
+
+    chprintf(stream, "tx_state %u\n", activeAudioSession.state);
+    chprintf(stream, "tx_api %s\n", CONFIG_AUDIO_TX_RAW_API ? "raw" : "netconn");
+    chprintf(stream, "tx_packets %u\n", audioTxStats.packetsSent);
+    chprintf(stream, "tx_failed_netbuf_new %u\n", audioTxStats.failedNetbufNew);
+    chprintf(stream, "tx_failed_netbuf_alloc %u\n",
+             audioTxStats.failedNetbufAlloc);
+    chprintf(stream, "tx_failed_send %u\n", audioTxStats.failedSend);
+    chprintf(stream, "tx_failed_queue %u\n", audioTxStats.failedQueue);
+    chprintf(stream, "tx_first_packet_ms %u\n",
+             ST2MS(audioTxStats.firstPacketTime));
+
+    /* Current session, RTP bytes only */
+    chprintf(stream, "session_audio_packets %u\n", session->audioPackets);
+    chprintf(stream, "session_cn_packets %u\n", session->cnPackets);
+    chprintf(stream, "session_suppressed_payloads %u\n",
+             session->suppressedPayloads);
+    chprintf(stream, "session_talkspurts %u\n", session->talkspurts);
+    chprintf(stream, "session_dropped_samples %u\n", session->droppedSamples);
+    chprintf(stream, "session_clipped_samples %u\n", session->clippedSamples);
+    chprintf(stream, "session_feature_packets %u\n",
+             activeAudioSession.featurePackets);
+    chprintf(stream, "session_level_packets %u\n",
+             activeAudioSession.levelPackets);
+    chprintf(stream, "session_bytes_sent %u\n",
+             session->audioPackets * packetizer->packetLength +
+             session->cnPackets * packetizer->cnPacketLength +
+             activeAudioSession.featureBytes +
+             activeAudioSession.levelPackets * LEVELS_RTCP_LENGTH);
+    chprintf(stream, "session_bytes_saved %u\n",
+             session->suppressedPayloads * packetizer->packetLength -
+             session->cnPackets * packetizer->cnPacketLength);
+
+    /* Core clock cycles per packet, in the processing thread and until sent */
+    chprintf(stream, "session_send_cycles_mean %u\n",
+             activeAudioSession.sendTime.n ?
+                (uint32_t)(activeAudioSession.sendTime.cumulative /
+                           activeAudioSession.sendTime.n) : 0);
+    chprintf(stream, "session_send_cycles_worst %u\n",
+             activeAudioSession.sendTime.worst);
+    chprintf(stream, "session_send_latency_cycles_mean %u\n",
+             activeAudioSession.sendLatencyCount ?
+                (uint32_t)(activeAudioSession.sendLatencyTotal /
+                           activeAudioSession.sendLatencyCount) : 0);
+    chprintf(stream, "session_send_latency_cycles_worst %u\n",
+             activeAudioSession.sendLatencyWorst);
+
+    /* PDM to PCM conversion, core clock cycles per block */
+    mp45dt02GetDspStats(&dsp);
+    chprintf(stream, "dsp_kernel %s\n", dsp.kernel);
+    chprintf(stream, "dsp_channels %u\n", dsp.channels);
+    chprintf(stream, "dsp_ports %u\n", dsp.ports);
+    chprintf(stream, "dsp_port_skew_cycles_worst %u\n", dsp.worstSkewCycles);
+    chprintf(stream, "beam_channels %u\n", dsp.beamChannels);
+    chprintf(stream, "beam_steer_degrees %.1f\n", dsp.beamSteerDegrees);
+    chprintf(stream, "beam_cycles_mean %u\n", dsp.beamMeanCycles);
+    chprintf(stream, "dsp_blocks %u\n", dsp.blocks);
+    chprintf(stream, "dsp_overruns %u\n", dsp.overruns);
+    chprintf(stream, "dsp_port_desyncs %u\n", dsp.desyncs);
+    chprintf(stream, "dsp_cycles_last %u\n", dsp.lastCycles);
+    chprintf(stream, "dsp_cycles_best %u\n", dsp.bestCycles);
+    chprintf(stream, "dsp_cycles_worst %u\n", dsp.worstCycles);
+    chprintf(stream, "dsp_cycles_mean %u\n", dsp.meanCycles);
+    chprintf(stream, "dsp_load_percent %.1f\n",
+             100.0f * dsp.meanCycles /
+             (STM32_SYSCLK / 1000 * MP45DT02_RAW_SAMPLE_DURATION_MS));
+    chprintf(stream, "dsp_latency_cycles_worst %u\n", dsp.worstLatencyCycles);
+    chprintf(stream, "dsp_deadline_margin_cycles_worst %d\n",
+             (int32_t)(STM32_SYSCLK / 1000 * MP45DT02_RAW_SAMPLE_DURATION_MS -
+                       dsp.worstLatencyCycles));
+    chprintf(stream, "eq_stages %u\n", dsp.eqStages);
+    chprintf(stream, "eq_cycles_mean %u\n", dsp.eqMeanCycles);
+    chprintf(stream, "eq_cycles_worst %u\n", dsp.eqWorstCycles);
+    chprintf(stream, "ns_frames %u\n", dsp.ns.frames);
+    chprintf(stream, "ns_noise_dbfs %.1f\n", dsp.ns.noiseDbfs);
+    chprintf(stream, "ns_gain_db %.1f\n", dsp.ns.gainDb);
+    chprintf(stream, "ns_latency_ms %u\n",
+             dsp.ns.latencySamples * 1000 / AUDIO_PACKETIZER_SAMPLE_RATE_HZ);
+    chprintf(stream, "ns_cycles_mean %u\n", dsp.nsMeanCycles);
+    chprintf(stream, "ns_cycles_worst %u\n", dsp.nsWorstCycles);
+    chprintf(stream, "slm_periods %u\n", dsp.slm.periods);
+    chprintf(stream, "slm_laeq_db %.1f\n", dsp.slm.laeq);
+    chprintf(stream, "slm_lceq_db %.1f\n", dsp.slm.lceq);
+    chprintf(stream, "slm_lzeq_db %.1f\n", dsp.slm.lzeq);
+    chprintf(stream, "slm_lafmax_db %.1f\n", dsp.slm.lafmax);
+    chprintf(stream, "slm_lasmax_db %.1f\n", dsp.slm.lasmax);
+    chprintf(stream, "slm_lcpeak_db %.1f\n", dsp.slm.lcpeak);
+    chprintf(stream, "slm_laeq_total_db %.1f\n", dsp.slm.laeqTotal);
+    chprintf(stream, "slm_cycles_mean %u\n", dsp.slmMeanCycles);
+    chprintf(stream, "meter_rms_dbfs %.1f\n", dsp.meter.rmsDbfs);
+    chprintf(stream, "meter_peak_dbfs %.1f\n", dsp.meter.peakDbfs);
+    chprintf(stream, "meter_max_peak_dbfs %.1f\n", dsp.meter.maxPeakDbfs);
+    chprintf(stream, "meter_clipped_samples %u\n", dsp.meter.clippedSamples);
+    chprintf(stream, "meter_clipped_blocks %u\n", dsp.meter.clippedBlocks);
+    chprintf(stream, "meter_cycles_mean %u\n", dsp.meterMeanCycles);
+    chprintf(stream, "agc_gain_db %.1f\n", dsp.agc.gainDb);
+    chprintf(stream, "agc_gated_blocks %u\n", dsp.agc.gatedBlocks);
+    chprintf(stream, "agc_cycles_mean %u\n", dsp.agcMeanCycles);
+    chprintf(stream, "agc_cycles_worst %u\n", dsp.agcWorstCycles);
+    chprintf(stream, "limiter_blocks %u\n", dsp.agc.limitedBlocks);
+    chprintf(stream, "limiter_percent %.1f\n",
+             dsp.agc.blocks ?
+                100.0f * dsp.agc.limitedBlocks / dsp.agc.blocks : 0.0f);
+    chprintf(stream, "limiter_engagements %u\n", dsp.agc.limiterEngagements);
+    chprintf(stream, "limiter_max_reduction_db %.1f\n",
+             dsp.agc.maxReductionDb);
+
+#if CONFIG_AUDIO_TRIGGER
+    chMtxLock(&audioTxTrigger.mutex);
+    audioTriggerGetStats(&audioTxTrigger.trigger, &trigger);
+    chMtxUnlock(&audioTxTrigger.mutex);
+    chprintf(stream, "trigger_triggered %u\n", trigger.triggered);
+    chprintf(stream, "trigger_events %u\n", trigger.events);
+    chprintf(stream, "trigger_level_fires %u\n", trigger.levelFires);
+    chprintf(stream, "trigger_vad_fires %u\n", trigger.vadFires);
+    chprintf(stream, "trigger_sent_payloads %u\n", trigger.sentPayloads);
+    chprintf(stream, "trigger_dropped_payloads %u\n", trigger.droppedPayloads);
+    chprintf(stream, "trigger_preroll_ms %u\n",
+             trigger.slots * AUDIO_PACKETIZER_PAYLOAD_DURATION_MS);
+    chprintf(stream, "trigger_held_ms %u\n",
+             trigger.heldSlots * AUDIO_PACKETIZER_PAYLOAD_DURATION_MS);
+    chprintf(stream, "trigger_level_dbfs %.1f\n", trigger.levelDbfs);
+    chprintf(stream, "trigger_cycles_mean %u\n",
+             audioTxTrigger.time.n ?
+                (uint32_t)(audioTxTrigger.time.cumulative /
+                           audioTxTrigger.time.n) : 0);
+    chprintf(stream, "trigger_cycles_worst %u\n", audioTxTrigger.time.worst);
+#endif
+
+#if CONFIG_AUDIO_FEATURES
+    audioFeaturesGetStats(&audioTxFeatures.features, &features);
+    chprintf(stream, "features_frames %u\n", features.frames);
+    chprintf(stream, "features_bands %u\n", features.bands);
+    chprintf(stream, "features_max_band_dbfs %.1f\n", features.maxBandDbfs);
+    chprintf(stream, "features_cycles_mean %u\n",
+             audioTxFeatures.time.n ?
+                (uint32_t)(audioTxFeatures.time.cumulative /
+                           audioTxFeatures.time.n) : 0);
+    chprintf(stream, "features_cycles_worst %u\n", audioTxFeatures.time.worst);
+#endif
+}
+
+/* Payload type of comfort noise packets, 0 if they are never sent */
+uint8_t audioTxGetCnPayloadType(void)
+{
+    return CONFIG_AUDIO_VAD && !CONFIG_AUDIO_FEATURES ?
+           AUDIO_TX_CN_PAYLOAD_TYPE : 0;
 }
 
+/* Interleaved channels in each L16 frame */
+uint8_t audioTxGetChannels(void)
+{
+    return mp45dt02GetChannels();
+}
+
+/* Encoding of the stream's payload type, as named in SDP */
+const char *audioTxGetEncoding(void)
+{
+    return CONFIG_AUDIO_FEATURES ? "x-bands" : "L16";
+}
+
+/* Takes effect straight away, and for later sessions. Not stored. */
+StatusCode audioTxSetTrigger(const audioTriggerSettings *settings)
+{
+#if CONFIG_AUDIO_TRIGGER
+    chMtxLock(&audioTxTrigger.mutex);
+
+    audioTxTrigger.settings = *settings;
+
+    if (activeAudioSession.state != AUDIO_TX_STATE_IDLE)
+    {
+        audioTriggerSetSettings(&audioTxTrigger.trigger, settings);
+    }
+
+    chMtxUnlock(&audioTxTrigger.mutex);
+
+    return STATUS_OK;
+#else
+    (void)settings;
+    return STATUS_ERROR_API;
+#endif
+}
+
+StatusCode audioTxGetTrigger(audioTriggerSettings *settings)
+{
+#if CONFIG_AUDIO_TRIGGER
+    chMtxLock(&audioTxTrigger.mutex);
+    *settings = audioTxTrigger.settings;
+    chMtxUnlock(&audioTxTrigger.mutex);
+
+    return STATUS_OK;
+#else
+    (void)settings;
+    return STATUS_ERROR_API;
+#endif
+}
@@ -28,7 +28,23 @@
 #define __AUDIO_TX_H__
 
 #include <stdint.h>
+#include "hal.h"
 #include "lwip/ip_addr.h"
+#include "rtp.h"
+#include "audio_packetizer.h"
+#include "audio_trigger.h"
+
+/* Dynamic RTP payload type used for the L16 stream */
+#define AUDIO_TX_RTP_PAYLOAD_TYPE   96
+
+/* Dynamic RTP payload type used for RFC 3389 comfort noise */
+#define AUDIO_TX_CN_PAYLOAD_TYPE    97
+
+/* Dynamic RTP payload type used for band energies, with CONFIG_AUDIO_FEATURES */
+#define AUDIO_TX_FEATURES_PAYLOAD_TYPE  98
+
+/* Sampling rate of the transmitted audio, Hz */
+#define AUDIO_TX_SAMPLE_RATE_HZ     AUDIO_PACKETIZER_SAMPLE_RATE_HZ
 
 typedef struct {
     ip_addr_t ipDest;
@@ -36,9 +52,17 @@ typedef struct {
     uint16_t remoteRtpPort;
 } audioTxRtpConfig;
 
+StatusCode audioTxInit(void);
 void audioTxRtpSetup(audioTxRtpConfig *setupConfig);
 void audioTxRtpTeardown(void);
 void audioTxRtpPlay(void);
 void audioTxRtpPause(void);
+void audioTxGetRtpConfig(rtpConfig *config);
+void audioTxPrintStats(BaseSequentialStream *stream);
+uint8_t audioTxGetCnPayloadType(void);
+uint8_t audioTxGetChannels(void);
+const char *audioTxGetEncoding(void);
+StatusCode audioTxSetTrigger(const audioTriggerSettings *settings);
+StatusCode audioTxGetTrigger(audioTriggerSettings *settings);
 
 #endif /* Header Guard */
@@ -270,3 +270,3948 @@ float32_t firCoeffs[FIR_COEFFS_LEN] = {
     -0.00020365859931971167711,
 };
 
+const float32_t firNibbleSums[FIR_COEFFS_LEN / 4][16] = {
+    {
+        27.08697542939523117411227,
+        13.31673656729268273579692,
+        13.48834756614395935514494,
+        -0.28189129595859085952725,
+        13.62948423126473151967275,
+        -0.14075463083781869499944,
+        0.03085636801345792434859,
+        -13.73938249408909229032361,
+        13.74020912297793017842196,
+        -0.03002973912462092442865,
+        0.14158125972665569491937,
+        -13.62865760237589540793124,
+        0.28271792484742697126876,
+        -13.48752093725512324340343,
+        -13.31590993840384840041224,
+        -27.08614880050639683872760,
+    },
+    {
+        28.69380571243902977585094,
+        13.94491617327519961122562,
+        14.23114246996123810617974,
+        -0.51774706920259294662401,
+        14.49062159986063491601271,
+        -0.25826793930319791314787,
+        0.02795835738284235816309,
+        -14.72093118178099047099749,
+        14.72180684723852195361360,
+        -0.02708269192530909919014,
+        0.25914360476073117212081,
+        -14.48974593440309988068293,
+        0.51862273466012442924011,
+        -14.23026680450370662356363,
+        -13.94404050781766812860951,
+        -28.69293004698149829323484,
+    },
+    {
+        31.15792339771151375771296,
+        15.04243838592463866632443,
+        15.41169090294285481945735,
+        -0.70379410884402027193119,
+        15.76463961844486405539101,
+        -0.35084539334201014781911,
+        0.01840712367620511713540,
+        -16.09707788811066819789630,
+        16.09802875247217102128161,
+        -0.01745625931470407010693,
+        0.35179625770351297120442,
+        -15.76368875408336123200570,
+        0.70474497320552309531649,
+        -15.41074003858135199607204,
+        -15.04148752156313761929596,
+        -31.15697253335001448704134,
+    },
+    {
+        34.17176485002619301667437,
+        16.49640246004268107071766,
+        16.88971739096533042356896,
+        -0.78564499901818152238775,
+        17.28404198566136074077804,
+        -0.39132040432214942882183,
+        0.00199452660049992402946,
+        -17.67336786338301379828408,
+        17.67441070288649029862427,
+        -0.00095168709702164733244,
+        0.39236324382562770551885,
+        -17.28299914615788424043785,
+        0.78668783852166157544161,
+        -16.88867455146185037051509,
+        -16.49535962053920101766380,
+        -34.17072201052270941090683,
+    },
+    {
+        37.20936406928979778285793,
+        18.08450458007366279389316,
+        18.41595017246218546347336,
+        -0.70890931675395130184825,
+        18.77233161724527832348031,
+        -0.35252787197085666548446,
+        -0.02108227958233577226110,
+        -19.14594176879847253758271,
+        19.14707730847343825075768,
+        0.02221781925730148543607,
+        0.35366341164582237865943,
+        -18.77119607757031616301902,
+        0.71004485642891523866638,
+        -18.41481463278721975029839,
+        -18.08336904039870063343187,
+        -37.20822852961483562239664,
+    },
+    {
+        39.53295495580272955749024,
+        19.47584144624462254569153,
+        19.63459584122685086526872,
+        -0.42251766833125614653000,
+        19.84814872587181255880751,
+        -0.20896478368629445299121,
+        -0.05021038870406613341402,
+        -20.10732389826217314521273,
+        20.10853034830355312578831,
+        0.05141683874544433763276,
+        0.21017123372767265720995,
+        -19.84694227583043613094560,
+        0.42372411837263612710558,
+        -19.63338939118547088469313,
+        -19.47463499620324256511594,
+        -39.53174850576134957691465,
+    },
+    {
+        40.21290304527103387499665,
+        20.23839433931817666234565,
+        20.09246914525462557321589,
+        0.11796043930176836056489,
+        20.03606111572219106164994,
+        0.06155240976933562535578,
+        -0.08437278429421546377398,
+        -20.05888149024707445278182,
+        20.06010869065739044003749,
+        0.08559998470453322738649,
+        -0.06032520935901786174327,
+        -20.03483391531187507439427,
+        -0.11673323889145237330922,
+        -20.09124194484430958596022,
+        -20.23716713890785712237630,
+        -40.21167584486071433502730,
+    },
+    {
+        38.16058428785027700769206,
+        19.85313693132809120811544,
+        19.25463157361494026531545,
+        0.94718421709275624209567,
+        18.78377058461600057626129,
+        0.47632322809381477668467,
+        -0.12218212961933438975848,
+        -18.42962948614151841297826,
+        18.43079405475381804535573,
+        0.12334669823163579849279,
+        -0.47515865948151336795036,
+        -18.78260601600369739117014,
+        -0.94601964848045483336136,
+        -19.25346700500264063293798,
+        -19.85197236271578447031061,
+        -38.15941971923797382260091,
+    },
+    {
+        32.17311750666431890977037,
+        17.73435075901742763448965,
+        16.52603638402137420371218,
+        2.08726963637448292843146,
+        15.48514553768874435490943,
+        1.04637879004185307962871,
+        -0.16193558495419946297034,
+        -14.60070233260109162642948,
+        14.60168417822812614303984,
+        0.16291743058123397958070,
+        -1.04539694441481945119676,
+        -15.48416369206171161465591,
+        -2.08628779074745107635636,
+        -16.52505453839434323981550,
+        -17.73336891339039667059296,
+        -32.17213566103728794587369,
+    },
+    {
+        20.98818251725923289541242,
+        13.25538408015509617143834,
+        11.27833753066818545107708,
+        3.54553909356404828301379,
+        9.50815659040516436562029,
+        1.77535815330102719755700,
+        -0.20168839618588396689347,
+        -7.93448683329002157904597,
+        7.93512734178969303400208,
+        0.20232890468555586593880,
+        -1.77471764480135529851168,
+        -9.50751608190549291066418,
+        -3.54489858506437638396847,
+        -11.27769702216851399612096,
+        -13.25474357165542471648223,
+        -20.98754200875956144045631,
+    },
+    {
+        3.34655394556268914740826,
+        5.77877143838274776044273,
+        2.88071386215032676503256,
+        5.31293135497038537806702,
+        0.22649712250966103077587,
+        2.65871461532971942176573,
+        -0.23934296090270201773365,
+        2.19287453191735615121161,
+        -2.19277240319587329864248,
+        0.23944508962418498132507,
+        -2.65861248660823612510740,
+        -0.22639499378817795616214,
+        -5.31282922624890296958711,
+        -2.88061173342884391246344,
+        -5.77866930966126446378439,
+        -3.34645181684120629483914,
+    },
+    {
+        -21.94051514291407301016079,
+        -5.31063988637621697819213,
+        -9.26669514706760821809439,
+        7.36318010947024870205269,
+        -12.94656918923164212742449,
+        3.68330606730621301636575,
+        -0.27274919338517733535809,
+        16.35712606315267692025373,
+        -16.35779563453765561575892,
+        0.27207962200020041620974,
+        -3.68397563869118904733568,
+        12.94589961784666698463298,
+        -7.36384968085522473302262,
+        9.26602557568263129894603,
+        5.30997031499124183540061,
+        21.93984557152909786736927,
+    },
+    {
+        -55.92228721531841983960476,
+        -20.57111897096755726010997,
+        -25.69833546463009810167932,
+        9.65283277972075914874495,
+        -30.52376307818986589381893,
+        4.82740516616099135660534,
+        -0.29981132750154770860718,
+        35.05135691684931487088761,
+        -35.05306352961832772052730,
+        0.29810471473252775354013,
+        -4.82911177893001131167239,
+        30.52205646542084593875188,
+        -9.65453939248977910381200,
+        25.69662885186107814661227,
+        20.56941235819853730504292,
+        55.92058060254939277911035,
+    },
+    {
+        -99.44134450783494116876682,
+        -40.46973207084420209866948,
+        -46.84947241854976596187043,
+        12.12214001844097666094058,
+        -52.91046794474085857018508,
+        6.06114449224988049991225,
+        -0.31859585545567625786134,
+        58.65301658153506281223599,
+        -58.65605129053493271840125,
+        0.31556114645580279898240,
+        -6.06417920124975395879119,
+        52.90743323574098155859247,
+        -12.12517472744084656710584,
+        46.84643770954988895027782,
+        40.46669736184433929793158,
+        99.43830979883507836802892,
+    },
+    {
+        -153.07167104394483203577693,
+        -65.35002163996210811092169,
+        -73.02484679244157916855329,
+        14.69680261154114475630195,
+        -80.37425937891484295505506,
+        7.34739002506787386437281,
+        -0.32743512741159008783143,
+        87.39421427657113383702381,
+        -87.39888565325094305080711,
+        0.32276375073177376862077,
+        -7.35206140174769018358347,
+        80.36958800223503374127176,
+        -14.70147398822096107551261,
+        73.02017541576176995476999,
+        65.34535026328231310799310,
+        153.06699966726503703284834,
+    },
+    {
+        -217.06533890747351733807591,
+        -95.40339240072410120774293,
+        -104.37142795510307280437701,
+        17.29051855164635043138333,
+        -113.01893219754498431939282,
+        8.64301430920443181094015,
+        -0.32502124517451846941185,
+        121.33692526157490476634848,
+        -121.34354957001323782606050,
+        0.31839693673617830427247,
+        -8.64963861764277197607953,
+        113.01230788910665125968080,
+        -17.29714286008469059652271,
+        104.36480364666473974466498,
+        95.39676809228579656974034,
+        217.05871459903522691092803,
+    },
+    {
+        -291.31081182236994209233671,
+        -130.64578785640139813040150,
+        -140.85679285975567154309829,
+        19.80823110621285820798221,
+        -150.76450423324860139473458,
+        9.90051973271992835634592,
+        -0.31048527063438768891501,
+        160.35453869533415627302020,
+        -160.36342879579260056743806,
+        0.30159517017594339449715,
+        -9.90940983317837265076378,
+        150.75561413279018552202615,
+        -19.81712120667128829154535,
+        140.84790275929725567038986,
+        130.63689775594292541427421,
+        291.30192172191146937620942,
+    },
+    {
+        -375.30540578983243449329166,
+        -170.90103194438239597729989,
+        -182.25443286302527212683344,
+        22.14994098242475217830361,
+        -193.33443034694886364377453,
+        11.06994349850114645050780,
+        -0.28345742014175812073518,
+        204.12091642530828039525659,
+        -204.13236983735021112806862,
+        0.27200400809982738792314,
+        -11.08139691054307718331984,
+        193.32297693490693291096250,
+        -22.16139439446671133282507,
+        182.24297945098331297231198,
+        170.88957853234040840106900,
+        375.29395237779044691706076,
+    },
+    {
+        -468.14383429017254911741475,
+        -215.79192757880434783146484,
+        -228.13699251678730206549517,
+        24.21491419458087079874531,
+        -240.25094657234956230240641,
+        12.10096013901858214012464,
+        -0.24410479896432946134155,
+        252.10780191240382919204421,
+        -252.12208852844051421016047,
+        0.22981818292764444322529,
+        -12.11524675505526715824089,
+        240.23665995631290570599958,
+        -24.22920081061754160600685,
+        228.12270590075061704737891,
+        215.77764096276771965676744,
+        468.12954767413589252100792,
+    },
+    {
+        -568.52404277432572143879952,
+        -264.73985956604212788079167,
+        -277.87808952911279902764363,
+        25.90609367917085137378308,
+        -290.83909754774265365995234,
+        12.94508566054099674147437,
+        -0.19314430252967440537759,
+        303.59103890575397599604912,
+        -303.60838888264527213323163,
+        0.17579432563837826819508,
+        -12.96243563743229287865688,
+        290.82174757085135752276983,
+        -25.92344365606214751096559,
+        277.86073955222150289046112,
+        264.72250958915083174360916,
+        568.50669279743442530161701,
+    },
+    {
+        -674.77073833465954066923587,
+        -316.97326007645472145668464,
+        -330.66296985987844436749583,
+        27.13450839832643168847426,
+        -344.23959799477722754090792,
+        13.55788026342764851506217,
+        -0.13182951999607439574902,
+        357.66564873820880166022107,
+        -357.68624110693235707003623,
+        0.11123715127249056422443,
+        -13.57847263215123234658677,
+        344.21900562605361528767389,
+        -27.15510076705004394170828,
+        330.64237749115477527084295,
+        316.95266770773105236003175,
+        674.75014596593587157258298,
+    },
+    {
+        -784.87618441437405181204667,
+        -371.54487933784128017578041,
+        -385.50783559602518835163210,
+        27.82346948050761170634360,
+        -399.43026057822623897664016,
+        13.90104449830653265962610,
+        -0.06191175987729025109729,
+        413.26939331665550980687840,
+        -413.29334583693179183683242,
+        0.03795923960097979943384,
+        -13.92499701858284311128955,
+        399.40630805794990010326728,
+        -27.84742200078392215800704,
+        385.48388307574884947825922,
+        371.52092681756505498924525,
+        784.85223189409782662551152,
+    },
+    {
+        -896.55699846040261036250740,
+        -427.35738289054552296875045,
+        -441.28726635745567818958079,
+        27.91234921240146604759502,
+        -455.25530871450439462932991,
+        13.94430685535274960784591,
+        0.01442338844259438701556,
+        469.21403895829973862419138,
+        -469.24139970654380249470705,
+        -0.04178413668665825753123,
+        -13.97166760359681347836158,
+        455.22794796626033075881423,
+        -27.93970996064547307469184,
+        441.25990560921161431906512,
+        427.33002214230145909823477,
+        896.52963771215854649199173,
+    },
+    {
+        -1007.32490412932543222268578,
+        -483.19639057893300559953786,
+        -496.76875832296082080574706,
+        27.35975522743166266081971,
+        -510.46150450044143553895992,
+        13.66700904995104792760685,
+        0.09464130592323272139765,
+        524.22315485631565934454557,
+        -524.25389597277467146341223,
+        -0.12538242238224484026432,
+        -13.69775016641008846818295,
+        510.43076338398236657667439,
+        -27.39049634389067477968638,
+        496.73801720650180868688039,
+        483.16564946247405032409006,
+        1007.29416301286653379065683,
+    },
+    {
+        -1114.56868877848182819434442,
+        -537.76970190075815025920747,
+        -550.65304856384943832381396,
+        26.14593831387412592448527,
+        -563.73967857509251189185306,
+        13.05930830263105235644616,
+        0.17596163953976429183967,
+        576.97494851726332854013890,
+        -577.00896245429885311750695,
+        -0.20997557657523202578886,
+        -13.09332223966652009039535,
+        563.70566463805698731448501,
+        -26.17995225090953681501560,
+        550.61903462681402743328363,
+        537.73568796372273936867714,
+        1114.53467484144630361697637,
+    },
+    {
+        -1215.64403739194904119358398,
+        -589.75113627437576724332757,
+        -601.61859444451488343474921,
+        24.27430667305839051550720,
+        -613.76996801121936186973471,
+        12.12293310635402576735942,
+        0.25547493621473904568120,
+        626.14837605378806983935647,
+        -626.18547456567137032834580,
+        -0.29257344809803953467053,
+        -12.16003161823732625634875,
+        613.73286949933594769390766,
+        -24.31140518494163416107767,
+        601.58149593263169663259760,
+        589.71403776249235306750052,
+        1215.60693888006562701775692,
+    },
+    {
+        -1307.96748592580888725933619,
+        -637.82717153921635144797619,
+        -648.36835384396715653565479,
+        21.77196054262554980596178,
+        -659.26886488259776797349332,
+        10.87144950399493836812326,
+        0.33026719924413328044466,
+        670.47058158583683962206123,
+        -670.51049758577346437959932,
+        -0.37018319918081488140160,
+        -10.91136550393161996908020,
+        659.22894888266114321595524,
+        -21.81187654256228825033759,
+        648.32843784403041809127899,
+        637.78725553927961300360039,
+        1307.92756992587237618863583,
+    },
+    {
+        -1389.11048309036550563178025,
+        -680.74440249178394424234284,
+        -689.67687374405045375169721,
+        18.68920685453099395090248,
+        -699.03606283815872757259058,
+        9.33001776042272013000911,
+        0.39754650815621062065475,
+        708.76362710673765832325444,
+        -708.80601939442954062542412,
+        -0.43993879584814976624330,
+        -9.37241004811465927559766,
+        698.99367055046673158358317,
+        -18.73159914222298993990989,
+        689.63448145635845776268980,
+        680.70201020409183456649771,
+        1389.06809080267339595593512,
+    },
+    {
+        -1456.88948404234247391286772,
+        -717.35577229537739185616374,
+        -724.43564998343822480819654,
+        15.09806176352702777876402,
+        -731.99906836865307013795245,
+        7.53464337831212560558924,
+        0.45476569025123581013759,
+        739.98847743721648839709815,
+        -740.03293817586518343887292,
+        -0.49922642889993085191236,
+        -7.57910411696082064736402,
+        731.95460763000437509617768,
+        -15.14252250217566597711993,
+        724.39118924478952976642177,
+        717.31131155672869681438897,
+        1456.84502330369377887109295,
+    },
+    {
+        -1509.44812722249480430036783,
+        -746.66355743019153123896103,
+        -751.69477272861252004076960,
+        11.08979706369080986405606,
+        -757.25361931447287133778445,
+        5.53095047783040172362234,
+        0.49973517940935607839492,
+        763.28430497171268598322058,
+        -763.33036967286079743644223,
+        -0.54579988055752437503543,
+        -5.57701517897857002026285,
+        757.20755461332475988456281,
+        -11.13586176483897816069657,
+        751.64870802746440858754795,
+        746.61749272904330609890167,
+        1509.40206252134657916030847,
+    },
+    {
+        -1545.32786188743875754880719,
+        -767.85721089683511308976449,
+        -770.69901869175100728170946,
+        6.77163229885263717733324,
+        -774.09812255656527213432128,
+        3.37252843403837232472142,
+        0.53072063912247813277645,
+        778.00137162972612259181915,
+        -778.04853129347998219600413,
+        -0.57788030287633773696143,
+        -3.41968809779223192890640,
+        774.05096289281141253013629,
+        -6.81879196260638309468050,
+        770.65185902799726136436220,
+        767.81005123308136717241723,
+        1545.28070222368501163145993,
+    },
+    {
+        -1563.52388454544370688381605,
+        -780.34438326175654765393119,
+        -780.91678581477140141942073,
+        2.26271546891598518413957,
+        -782.06057808977084278012626,
+        1.11892319391648698001518,
+        0.54652064090157637110678,
+        783.72602192458884928782936,
+        -783.77373688688578567962395,
+        -0.59423560319845591948251,
+        -1.16663815621336652839091,
+        782.01286312747402007516939,
+        -2.31043043121286473251530,
+        780.86907085247446502762614,
+        780.29666829945961126213660,
+        1563.47616958314688417885918,
+    },
+    {
+        -1563.52388454544370688381605,
+        -783.77373688688567199278623,
+        -782.06057808977084278012626,
+        -2.31043043121286473251530,
+        -780.91678581477128773258300,
+        -1.16663815621336652839091,
+        0.54652064090157637110678,
+        780.29666829945949757529888,
+        -780.34438326175632028025575,
+        -0.59423560319845591948251,
+        1.11892319391648698001518,
+        780.86907085247435134078842,
+        2.26271546891604202755843,
+        782.01286312747402007516939,
+        783.72602192458896297466708,
+        1563.47616958314688417885918,
+    },
+    {
+        -1545.32786188743875754880719,
+        -778.04853129347998219600413,
+        -774.09812255656527213432128,
+        -6.81879196260643993809936,
+        -770.69901869175100728170946,
+        -3.41968809779223192890640,
+        0.53072063912247813277645,
+        767.81005123308136717241723,
+        -767.85721089683511308976449,
+        -0.57788030287633773696143,
+        3.37252843403837232472142,
+        770.65185902799726136436220,
+        6.77163229885258033391437,
+        774.05096289281141253013629,
+        778.00137162972600890498143,
+        1545.28070222368478425778449,
+    },
+    {
+        -1509.44812722249480430036783,
+        -763.33036967286079743644223,
+        -757.25361931447275765094673,
+        -11.13586176483892131727771,
+        -751.69477272861252004076960,
+        -5.57701517897868370710057,
+        0.49973517940935607839492,
+        746.61749272904319241206395,
+        -746.66355743019130386528559,
+        -0.54579988055752437503543,
+        5.53095047783051541046007,
+        751.64870802746440858754795,
+        11.08979706369080986405606,
+        757.20755461332464619772509,
+        763.28430497171268598322058,
+        1509.40206252134657916030847,
+    },
+    {
+        -1456.88948404234247391286772,
+        -740.03293817586506975203520,
+        -731.99906836865307013795245,
+        -15.14252250217572282053879,
+        -724.43564998343822480819654,
+        -7.57910411696082064736402,
+        0.45476569025123581013759,
+        717.31131155672858312755125,
+        -717.35577229537727816932602,
+        -0.49922642889993085191236,
+        7.53464337831212560558924,
+        724.39118924478952976642177,
+        15.09806176352697093534516,
+        731.95460763000437509617768,
+        739.98847743721626102342270,
+        1456.84502330369377887109295,
+    },
+    {
+        -1389.11048309036550563178025,
+        -708.80601939442965431226185,
+        -699.03606283815872757259058,
+        -18.73159914222293309649103,
+        -689.67687374405045375169721,
+        -9.37241004811465927559766,
+        0.39754650815621062065475,
+        680.70201020409194825333543,
+        -680.74440249178394424234284,
+        -0.43993879584814976624330,
+        9.33001776042272013000911,
+        689.63448145635857144952752,
+        18.68920685453099395090248,
+        698.99367055046673158358317,
+        708.76362710673765832325444,
+        1389.06809080267339595593512,
+    },
+    {
+        -1307.96748592580865988566075,
+        -670.51049758577323700592387,
+        -659.26886488259765428665560,
+        -21.81187654256223140691873,
+        -648.36835384396704284881707,
+        -10.91136550393161996908020,
+        0.33026719924413328044466,
+        637.78725553927949931676267,
+        -637.82717153921612407430075,
+        -0.37018319918081488140160,
+        10.87144950399493836812326,
+        648.32843784403030440444127,
+        21.77196054262566349279950,
+        659.22894888266102952911751,
+        670.47058158583672593522351,
+        1307.92756992587214881496038,
+    },
+    {
+        -1215.64403739194881381990854,
+        -626.18547456567125664150808,
+        -613.76996801121913449605927,
+        -24.31140518494146363082109,
+        -601.61859444451499712158693,
+        -12.16003161823732625634875,
+        0.25547493621473904568120,
+        589.71403776249235306750052,
+        -589.75113627437576724332757,
+        -0.29257344809803953467053,
+        12.12293310635402576735942,
+        601.58149593263169663259760,
+        24.27430667305810629841289,
+        613.73286949933572032023221,
+        626.14837605378784246568102,
+        1215.60693888006562701775692,
+    },
+    {
+        -1114.56868877848182819434442,
+        -577.00896245429885311750695,
+        -563.73967857509251189185306,
+        -26.17995225090965050185332,
+        -550.65304856384943832381396,
+        -13.09332223966652009039535,
+        0.17596163953965060500195,
+        537.73568796372251199500170,
+        -537.76970190075803657236975,
+        -0.20997557657511833895114,
+        13.05930830263105235644616,
+        550.61903462681402743328363,
+        26.14593831387418276790413,
+        563.70566463805710100132274,
+        576.97494851726321485330118,
+        1114.53467484144607624330092,
+    },
+    {
+        -1007.32490412932543222268578,
+        -524.25389597277467146341223,
+        -510.46150450044137869554106,
+        -27.39049634389070320139581,
+        -496.76875832296070711890934,
+        -13.69775016641000320305466,
+        0.09464130592326114310708,
+        483.16564946247399348067120,
+        -483.19639057893300559953786,
+        -0.12538242238230168368318,
+        13.66700904995096266247856,
+        496.73801720650169500004267,
+        27.35975522743163423911028,
+        510.43076338398236657667439,
+        524.22315485631554565770784,
+        1007.29416301286630641698139,
+    },
+    {
+        -896.55699846040226930199424,
+        -469.24139970654351827761275,
+        -455.25530871450416725565447,
+        -27.93970996064538780956354,
+        -441.28726635745550765932421,
+        -13.97166760359675663494272,
+        0.01442338844265123043442,
+        427.33002214230140225481591,
+        -427.35738289054546612533159,
+        -0.04178413668671510095010,
+        13.94430685535269276442705,
+        441.25990560921144378880854,
+        27.91234921240132393904787,
+        455.22794796626010338513879,
+        469.21403895829951125051593,
+        896.52963771215831911831629,
+    },
+    {
+        -784.87618441437382443837123,
+        -413.29334583693162130657583,
+        -399.43026057822612528980244,
+        -27.84742200078397900142591,
+        -385.50783559602501782137551,
+        -13.92499701858287153299898,
+        -0.06191175987731867280672,
+        371.52092681756482761556981,
+        -371.54487933784116648894269,
+        0.03795923960100822114327,
+        13.90104449830656108133553,
+        385.48388307574873579142150,
+        27.82346948050764012805303,
+        399.40630805794978641642956,
+        413.26939331665528243320296,
+        784.85223189409748556499835,
+    },
+    {
+        -674.77073833465919960872270,
+        -357.68624110693224338319851,
+        -344.23959799477700016723247,
+        -27.15510076705001551999885,
+        -330.66296985987833068065811,
+        -13.57847263215128919000563,
+        -0.13182951999613123916788,
+        316.95266770773088182977517,
+        -316.97326007645449408300919,
+        0.11123715127254740764329,
+        13.55788026342770535848103,
+        330.64237749115471842742409,
+        27.13450839832643168847426,
+        344.21900562605344475741731,
+        357.66564873820868797338335,
+        674.75014596593564419890754,
+    },
+    {
+        -568.52404277432560775196180,
+        -303.60838888264515844639391,
+        -290.83909754774259681653348,
+        -25.92344365606214751096559,
+        -277.87808952911268534080591,
+        -12.96243563743223603523802,
+        -0.19314430252961756195873,
+        264.72250958915083174360916,
+        -264.73985956604212788079167,
+        0.17579432563832142477622,
+        12.94508566054093989805551,
+        277.86073955222138920362340,
+        25.90609367917085137378308,
+        290.82174757085130067935097,
+        303.59103890575397599604912,
+        568.50669279743442530161701,
+    },
+    {
+        -468.14383429017237858715816,
+        -252.12208852844042894503218,
+        -240.25094657234950545898755,
+        -24.22920081061755581686157,
+        -228.13699251678724522207631,
+        -12.11524675505528136909561,
+        -0.24410479896434367219626,
+        215.77764096276760596992972,
+        -215.79192757880429098804598,
+        0.22981818292765865408001,
+        12.10096013901859635097935,
+        228.12270590075053178225062,
+        24.21491419458084237703588,
+        240.23665995631279201916186,
+        252.10780191240377234862535,
+        468.12954767413572199075134,
+    },
+    {
+        -375.30540578983226396303507,
+        -204.13236983735004059781204,
+        -193.33443034694889206548396,
+        -22.16139439446665448940621,
+        -182.25443286302521528341458,
+        -11.08139691054299191819155,
+        -0.28345742014184338586347,
+        170.88957853234040840106900,
+        -170.90103194438233913388103,
+        0.27200400809991265305143,
+        11.06994349850106118537951,
+        182.24297945098328455060255,
+        22.14994098242475217830361,
+        193.32297693490698975438136,
+        204.12091642530816670841887,
+        375.29395237779039007364190,
+    },
+    {
+        -291.31081182236988524891785,
+        -160.36342879579260056743806,
+        -150.76450423324860139473458,
+        -19.81712120667133092410950,
+        -140.85679285975567154309829,
+        -9.90940983317837265076378,
+        -0.31048527063438768891501,
+        130.63689775594289699256478,
+        -130.64578785640134128698264,
+        0.30159517017594339449715,
+        9.90051973271992835634592,
+        140.84790275929719882697100,
+        19.80823110621287241883692,
+        150.75561413279015710031672,
+        160.35453869533412785131077,
+        291.30192172191141253279056,
+    },
+    {
+        -217.06533890747348891636648,
+        -121.34354957001323782606050,
+        -113.01893219754495589768339,
+        -17.29714286008470480737742,
+        -104.37142795510303017181286,
+        -8.64963861764278618693425,
+        -0.32502124517451846941185,
+        95.39676809228572551546677,
+        -95.40339240072407278603350,
+        0.31839693673617830427247,
+        8.64301430920444602179487,
+        104.36480364666468290124612,
+        17.29051855164636464223804,
+        113.01230788910660862711666,
+        121.33692526157486213378434,
+        217.05871459903511322409031,
+    },
+    {
+        -153.07167104394477519235807,
+        -87.39888565325088620738825,
+        -80.37425937891478611163620,
+        -14.70147398822088291581167,
+        -73.02484679244159337940800,
+        -7.35206140174769728901083,
+        -0.32743512741159719325879,
+        65.34535026328231310799310,
+        -65.35002163996212232177641,
+        0.32276375073178087404813,
+        7.34739002506788096980017,
+        73.02017541576178416562470,
+        14.69680261154105949117366,
+        80.36958800223496268699819,
+        87.39421427657106278275023,
+        153.06699966726495176772005,
+    },
+    {
+        -99.44134450783494116876682,
+        -58.65605129053493982382861,
+        -52.91046794474086567561244,
+        -12.12517472744085722524687,
+        -46.84947241854976596187043,
+        -6.06417920124976106421855,
+        -0.31859585545568336328870,
+        40.46669736184432508707687,
+        -40.46973207084420209866948,
+        0.31556114645580990440976,
+        6.06114449224988760533961,
+        46.84643770954989605570518,
+        12.12214001844098021365426,
+        52.90743323574098866401982,
+        58.65301658153506281223599,
+        99.43830979883506415717420,
+    },
+    {
+        -55.92228721531839141789533,
+        -35.05306352961831350967259,
+        -30.52376307818985523567790,
+        -9.65453939248977555109832,
+        -25.69833546463008389082461,
+        -4.82911177893000598260187,
+        -0.29981132750154770860718,
+        20.56941235819853375232924,
+        -20.57111897096755370739629,
+        0.29810471473252775354013,
+        4.82740516616098602753482,
+        25.69662885186106393575756,
+        9.65283277972075737238811,
+        30.52205646542083883332452,
+        35.05135691684930066003290,
+        55.92058060254937856825563,
+    },
+    {
+        -21.94051514291408722101551,
+        -16.35779563453766627389996,
+        -12.94656918923165100920869,
+        -7.36384968085523361480682,
+        -9.26669514706761177080807,
+        -3.68397563869119393231699,
+        -0.27274919338517822353651,
+        5.30997031499124005904378,
+        -5.31063988637621609001371,
+        0.27207962200020174847737,
+        3.68330606730621745725784,
+        9.26602557568263485165971,
+        7.36318010947025491930162,
+        12.94589961784667231370349,
+        16.35712606315269113110844,
+        21.93984557152910852551031,
+    },
+    {
+        3.34655394556268914740826,
+        -2.19277240319587374273169,
+        0.22649712250966125282048,
+        -5.31282922624890119323027,
+        2.88071386215032632094335,
+        -2.65861248660823701328582,
+        -0.23934296090270157364444,
+        -5.77866930966126446378439,
+        5.77877143838274776044273,
+        0.23944508962418442621356,
+        2.65871461532971986585494,
+        -2.88061173342884302428502,
+        5.31293135497038448988860,
+        -0.22639499378817840025135,
+        2.19287453191735703939003,
+        -3.34645181684120629483914,
+    },
+    {
+        20.98818251725923289541242,
+        7.93512734178967971132579,
+        9.50815659040516791833397,
+        -3.54489858506438348939582,
+        11.27833753066818900379076,
+        -1.77471764480136240393904,
+        -0.20168839618587330875243,
+        -13.25474357165542471648223,
+        13.25538408015509617143834,
+        0.20232890468554476370855,
+        1.77535815330103385889515,
+        -11.27769702216851754883464,
+        3.54553909356405494435194,
+        -9.50751608190549646337786,
+        -7.93448683329000825636967,
+        -20.98754200875956144045631,
+    },
+    {
+        32.17311750666433312062509,
+        14.60168417822813502482404,
+        15.48514553768875146033679,
+        -2.08628779074744663546426,
+        16.52603638402138486185322,
+        -1.04539694441481412212624,
+        -0.16193558495419679843508,
+        -17.73336891339039311787928,
+        17.73435075901743118720333,
+        0.16291743058123309140228,
+        1.04637879004184863873661,
+        -16.52505453839435034524286,
+        2.08726963637448115207462,
+        -15.48416369206171694372642,
+        -14.60070233260110228457052,
+        -32.17213566103730215672840,
+    },
+    {
+        38.16058428785026990226470,
+        18.43079405475381804535573,
+        18.78377058461600057626129,
+        -0.94601964848045483336136,
+        19.25463157361494381802913,
+        -0.47515865948151159159352,
+        -0.12218212961933261340164,
+        -19.85197236271578447031061,
+        19.85313693132808765540176,
+        0.12334669823163402213595,
+        0.47632322809381300032783,
+        -19.25346700500264063293798,
+        0.94718421709275446573884,
+        -18.78260601600369739117014,
+        -18.42962948614152196569194,
+        -38.15941971923797382260091,
+    },
+    {
+        40.21290304527100545328722,
+        20.06010869065737978189645,
+        20.03606111572217685079522,
+        -0.11673323889145237330922,
+        20.09246914525462557321589,
+        -0.06032520935900187453171,
+        -0.08437278429420302927610,
+        -20.23716713890783225338055,
+        20.23839433931814824063622,
+        0.08559998470452079288862,
+        0.06155240976931963814422,
+        -20.09124194484430958596022,
+        0.11796043930177013692173,
+        -20.03483391531185731082587,
+        -20.05888149024706024192710,
+        -40.21167584486068591331787,
+    },
+    {
+        39.53295495580269403035345,
+        20.10853034830353180950624,
+        19.84814872587180190066647,
+        0.42372411837263612710558,
+        19.63459584122683665441400,
+        0.21017123372767265720995,
+        -0.05021038870405547527298,
+        -19.47463499620322124883387,
+        19.47584144624459767669578,
+        0.05141683874543367949173,
+        -0.20896478368629445299121,
+        -19.63338939118546022655210,
+        -0.42251766833125437017316,
+        -19.84694227583041836737721,
+        -20.10732389826214472350330,
+        -39.53174850576130694435051,
+    },
+    {
+        37.20936406928974804486643,
+        19.14707730847341338176193,
+        18.77233161724525700719823,
+        0.71004485642892056773690,
+        18.41595017246215704176393,
+        0.35366341164582237865943,
+        -0.02108227958233577226110,
+        -18.08336904039867221172244,
+        18.08450458007363437218373,
+        0.02221781925730148543607,
+        -0.35252787197085666548446,
+        -18.41481463278719132858896,
+        -0.70890931675395663091876,
+        -18.77119607757029129402326,
+        -19.14594176879845122130064,
+        -37.20822852961478588440514,
+    },
+    {
+        34.17176485002616459496494,
+        17.67441070288647608776955,
+        17.28404198566134652992332,
+        0.78668783852165802272793,
+        16.88971739096530200185953,
+        0.39236324382561349466414,
+        0.00199452660048571317475,
+        -16.49535962053920457037748,
+        16.49640246004268107071766,
+        -0.00095168709700743647772,
+        -0.39132040432213521796712,
+        -16.88867455146182550151934,
+        -0.78564499901817974603091,
+        -17.28299914615787002958314,
+        -17.67336786338299958742937,
+        -34.17072201052268809462475,
+    },
+    {
+        31.15792339771149954685825,
+        16.09802875247216746856793,
+        15.76463961844486227903417,
+        0.70474497320552931256543,
+        15.41169090294285126674367,
+        0.35179625770351741209652,
+        0.01840712367621044620591,
+        -15.04148752156312340844124,
+        15.04243838592462623182655,
+        -0.01745625931470762282061,
+        -0.35084539334201458871121,
+        -15.41074003858134844335837,
+        -0.70379410884402382464486,
+        -15.76368875408335767929202,
+        -16.09707788811066109246894,
+        -31.15697253334999672347294,
+    },
+    {
+        28.69380571243901911770990,
+        14.72180684723851129547256,
+        14.49062159986063136329904,
+        0.51862273466012354106169,
+        14.23114246996123455346606,
+        0.25914360476072495487188,
+        0.02795835738284857541203,
+        -13.94404050781766102318215,
+        13.94491617327519250579826,
+        -0.02708269192531531643908,
+        -0.25826793930319169589893,
+        -14.23026680450369951813627,
+        -0.51774706920259028208875,
+        -14.48974593440309988068293,
+        -14.72093118178097626014278,
+        -28.69293004698148408238012,
+    },
+    {
+        27.08697542939523472682595,
+        13.74020912297793017842196,
+        13.62948423126473151967275,
+        0.28271792484742697126876,
+        13.48834756614396113150178,
+        0.14158125972665569491937,
+        0.03085636801345792434859,
+        -13.31590993840384662405540,
+        13.31673656729268273579692,
+        -0.03002973912462092442865,
+        -0.14075463083781869499944,
+        -13.48752093725512324340343,
+        -0.28189129595858997134883,
+        -13.62865760237589540793124,
+        -13.73938249408909229032361,
+        -27.08614880050639683872760,
+    },
+};
+
+const float32_t firCoeffsFolded[FIR_COEFFS_FOLDED_LEN] = {
+    -0.00020365859931971167711,
+    -0.00020534815286687269726,
+    -0.00020750176033037726260,
+    -0.00021012037631956283321,
+    -0.00021319903662471212293,
+    -0.00021672669737664450773,
+    -0.00022068609510151509026,
+    -0.00022505362843005770877,
+    -0.00022979926215364830373,
+    -0.00023488645424989164899,
+    -0.00024027210642814768662,
+    -0.00024590653867073892797,
+    -0.00025173348816876021375,
+    -0.00025769013297268373447,
+    -0.00026370714059755645271,
+    -0.00026970874174080279855,
+    -0.00027561282918770678126,
+    -0.00028133108189584986368,
+    -0.00028676911416537141609,
+    -0.00029182664971719136449,
+    -0.00029639772041655876658,
+    -0.00030037088929474201147,
+    -0.00030362949743764215986,
+    -0.00030605193422687278345,
+    -0.00030751193033666963115,
+    -0.00030787887280916823767,
+    -0.00030701814145138336910,
+    -0.00030479146571988795017,
+    -0.00030105730118404599310,
+    -0.00029567122458585908765,
+    -0.00028848634644442410846,
+    -0.00027935374008578901925,
+    -0.00026812288591494918026,
+    -0.00025464212968605439520,
+    -0.00023875915346979392968,
+    -0.00022032145796363610955,
+    -0.00019917685474127628403,
+    -0.00017517396699250889144,
+    -0.00014816273726392078028,
+    -0.00011799494067451189922,
+    -0.00008452470204865435122,
+    -0.00004760901538190323443,
+    -0.00000710826403314813300,
+    0.00003711325998046934450,
+    0.00008518683922143004085,
+    0.00013723881824494437841,
+    0.00019339009683141017600,
+    0.00025375563067884116799,
+    0.00031844394118715329276,
+    0.00038755663595221715757,
+    0.00046118794156844918628,
+    0.00053942425031434893760,
+    0.00062234368226596488947,
+    0.00071001566434873101402,
+    0.00080250052779865996538,
+    0.00089984912545953673127,
+    0.00100210247029364294541,
+    0.00110929139642984651154,
+    0.00122143624401469842733,
+    0.00133854656906969905240,
+    0.00146062087949126880558,
+    0.00158764639825938126856,
+    0.00171959885484657777274,
+    0.00185644230574119823221,
+    0.00199812898491763665451,
+    0.00214459918500223235480,
+    0.00229578116979650909482,
+    0.00245159111872996935896,
+    0.00261193310372292942720,
+    0.00277669909884616615547,
+    0.00294576902306869798515,
+    0.00311901081628824334777,
+    0.00329628054874085653012,
+    0.00347742256378763981567,
+    0.00366226965397703886976,
+    0.00385064327018185947188,
+    0.00404235376351080345769,
+    0.00423720065959537831035,
+    0.00443497296475490934003,
+    0.00463544950344523757485,
+    0.00483839928630086513195,
+    0.00504358190798630257046,
+    0.00525074797398002775933,
+    0.00545963955532470946591,
+    0.00566999067028980431593,
+    0.00588152779180816168147,
+    0.00609397037946668093666,
+    0.00630703143475292229980,
+    0.00652041807818507478112,
+    0.00673383214688179267821,
+    0.00694697081106198169320,
+    0.00715952720790199309553,
+    0.00737119109112002388051,
+    0.00758164949460416685151,
+    0.00779058740835224944332,
+    0.00799768846494838640815,
+    0.00820263563476284277010,
+    0.00840511192802913253974,
+    0.00860480110192465494356,
+    0.00880138837075949628797,
+    0.00899456111736137396695,
+    0.00918400960373433675188,
+    0.00936942767906361571872,
+    0.00955051348313989967309,
+    0.00972697014328275690043,
+    0.00989850646285513405265,
+    0.01006483759947878094121,
+    0.01022568573108404224592,
+    0.01038078070795660050318,
+    0.01052986068897850992221,
+    0.01067267276030083034133,
+    0.01080897353473077651675,
+    0.01093852973016674022533,
+    0.01106111872547019779611,
+    0.01117652909222406794332,
+    0.01128456110089212129088,
+    0.01138502719996389682400,
+    0.01147775246674329584218,
+    0.01156257502851731552851,
+    0.01163934645292291625296,
+    0.01170793210641579012998,
+    0.01176821147983327271735,
+    0.01182007848013561825129,
+    0.01186344168750444287574,
+    0.01189822457707420330641,
+    0.01192436570467189822786,
+    0.01194181885604138869394,
+    0.01195055315913156820939,
+};
+
+const float32_t firFoldedTernarySums[FIR_COEFFS_FOLDED_LEN / 4][81] = {
+    {
+        54.17395085879046234822454,
+        40.40371199668791035719551,
+        26.63347313458536547159383,
+        40.57532299553918875290037,
+        26.80508413343664031458502,
+        13.03484527133409009991283,
+        26.97669513228791871028989,
+        13.20645627018536849561769,
+        -0.56378259191718171905450,
+        40.71645966065996447014186,
+        26.94622079855741603182651,
+        13.17598193645486581715431,
+        27.11783179740869087481769,
+        13.34759293530614243650234,
+        -0.42264592679640777816985,
+        13.51920393415741905585037,
+        -0.25103492794513121433297,
+        -14.02127379004768137349402,
+        27.25896846252946303934550,
+        13.48872960042691282467331,
+        -0.28150926167563738999888,
+        13.66034059927818944402134,
+        -0.10989826282436113147334,
+        -13.88013712492691098532305,
+        0.06171273602691584869717,
+        -13.70852612607563436597502,
+        -27.47876498817818458064721,
+        40.82718455237316135253423,
+        27.05694569027061291421887,
+        13.28670682816806269954668,
+        27.22855668912188775721006,
+        13.45831782701933931889471,
+        -0.31192103508321089577748,
+        13.62992882587061593824274,
+        -0.14031003623193433194061,
+        -13.91054889833448449110165,
+        27.36969335424265992173787,
+        13.59945449214010970706568,
+        -0.17078436996244050760652,
+        13.77106549099138632641370,
+        0.00082662888883652438886,
+        -13.76941223321371410293068,
+        0.17243762774011273108954,
+        -13.59780123436243748358265,
+        -27.36804009646498769825484,
+        13.91220215611215849094151,
+        0.14196329400960822075817,
+        -13.62827556809294193840287,
+        0.31357429286088489561735,
+        -13.45666456924166531905485,
+        -27.22690343134421553372704,
+        -13.28505357039038692334998,
+        -27.05529243249293713802217,
+        -40.82553129459548557633752,
+        27.48041824595586035684391,
+        13.71017938385330836581488,
+        -0.06005947824924184885731,
+        13.88179038270458498516291,
+        0.11155152060203440966824,
+        -13.65868734150051544418147,
+        0.28316251945331138983875,
+        -13.48707634264923882483345,
+        -27.25731520475179081586248,
+        14.02292704782535714969072,
+        0.25268818572280687950737,
+        -13.51755067637974327965367,
+        0.42429918457408355436655,
+        -13.34593967752846666030564,
+        -27.11617853963101509862099,
+        -13.17432867867719004095761,
+        -26.94456754077974025562980,
+        -40.71480640288228869394516,
+        0.56543584969485394253752,
+        -13.20480301240769627213467,
+        -26.97504187451024648680686,
+        -13.03319201355642142914348,
+        -26.80343087565897164381568,
+        -40.57366973776152008213103,
+        -26.63181987680769680082449,
+        -40.40205873891024879185352,
+        -54.17229760101279367745519,
+    },
+    {
+        57.38761142487805955170188,
+        42.63872188571422583436288,
+        27.88983234655039922245123,
+        42.92494818240027143474435,
+        28.17605864323643771740535,
+        13.42716910407260577642319,
+        28.46228493992247621235947,
+        13.71339540075864604773415,
+        -1.03549413840518589324802,
+        43.18442731229966113914998,
+        28.43553777313583097452465,
+        13.68664823397199903354249,
+        28.72176406982187302219245,
+        13.97287453065804108121029,
+        -0.77601500850579085977188,
+        14.25910082734408135252124,
+        -0.48978871181975058846092,
+        -15.23867825098358252944308,
+        28.98124319972126983202543,
+        14.23235366055743611468642,
+        -0.51653587860639582629574,
+        14.51857995724347638599738,
+        -0.23030958192035533294018,
+        -14.97919912108418749596694,
+        0.05591671476568471632618,
+        -14.69297282439814722465599,
+        -29.44186236356198094199499,
+        43.41561255967755528217822,
+        28.66672302051372156483922,
+        13.91783348134988962385705,
+        28.95294931719976005979333,
+        14.20405977803592989516801,
+        -0.54482976112790204581415,
+        14.49028607472197016647897,
+        -0.25860346444186177450320,
+        -15.00749300360569371548536,
+        29.21242844709915686962631,
+        14.46353890793532492864415,
+        -0.28535063122850701233801,
+        14.74976520462136519995511,
+        0.00087566545753292937548,
+        -14.74801387370629868200922,
+        0.28710196214357353028390,
+        -14.46178757702025841069826,
+        -29.21067711618409035168042,
+        15.00924433452075845707441,
+        0.26035479535692651609224,
+        -14.48853474380690542488992,
+        0.54658109204296678740320,
+        -14.20230844712086515357896,
+        -28.95119798628469709456112,
+        -13.91608215043482310591116,
+        -28.66497168959865504689333,
+        -43.41386122876248521151865,
+        29.44361369447704390722720,
+        14.69472415531321374260187,
+        -0.05416538385061819838029,
+        14.98095045199925401391283,
+        0.23206091283542229497527,
+        -14.51682862632840986805149,
+        0.51828720952146234424163,
+        -14.23060232964236959674054,
+        -28.97949186880619976136586,
+        15.24042958189864727103213,
+        0.49154004273481533004997,
+        -14.25734949642901661093219,
+        0.77776633942085560136093,
+        -13.97112319974297633962124,
+        -28.72001273890681005696024,
+        -13.68489690305693606831028,
+        -28.43378644222076800929244,
+        -43.18267598138459817391777,
+        1.03724546932024885848023,
+        -13.71164406984358308250194,
+        -28.46053360900741324712726,
+        -13.42541777315754281119098,
+        -28.17430731232137475217314,
+        -42.92319685148520846951214,
+        -27.88808101563533625721902,
+        -42.63697055479916997455803,
+        -57.38586009396299658646967,
+    },
+    {
+        62.31584679542302751542593,
+        46.20036178363615420039423,
+        30.08487677184927733264885,
+        46.56961430065436502445664,
+        30.45412928886749170942494,
+        14.33864427708061839439324,
+        30.82338180588570963891470,
+        14.70789679409883454752617,
+        -1.40758821768804054386237,
+        46.92256301615637426039029,
+        30.80707800436950094535860,
+        14.69159299258262763032690,
+        31.17633052138771887484836,
+        15.06084550960084378345982,
+        -1.05463950218603130792872,
+        15.43009802661905993659275,
+        -0.68538698516781570990730,
+        -16.80087199695469024618433,
+        31.52927923688972811078202,
+        15.41379422510285479575032,
+        -0.70169078668402029563822,
+        15.78304674212107094888324,
+        -0.33243826966580442006105,
+        -16.44792328145267745753699,
+        0.03681424735241023427079,
+        -16.07867076443446663347459,
+        -32.19415577622133639579260,
+        47.25595215018368833170825,
+        31.14046713839681146396288,
+        15.02498212660993814893118,
+        31.50971965541502584073896,
+        15.39423464362815252570726,
+        -0.72125036815872256568127,
+        15.76348716064636867884019,
+        -0.35199785114050696765986,
+        -16.46748286292738328029372,
+        31.86266837091703507667262,
+        15.74718335913016176164092,
+        -0.36830165265671332974762,
+        16.11643587614837969113069,
+        0.00095086436150242656731,
+        -16.11453414742537049164639,
+        0.37020338137971897651823,
+        -15.74528163040715611487030,
+        -31.86076664219402942990200,
+        16.46938459165038892706434,
+        0.35389957986351328056429,
+        -15.76158543192336125571273,
+        0.72315209688172998880873,
+        -15.39233291490514510257981,
+        -31.50781792669202019396835,
+        -15.02308039788692894944688,
+        -31.13856540967380581719226,
+        -47.25405042146067557951028,
+        32.19605750494434204256322,
+        16.08057249315746517481784,
+        -0.03491251862940814021385,
+        16.44982501017568665702129,
+        0.33433999838880951172015,
+        -15.78114501339806530211263,
+        0.70359251540702594240884,
+        -15.41189249637984914897970,
+        -31.52737750816672246401140,
+        16.80277372567769589295494,
+        0.68728871389081847009805,
+        -15.42819629789605606617897,
+        1.05654123090903517834249,
+        -15.05894378087783991304605,
+        -31.17442879266471322807774,
+        -14.68969126385962198355628,
+        -30.80517627564649885130166,
+        -46.92066128743337571904704,
+        1.40948994641104619063299,
+        -14.70599506537582890075555,
+        -30.82148007716270399214409,
+        -14.33674254835761274762262,
+        -30.45222756014448961536800,
+        -46.56771257193136648311338,
+        -30.08297504312627523859192,
+        -46.19846005491314855362361,
+        -62.31394506670002897408267,
+    },
+    {
+        68.34352970005238603334874,
+        50.66816731006887408739203,
+        32.99280492008536214143533,
+        51.06148224099152344024333,
+        33.38611985100801149428662,
+        15.71075746102449954832991,
+        33.77943478193066084713791,
+        16.10407239194714890118121,
+        -1.57128999803636304477550,
+        51.45580683568755375745241,
+        33.78044444570404181149570,
+        16.10508205572052986553899,
+        34.17375937662669116434699,
+        16.49839698664317921839029,
+        -1.17696540334033272756642,
+        16.89171191756582857124158,
+        -0.78365047241768281960361,
+        -18.45901286240119532067183,
+        34.56808397132272148155607,
+        16.89272158133921308831304,
+        -0.78264080864429885764366,
+        17.28603651226186244116434,
+        -0.38932587772164850559165,
+        -18.06468826770516145074907,
+        0.00398905320099984805893,
+        -17.67137333678251209789778,
+        -35.34673572676602759656816,
+        51.84617555291268331529864,
+        34.17081316292917136934193,
+        16.49545077294565942338522,
+        34.56412809385182072219322,
+        16.88876570386830877623652,
+        -0.78659668611520316972019,
+        17.28208063479095812908781,
+        -0.39328175519255326175738,
+        -18.06864414517606576282560,
+        34.95845268854785103940230,
+        17.28309029856434264615928,
+        -0.39227209141916929979743,
+        17.67640522948699199901057,
+        0.00104283950347980325368,
+        -17.67431955048003189290284,
+        0.39435777042612940590516,
+        -17.28100461955738254005155,
+        -34.95636700954089803872193,
+        18.07072982418302586893333,
+        0.39536743419951447808813,
+        -17.27999495578399802298009,
+        0.78868236512216327582792,
+        -16.88668002486134867012879,
+        -34.56204241484486061608550,
+        -16.49336509393869931727750,
+        -34.16872748392221126323420,
+        -51.84408987390572320919091,
+        35.34882140577298059724853,
+        17.67345901578946865129183,
+        -0.00190337419404329466488,
+        18.06677394671211800414312,
+        0.39141155672860705738714,
+        -17.28395083325490588777029,
+        0.78472648765125541103771,
+        -16.89063590233225653491900,
+        -34.56599829231576848087570,
+        18.46109854140815187406588,
+        0.78573615142464048322068,
+        -16.88962623855887201784753,
+        1.17905108234728928096047,
+        -16.49631130763622266499624,
+        -34.17167369761973816366663,
+        -16.10299637671356975943127,
+        -33.77835876669708170538797,
+        -51.45372115668059365134468,
+        1.57337567704332315088323,
+        -16.10198671294018879507348,
+        -33.77734910292370074103019,
+        -15.70867178201753944222219,
+        -33.38403417200105138817889,
+        -51.05939656198456333413560,
+        -32.99071924107840203532760,
+        -50.66608163106191398128431,
+        -68.34144402104541882181366,
+    },
+    {
+        74.41872813857959556571586,
+        55.29386864936346057675109,
+        36.16900916014732558778633,
+        55.62531424175199390447233,
+        36.50045475253585181008020,
+        17.37559526331971682111543,
+        36.83190034492437092694672,
+        17.70704085570823593798195,
+        -1.41781863350790260369649,
+        55.98169568653507610633824,
+        36.85683619731894111737347,
+        17.73197670810280612840870,
+        37.18828178970746733966735,
+        18.06342230049133235070258,
+        -1.06143718872480619097587,
+        18.39486789287985146756910,
+        -0.72999159633628463161870,
+        -19.85485108555242206307412,
+        37.54466323449055664696061,
+        18.41980374527442521070952,
+        -0.70505574394171333096892,
+        18.75124933766294432757604,
+        -0.37361015155319166058945,
+        -19.49846964076932920306717,
+        -0.04216455916467154452221,
+        -19.16702404838080653348698,
+        -38.29188353759694507516542,
+        56.35644137776323248090193,
+        37.23158188854709749193717,
+        18.10672239933096250297240,
+        37.56302748093562371423104,
+        18.43816799171948872526627,
+        -0.68669149749664981641217,
+        18.76961358410800784213279,
+        -0.35524590510812825705500,
+        -19.48010539432426568851042,
+        37.91940892571871302152431,
+        18.79454943650258158527322,
+        -0.33031005271355695640523,
+        19.12599502889110070213974,
+        0.00113553967496611931710,
+        -19.12372394954117282850348,
+        0.33258113206348483004149,
+        -18.79227835715265015892328,
+        -37.91713784636878870060173,
+        19.48237647367419711486036,
+        0.35751698445806101567257,
+        -18.76734250475807641578285,
+        0.68896257684658124276211,
+        -18.43589691236955374620266,
+        -37.56075640158569228788110,
+        -18.10445131998103462933614,
+        -37.22931080919717317101458,
+        -56.35417029841330815997935,
+        38.29415461694687650151536,
+        19.16929512773074151255059,
+        0.04443563851460297087215,
+        19.50074072011926062941711,
+        0.37588123090312464125162,
+        -18.74897825831301290122610,
+        0.70732682329164475731886,
+        -18.41753266592449023164590,
+        -37.54239215514063232603803,
+        19.85712216490235704213774,
+        0.73226267568622094294994,
+        -18.39259681352991648850548,
+        1.06370826807474117003949,
+        -18.06115122114139381892528,
+        -37.18601071035753591331741,
+        -17.72970562875287825477244,
+        -36.85456511796901679645089,
+        -55.97942460718515178541566,
+        1.42008971285783047733275,
+        -17.70476977635830451163201,
+        -36.82962926557443950059678,
+        -17.37332418396978184205182,
+        -36.49818367318592038373026,
+        -55.62304316240205537269503,
+        -36.16673808079740126686374,
+        -55.29159757001353625582851,
+        -74.41645705922967124479328,
+    },
+    {
+        79.06590991160545911498048,
+        59.00879640204734499775441,
+        38.95168289248924509138305,
+        59.16755079702957687004528,
+        39.11043728747146985824656,
+        19.05332377791336639916153,
+        39.26919168245370173053743,
+        19.21207817289559471873872,
+        -0.84503533666251229305999,
+        59.38110368167454566901142,
+        39.32399017211643155178535,
+        19.26687666255832809270032,
+        39.48274456709866342407622,
+        19.42563105754055641227751,
+        -0.63148245201755059952120,
+        19.58438545252278473185470,
+        -0.47272805703532311261128,
+        -20.52984156659342929174272,
+        39.69629745174362511761501,
+        19.63918394218551810581630,
+        -0.41792956737258890598241,
+        19.79793833716774642539349,
+        -0.25917517239036169662825,
+        -20.31628868194846759820393,
+        -0.10042077740813226682803,
+        -20.15753428696623927862674,
+        -40.21464779652434629042546,
+        59.64148530410628268327855,
+        39.58437179454816856605248,
+        19.52725828499006510696745,
+        39.74312618953040043834335,
+        19.68601267997229342654464,
+        -0.37110082958581358525407,
+        19.84476707495452174612183,
+        -0.21234643460358612609973,
+        -20.26945994416169227747559,
+        39.95667907417536213188214,
+        19.89956556461725512008343,
+        -0.15754794494085189171528,
+        20.05831995959948343966062,
+        0.00120645004137581572136,
+        -20.05590705951673058393681,
+        0.15996084502360474743909,
+        -19.89715266453450226435962,
+        -39.95426617409260927615833,
+        20.27187284424444513319941,
+        0.21475933468633726097785,
+        -19.84235417487176889039802,
+        0.37351372966856644097788,
+        -19.68359977988954057082083,
+        -39.74071328944764758261954,
+        -19.52484538490731225124364,
+        -39.58195889446542281575603,
+        -59.63907240402352272212738,
+        40.21706069660710625157662,
+        20.15994718704899568706423,
+        0.10283367749088867526552,
+        20.31870158203122400664142,
+        0.26158807247311588461969,
+        -19.79552543708499001695600,
+        0.42034246745534531441990,
+        -19.63677104210276169737881,
+        -39.69388455166087226189120,
+        20.53225446667618570018021,
+        0.47514095711807785571423,
+        -19.58197255244002832341721,
+        0.63389535210030700795869,
+        -19.42321815745780000384002,
+        -39.48033166701590346292505,
+        -19.26446376247557523697651,
+        -39.32157727203368580148890,
+        -59.37869078159178570786025,
+        0.84744823674527225421116,
+        -19.20966527281283475758755,
+        -39.26677878237094176938626,
+        -19.05091087783060643801036,
+        -39.10802438738871700252275,
+        -59.16513789694681690889411,
+        -38.94926999240648513023189,
+        -59.00638350196459924745795,
+        -79.06349701152269915382931,
+    },
+    {
+        80.42580609054206774999329,
+        60.45129738458921053734230,
+        40.47678867863635332469130,
+        60.30537219052565944821254,
+        40.33086348457280223556154,
+        20.35635477861994147019686,
+        40.18493829050925114643178,
+        20.21042958455639393378078,
+        0.23592087860353672112979,
+        60.24896416099322493664658,
+        40.27445545504037482942294,
+        20.29994674908751406405827,
+        40.12853026097681663486583,
+        20.15402155502396297492851,
+        0.17951284907110576227751,
+        20.00809636096041188579875,
+        0.03358765500755506866470,
+        -19.94092105094530253950325,
+        40.07212223144438212329987,
+        20.09761352549152846336256,
+        0.12310481953867125071156,
+        19.95168833142797737423280,
+        -0.02282037452488023046571,
+        -19.99732908047773705106920,
+        -0.16874556858843092754796,
+        -20.14325427454128814019896,
+        -40.11776298049414890556363,
+        60.27301173592842076232046,
+        40.29850302997557065509682,
+        20.32399432402270988973214,
+        40.15257783591201246053970,
+        20.17806912995915880060238,
+        0.20356042400630158795138,
+        20.03214393589560771147262,
+        0.05763522994275089433858,
+        -19.91687347601010671382937,
+        40.09616980637957794897375,
+        20.12166110042672428903643,
+        0.14715239447386707638543,
+        19.97573590636317319990667,
+        0.00122720041031710918808,
+        -19.97328150554254122539533,
+        -0.14469799365323510187409,
+        -20.11920669960609231452509,
+        -40.09371540555895307988976,
+        19.91932787683074224105439,
+        -0.05518082912211457607965,
+        -20.02968953507497218424760,
+        -0.20110602318566606072636,
+        -20.17561472913852327337736,
+        -40.15012343509138048602836,
+        -20.32153992320207080979344,
+        -40.29604862915492446973076,
+        -60.27055733510778168238176,
+        40.12021738131478088007498,
+        20.14570867536192366742398,
+        0.17119996940906645477298,
+        19.99978348129837257829422,
+        0.02527477534551497359572,
+        -19.94923393060734184700777,
+        -0.12065041871803572348654,
+        -20.09515912467089293613753,
+        -40.06966783062375014878853,
+        19.94337545176594161944195,
+        -0.03113325418691519422265,
+        -20.00564196013977280586005,
+        -0.17705844825046668233881,
+        -20.15156715420332389498981,
+        -40.12607586015617755492713,
+        -20.29749234826687498411957,
+        -40.27200105421972864405689,
+        -60.24650976017258585670788,
+        -0.23346647778290474661844,
+        -20.20797518373576195926944,
+        -40.18248388968861917192044,
+        -20.35390037779931660111288,
+        -40.32840908375217026105020,
+        -60.30291778970503457912855,
+        -40.47433427781571424475260,
+        -60.44884298376857145740360,
+        -80.42335168972142867005459,
+    },
+    {
+        76.32116857570055401538411,
+        58.01372121917836466309382,
+        39.70627386265618241623088,
+        57.41521586146521372029383,
+        39.10776850494302436800353,
+        20.80032114842084212114059,
+        38.50926314722988053063091,
+        20.20181579070769828376797,
+        1.89436843418551248419135,
+        56.94435487246627758395334,
+        38.63690751594408823166305,
+        20.32946015942190598480011,
+        38.03840215823093728886306,
+        19.73095480170875504200012,
+        1.42350744518656924242350,
+        19.13244944399560409920014,
+        0.82500208747342074211417,
+        -17.48244526904876394723942,
+        37.56754116923200115252257,
+        19.26009381270981535294595,
+        0.95264645618762955336933,
+        18.66158845499666441014597,
+        0.35414109847448027590389,
+        -17.95330625804770363629359,
+        -0.24436425923866877951696,
+        -18.55181161576085102637990,
+        -36.85925897228303682595651,
+        56.59137834260408794762043,
+        38.28393098608190570075749,
+        19.97648362955972345389455,
+        37.68542562836876186338486,
+        19.37797827184657606380824,
+        1.07053091532439026423162,
+        18.77947291413342512100826,
+        0.47202555761124176392229,
+        -17.83542179891094292543130,
+        37.21456463936981862161701,
+        18.90711728284763637475407,
+        0.59966992632545057517746,
+        18.30861192513448187924041,
+        0.00116456861230011831689,
+        -18.30628278790988616719915,
+        -0.59734078910084775770883,
+        -18.90478814562303000457177,
+        -37.21223550214521935686207,
+        17.83775093613554219018624,
+        -0.46969642038664116689972,
+        -18.77714377690882585625332,
+        -1.06820177809979099947668,
+        -19.37564913462197324633962,
+        -37.68309649114415549320256,
+        -19.97415449233512063642593,
+        -38.28160184885730643600255,
+        -56.58904920537948868286549,
+        36.86158810950763609071146,
+        18.55414075298545739656220,
+        0.24669339646327159698558,
+        17.95563539527230645376221,
+        -0.35181196124987768047987,
+        -18.65925931777206159267735,
+        -0.95031731896302673590071,
+        -19.25776467548520898276365,
+        -37.56521203200739478234027,
+        17.48477440627336321199436,
+        -0.82267295024882014509160,
+        -19.13012030677100483444519,
+        -1.42117830796196997766856,
+        -19.72862566448415222453150,
+        -38.03607302100633802410812,
+        -20.32713102219730316733148,
+        -38.63457837871948896690810,
+        -56.94202573524167121377104,
+        -1.89203929696090966672273,
+        -20.19948665348309191358567,
+        -38.50693401000528126587596,
+        -20.79799201119624640909933,
+        -39.10543936771843220867595,
+        -57.41288672424061445553889,
+        -39.70394472543156894062122,
+        -58.01139208195375829291152,
+        -76.31883943847594764520181,
+    },
+    {
+        64.34623501332863781954075,
+        49.90746826568175009697370,
+        35.46870151803485526897930,
+        48.69915389068569311348256,
+        34.26038714303880539091551,
+        19.82162039539191056292111,
+        33.05207276804274840742437,
+        18.61330602039585713214365,
+        4.17453927274896585686292,
+        47.65826304435306326467980,
+        33.21949629670617554211276,
+        18.78072954905928071411836,
+        32.01118192171011855862162,
+        17.57241517406322728334089,
+        3.13364842641633600806017,
+        16.36410079906717385256343,
+        1.92533405142028324341652,
+        -12.51343269622660869799802,
+        30.97029107537748870981886,
+        16.53152432773059743453814,
+        2.09275758008370615925742,
+        15.32320995273454755647435,
+        0.88444320508765472688140,
+        -13.55432354255923677044393,
+        -0.32387116990839892594067,
+        -14.76263791755529197757824,
+        -29.20140466520218325285896,
+        46.77480168489244505281022,
+        32.33603493724555733024317,
+        17.89726818959866250224877,
+        31.12772056224950034675203,
+        16.68895381460260907147131,
+        2.25018706695571779619058,
+        15.48063943960655741705068,
+        1.04187269195966503154693,
+        -13.39689405568722690986760,
+        30.08682971591687049794928,
+        15.64806296826997922266855,
+        1.20929622062308794738783,
+        14.43974859327392756824793,
+        0.00098184562703443356048,
+        -14.43778490201985675867036,
+        -1.20733252936901891416710,
+        -15.64609927701591196580466,
+        -30.08486602466280146472855,
+        13.39885774694129949580201,
+        -1.03990900070559288970173,
+        -15.47867574835248483111627,
+        -2.24822337570164698661301,
+        -16.68699012334854003825058,
+        -31.12575687099543131353130,
+        -17.89530449834459346902804,
+        -32.33407124599148119159508,
+        -46.77283799363837601958949,
+        29.20336835645625228607969,
+        14.76460160880935923444213,
+        0.32583486116246795916140,
+        13.55628723381330758002150,
+        -0.88247951383358524957146,
+        -15.32124626148047674689678,
+        -2.09079388882963890239353,
+        -16.52956063647653195403109,
+        -30.96832738412342322931181,
+        12.51539638748067773121875,
+        -1.92337036016621465428500,
+        -16.36213710781310481934270,
+        -3.13168473516226875119628,
+        -17.57045148280916180283384,
+        -32.00921823045605663082824,
+        -18.77876585780521168089763,
+        -33.21753260545209940346467,
+        -47.65629935309899423145907,
+        -4.17257558149490215271271,
+        -18.61134232914179520435027,
+        -33.05010907678868647963100,
+        -19.81965670413784863512774,
+        -34.25842345178473635769478,
+        -48.69719019943163118568918,
+        -35.46673782678079334118593,
+        -49.90550457442768106375297,
+        -64.34427132207457589174737,
+    },
+    {
+        41.97636503451846579082485,
+        34.24356659741432906685077,
+        26.51076816031019234287669,
+        32.26652004792742189920318,
+        24.53372161082328162251542,
+        16.80092317371914489854134,
+        22.55667506133637090215416,
+        14.82387662423223417818008,
+        7.09107818712809656602758,
+        30.49633910766439726103272,
+        22.76354067056026053705864,
+        15.03074223345612381308456,
+        20.78649412107334981669737,
+        13.05369568396921309272329,
+        5.32089724686507548057079,
+        11.07664913448230237236203,
+        3.34385069737816520429874,
+        -4.38894773972597196376455,
+        19.01631318081032873124059,
+        11.28351474370619200726651,
+        3.55071630660205439511401,
+        9.30646819421928128690524,
+        1.57366975711514300861893,
+        -6.15912867998899393739975,
+        -0.40337679237176793378694,
+        -8.13617522947590465776102,
+        -15.86897366658004315809194,
+        28.92330985904892770577135,
+        21.19051142194479098179727,
+        13.45771298484065425782319,
+        19.21346487245787670872232,
+        11.48066643535374176110508,
+        3.74786799824960414895259,
+        9.50361988586683104074382,
+        1.77082144876269365063592,
+        -5.96197698834144329538276,
+        17.44328393219485917597922,
+        9.71048549509072067564830,
+        1.97768705798658306349580,
+        7.73343894560380995528703,
+        0.00064050849967221780076,
+        -7.73215792860446438083954,
+        -1.97640604098723926540515,
+        -9.70920447809137598937923,
+        -17.44200291519551271335331,
+        5.96325800534078709347341,
+        -1.76954043176335029663448,
+        -9.50233886886748635447475,
+        -3.74658698125026212721878,
+        -11.47938541835439885119285,
+        -19.21218385545853735152377,
+        -13.45643196784130957155412,
+        -21.18923040494544807188504,
+        -28.92202884204958479585912,
+        15.87025468357938606800417,
+        8.13745624647524934403009,
+        0.40465780937111173187759,
+        6.16040969698833773549040,
+        -1.57238874011579965461749,
+        -9.30518717721993660063617,
+        -3.54943528960271059702336,
+        -11.28223372670684732099744,
+        -19.01503216381098582132836,
+        4.39022875672531576185520,
+        -3.34256968037882140620809,
+        -11.07536811748295946244980,
+        -5.31961622986573345883698,
+        -13.05241466696987018281106,
+        -20.78521310407400690678514,
+        -15.02946121645677912681549,
+        -22.76225965356091762714641,
+        -30.49505809066505435112049,
+        -7.08979717012875276793693,
+        -14.82259560723288949191101,
+        -22.55539404433702799224193,
+        -16.79964215671979843591544,
+        -24.53244059382393871260319,
+        -32.26523903092807188386359,
+        -26.50948714331084943296446,
+        -34.24228558041498615693854,
+        -41.97508401751912288091262,
+    },
+    {
+        6.69310789112537829481653,
+        9.12532538394543735194020,
+        11.55754287676549552088545,
+        6.22726780771301502426240,
+        8.65948530053307408138608,
+        11.09170279335313225033133,
+        5.76142772430065353006512,
+        8.19364521712071258718879,
+        10.62586270994077075613404,
+        3.57305106807234995613953,
+        6.00526856089240812508478,
+        8.43748605371246718220846,
+        3.10721098465998757376383,
+        5.53942847748004574270908,
+        7.97164597030010391165433,
+        2.64137090124762430320970,
+        5.07358839406768247215496,
+        7.50580588688774064110021,
+        0.45299424501932206155175,
+        2.88521173783938067458621,
+        5.31742923065943884353146,
+        -0.01284583839304120900238,
+        2.41937165442701740403209,
+        4.85158914724707557297734,
+        -0.47868592180540403546729,
+        1.95353157101465435552257,
+        4.38574906383471230242321,
+        1.15378154236681629285499,
+        3.58599903518687490588945,
+        6.01821652800693307483471,
+        0.68794145895445302230087,
+        3.12015895177451163533533,
+        5.55237644459456980428058,
+        0.22210137554209019583595,
+        2.65431886836214880887042,
+        5.08653636118220653372646,
+        -1.96627528068621248991121,
+        0.46594221213384612312325,
+        2.89815970495390429206850,
+        -2.43211536409857531637613,
+        0.00010212872148323636314,
+        2.43231962154154146560359,
+        -2.89795544751093814284104,
+        -0.46573795469087969634003,
+        1.96647953812917863913867,
+        -5.08633210373924082858821,
+        -2.65411461091918221555375,
+        -0.22189711809912404660849,
+        -5.55217218715160409914233,
+        -3.11995469433154548610787,
+        -0.68773720151148731716262,
+        -6.01801227056396648151804,
+        -3.58579477774390831257278,
+        -1.15357728492385014362753,
+        -4.38554480639174659728496,
+        -1.95332731357168842833971,
+        0.47889017924836996265014,
+        -4.85138488980410986783909,
+        -2.41916739698405125480463,
+        0.01305009583600691414063,
+        -5.31722497321647225021479,
+        -2.88500748039641408126954,
+        -0.45278998757635591232429,
+        -7.50560162944477582414038,
+        -5.07338413662471765519513,
+        -2.64116664380465904216067,
+        -7.97144171285713820651608,
+        -5.53922422003708003757083,
+        -3.10700672721702142453637,
+        -8.43728179626950236524863,
+        -6.00506430344944330812496,
+        -3.57284681062938469509049,
+        -10.62565845249780593917421,
+        -8.19344095967774599387212,
+        -5.76122346685768782492687,
+        -11.09149853591016920972834,
+        -8.65928104309010926442625,
+        -6.22706355027005109548099,
+        -11.55733861932252892756878,
+        -9.12512112650247075862353,
+        -6.69290363368241258967828,
+    },
+    {
+        -43.88103028582814602032158,
+        -27.25115502929029176470976,
+        -10.62127977275243395638427,
+        -31.20721028998168122825518,
+        -14.57733503344382341992969,
+        2.05254022309403261203897,
+        -18.53339029413521643618878,
+        -1.90351503759735862786329,
+        14.72636021894049740410537,
+        -34.88708433214571869029896,
+        -18.25720907560786088197347,
+        -1.62733381907000307364797,
+        -22.21326433629925034551889,
+        -5.58338907976139431355023,
+        11.04648617677646171841843,
+        -9.53944434045278555345249,
+        7.09043091608507136669459,
+        23.72030617262292651048483,
+        -25.89313837846328425484899,
+        -9.26326312192542999923717,
+        7.36661213461242603273149,
+        -13.21931838261681946278259,
+        3.41055687392103568100765,
+        20.04043213045889260115473,
+        -0.54549838677035467071619,
+        16.08437686976749958489563,
+        32.71425212630535384050745,
+        -38.29831077745173217863339,
+        -21.66843552091387437030789,
+        -5.03856026437601656198240,
+        -25.62449078160526028113964,
+        -8.99461552506740602552782,
+        7.63525973147045000644084,
+        -12.95067078575879726543008,
+        3.67920447077905876653858,
+        20.30907972731691302215040,
+        -29.30436482376929774318342,
+        -12.67448956723144171121476,
+        3.95538568930641432075390,
+        -16.63054482792283295111702,
+        -0.00066957138497662576325,
+        16.62920568515287911282030,
+        -3.95672483207636638269378,
+        12.67315042446148964927488,
+        29.30302568099934745760038,
+        -20.31041887008687041316080,
+        -3.68054361354901260483530,
+        12.94933164298884342713336,
+        -7.63659887424040206838072,
+        8.99327638229745396358794,
+        25.62315163883530999555660,
+        5.03722112160606272368568,
+        21.66709637814391697929750,
+        38.29697163468177478762300,
+        -32.71559126907531123151784,
+        -16.08571601253745697590603,
+        0.54415924400040083241947,
+        -20.04177127322884643945144,
+        -3.41189601669098863112595,
+        13.21797923984686740084271,
+        -7.36795127738237809467137,
+        9.26192397915547793729729,
+        25.89179923569333396926595,
+        -23.72164531539288034878155,
+        -7.09177005885502431681289,
+        9.53810519768283171515577,
+        -11.04782531954641555671515,
+        5.58204993699144136343193,
+        22.21192519352929650722217,
+        1.62599467630004923535125,
+        18.25586993283790349096307,
+        34.88574518937576129928857,
+        -14.72769936171044946604525,
+        1.90217589482740656592341,
+        18.53205115136526259789207,
+        -2.05387936586398289762201,
+        14.57599589067387313434665,
+        31.20587114721173094267215,
+        10.61994062998248367080123,
+        27.24981588652033792641305,
+        43.87969114305819573473855,
+    },
+    {
+        -111.84457443063683967920952,
+        -76.49340618628598065242841,
+        -41.14223794193511452021994,
+        -81.62062267994852504671144,
+        -46.26945443559765891450297,
+        -10.91828619124679988772186,
+        -51.39667092926019620335865,
+        -16.04550268490934072929122,
+        19.30566555944151829748989,
+        -86.44605029350827862799633,
+        -51.09488204915742670664258,
+        -15.74371380480656767986147,
+        -56.22209854281997110092561,
+        -20.87093029846911207414450,
+        14.48023794588174695263660,
+        -25.99814679213165291571386,
+        9.35302145221920433471041,
+        44.70418969657006869056204,
+        -61.04752615637973178763787,
+        -25.69635791202887631357044,
+        9.65481033232198271321067,
+        -30.82357440569141715513979,
+        4.52759383865943920710606,
+        39.87876208301030089842243,
+        -0.59962265500309541721435,
+        34.75154558934776360956675,
+        70.10271383369862974177522,
+        -90.97535074493674756013206,
+        -55.62418250058588853335095,
+        -20.27301425623502950656984,
+        -60.75139899424843292763398,
+        -25.40023074989757034813920,
+        9.95093749445328867864191,
+        -30.52744724356011118970855,
+        4.82372100079074606071572,
+        40.17488924514160686385367,
+        -65.57682660780820071977359,
+        -30.22565836345733814027881,
+        5.12550988089352088650230,
+        -35.35287485711987898184816,
+        -0.00170661276902216857421,
+        35.34946163158183907171406,
+        -5.12892310643156079663640,
+        30.22224513791929823014470,
+        65.57341338227016080963949,
+        -40.17830247067963966856041,
+        -4.82713422632878597084982,
+        30.52403401802207483228813,
+        -9.95435071999132503606234,
+        25.39681752435953399071877,
+        60.74798576871039301749988,
+        20.26960103069699670186310,
+        55.62076927504785572864421,
+        90.97193751939872186085267,
+        -70.10612705923665544105461,
+        -34.75495881488580351970086,
+        0.59620942946505550708025,
+        -39.88217530854834080855653,
+        -4.53100706419748444631068,
+        30.82016118015337724500569,
+        -9.65822355786002262334478,
+        25.69294468649083640343633,
+        61.04411293084169187750376,
+        -44.70760292210810860069614,
+        -9.35643467775725135027187,
+        25.99473356659360945286608,
+        -14.48365117141979041548439,
+        20.86751707293106861129672,
+        56.21868531728192408536415,
+        15.74030057926852776972737,
+        51.09146882361938679650848,
+        86.44263706797025292871695,
+        -19.30907878497955820762400,
+        16.04208945937130081915711,
+        51.39325770372215629322454,
+        10.91487296570875997758776,
+        46.26604121005961900436887,
+        81.61720945441047092572262,
+        41.13882471639707461008584,
+        76.48999296074792653143959,
+        111.84116120509878555822070,
+    },
+    {
+        -198.88268901566988233753364,
+        -139.91107657867914326743630,
+        -80.93946414168840419733897,
+        -146.29081692638470713063725,
+        -87.31920448939396806053992,
+        -28.34759205240322899044259,
+        -93.69894483709953192374087,
+        -34.72733240010878574821618,
+        24.24428003688195332188116,
+        -152.35181245257581394980662,
+        -93.38020001558506066885457,
+        -34.40858757859432159875723,
+        -99.75994036329061032120080,
+        -40.78832792629987835653083,
+        18.18328451069086071356651,
+        -47.16806827400543511430442,
+        11.80354416298530395579292,
+        70.77515659997604302589025,
+        -105.82093588948171714037016,
+        -46.84932345249097807027283,
+        12.12228898449976099982450,
+        -53.22906380019653482804642,
+        5.74254863679420335387249,
+        64.71416107378493620672089,
+        -0.63719171091135251572268,
+        58.33442072607938655437465,
+        117.30603316307012562447198,
+        -158.09739579836988809802278,
+        -99.12578336137914902792545,
+        -40.15417092438840995782812,
+        -105.50552370908469868027169,
+        -46.53391127209395961017435,
+        12.43770116489677945992298,
+        -52.91365161979951636794794,
+        6.05796081719122359032781,
+        65.02957325418196887767408,
+        -111.56651923527579128858633,
+        -52.59490679828505221848900,
+        6.37670563870568685160833,
+        -58.97464714599061608168995,
+        -0.00303470899987289249172,
+        58.96857772799086205850472,
+        -6.38277505670542666393885,
+        52.58883738028531240615848,
+        111.56044981727605147625582,
+        -65.03564267218170869000460,
+        -6.06403023519096873172884,
+        52.90758220179976945019007,
+        -12.44377058289652637768086,
+        46.52784185409421269241648,
+        105.49945429108495886794117,
+        40.14810150638865593464288,
+        99.11971394337939500474022,
+        158.09132638037013407483755,
+        -117.31210258106986543680250,
+        -58.34049014407913347213253,
+        0.63112229291160559796481,
+        -64.72023049178469022990612,
+        -5.74861805479395204798720,
+        53.22299438219678791028855,
+        -12.12835840249950791758238,
+        46.84325403449123115251496,
+        105.81486647148196311718493,
+        -70.78122601797578283822077,
+        -11.80961358098504376812343,
+        47.16199885600569530197390,
+        -18.18935392869060052589703,
+        40.78225850830013854420031,
+        99.75387094529088471972500,
+        34.40251816059458178642672,
+        93.37413059758532085652405,
+        152.34574303457605992662138,
+        -24.25034945488169313421167,
+        34.72126298210904593588566,
+        93.69287541909977790055564,
+        28.34152263440348917811207,
+        87.31313507139422824820940,
+        146.28474750838495310745202,
+        80.93339472368867859586317,
+        139.90500716067941766596050,
+        198.87661959767015673605783,
+    },
+    {
+        -306.14334208788966407155385,
+        -218.42169268390694014669862,
+        -130.70004327992421622184338,
+        -226.09651783638639699347550,
+        -138.37486843240367306862026,
+        -50.65321902842096335461974,
+        -146.04969358488315833710658,
+        -58.32804418090043441225134,
+        29.39360522308228951260389,
+        -233.44593042285970341254142,
+        -145.72428101887695106597675,
+        -58.00263161489424135197623,
+        -153.39910617135643633446307,
+        -65.67745676737369819875312,
+        22.04419263660902572610212,
+        -73.35228191985316925638472,
+        14.36936748412955822118420,
+        102.09101688811227859332575,
+        -160.74851875782968591011013,
+        -73.02686935384697619610961,
+        14.69478005013574772874563,
+        -80.70169450632643304288649,
+        7.01995489765628910561190,
+        94.74160430163901480682398,
+        -0.65487025482318017566286,
+        87.06677914915954374919238,
+        174.78842855314226767404762,
+        -240.47055669719577508658404,
+        -152.74890729321305116172880,
+        -65.02725788923034144772828,
+        -160.42373244569250800850568,
+        -72.70208304170979829450516,
+        15.01956636227292563035007,
+        -80.37690819418926935213676,
+        7.34474120979345812543215,
+        95.06639061377617849757371,
+        -167.77314503216581442757160,
+        -80.05149562818307629186165,
+        7.67015377579964763299358,
+        -87.72632078066253313863854,
+        -0.00467137667980788671984,
+        87.71697802730291471107194,
+        -7.67949652915928027141490,
+        80.04215287482344365344034,
+        167.76380227880616757829557,
+        -95.07573336713581113599503,
+        -7.35408396315308365842611,
+        80.36756544082963671371544,
+        -15.02890911563254405791668,
+        72.69274028835017986693856,
+        160.41438969233291800264851,
+        65.01791513587072302016168,
+        152.73956453985346115587163,
+        240.46121394383618508072686,
+        -174.79777130650188610161422,
+        -87.07612190251917638761370,
+        0.64552750146354753724154,
+        -94.75094705499863323439058,
+        -7.02929765101591108589218,
+        80.69235175296681461531989,
+        -14.70412280349538036716694,
+        73.01752660048734355768829,
+        160.73917600447006748254353,
+        -102.10035964147191123174707,
+        -14.37871023748918375417816,
+        73.34293916649353661796340,
+        -22.05353538996864415366872,
+        65.66811401401407977118652,
+        153.38976341799678948518704,
+        57.99328886153459450270020,
+        145.71493826551733263841015,
+        233.43658766950005656326539,
+        -29.40294797644192215102521,
+        58.31870142754080177383003,
+        146.04035083152353990953998,
+        50.64387627506134492705314,
+        138.36552567904408306276309,
+        226.08717508302680698761833,
+        130.69070052656462621598621,
+        218.41234993054735014084144,
+        306.13399933453007406569668,
+    },
+    {
+        -434.13067781494703467615182,
+        -312.46873130819761854581884,
+        -190.80678480144820241548587,
+        -321.43676686257663277501706,
+        -199.77482035582718822297466,
+        -78.11287384907775788178697,
+        -208.74285591020614560875401,
+        -87.08090940345671526756632,
+        34.58103710329270086276665,
+        -330.08427110501850165746873,
+        -208.42232459826911394884519,
+        -86.76037809151968360765750,
+        -217.39036015264807133462455,
+        -95.72841364589864099343686,
+        25.93353286085077513689612,
+        -104.69644920027759837921622,
+        16.96549730647182840925780,
+        138.62744381322124809230445,
+        -226.03786439508996863878565,
+        -104.37591788834055250845267,
+        17.28602861840886362188030,
+        -113.34395344271950989423203,
+        8.31799306402991867059882,
+        129.97993957077935078814335,
+        -0.65004249034903693882370,
+        121.01190401640039340236399,
+        242.67385052314980953269696,
+        -338.40888847748681200755527,
+        -216.74694197073736745551287,
+        -95.08499546398793711432518,
+        -225.71497752511629641958280,
+        -104.05303101836688028924982,
+        17.60891548838253584108315,
+        -113.02106657274583767502918,
+        8.64087993400358911344483,
+        130.30282644075299458563677,
+        -234.36248176755822214545333,
+        -112.70053526080880601512035,
+        8.96141124594061011521262,
+        -121.66857081518776340089971,
+        -0.00662430843833842521173,
+        121.65532219831108307062095,
+        -8.97465986281729044549138,
+        112.68728664393213989569631,
+        234.34923315068155602602928,
+        -130.31607505762968912677024,
+        -8.65412855088024812744152,
+        113.00781795586917155560513,
+        -17.62216410525920196050720,
+        104.03978240149022838068049,
+        225.70172890823965872186818,
+        95.07174684711125678404642,
+        216.73369335386067291437939,
+        338.39563986061011746642180,
+        -242.68709914002647565212101,
+        -121.02515263327705952178803,
+        0.63679387347235660854494,
+        -129.99318818765601690756739,
+        -8.33124168090658834273654,
+        113.33070482584282956395327,
+        -17.29927723528554395215906,
+        104.36266927146388638902863,
+        226.02461577821330251936160,
+        -138.64069243009794263343792,
+        -16.97874592334851584496391,
+        104.68320058340090383808274,
+        -25.94678147772746967802959,
+        95.71516502902196066315810,
+        217.37711153577137679349107,
+        86.74712947464300327737874,
+        208.40907598139241940771171,
+        330.07102248814186395975412,
+        -34.59428572016938119304541,
+        87.06766078658004914814228,
+        208.72960729332947948932997,
+        78.09962523220110597321764,
+        199.76157173895052210355061,
+        321.42351824569993823388359,
+        190.79353618457159313948068,
+        312.45548269132103769152309,
+        434.11742919807045382185606,
+    },
+    {
+        -582.62162364473988418467343,
+        -421.95659967877134022273822,
+        -261.29157571280279626080301,
+        -432.16760468212555679201614,
+        -271.50258071615706967349979,
+        -110.83755675018849728985515,
+        -281.71358571951134308619658,
+        -121.04856175354282754597079,
+        39.61646221242571641596442,
+        -442.07531605561860033049015,
+        -281.41029208965005636855494,
+        -120.74526812368148398491030,
+        -291.62129709300432978125173,
+        -130.95627312703578581931652,
+        29.70875083893275814261870,
+        -141.16727813039008765372273,
+        19.49774583557845275549880,
+        180.16276980154700027014769,
+        -301.52900846649720278946916,
+        -140.86398450052868724924338,
+        19.80103946543985671269184,
+        -151.07498950388301750535902,
+        9.59003446208553533836039,
+        170.25505842805407041851140,
+        -0.62097054126877537783002,
+        160.04405342469976858410519,
+        320.70907739066831254604040,
+        -451.67424061816257108148420,
+        -291.00921665219402711954899,
+        -130.34419268622545473590435,
+        -301.22022165554830053224578,
+        -140.55519768957975657031056,
+        20.10982627638878739162465,
+        -150.76620269293405840471678,
+        9.89882127303448378086159,
+        170.56384523900302951915364,
+        -311.12793302904117354046321,
+        -150.46290906307265800023742,
+        10.20211490289588596169779,
+        -160.67391406642698825635307,
+        -0.00889010045844634833045,
+        160.65613386551009966751735,
+        -10.21989510381274612882407,
+        150.44512886215579783311114,
+        311.11015282812434179504635,
+        -170.58162543991991810798936,
+        -9.91660147395137592241099,
+        150.74842249201716981588106,
+        -20.12760647730570440216979,
+        140.53741748866283955976542,
+        301.20244145463141194341006,
+        130.32641248530856614706863,
+        290.99143645127708168729441,
+        451.65646041724562564922962,
+        -320.72685759158520113487612,
+        -160.06183362561665717294090,
+        0.60319034035188678899431,
+        -170.27283862897098742905655,
+        -9.60781466300243458533714,
+        151.05720930296610049481387,
+        -19.81881966635674530152755,
+        140.84620429961179866040766,
+        301.51122826558037104405230,
+        -180.18055000246391728069284,
+        -19.51552603649537687147131,
+        141.14949792947317064317758,
+        -29.72653103984970357487327,
+        130.93849292611884038706194,
+        291.60351689208738434899715,
+        120.72748792276453855265572,
+        281.39251188873305409288150,
+        442.05753585470165489823557,
+        -39.63424241334257658309070,
+        121.03078155262596737884451,
+        281.69580551859451134077972,
+        110.81977654927166554443829,
+        271.48480051524018108466407,
+        432.14982448120872504659928,
+        261.27379551188585082854843,
+        421.93881947785439479048364,
+        582.60384344382293875241885,
+    },
+    {
+        -750.61081157966486898658331,
+        -546.20643773421477362717269,
+        -341.80206388876479195459979,
+        -557.55983865285770662012510,
+        -353.15546480740766810413334,
+        -148.75109096195762958814157,
+        -364.50886572605054425366689,
+        -160.10449188060050573767512,
+        44.29988196484950435660721,
+        -568.63983613678124129364733,
+        -364.23546229133125962107442,
+        -159.83108844588122110508266,
+        -375.58886320997413577060797,
+        -171.18448936452409725461621,
+        33.21988448092591283966613,
+        -182.53789028316703024756862,
+        21.86648356228299761028211,
+        226.27085740773301836270548,
+        -386.66886069389772728754906,
+        -182.26448684844771719326673,
+        22.13988699700229290101561,
+        -193.61788776709062176450971,
+        10.78648607835939543519999,
+        215.19085992380942684576439,
+        -0.56691484028351624147035,
+        203.83745900516652227452141,
+        408.24183285061656079051318,
+        -579.43777562718264562136028,
+        -375.03340178173260710536852,
+        -170.62902793628256858937675,
+        -386.38680270037548325490206,
+        -181.98242885492541631720087,
+        22.42194499052459377708146,
+        -193.33582977356834931015328,
+        11.06854407188167854769745,
+        215.47291791733169930012082,
+        -397.46680018429907477184315,
+        -193.06242633884903625585139,
+        11.34194750660097383843095,
+        -204.41582725749194082709437,
+        -0.01145341204192603865031,
+        204.39292043340810778317973,
+        -11.36485433068483530405501,
+        193.03951951476520321193675,
+        397.44389336021521330621908,
+        -215.49582474141558918745432,
+        -11.09145089596556132960359,
+        193.31292294948445942281978,
+        -22.44485181460845524270553,
+        181.95952203084158327328623,
+        386.36389587629162178927800,
+        170.60612111219862185862439,
+        375.01049495764863195290673,
+        579.41486880309867046889849,
+        -408.26473967470042225613724,
+        -203.86036582925035531843605,
+        0.54400801619965477584628,
+        -215.21376674789325988967903,
+        -10.80939290244324268996934,
+        193.59498094300678872059507,
+        -22.16279382108615436663968,
+        182.24158002436388414935209,
+        386.64595386981386582192499,
+        -226.29376423181690825003898,
+        -21.88939038636688039218825,
+        182.51498345908314036023512,
+        -33.24279130500977430529019,
+        171.16158254044026421070157,
+        375.56595638589027430498390,
+        159.80818162179733121774916,
+        364.21255546724734131203149,
+        568.61692931269737982802326,
+        -44.32278878893342266565014,
+        160.08158505651661585034162,
+        364.48595890196662594462396,
+        148.72818413787368285738921,
+        353.13255798332369295167155,
+        557.53693182877373146766331,
+        341.77915706468081680213800,
+        546.18353091013091216154862,
+        750.58790475558089383412153,
+    },
+    {
+        -936.28766858034509823482949,
+        -683.93576186897689694887958,
+        -431.58385515760869566292968,
+        -696.28082680695979433949105,
+        -443.92892009559170674037887,
+        -191.57701338422353387613839,
+        -456.27398503357460413099034,
+        -203.92207832220640284504043,
+        48.42982838916174159749062,
+        -708.39478086252211141982116,
+        -456.04287415115396697729011,
+        -203.69096743978579411304963,
+        -468.38793908913686436790158,
+        -216.03603237776869150366110,
+        36.31587433359945293886994,
+        -228.38109731575161731598200,
+        23.97080939561654489011744,
+        276.32271610698467156908009,
+        -480.50189314469912460481282,
+        -228.14998643333098016228178,
+        24.20192027803716428024927,
+        -240.49505137131390597460268,
+        11.85685534005424912606941,
+        264.20876205142241133216885,
+        -0.48820959792865892268310,
+        251.86369711343951394155738,
+        504.21560382480765838408843,
+        -720.26592281861303490586579,
+        -467.91401610724494730675360,
+        -215.56210939587677444251312,
+        -480.25908104522784469736507,
+        -227.90717433385964341141516,
+        24.44473237750850103111588,
+        -240.25223927184256922373606,
+        12.09966743952559120600654,
+        264.45157415089374808303546,
+        -492.37303510079004809085745,
+        -240.02112838942190364832641,
+        12.33077832194624079420464,
+        -252.36619332740485788235674,
+        -0.01428661603668739468742,
+        252.33762009533145942441479,
+        -12.35935155401958240872773,
+        239.99255515734859045551275,
+        492.34446186871673489804380,
+        -264.48014738296711811926798,
+        -12.12824067159895768952538,
+        240.22366603976919918750355,
+        -24.47330560958187106734840,
+        227.87860110178630179689208,
+        480.23050781315441781771369,
+        215.53353616380337598457118,
+        467.88544287517152042710222,
+        720.23734958653972171305213,
+        -504.24417705688102842032094,
+        -251.89227034551285555608047,
+        0.45963636585528888645058,
+        -264.23733528349578136840137,
+        -11.88542857212762626772928,
+        240.46647813924053593837016,
+        -24.23049351011053431648179,
+        228.12141320125763854775869,
+        480.47331991262581141199917,
+        -276.35128933905804160531261,
+        -23.99938262768987939921317,
+        228.35252408367827570145892,
+        -36.34444756567279455339303,
+        216.00745914569537831084745,
+        468.35936585706349433166906,
+        203.66239420771245249852655,
+        456.01430091908059694105759,
+        708.36620763044879822700750,
+        -48.45840162123508321201371,
+        203.89350509013308965222677,
+        456.24541180150123409475782,
+        191.54844015215013541819644,
+        443.90034686351827986072749,
+        696.25225357488648114667740,
+        431.55528192553543931353488,
+        683.90718863690358375606593,
+        936.25909534827178504201584,
+    },
+    {
+        -1137.04808554865144287759904,
+        -833.26390234036784931959119,
+        -529.47971913208425576158334,
+        -846.40213230343852046644315,
+        -542.61794909515492690843530,
+        -238.83376588687127650700859,
+        -555.75617905822559805528726,
+        -251.97199584994194765386055,
+        51.81218735834170274756616,
+        -859.36314032206837509875186,
+        -555.57895711378478154074401,
+        -251.79477390550113113931729,
+        -568.71718707685545268759597,
+        -264.93300386857180228616926,
+        38.85117933971184811525745,
+        -278.07123383164247343302122,
+        25.71294937664116986297813,
+        329.49713258492482736983220,
+        -581.67819509548530731990468,
+        -277.89401188720165691847797,
+        25.89017132108199348294875,
+        -291.03224185027232806532993,
+        12.75194135801132055973994,
+        316.53612456629497273752349,
+        -0.38628860505934881075518,
+        303.39789460322430159067153,
+        607.18207781150795199209824,
+        -872.13243165697099357203115,
+        -568.34824844868740001402330,
+        -264.56406524040374961259658,
+        -581.48647841175807116087526,
+        -277.70229520347442075944855,
+        26.08188800480922964197816,
+        -290.84052516654509190630051,
+        12.94365804173855316605568,
+        316.72784125002220889655291,
+        -594.44748643038792579318397,
+        -290.66330322210427539175726,
+        13.12087998617937500966946,
+        -303.80153318517494653860922,
+        -0.01734997689130632694821,
+        303.76683323139235426424420,
+        -13.15557993996196728403447,
+        290.62860326832168311739224,
+        594.41278647660533351881895,
+        -316.76254120380480117091793,
+        -12.97835799552115609856173,
+        290.80582521276249963193550,
+        -26.11658795859182191634318,
+        277.66759524969182848508353,
+        581.45177845797547888651025,
+        264.52936528662115733823157,
+        568.31354849490480773965828,
+        872.09773170318840129766613,
+        -607.21677776529054426646326,
+        -303.43259455700689386503655,
+        0.35158865127675653639017,
+        -316.57082452007756501188851,
+        -12.78664131179391638681864,
+        290.99754189648973579096491,
+        -25.92487127486458575731376,
+        277.85931193341906464411295,
+        581.64349514170271504553966,
+        -329.53183253870741964419722,
+        -25.74764933042377634819786,
+        278.03653387785988115865621,
+        -38.88587929349444038962247,
+        264.89830391478921001180424,
+        568.68248712307286041323096,
+        251.76007395171853886495228,
+        555.54425716000218926637899,
+        859.32844036828578282438684,
+        -51.84688731212429502193118,
+        251.93729589615935537949554,
+        555.72147910444300578092225,
+        238.79906593308868423264357,
+        542.58324914137233463407028,
+        846.36743234965592819207814,
+        529.44501917830166348721832,
+        833.22920238658525704522617,
+        1137.01338559486885060323402,
+    },
+    {
+        -1349.54147666931908133847173,
+        -991.74399841111426212592050,
+        -633.94652015290944291336928,
+        -1005.43370819453798503673170,
+        -647.63622993633305213734275,
+        -289.83875167812823292479152,
+        -661.32593971975688873499166,
+        -303.52846146155201267902157,
+        54.26901679665286337694852,
+        -1019.01033632943676821014378,
+        -661.21285807123194899759255,
+        -303.41537981302712978504132,
+        -674.90256785465567190840375,
+        -317.10508959645085269585252,
+        40.69238866175402336011757,
+        -330.79479937987451876324485,
+        27.00267887833031466016109,
+        384.80015713653517650527647,
+        -688.47919598955445508181583,
+        -330.68171773134957902584574,
+        27.11576052685529703012435,
+        -344.37142751477330193665694,
+        13.42605074343155635574476,
+        371.22352900163639333186438,
+        -0.26365903999214879149804,
+        357.53381921821267042105319,
+        715.33129747641760332044214,
+        -1032.45697944159178405243438,
+        -674.65950118338696483988315,
+        -316.86202292518214562733192,
+        -688.34921096681080143753206,
+        -330.55173270860598222498083,
+        27.24574554959889383098925,
+        -344.24144249202964829237317,
+        13.55603576617518690738962,
+        371.35351402438004697614815,
+        -701.92583910170947092410643,
+        -344.12836084350470855497406,
+        13.66911741470016750099603,
+        -357.81807062692843146578525,
+        -0.02059236872359190492765,
+        357.77688588948126380273607,
+        -13.71030215214727832062636,
+        344.08717610605754089192487,
+        701.88465436426236010447610,
+        -371.39469876182721463919734,
+        -13.59722050362237943943455,
+        344.20025775458248062932398,
+        -27.28693028704611833745730,
+        330.51054797115870087509393,
+        688.30802622936357693106402,
+        316.82083818773497796428273,
+        674.61831644593985402025282,
+        1032.41579470414467323280405,
+        -715.37248221386471414007246,
+        -357.57500395565989492752124,
+        0.22247430254498112844885,
+        -371.26471373908361783833243,
+        -13.46723548087875954593073,
+        344.33024277732607743018889,
+        -27.15694526430246469317353,
+        330.64053299390235451937770,
+        688.43801125210723057534778,
+        -384.84134187398240101174451,
+        -27.04386361577756758833857,
+        330.75361464242729425677680,
+        -40.73357339920130471000448,
+        317.06390485900351450254675,
+        674.86138311720833371509798,
+        303.37419507557984843515442,
+        661.17167333378472449112451,
+        1018.96915159198954370367574,
+        -54.31020153410008788341656,
+        303.48727672410473132913467,
+        661.28475498230955054168589,
+        289.79756694068106526174233,
+        647.59504519888594131771242,
+        1005.39252345709076053026365,
+        633.90533541546210472006351,
+        991.70281367366703761945246,
+        1349.50029193187174314516596,
+    },
+    {
+        -1569.75236882874810362409335,
+        -1156.42106375221533198782708,
+        -743.08975867568256035156082,
+        -1170.38402001039912647684105,
+        -757.05271493386646852741251,
+        -343.72140985733369689114625,
+        -771.01567119205037670326419,
+        -357.68436611551754822357907,
+        55.64693896101522341268719,
+        -1184.30644499260029078868683,
+        -770.97513991606751915242057,
+        -357.64383483953474751615431,
+        -784.93809617425142732827226,
+        -371.60679109771865569200600,
+        41.72451397881411594426027,
+        -385.56974735590245018101996,
+        27.76155772063031434981895,
+        441.09286279716309309151256,
+        -798.86052115645247795328032,
+        -385.52921607991970631701406,
+        27.80208899661306531925220,
+        -399.49217233810355764944688,
+        13.83913273842921931588990,
+        427.17043781496198562308564,
+        -0.12382351975458050219459,
+        413.20748155677819113407168,
+        826.53878663331101961375680,
+        -1198.16953025130578680546023,
+        -784.83822517477312885603169,
+        -371.50692009824035721976543,
+        -798.80118143295703703188337,
+        -385.46987635642420855219825,
+        27.86142872010856308406801,
+        -399.43283261460800304121221,
+        13.89847246192475971326985,
+        427.22977753845754023132031,
+        -812.72360641515797397005372,
+        -399.39230133862525917720632,
+        13.93900373790751245905994,
+        -413.35525759680905366622028,
+        -0.02395252027631756749915,
+        413.30735255625648960631224,
+        -13.98690877846013336238684,
+        399.34439629807263827387942,
+        812.67570137460540991014568,
+        -427.27768257901016113464721,
+        -13.94637750247739838016514,
+        399.38492757405538213788532,
+        -27.90933376066124083081377,
+        385.42197131587153080545249,
+        798.75327639240435928513762,
+        371.45901505768779315985739,
+        784.79032013422056479612365,
+        1198.12162521075333643238991,
+        -826.58669167386358367366483,
+        -413.25538659733081203739857,
+        0.07591847920195959886769,
+        -427.21834285551466336983140,
+        -13.88703777898188640449462,
+        399.44426729755087990270113,
+        -27.84999403716568622257910,
+        385.48131103936708541368716,
+        798.81261611589980020653456,
+        -441.14076783771571399483946,
+        -27.80946276118294946400056,
+        385.52184231534982927769306,
+        -41.77241901936679369100602,
+        371.55888605716597794526024,
+        784.89019113369874958152650,
+        357.59592979898218345624628,
+        770.92723487551495509251254,
+        1184.25853995204761304194108,
+        -55.69484400156784431601409,
+        357.63646107496492732025217,
+        770.96776615149769895651843,
+        343.67350481678113283123821,
+        757.00480989331390446750447,
+        1170.33611496984667610377073,
+        743.04185363513010997849051,
+        1156.37315871166288161475677,
+        1569.70446378819565325102303,
+    },
+    {
+        -1793.11399692080522072501481,
+        -1323.91438135094813333125785,
+        -854.71476578109104593750089,
+        -1337.84426481785840223892592,
+        -868.64464924800120115833124,
+        -399.44503367814405692115542,
+        -882.57453271491135637916159,
+        -413.37491714505415529856691,
+        55.82469842480293209519004,
+        -1351.81230717490689130499959,
+        -882.61269160504991759808036,
+        -413.41307603519277336090454,
+        -896.54257507196007281891070,
+        -427.34295950210287173831603,
+        41.85665606775421565544093,
+        -441.27284296901308380256523,
+        27.92677260084403201290115,
+        497.12638817070114782836754,
+        -910.51061742900878925865982,
+        -441.31100185915158817806514,
+        27.88861371070549921569182,
+        -455.24088532606174339889549,
+        13.95873024379535465300251,
+        483.15834581365248823203729,
+        0.02884677688518877403112,
+        469.22846234674233301120694,
+        938.42807791659947724838275,
+        -1365.79839816694629917037673,
+        -896.59878259708932546345750,
+        -427.39916702723218122628168,
+        -910.52866606399948068428785,
+        -441.32905049414227960369317,
+        27.87056507571480779006379,
+        -455.25893396105249166794238,
+        13.94068160880462592388085,
+        483.14029717866173996299040,
+        -924.49670842104819712403696,
+        -455.29709285119099604344228,
+        13.90252271866609135031467,
+        -469.22697631810115126427263,
+        -0.02736074824403084138069,
+        469.17225482161308036666014,
+        -13.95724421515421909134602,
+        455.24237135470292514582979,
+        924.44198692456006938300561,
+        -483.19501867514986770402174,
+        -13.99540310529275011219852,
+        455.20421246456436392691103,
+        -27.92528657220287868767628,
+        441.27432899765426554949954,
+        910.47394456751135294325650,
+        427.34444553074399664183147,
+        896.54406110060108403558843,
+        1365.74367667045817142934538,
+        -938.48279941308760498941410,
+        -469.28318384323040390881943,
+        -0.08356827337331651506247,
+        -483.21306731014055912964977,
+        -14.01345174028346107775178,
+        455.18616382957367250128300,
+        -27.94333520719362695672316,
+        441.25628036266351728045265,
+        910.45589593252066151762847,
+        -497.18110966718927556939889,
+        -27.98149409733215975393250,
+        441.21812147252495606153389,
+        -41.91137756424228655305342,
+        427.28823800561485768412240,
+        896.48785357547194507787935,
+        413.35835453870458877645433,
+        882.55797010856167617021129,
+        1351.75758567841876356396824,
+        -55.87941992129094614938367,
+        413.32019564856619808779215,
+        882.51981121842322863813024,
+        399.39031218165598602354294,
+        868.58992775151307341729989,
+        1337.78954332137027449789457,
+        854.66004428460291819646955,
+        1323.85965985446000559022650,
+        1793.05927542431709298398346,
+    },
+    {
+        -2014.64980825865086444537155,
+        -1490.52129470825843782222364,
+        -966.39278115786601119907573,
+        -1504.09366245228648040210828,
+        -979.96514890189382640528493,
+        -455.83663535150139978213701,
+        -993.53751664592164161149412,
+        -469.40900309552915814492735,
+        54.71951045486332532163942,
+        -1517.78640862976681091822684,
+        -993.65789507937438429507893,
+        -469.52938152898195767193101,
+        -1007.23026282340231318812585,
+        -483.10174927300982972155907,
+        41.02676427738265374500770,
+        -496.67411701703764492776827,
+        27.45439653335485985508058,
+        551.58291008374726516194642,
+        -1020.92300900088287107791984,
+        -496.79449545049038761135307,
+        27.33401809990209585521370,
+        -510.36686319451820281756227,
+        13.76165035587429841257290,
+        537.89016390626670727215242,
+        0.18928261184646544279531,
+        524.31779616223900575278094,
+        1048.44630971263131868909113,
+        -1531.57880010210010368609801,
+        -1007.45028655170767706295010,
+        -483.32177300131525043980218,
+        -1021.02265429573560595599702,
+        -496.89414074534312248943024,
+        27.23437280504936097713653,
+        -510.46650848937093769563944,
+        13.66200506102156531085257,
+        537.79051861141397239407524,
+        -1034.71540047321627753262874,
+        -510.58688692282373722264310,
+        13.54162662756874624392367,
+        -524.15925466685155242885230,
+        -0.03074111645902482398141,
+        524.09777243393341450428125,
+        -13.60310886048688416849473,
+        510.52540468990559929807205,
+        1034.65391824029802592121996,
+        -537.85200084433211031864630,
+        -13.72348729393960731215429,
+        510.40502625645285661448725,
+        -27.29585503796744205828873,
+        496.83265851242504140827805,
+        1020.96117206281746803142596,
+        483.26029076839722620206885,
+        1007.38880431878976651205448,
+        1531.51731786918207944836468,
+        -1048.50779194554934292682447,
+        -524.37927839515691630367655,
+        -0.25076484476448968052864,
+        -537.95164613918484519672347,
+        -13.82313258879234396658831,
+        510.30538096160012173641007,
+        -27.39550033282017693636590,
+        496.73301321757230653020088,
+        1020.86152676796473315334879,
+        -551.64439231666551677335519,
+        -27.51587876627295514708749,
+        496.61263478411950700319721,
+        -41.08824651030079166957876,
+        483.04026704009169179698802,
+        1007.16878059048417526355479,
+        469.46789929606381974735996,
+        993.59641284645636005734559,
+        1517.72492639684878668049350,
+        -54.78099268778134955937276,
+        469.34752086261113390719402,
+        993.47603441300361737376079,
+        455.77515311858326185756596,
+        979.90366666897580216755159,
+        1504.03218021936822879069950,
+        966.33129892494810064818012,
+        1490.45981247534064095816575,
+        2014.58832602573306758131366,
+    },
+    {
+        -2229.13737755696365638868883,
+        -1652.33839067923986476671416,
+        -1075.53940380151630051841494,
+        -1665.22173734233115283132065,
+        -1088.42275046460758858302142,
+        -511.62376358688402433472220,
+        -1101.30609712769887664762791,
+        -524.50711024997531239932869,
+        52.29187662774825184897054,
+        -1678.30836735357411271252204,
+        -1101.50938047585054846422281,
+        -524.71039359812698421592358,
+        -1114.39272713894206390250474,
+        -537.59374026121838596736779,
+        39.20524661650517828093143,
+        -550.47708692430967403197428,
+        26.32189995341391508532070,
+        603.12088683113745446462417,
+        -1127.47935715018502378370613,
+        -550.68037027246145953540690,
+        26.11861660526210471289232,
+        -563.56371693555274760001339,
+        13.23526994217082730642687,
+        590.03425681989438089658506,
+        0.35192327907952858367935,
+        577.15091015680309283197857,
+        1153.94989703452665708027780,
+        -1691.57765123278045393817592,
+        -1114.77866435505688968987670,
+        -537.97967747733332544157747,
+        -1127.66201101814840512815863,
+        -550.86302414042472719302168,
+        25.93596273729883705527755,
+        -563.74637080351601525762817,
+        13.05261607420757385966681,
+        589.85160295193111323897028,
+        -1140.74864102939136500936002,
+        -563.94965415166780076106079,
+        12.84933272605576348723844,
+        -576.83300081475908882566728,
+        -0.03401393703547613001081,
+        576.76497294068803967093118,
+        -12.91736060012681264197454,
+        563.88162627759675160632469,
+        1140.68061315532031585462391,
+        -589.91963082600216239370639,
+        -13.12064394827857327641141,
+        563.67834292944496610289207,
+        -26.00399061136988621001365,
+        550.79499626635367803828558,
+        1127.59398314407735597342253,
+        537.91164960326227628684137,
+        1114.71063648098584053514060,
+        1691.50962335870940478343982,
+        -1154.01792490859770623501390,
+        -577.21893803087402829987695,
+        -0.41995115315046405157773,
+        -590.10228469396531636448344,
+        -13.30329781624174145804318,
+        563.49568906148181213211501,
+        -26.18664447933304018079070,
+        550.61234239839052406750852,
+        1127.41132927611397462897003,
+        -603.18891470520838993252255,
+        -26.38992782748480081522757,
+        550.40905905023873856407590,
+        -39.27327449057611374882981,
+        537.52571238714745049946941,
+        1114.32469926487101474776864,
+        524.64236572405616243486293,
+        1101.44135260177972668316215,
+        1678.24033947950329093146138,
+        -52.35990450181907363003120,
+        524.43908237590449061826803,
+        1101.23806925362805486656725,
+        511.55573571281320255366154,
+        1088.35472259053676680196077,
+        1665.15370946826033105025999,
+        1075.47137592744547873735428,
+        1652.27036280516904298565350,
+        2229.06934968289260723395273,
+    },
+    {
+        -2431.28807478389808238716796,
+        -1805.39517366632480843691155,
+        -1179.50227254875153448665515,
+        -1817.26263183646392462833319,
+        -1191.36973071889065067807678,
+        -565.47682960131726304098265,
+        -1203.23718888902976686949842,
+        -577.34428777145660660607973,
+        48.54861334611678103101440,
+        -1829.41400540316817568964325,
+        -1203.52110428559490173938684,
+        -577.62820316802151410229271,
+        -1215.38856245573424530448392,
+        -589.49566133816097135422751,
+        36.39723977941241628286662,
+        -601.36311950830020123248687,
+        24.52978160927312245576104,
+        650.42268272684646035486367,
+        -1227.53993602243872373946942,
+        -601.64703490486533610237530,
+        24.24586621270805153471883,
+        -613.51449307500456598063465,
+        12.37840804256877191846797,
+        638.27130916014209560671588,
+        0.51094987242947809136240,
+        626.40385099000275204161881,
+        1252.29675210757613967871293,
+        -1841.82951195762052520876750,
+        -1215.93661084004725125851110,
+        -590.04370972247386362141697,
+        -1227.80406901018636744993273,
+        -601.91116789261309349967632,
+        23.98173322496029413741780,
+        -613.77862606275232337793568,
+        12.11427505482100208666907,
+        638.00717617239433820941485,
+        -1239.95544257689061851124279,
+        -614.06254145931745824782411,
+        11.83035965825592938927002,
+        -625.92999962945657443924574,
+        -0.03709851188329922611064,
+        625.85580260569008714810479,
+        -11.90455668202264405408641,
+        613.98834443555062989616999,
+        1239.88124555312401753326412,
+        -638.08137319616093918739352,
+        -12.18847207858761372278877,
+        613.70442903898572239995701,
+        -24.05593024872689511539647,
+        601.83697086884637883485993,
+        1227.72987198641976647195406,
+        589.96951269870714895660058,
+        1215.86241381628042290685698,
+        1841.75531493385369685711339,
+        -1252.37094913134274065669160,
+        -626.47804801376946670643520,
+        -0.58514689619607906934107,
+        -638.34550618390869658469455,
+        -12.45260506633535868559193,
+        613.44029605123796500265598,
+        -24.32006323647465251269750,
+        601.57283788109862143755890,
+        1227.46573899867189538781531,
+        -650.49687975061294764600461,
+        -24.60397863303962395775670,
+        601.28892248453371394134592,
+        -36.47143680317890357400756,
+        589.42146431439437037624884,
+        1215.31436543196787170018069,
+        577.55400614425525418482721,
+        1203.44690726182852813508362,
+        1829.33980837940180208534002,
+        -48.62281036988326832215535,
+        577.27009074769000562810106,
+        1203.16299186526339326519519,
+        565.40263257755077574984170,
+        1191.29553369512404970009811,
+        1817.18843481269732365035452,
+        1179.42807552498470613500103,
+        1805.32097664255798008525744,
+        2431.21387776013125403551385,
+    },
+    {
+        -2615.93497185161777451867238,
+        -1945.79465746502523870731238,
+        -1275.65434307843270289595239,
+        -1956.33583976977615748182870,
+        -1286.19552538318339429679327,
+        -616.05521099659074479859555,
+        -1296.73670768793431307130959,
+        -626.59639330134154988627415,
+        43.54392108525109961192356,
+        -1967.23635080840676891966723,
+        -1297.09603642181400573463179,
+        -626.95572203522135623643408,
+        -1307.63721872656469713547267,
+        -637.49690433997204763727495,
+        32.64341004662060186092276,
+        -648.03808664472296641179128,
+        22.10222774186974348253898,
+        692.24254212846244627144188,
+        -1318.53772976519553594698664,
+        -648.39741537860277276195120,
+        21.74289900798987673624652,
+        -658.93859768335357784962980,
+        11.20171670323908053035211,
+        681.34203108983183483360335,
+        0.66053439848826656088931,
+        670.80084878508102974592475,
+        1340.94116317167367924412247,
+        -1978.47798351158257901261095,
+        -1308.33766912498981582757551,
+        -638.19735473839716632937780,
+        -1318.87885142974073460209183,
+        -648.73853704314785773021867,
+        21.40177734344479176797904,
+        -659.27971934789877650473500,
+        10.86059503869393161323842,
+        681.00090942528663617849816,
+        -1329.77936246837134603993036,
+        -659.63904808177858285489492,
+        10.50126630481406664330279,
+        -670.18023038652938794257352,
+        -0.03991599993670071067076,
+        670.10039838665602474065963,
+        -10.58109830468754353205441,
+        659.55921608190521965298103,
+        1329.69953046849786915117875,
+        -681.08074142516011306724977,
+        -10.94042703856740494927635,
+        659.19988734802529961598339,
+        -21.48160934331815496989293,
+        648.65870504327460821514251,
+        1318.79901942986725771334022,
+        638.11752273852357575378846,
+        1308.25783712511633893882390,
+        1978.39815151170887475018390,
+        -1341.02099517154692875919864,
+        -670.88068078495427926100092,
+        -0.74036639836162976280320,
+        -681.42186308970508434867952,
+        -11.28154870311242596869761,
+        658.85876568348032833455363,
+        -21.82273100786323993816040,
+        648.31758337872952324687503,
+        1318.45789776532228643191047,
+        -692.32237412833580947335577,
+        -22.18205974174309957902551,
+        647.95825464484960320987739,
+        -32.72324204649385137599893,
+        637.41707234009891180903651,
+        1307.55738672669167499407195,
+        626.87589003534799303452019,
+        1297.01620442194075621955562,
+        1967.15651880853329203091562,
+        -43.62375308512457650067518,
+        626.51656130146818668436026,
+        1296.65687568806083618255798,
+        615.97537899671738159668166,
+        1286.11569338331014478171710,
+        1956.25600776990268059307709,
+        1275.57451107855922600720078,
+        1945.71482546515198919223621,
+        2615.85513985174475237727165,
+    },
+    {
+        -2778.22096618073101126356050,
+        -2069.85488558214956356096081,
+        -1361.48880498356788848468568,
+        -2078.78735683441573200980201,
+        -1370.42127623583451168087777,
+        -662.05519563725306397827808,
+        -1379.35374748810090750339441,
+        -670.98766688951945980079472,
+        37.37841370906198790180497,
+        -2088.14654592852411951753311,
+        -1379.78046532994267181493342,
+        -671.41438473136122411233373,
+        -1388.71293658220929501112550,
+        -680.34685598362773362168809,
+        28.01922461495371408091160,
+        -689.27932723589424313104246,
+        19.08675336268719746612987,
+        727.45283396126865227415692,
+        -1398.07212567631745514518116,
+        -689.70604507773600744258147,
+        18.66003552084544026001822,
+        -698.63851633000251695193583,
+        9.72756426857890055259759,
+        718.09364486716037845326355,
+        0.79509301631242124130949,
+        709.16117361489386894390918,
+        1417.52725421347531664650887,
+        -2097.91650248479527363087982,
+        -1389.55042188621359855460469,
+        -681.18434128763215085200500,
+        -1398.48289313847999437712133,
+        -690.11681253989854667452164,
+        18.24926805868290102807805,
+        -699.04928379216505618387600,
+        9.31679680641638263693949,
+        717.68287740499783922132337,
+        -1407.84208223258838188485242,
+        -699.47600163400682049541501,
+        8.89007896457462720718468,
+        -708.40847288627344369160710,
+        -0.04239228769196672075292,
+        708.32368831088945171359228,
+        -8.97486353995839181152405,
+        699.39121705862305589107564,
+        1407.75729765720461728051305,
+        -717.76766198038160382566275,
+        -9.40158138180016500484726,
+        698.96449921678129157953663,
+        -18.33405263406666563241743,
+        690.03202796451478207018226,
+        1398.39810856309622977278195,
+        681.09955671224838624766562,
+        1389.46563731082983395026531,
+        2097.83171790941105427918956,
+        -1417.61203878885908125084825,
+        -709.24595819027774723508628,
+        -0.87987759169629953248659,
+        -718.17842944254425674444064,
+        -9.81234884396283923990723,
+        698.55373175461863866075873,
+        -18.74482009622931855119532,
+        689.62126050235212915140437,
+        1397.98734110093346316716634,
+        -727.53761853665253056533402,
+        -19.17153793807108996816169,
+        689.19454266051036483986536,
+        -28.10400919033759237208869,
+        680.26207140824385533051100,
+        1388.62815200682530303311069,
+        671.32960015597723213431891,
+        1379.69568075455867983691860,
+        2088.06176135314035491319373,
+        -37.46319828444597987981979,
+        670.90288231413546782277990,
+        1379.26896291271691552537959,
+        661.97041106186884462658782,
+        1370.33649166045029232918750,
+        2078.70257225903151265811175,
+        1361.40402040818366913299542,
+        2069.77010100676488946191967,
+        2778.13618160534679191187024,
+    },
+    {
+        -2913.77896808468494782573543,
+        -2174.24525633772009314270690,
+        -1434.71154459075478371232748,
+        -2181.32513402578069872106425,
+        -1441.79142227881538929068483,
+        -702.25771053185019354714314,
+        -1448.87129996687644961639307,
+        -709.33758821991114018601365,
+        30.19612352705405555752805,
+        -2188.88855241099554405082017,
+        -1449.35484066403046199411619,
+        -709.82112891706526625057450,
+        -1456.43471835209129494614899,
+        -716.90100660512609920260729,
+        22.63270514183909654093441,
+        -723.98088429318693215464009,
+        15.55282745377823694354902,
+        755.08653920074345933244331,
+        -1463.99813673730614027590491,
+        -724.46442499034094453236321,
+        15.06928675662425121117849,
+        -731.54430267840189117123373,
+        7.98940906856332233587636,
+        747.52312081552850031584967,
+        0.90953138050247162027517,
+        740.44324312746766736381687,
+        1479.97695487443297679419629,
+        -2196.92242221820742997806519,
+        -1457.38871047124234792136122,
+        -717.85499872427715217781952,
+        -1464.46858815930340824706946,
+        -724.93487641233821250352776,
+        14.59883533462698324001394,
+        -732.01475410039904545556055,
+        7.51895764656612364262855,
+        747.05266939353134603152284,
+        -1472.03200654451825357682537,
+        -732.49829479755305783328367,
+        7.03541694941213791025802,
+        -739.57817248561389078531647,
+        -0.04446073864875312725564,
+        739.48925100831650070176693,
+        -7.12433842670964168064529,
+        732.40937332025555406289641,
+        1471.94308506722063611960039,
+        -747.14159087082884980191011,
+        -7.60787912386368070372100,
+        731.92583262310154168517329,
+        -14.68775681192460069723893,
+        724.84595493504059504630277,
+        1464.37966668200579078984447,
+        717.76607724697976209426997,
+        1457.29978899394495783781167,
+        2196.83350074091003989451565,
+        -1480.06587635173036687774584,
+        -740.53216460476505744736642,
+        -0.99845285779986170382472,
+        -747.61204229282600408623694,
+        -8.07833054586079057912684,
+        731.45538120110438740084646,
+        -15.15820823392164129472803,
+        724.37550351304355444881367,
+        1463.90921526000875019235536,
+        -755.17546067804084941599285,
+        -15.64174893107568031780374,
+        723.89196281588954207109055,
+        -22.72162661913660031132167,
+        716.81208512782859543222003,
+        1456.34579687479390486259945,
+        709.73220743976787616702495,
+        1449.26591918673307191056665,
+        2188.79963093369815396727063,
+        -30.28504500435133195423987,
+        709.24866674261386378930183,
+        1448.78237848957905953284353,
+        702.16878905455303083726903,
+        1441.70250080151822658081073,
+        2181.23621254848330863751471,
+        1434.62262311345739362877794,
+        2174.15633486042224831180647,
+        2913.69004660738755774218589,
+    },
+    {
+        -3018.89625444498960860073566,
+        -2256.11168465268610816565342,
+        -1493.32711486038306247792207,
+        -2261.14289995110721065429971,
+        -1498.35833015880416496656835,
+        -735.57376036650077821832383,
+        -1503.38954545722504008153919,
+        -740.60497566492176702013239,
+        22.17959412738161972811213,
+        -2266.70174653696767563815229,
+        -1503.91717674466440257674549,
+        -741.13260695236101582850097,
+        -1508.94839204308527769171633,
+        -746.16382225078211831714725,
+        16.62074754152126843109727,
+        -751.19503754920310711895581,
+        11.58953224310021035137197,
+        774.37410203540355269069551,
+        -1514.50723862894574267556891,
+        -751.72266883664258330099983,
+        11.06190095566080344724469,
+        -756.75388413506357210280839,
+        6.03068565723973382119993,
+        768.81525544954308770684293,
+        0.99947035881871215678984,
+        763.78404015112198521819664,
+        1526.56860994342537196644116,
+        -2272.77849689535560173681006,
+        -1509.99392710305232867540326,
+        -747.20935731074894192715874,
+        -1515.02514240147320379037410,
+        -752.24057260917004441580502,
+        10.54399718313334233243950,
+        -757.27178790759103321761359,
+        5.51278188471228336453578,
+        768.29735167701562659203773,
+        -1520.58398898733366877422668,
+        -757.79941919503050939965760,
+        4.98515059727287734858692,
+        -762.83063449345149820146617,
+        -0.04606470114814742444764,
+        762.73850509115516160818515,
+        -5.07727999956921394186793,
+        757.70728979273405911953887,
+        1520.49185958503744586778339,
+        -768.38948107931184949848102,
+        -5.60491128700853291633166,
+        757.17965850529481031117029,
+        -10.63612658542956523888279,
+        752.14844320687370782252401,
+        1514.93301299917720825760625,
+        747.11722790845260533387773,
+        1509.90179770075587839528453,
+        2272.68636749305915145669132,
+        -1526.66073934572159487288445,
+        -763.87616955341843549831538,
+        -1.09159976111504875007086,
+        -768.90738485183942430012394,
+        -6.12281505953611837611561,
+        756.66175473276723550952738,
+        -11.15403035795714004052570,
+        751.63053943434613302088110,
+        1514.41510922664951976912562,
+        -774.46623143769977559713880,
+        -11.68166164539645812681101,
+        751.10290814690688421251252,
+        -16.71287694381749133754056,
+        746.07169284848578172386624,
+        1508.85626264078928215894848,
+        741.04047755006467923521996,
+        1503.82504734236795229662675,
+        2266.60961713467122535803355,
+        -22.27172352967795632139314,
+        740.51284626262531674001366,
+        1503.29741605492881717509590,
+        735.48163096420421425136738,
+        1498.26620075650748731277417,
+        2261.05077054881076037418097,
+        1493.23498545808661219780333,
+        2256.01955525039011263288558,
+        3018.80412504269315832061693,
+    },
+    {
+        -3090.65572377487751509761438,
+        -2313.18507278427387063857168,
+        -1535.71442179367022617952898,
+        -2316.02688057918976483051665,
+        -1538.55622958858612037147395,
+        -761.08557859798258959926898,
+        -1541.39803738350201456341892,
+        -763.92738639289837010437623,
+        13.54326459770527435466647,
+        -2319.42598444400437074364163,
+        -1541.95533345340049891092349,
+        -764.48468246279696813871851,
+        -1544.79714124831639310286846,
+        -767.32649025771274864382576,
+        10.14416073289089581521694,
+        -770.16829805262864283577073,
+        7.30235293797502116319720,
+        784.77300392857864608231466,
+        -1548.19624511313054426864255,
+        -770.72559412252689980959985,
+        6.74505686807674464944284,
+        -773.56740191744279400154483,
+        3.90324907316086200381733,
+        781.37390006376449491654057,
+        1.06144127824495626555290,
+        778.53209226884860072459560,
+        1556.00274325945224518363830,
+        -2323.37639318091896711848676,
+        -1545.90574219031509528576862,
+        -768.43509119971156451356364,
+        -1548.74754998523121685138904,
+        -771.27689899462745870550862,
+        6.19375199597618575353408,
+        -774.11870678954335289745359,
+        3.35194420106031110151434,
+        780.82259519166393602063181,
+        -1552.14665385004536801716313,
+        -774.67600285944160987128271,
+        2.79464813116203458775999,
+        -777.51781065435750406322768,
+        -0.04715966375388912223965,
+        777.42349132684978485485772,
+        -2.88896745866975379612995,
+        774.58168353193389066291275,
+        1552.05233452253742143511772,
+        -780.91691451917176891583949,
+        -3.44626352856810491687156,
+        774.02438746203552000224590,
+        -6.28807132348401864874177,
+        771.18257966711962581030093,
+        1548.65323065772327026934363,
+        768.34077187220384530519368,
+        1545.81142286280760345107410,
+        2323.28207385341102053644136,
+        -1556.09706258695996439200826,
+        -778.62641159635631993296556,
+        -1.15576060575267547392286,
+        -781.46821939127221412491053,
+        -3.99756840066855811954838,
+        773.47308258993507479317486,
+        -6.83937619558446385781281,
+        770.63127479501918060122989,
+        1548.10192578562282506027259,
+        -784.86732325608647897752235,
+        -7.39667226548281497855442,
+        770.07397872512080994056305,
+        -10.23848006039872871042462,
+        767.23217093020491574861808,
+        1544.70282192080867389449850,
+        764.39036313528902155667311,
+        1541.86101412589277970255353,
+        2319.33166511649642416159622,
+        -13.63758392521276618936099,
+        763.83306706539087826968171,
+        1541.30371805599452272872441,
+        760.99125927047487039089901,
+        1538.46191026107862853677943,
+        2315.93256125168227299582213,
+        1535.62010246616273434483446,
+        2313.09075345676637880387716,
+        3090.56140444737002326291986,
+    },
+    {
+        -3127.04776909088741376763210,
+        -2343.86826780720048191142268,
+        -1560.68876652351309530786239,
+        -2344.44067036021533567691222,
+        -1561.26116907652772169967648,
+        -778.08166779284044878295390,
+        -1561.83357162954280283884145,
+        -778.65407034585541623528115,
+        4.52543093783197036827914,
+        -2345.58446263521454966394231,
+        -1562.40496135152716306038201,
+        -779.22546006783989014365943,
+        -1562.97736390454201682587154,
+        -779.79786262085485759598669,
+        3.38163866283252900757361,
+        -780.37026517386971136147622,
+        2.80923610981761129323786,
+        785.98873739350494815880666,
+        -1564.12115617954168556025252,
+        -780.94165489585441264352994,
+        2.23784638783297396003036,
+        -781.51405744886926640901947,
+        1.66544383481804514346436,
+        784.84494511850539311126340,
+        1.09304128180315274221357,
+        784.27254256549042565893615,
+        1567.45204384917769857565872,
+        -2347.29762143232983362395316,
+        -1564.11812014864221964671742,
+        -780.93861886495494672999484,
+        -1564.69052270165707341220696,
+        -781.51102141796980049548438,
+        1.66847986571758610807592,
+        -782.08342397098465426097391,
+        1.09607731270266839374017,
+        784.27557859639000525930896,
+        -1565.83431497665651477291249,
+        -782.65481369296935554302763,
+        0.52468759071803106053267,
+        -783.22721624598420930851717,
+        -0.04771496229691905843762,
+        783.13178632139045021176571,
+        -0.62011751531179015728412,
+        782.55938376837548275943846,
+        1565.73888505206286936299875,
+        -784.37100852098376435606042,
+        -1.19150723729644170134634,
+        781.98799404639089516422246,
+        -1.76390979031134520482738,
+        781.41559149337592771189520,
+        1564.59509277706320062861778,
+        780.84318894036118763324339,
+        1564.02269022404857423680369,
+        2347.20219150773573346668854,
+        -1567.54747377377157135924790,
+        -784.36797249008429844252532,
+        -1.18847120639691183896502,
+        -784.94037504309915220801486,
+        -1.76087375941184065553102,
+        781.41862752427550731226802,
+        -2.33327631242673305678181,
+        780.84622497126053985994076,
+        1564.02572625494804015033878,
+        -786.08416731809870725555811,
+        -2.90466603441138460084403,
+        780.27483524927595226472476,
+        -3.47706858742628810432507,
+        779.70243269626098481239751,
+        1562.88193397994837141595781,
+        779.13003014324613104690798,
+        1562.30953142693351765046827,
+        2345.48903271062090425402857,
+        -4.62086086242572946503060,
+        778.55864042126154345169198,
+        1561.73814170494893005525228,
+        777.98623786824668968620244,
+        1561.16573915193407628976274,
+        2344.34524043562123551964760,
+        1560.59333659891922252427321,
+        2343.77283788260638175415806,
+        3126.95233916629376835771836,
+    },
+};
+
@@ -15,6 +15,10 @@ Design Parameters:
 #include "arm_math.h"
 
 #define FIR_COEFFS_LEN    256
+#define FIR_COEFFS_FOLDED_LEN    128
 extern float32_t firCoeffs[FIR_COEFFS_LEN];
+extern const float32_t firNibbleSums[FIR_COEFFS_LEN / 4][16];
+extern const float32_t firCoeffsFolded[FIR_COEFFS_FOLDED_LEN];
+extern const float32_t firFoldedTernarySums[FIR_COEFFS_FOLDED_LEN / 4][81];
 
 #endif
@@ -26,16 +26,74 @@
 
 #include "ch.h"
 #include "hal.h"
-#include "autogen_fir_coeffs.h"
+#include "audio_beam.h"
+#include "audio_dsp.h"
+#include "audio_ns.h"
+#include "audio_slm.h"
+#include "config.h"
 #include "debug.h"
+#include "memory_sections.h"
 #include "mp45dt02_processing.h"
 
 /******************************************************************************/
 /* Hardware configuration */
 /******************************************************************************/
 
-/* ChibiOS I2S driver in use */
-#define MP45DT02_I2S_DRIVER                 I2SD2
+/* I2S ports read at once, see mp45dt02Drivers */
+#define MP45DT02_PORTS                      CONFIG_AUDIO_I2S_PORTS
+
+#if MP45DT02_PORTS != 1 && MP45DT02_PORTS != 2
+#error "CONFIG_AUDIO_I2S_PORTS must be 1 or 2"
+#endif
+
+/* Microphones sharing each data line. With two, the I2S clock runs at twice
+ * theirs so that both of their bits are read each microphone clock period. */
+#define MP45DT02_MICS_PER_PORT              CONFIG_AUDIO_MICS_PER_PORT
+
+#if MP45DT02_MICS_PER_PORT != 1 && MP45DT02_MICS_PER_PORT != 2
+#error "CONFIG_AUDIO_MICS_PER_PORT must be 1 or 2"
+#endif
+
+/* Channels, numbered through each port's microphones in turn */
+#define MP45DT02_CHANNELS                   (MP45DT02_PORTS * \
+                                             MP45DT02_MICS_PER_PORT)
+
+#if CONFIG_AUDIO_BEAM && MP45DT02_CHANNELS < 2
+#error "CONFIG_AUDIO_BEAM needs more than one microphone"
+#endif
+
+/* Channels after the beamformer, which combines every microphone into one */
+#define MP45DT02_OUTPUT_CHANNELS            (CONFIG_AUDIO_BEAM ? 1 : \
+                                             MP45DT02_CHANNELS)
+
+/* Where the state and buffers only the CPU touches are kept */
+#if CONFIG_AUDIO_DSP_CCM
+#define MP45DT02_DSP_MEMORY                 MEMORY_CCM
+#else
+#define MP45DT02_DSP_MEMORY
+#endif
+
+/* Noise suppression for more than two channels won't fit in CCM alongside
+ * their decimators, so is left in SRAM */
+#if MP45DT02_OUTPUT_CHANNELS > 2
+#define MP45DT02_NS_MEMORY
+#else
+#define MP45DT02_NS_MEMORY                  MP45DT02_DSP_MEMORY
+#endif
+
+/* A bit for each port, all set once every port has delivered a block */
+#define MP45DT02_PORTS_READY                ((1U << MP45DT02_PORTS) - 1)
+
+/* Words read over I2S per block, and in the buffer, for all microphones on a
+ * port */
+#define MP45DT02_I2S_BLOCK_WORDS            (MP45DT02_I2S_SAMPLE_SIZE_2B * \
+                                             MP45DT02_MICS_PER_PORT)
+#define MP45DT02_I2S_BUFFER_WORDS           (MP45DT02_I2S_BUFFER_SIZE_2B * \
+                                             MP45DT02_MICS_PER_PORT)
+
+/* Decimated samples per block, for all channels passed on */
+#define MP45DT02_BLOCK_SAMPLES              (MP45DT02_DECIMATED_BUFFER_SIZE * \
+                                             MP45DT02_OUTPUT_CHANNELS)
 
 /* STM32F4 configuration for the I2S configuration register */
 #define I2SCFG_MODE_MASTER_RECEIVE          (SPI_I2SCFGR_I2SCFG_0 | SPI_I2SCFGR_I2SCFG_1)
@@ -47,172 +105,589 @@
 #define I2SCFG_CKPOL_STEADY_HIGH            (SPI_I2SCFGR_CKPOL)
 
 /* STM32F4 configuration for I2S prescalar register */
-#define MP45DT02_I2SDIV                     42
+#define MP45DT02_I2SDIV                     (42 / MP45DT02_MICS_PER_PORT)
 #define MP45DT02_I2SODD                     0
 #define I2SPR_I2SODD_SHIFT                  8
 
+/* AGC settings not exposed in config.h */
+#define MP45DT02_AGC_MIN_GAIN_DB            -10
+#define MP45DT02_AGC_GATE_DBFS              -60
+#define MP45DT02_AGC_ATTACK_MS              20
+#define MP45DT02_AGC_RELEASE_MS             300
+#define MP45DT02_LIMITER_RELEASE_MS         50
+
+/* Noise suppression setting not exposed in config.h */
+#define MP45DT02_NS_NOISE_RISE_DB_S         3
+
+#if CONFIG_AUDIO_NS && AUDIO_NS_HOP % MP45DT02_DECIMATED_BUFFER_SIZE != 0
+#error "CONFIG_AUDIO_NS needs its hop to be a whole number of blocks"
+#endif
+
+/* Sound level meter reporting period, one report a second */
+#define MP45DT02_SLM_PERIOD_MS              1000
+
 /* Debugging - check for buffer overflows */
 #define MEMORY_GUARD                        0xDEADBEEF
 
-static struct {
+/* The decimation of an I2S port's microphones. Kept apart from the port, as
+ * only the CPU touches it. */
+typedef struct {
+    /* A decimator for each microphone */
+    audioDsp dsp[MP45DT02_MICS_PER_PORT];
+#if MP45DT02_MICS_PER_PORT > 1
+    /* Each microphone's words, split from the block read */
+    uint16_t pdm[MP45DT02_MICS_PER_PORT][MP45DT02_I2S_SAMPLE_SIZE_2B];
+#endif
+    uint32_t guard;
+} mp45dt02PortDsp;
+
+/* One I2S port and the microphones on its data line. The buffer is written by
+ * DMA, so this must stay in SRAM. */
+typedef struct {
+    I2SDriver *driver;
+    I2SConfig i2sConfig;
+    /* Latest block, set by mp45dt02Cb() */
     uint32_t offset;
     uint32_t number;
-    uint16_t buffer[MP45DT02_I2S_BUFFER_SIZE_2B];
+    uint16_t buffer[MP45DT02_I2S_BUFFER_WORDS];
     uint32_t guard;
-} mp45dt02I2sData;
+    mp45dt02PortDsp *dsp;
+} mp45dt02Port;
+
+/* Both are I2S masters clocked from PLLI2S, so they run at exactly the same
+ * rate. SPI2 reads the microphone on the board, clocked by PB10 with data on
+ * PC3. SPI3 uses the pins wired to the CS43L22 DAC, clocked by PC10 with data
+ * on PC12, so the DAC can't be used alongside. */
+static I2SDriver *const mp45dt02Drivers[MP45DT02_PORTS] = {
+    &I2SD2,
+#if MP45DT02_PORTS > 1
+    &I2SD3,
+#endif
+};
 
+static mp45dt02Port mp45dt02Ports[MP45DT02_PORTS];
+static mp45dt02PortDsp mp45dt02PortDsps[MP45DT02_PORTS] MP45DT02_DSP_MEMORY;
+
+/* Written by mp45dt02Cb() for every port */
 static struct {
-    arm_fir_decimate_instance_f32 decimateInstance;
-    float32_t state[FIR_COEFFS_LEN + MP45DT02_EXPANDED_BUFFER_SIZE - 1];
-    uint32_t guard;
-} cmsisDsp;
+    /* Ports which have delivered a block the others have not yet */
+    uint32_t ready;
+    /* Realtime counter when the first port's block arrived */
+    rtcnt_t firstArrived;
+    /* When the latest block finished arriving on every port, and the
+     * realtime counter then */
+    systime_t time;
+    rtcnt_t arrived;
+    /* Blocks which arrived before the last was taken for processing. Kept
+     * across sessions. */
+    uint32_t overruns;
+    /* Longest between the first and last port's block arriving, in core
+     * clock cycles */
+    uint32_t worstSkewCycles;
+    /* Blocks dropped as a port delivered again before the others had caught
+     * up. Kept across sessions. */
+    uint32_t desyncs;
+} mp45dt02Capture;
+
+static time_measurement_t mp45dt02DspTime;
+
+/* Longest from a block arriving to the processing thread being done with it,
+ * in core clock cycles. Past a block's duration, the next is overrun. */
+static uint32_t mp45dt02WorstLatencyCycles;
+
+/* When the block being processed finished arriving */
+static systime_t mp45dt02BlockTime;
+
+#if CONFIG_AUDIO_BEAM
+/* Delays each microphone's PDM, then averages them once decimated. Steered
+ * by the control thread, hence the mutex. */
+static struct {
+    audioBeam beam;
+    mutex_t mutex;
+    time_measurement_t time;
+} mp45dt02Beam MP45DT02_DSP_MEMORY;
+#endif
+
+/* Applied to each channel after decimation, with the same bands. Kept
+ * across sessions and changed by the control thread, hence the mutex. */
+static struct {
+    audioEq eq[MP45DT02_OUTPUT_CHANNELS];
+    mutex_t mutex;
+    time_measurement_t time;
+} mp45dt02Eq MP45DT02_DSP_MEMORY;
+
+#if CONFIG_AUDIO_NS
+/* Noise suppression of each channel after the EQ. Restarts with each
+ * session. */
+static struct {
+    audioNs ns[MP45DT02_OUTPUT_CHANNELS];
+    time_measurement_t time;
+} mp45dt02Ns MP45DT02_NS_MEMORY;
+#endif
+
+#if CONFIG_AUDIO_SLM
+/* Sound level meter of the first channel, before the EQ, so the levels are
+ * those at the microphone. Restarts with each session. */
+static struct {
+    audioSlm slm;
+    time_measurement_t time;
+} mp45dt02Slm MP45DT02_DSP_MEMORY;
+#endif
+
+/* Metering of the microphones' level, over all channels. Restarts with each
+ * session. */
+static struct {
+    audioMeter meter;
+    time_measurement_t time;
+} mp45dt02Meter MP45DT02_DSP_MEMORY;
+
+/* Applied last, so nothing clips when converted to 16 bit. The gain is shared
+ * by all channels, keeping their balance. Restarts with each session. */
+static struct {
+    audioAgc agc;
+    time_measurement_t time;
+} mp45dt02Agc MP45DT02_DSP_MEMORY;
 
 static thread_t *pMp45dt02ProcessingThd;
 static THD_WORKING_AREA(mp45dt02ProcessingThdWA, 1024);
 static semaphore_t mp45dt02ProcessingSem;
 
-static I2SConfig mp45dt02I2SConfig;
+static float32_t mp45dt02DecimatedBuffer[MP45DT02_CHANNELS]
+                                        [MP45DT02_DECIMATED_BUFFER_SIZE]
+                                        MP45DT02_DSP_MEMORY;
 
-static float32_t mp45dt02ExpandedBuffer[MP45DT02_EXPANDED_BUFFER_SIZE];
-static float32_t mp45dt02DecimatedBuffer[MP45DT02_DECIMATED_BUFFER_SIZE];
+#if MP45DT02_OUTPUT_CHANNELS > 1
+/* Frames of all channels, as passed on */
+static float32_t mp45dt02InterleavedBuffer[MP45DT02_BLOCK_SAMPLES]
+                                          MP45DT02_DSP_MEMORY;
+#endif
 
 static mp45dt02Config initConfig;
 
-/* 
- * outBuffer: Array of floats, where each element is derived from an input in
- *            inBuffer.
- *            It must be of length MP45DT02_EXPANDED_BUFFER_SIZE
- * inBuffer: Array of I2S data that is to be expanded to a more useful datatype
- *           by this function.
- *           It must be of length MP45DT02_I2S_SAMPLE_SIZE_2B
- */
-static void expand(float32_t *outBuffer,
-                   const uint16_t *inBuffer)
+/* The microphone's PDM, delayed for the beamformer if there is one */
+static const uint16_t *mp45dt02Steer(uint32_t channel, const uint16_t *pdm)
 {
-    uint32_t bitIndex = 0;
-    uint16_t modifiedCurrentWord = 0;
+#if CONFIG_AUDIO_BEAM
+    return audioBeamDelay(&mp45dt02Beam.beam, channel, pdm);
+#else
+    (void)channel;
+    return pdm;
+#endif
+}
 
-    memset(outBuffer, 0, sizeof(MP45DT02_EXPANDED_BUFFER_SIZE));
+/* Decimates the latest block read by the port into a block for each of its
+ * microphones, the first being channel */
+static void mp45dt02PortProcess(mp45dt02Port *port,
+                                uint32_t channel,
+                                float32_t *const *channels)
+{
+    const uint16_t *words = &port->buffer[port->offset];
+    mp45dt02PortDsp *dsp = port->dsp;
+    uint32_t mic = 0;
 
-    /* Move each bit from each uint16_t word to an element of output array. */
-    for(bitIndex=0;
-        bitIndex < MP45DT02_I2S_SAMPLE_SIZE_BITS;
-        bitIndex++)
+    if (port->number != MP45DT02_I2S_BLOCK_WORDS)
     {
-        if (bitIndex % 16 == 0)
-        {
-            modifiedCurrentWord = inBuffer[bitIndex/MP45DT02_I2S_WORD_SIZE_BITS];
-        }
+        PRINT_CRITICAL("Unexpected number of samples provided. %d not %d.",
+                       port->number,
+                       MP45DT02_I2S_BLOCK_WORDS);
+    }
 
-        if (modifiedCurrentWord & 0x8000)
-        {
-            outBuffer[bitIndex] = INT16_MAX;
-        }
-        else 
-        {
-            outBuffer[bitIndex] = INT16_MIN;
-        }
+#if MP45DT02_MICS_PER_PORT > 1
+    audioDspDeinterleave(words,
+                         MP45DT02_I2S_BLOCK_WORDS,
+                         dsp->pdm[0],
+                         dsp->pdm[1]);
 
-        modifiedCurrentWord = modifiedCurrentWord << 1;
+    for (mic = 0; mic < MP45DT02_MICS_PER_PORT; mic++)
+    {
+        audioDspProcess(&dsp->dsp[mic],
+                        mp45dt02Steer(channel + mic, dsp->pdm[mic]),
+                        channels[channel + mic]);
+    }
+#else
+    audioDspProcess(&dsp->dsp[mic],
+                    mp45dt02Steer(channel, words),
+                    channels[channel]);
+#endif
+
+    if (port->guard != MEMORY_GUARD || dsp->guard != MEMORY_GUARD)
+    {
+        PRINT_CRITICAL("Overflow detected.",0);
     }
 }
 
 static THD_FUNCTION(mp45dt02ProcessingThd, arg)
 {
+    float32_t *channels[MP45DT02_CHANNELS];
+    float32_t *output = mp45dt02DecimatedBuffer[0];
+    uint32_t channel = 0;
+    uint32_t port = 0;
+    rtcnt_t arrived = 0;
+    uint32_t latency = 0;
+#if CONFIG_AUDIO_SLM
+    audioSlmLevels levels;
+    bool levelsComplete = false;
+#endif
+
     (void)arg;
 
     chRegSetThreadName(__FUNCTION__);
 
+    for (channel = 0; channel < MP45DT02_CHANNELS; channel++)
+    {
+        channels[channel] = mp45dt02DecimatedBuffer[channel];
+    }
+
+#if MP45DT02_OUTPUT_CHANNELS > 1
+    output = mp45dt02InterleavedBuffer;
+#endif
+
     while (chThdShouldTerminateX() == false)
     {
         chSemWait(&mp45dt02ProcessingSem);
-        
+
         if (chThdShouldTerminateX() == true)
         {
             break;
         }
 
-        if (mp45dt02I2sData.number != MP45DT02_I2S_SAMPLE_SIZE_2B)
+        /**********************************************************************/
+        /* Convert I2S data to PCM                                            */
+        /**********************************************************************/
+
+        mp45dt02BlockTime = mp45dt02Capture.time;
+        arrived = mp45dt02Capture.arrived;
+
+#if CONFIG_AUDIO_BEAM
+        chMtxLock(&mp45dt02Beam.mutex);
+#endif
+
+        /* Every port's block is processed on the one wake up */
+        chTMStartMeasurementX(&mp45dt02DspTime);
+
+        for (port = 0; port < MP45DT02_PORTS; port++)
         {
-            PRINT_CRITICAL("Unexpected number of samples provided. %d not %d.",
-                           mp45dt02I2sData.number,
-                           MP45DT02_I2S_SAMPLE_SIZE_2B);
+            mp45dt02PortProcess(&mp45dt02Ports[port],
+                                port * MP45DT02_MICS_PER_PORT,
+                                channels);
         }
 
-        /**********************************************************************/ 
-        /* Convert I2S data to a useful format                                */
-        /**********************************************************************/ 
+        chTMStopMeasurementX(&mp45dt02DspTime);
+
+#if CONFIG_AUDIO_BEAM
+        chTMStartMeasurementX(&mp45dt02Beam.time);
 
-        expand(mp45dt02ExpandedBuffer,
-               &mp45dt02I2sData.buffer[mp45dt02I2sData.offset]);
+        audioBeamSum(&mp45dt02Beam.beam,
+                     channels,
+                     MP45DT02_DECIMATED_BUFFER_SIZE,
+                     output);
 
-        /**********************************************************************/ 
-        /* Filtering                                                          */
-        /**********************************************************************/ 
+        chTMStopMeasurementX(&mp45dt02Beam.time);
+        chMtxUnlock(&mp45dt02Beam.mutex);
+#endif
 
-        arm_fir_decimate_f32(&cmsisDsp.decimateInstance,
-                             mp45dt02ExpandedBuffer,
-                             mp45dt02DecimatedBuffer,
-                             MP45DT02_EXPANDED_BUFFER_SIZE);
+#if CONFIG_AUDIO_SLM
+        chTMStartMeasurementX(&mp45dt02Slm.time);
 
-        /**********************************************************************/ 
-        /* Notify of new data                                                 */
-        /**********************************************************************/ 
+        levelsComplete = audioSlmProcess(&mp45dt02Slm.slm,
+                                         channels[0],
+                                         MP45DT02_DECIMATED_BUFFER_SIZE);
+
+        chTMStopMeasurementX(&mp45dt02Slm.time);
+
+        if (levelsComplete && initConfig.levelsCb != NULL)
+        {
+            audioSlmGetLevels(&mp45dt02Slm.slm, &levels);
+            initConfig.levelsCb(&levels);
+        }
+#endif
 
-        initConfig.fullbufferCb(mp45dt02DecimatedBuffer, 
-                                MP45DT02_DECIMATED_BUFFER_SIZE);
+        chMtxLock(&mp45dt02Eq.mutex);
+        chTMStartMeasurementX(&mp45dt02Eq.time);
 
-        if (mp45dt02I2sData.guard != MEMORY_GUARD)
+        for (channel = 0; channel < MP45DT02_OUTPUT_CHANNELS; channel++)
         {
-            PRINT_CRITICAL("Overflow detected.",0);
+            audioEqProcess(&mp45dt02Eq.eq[channel],
+                           channels[channel],
+                           MP45DT02_DECIMATED_BUFFER_SIZE);
         }
-        if (cmsisDsp.guard != MEMORY_GUARD)
+
+        chTMStopMeasurementX(&mp45dt02Eq.time);
+        chMtxUnlock(&mp45dt02Eq.mutex);
+
+#if CONFIG_AUDIO_NS
+        /* Spreads each frame over the blocks of a hop, so this is the cost of
+         * one block rather than one frame */
+        chTMStartMeasurementX(&mp45dt02Ns.time);
+
+        for (channel = 0; channel < MP45DT02_OUTPUT_CHANNELS; channel++)
         {
-            PRINT_CRITICAL("Overflow detected.",0);
+            audioNsProcess(&mp45dt02Ns.ns[channel],
+                           channels[channel],
+                           MP45DT02_DECIMATED_BUFFER_SIZE);
+        }
+
+        chTMStopMeasurementX(&mp45dt02Ns.time);
+#endif
+
+#if MP45DT02_OUTPUT_CHANNELS > 1
+        audioDspInterleave(channels,
+                           MP45DT02_CHANNELS,
+                           MP45DT02_DECIMATED_BUFFER_SIZE,
+                           output);
+#endif
+
+        chTMStartMeasurementX(&mp45dt02Meter.time);
+
+        audioMeterProcess(&mp45dt02Meter.meter,
+                          output,
+                          MP45DT02_BLOCK_SAMPLES);
+
+        chTMStopMeasurementX(&mp45dt02Meter.time);
+
+        chTMStartMeasurementX(&mp45dt02Agc.time);
+
+        audioAgcProcess(&mp45dt02Agc.agc,
+                        output,
+                        MP45DT02_BLOCK_SAMPLES);
+
+        chTMStopMeasurementX(&mp45dt02Agc.time);
+
+        /**********************************************************************/
+        /* Notify of new data                                                 */
+        /**********************************************************************/
+
+        initConfig.fullbufferCb(output, MP45DT02_BLOCK_SAMPLES);
+
+        /* Includes waiting to be scheduled and sending the block on, so
+         * shows what's left of the deadline with the network busy */
+        latency = chSysGetRealtimeCounterX() - arrived;
+
+        if (latency > mp45dt02WorstLatencyCycles)
+        {
+            mp45dt02WorstLatencyCycles = latency;
         }
     }
 }
 
-/* (*i2scallback_t) */
+/* (*i2scallback_t)
+ * Shared by the ports. The processing thread is only woken once every port
+ * has delivered its block. */
 static void mp45dt02Cb(I2SDriver *i2sp, size_t offset, size_t number)
 {
-    (void)i2sp;
+    rtcnt_t now = chSysGetRealtimeCounterX();
+    uint32_t port = MP45DT02_PORTS - 1;
+    uint32_t skew = 0;
+
+    while (port > 0 && mp45dt02Ports[port].driver != i2sp)
+    {
+        port--;
+    }
 
     chSysLockFromISR();
-    mp45dt02I2sData.offset = offset;
-    mp45dt02I2sData.number = number;
-    chSemSignalI(&mp45dt02ProcessingSem);
+
+    /* The others missed a block, so the one held for this port is dropped
+     * and the batch starts again from this block */
+    if (mp45dt02Capture.ready & (1U << port))
+    {
+        mp45dt02Capture.desyncs++;
+        mp45dt02Capture.ready = 0;
+    }
+
+    mp45dt02Ports[port].offset = offset;
+    mp45dt02Ports[port].number = number;
+
+    if (mp45dt02Capture.ready == 0)
+    {
+        mp45dt02Capture.firstArrived = now;
+    }
+
+    mp45dt02Capture.ready |= 1U << port;
+
+    if (mp45dt02Capture.ready == MP45DT02_PORTS_READY)
+    {
+        mp45dt02Capture.ready = 0;
+
+        skew = now - mp45dt02Capture.firstArrived;
+        if (skew > mp45dt02Capture.worstSkewCycles)
+        {
+            mp45dt02Capture.worstSkewCycles = skew;
+        }
+
+        if (chSemGetCounterI(&mp45dt02ProcessingSem) > 0)
+        {
+            mp45dt02Capture.overruns++;
+        }
+
+        mp45dt02Capture.time = chVTGetSystemTimeX();
+        mp45dt02Capture.arrived = now;
+        chSemSignalI(&mp45dt02ProcessingSem);
+    }
+
     chSysUnlockFromISR();
 }
 
+static void portInit(mp45dt02Port *port,
+                     mp45dt02PortDsp *dsp,
+                     I2SDriver *driver)
+{
+    StatusCode status = STATUS_OK;
+    uint32_t mic = 0;
+
+    port->driver = driver;
+    port->dsp = dsp;
+
+    for (mic = 0; mic < MP45DT02_MICS_PER_PORT; mic++)
+    {
+        status = audioDspInit(&dsp->dsp[mic], CONFIG_AUDIO_DSP_KERNEL);
+
+        if (STATUS_OK != status)
+        {
+            PRINT_CRITICAL("audioDspInit failed with %s",
+                           statusCodeToString(status));
+        }
+    }
+
+    dsp->guard = MEMORY_GUARD;
+
+    memset(port->buffer, 0, sizeof(port->buffer));
+    port->guard = MEMORY_GUARD;
+
+    memset(&port->i2sConfig, 0, sizeof(port->i2sConfig));
+    port->i2sConfig.tx_buffer = NULL;
+    port->i2sConfig.rx_buffer = port->buffer;
+    port->i2sConfig.size      = MP45DT02_I2S_BUFFER_WORDS;
+    port->i2sConfig.end_cb    = mp45dt02Cb;
+
+    port->i2sConfig.i2scfgr   = I2SCFG_MODE_MASTER_RECEIVE    |
+                                I2SCFG_STD_MSB_JUSTIFIED      |
+                                I2SCFG_CKPOL_STEADY_HIGH;
+
+    port->i2sConfig.i2spr     = (SPI_I2SPR_I2SDIV & MP45DT02_I2SDIV) |
+                                (SPI_I2SPR_ODD & (MP45DT02_I2SODD << I2SPR_I2SODD_SHIFT));
+}
+
 static void dspInit(void)
 {
-    arm_status armStatus;
-
-    memset(&cmsisDsp, 0, sizeof(cmsisDsp));
-    cmsisDsp.guard = MEMORY_GUARD;
-
-    if (ARM_MATH_SUCCESS != (armStatus = arm_fir_decimate_init_f32(
-                                            &cmsisDsp.decimateInstance,
-                                            FIR_COEFFS_LEN,
-                                            MP45DT02_FIR_DECIMATION_FACTOR,
-                                            firCoeffs,
-                                            cmsisDsp.state,
-                                            MP45DT02_EXPANDED_BUFFER_SIZE)))
+    StatusCode status = STATUS_OK;
+    audioAgcConfig agcConfig;
+#if CONFIG_AUDIO_NS
+    audioNsConfig nsConfig;
+    uint32_t channel = 0;
+#endif
+#if CONFIG_AUDIO_SLM
+    audioSlmConfig slmConfig;
+#endif
+#if CONFIG_AUDIO_BEAM
+    float positions[MP45DT02_CHANNELS];
+#endif
+
+    /* The meter and AGC see interleaved frames as one channel, at
+     * MP45DT02_OUTPUT_CHANNELS times the rate */
+    audioMeterInit(&mp45dt02Meter.meter,
+                   MP45DT02_BLOCK_SAMPLES * 1000 /
+                   MP45DT02_RAW_SAMPLE_DURATION_MS,
+                   MP45DT02_BLOCK_SAMPLES);
+
+    memset(&agcConfig, 0, sizeof(agcConfig));
+    agcConfig.sampleRate = MP45DT02_BLOCK_SAMPLES * 1000 /
+                           MP45DT02_RAW_SAMPLE_DURATION_MS;
+    agcConfig.blockSamples = MP45DT02_BLOCK_SAMPLES;
+    agcConfig.targetDbfs = CONFIG_AUDIO_AGC_TARGET_DBFS;
+    agcConfig.minGainDb = CONFIG_AUDIO_AGC ? MP45DT02_AGC_MIN_GAIN_DB : 0;
+    agcConfig.maxGainDb = CONFIG_AUDIO_AGC ? CONFIG_AUDIO_AGC_MAX_GAIN_DB : 0;
+    agcConfig.gateDbfs = MP45DT02_AGC_GATE_DBFS;
+    agcConfig.attackMs = MP45DT02_AGC_ATTACK_MS;
+    agcConfig.releaseMs = MP45DT02_AGC_RELEASE_MS;
+    agcConfig.limiterDbfs = CONFIG_AUDIO_LIMITER_DBFS;
+    agcConfig.lookaheadSamples = CONFIG_AUDIO_LIMITER_LOOKAHEAD_MS *
+                                 MP45DT02_BLOCK_SAMPLES /
+                                 MP45DT02_RAW_SAMPLE_DURATION_MS;
+    agcConfig.limiterReleaseMs = MP45DT02_LIMITER_RELEASE_MS;
+
+    status = audioAgcInit(&mp45dt02Agc.agc, &agcConfig);
+
+    if (STATUS_OK != status)
     {
-        PRINT_CRITICAL("arm_fir_decimate_init_f32 failed with %d", armStatus);
+        PRINT_CRITICAL("audioAgcInit failed with %s",
+                       statusCodeToString(status));
     }
+
+#if CONFIG_AUDIO_BEAM
+    /* Clears the delay lines, keeping the steering */
+    chMtxLock(&mp45dt02Beam.mutex);
+    memcpy(positions, mp45dt02Beam.beam.positions, sizeof(positions));
+    status = audioBeamInit(&mp45dt02Beam.beam,
+                           MP45DT02_CHANNELS,
+                           positions,
+                           mp45dt02Beam.beam.steerDegrees);
+    chMtxUnlock(&mp45dt02Beam.mutex);
+
+    if (STATUS_OK != status)
+    {
+        PRINT_CRITICAL("audioBeamInit failed with %s",
+                       statusCodeToString(status));
+    }
+
+    chTMObjectInit(&mp45dt02Beam.time);
+#endif
+
+#if CONFIG_AUDIO_NS
+    memset(&nsConfig, 0, sizeof(nsConfig));
+    nsConfig.sampleRate = MP45DT02_DECIMATED_BUFFER_SIZE * 1000 /
+                          MP45DT02_RAW_SAMPLE_DURATION_MS;
+    nsConfig.blockSamples = MP45DT02_DECIMATED_BUFFER_SIZE;
+    nsConfig.maxAttenuationDb = CONFIG_AUDIO_NS_MAX_ATTENUATION_DB;
+    nsConfig.noiseRiseDbS = MP45DT02_NS_NOISE_RISE_DB_S;
+
+    for (channel = 0; channel < MP45DT02_OUTPUT_CHANNELS; channel++)
+    {
+        status = audioNsInit(&mp45dt02Ns.ns[channel], &nsConfig);
+
+        if (STATUS_OK != status)
+        {
+            PRINT_CRITICAL("audioNsInit failed with %s",
+                           statusCodeToString(status));
+        }
+    }
+
+    chTMObjectInit(&mp45dt02Ns.time);
+#endif
+
+#if CONFIG_AUDIO_SLM
+    memset(&slmConfig, 0, sizeof(slmConfig));
+    slmConfig.sampleRate = MP45DT02_DECIMATED_BUFFER_SIZE * 1000 /
+                           MP45DT02_RAW_SAMPLE_DURATION_MS;
+    slmConfig.blockSamples = MP45DT02_DECIMATED_BUFFER_SIZE;
+    slmConfig.calibrationDb = CONFIG_AUDIO_SLM_CALIBRATION_DB;
+    slmConfig.periodMs = MP45DT02_SLM_PERIOD_MS;
+
+    status = audioSlmInit(&mp45dt02Slm.slm, &slmConfig);
+
+    if (STATUS_OK != status)
+    {
+        PRINT_CRITICAL("audioSlmInit failed with %s",
+                       statusCodeToString(status));
+    }
+
+    chTMObjectInit(&mp45dt02Slm.time);
+#endif
+
+    chTMObjectInit(&mp45dt02DspTime);
+    chTMObjectInit(&mp45dt02Eq.time);
+    chTMObjectInit(&mp45dt02Meter.time);
+    chTMObjectInit(&mp45dt02Agc.time);
 }
 
 void mp45dt02Init(mp45dt02Config *config)
 {
+    uint32_t port = 0;
+
 #if 0
     PRINT("Initialising mp45dt02.\n\r"
-          "mp45dt02I2sData.buffer size: %u words %u bytes\n\r"
-          "mp45dt02ExpandedBuffer size: %u words %u bytes\n\r"
+          "mp45dt02Ports size: %u bytes\n\r"
           "MP45DT02_DECIMATED_BUFFER_SIZE: %u",
-          MP45DT02_I2S_BUFFER_SIZE_2B, sizeof(mp45dt02I2sData.buffer),
-          MP45DT02_EXPANDED_BUFFER_SIZE, sizeof(mp45dt02ExpandedBuffer),
+          sizeof(mp45dt02Ports),
           MP45DT02_DECIMATED_BUFFER_SIZE);
 #endif
 
@@ -227,30 +702,35 @@ void mp45dt02Init(mp45dt02Config *config)
 
     dspInit();
 
-    memset(&mp45dt02I2sData, 0, sizeof(mp45dt02I2sData));
-    mp45dt02I2sData.guard = MEMORY_GUARD;
+    mp45dt02Capture.ready = 0;
+    mp45dt02Capture.worstSkewCycles = 0;
+    mp45dt02WorstLatencyCycles = 0;
 
-    memset(&mp45dt02I2SConfig, 0, sizeof(mp45dt02I2SConfig));
-    mp45dt02I2SConfig.tx_buffer = NULL;
-    mp45dt02I2SConfig.rx_buffer = mp45dt02I2sData.buffer;
-    mp45dt02I2SConfig.size      = MP45DT02_I2S_BUFFER_SIZE_2B;
-    mp45dt02I2SConfig.end_cb    = mp45dt02Cb;
-
-    mp45dt02I2SConfig.i2scfgr   = I2SCFG_MODE_MASTER_RECEIVE    |
-                                  I2SCFG_STD_MSB_JUSTIFIED      |
-                                  I2SCFG_CKPOL_STEADY_HIGH;
-
-    mp45dt02I2SConfig.i2spr     = (SPI_I2SPR_I2SDIV & MP45DT02_I2SDIV) |
-                                  (SPI_I2SPR_ODD & (MP45DT02_I2SODD << I2SPR_I2SODD_SHIFT));
+    for (port = 0; port < MP45DT02_PORTS; port++)
+    {
+        portInit(&mp45dt02Ports[port],
+                 &mp45dt02PortDsps[port],
+                 mp45dt02Drivers[port]);
+        i2sStart(mp45dt02Ports[port].driver, &mp45dt02Ports[port].i2sConfig);
+    }
 
-    i2sStart(&MP45DT02_I2S_DRIVER, &mp45dt02I2SConfig);
-    i2sStartExchange(&MP45DT02_I2S_DRIVER);
+    /* Started back to back, so their blocks arrive within a few cycles of
+     * each other */
+    for (port = 0; port < MP45DT02_PORTS; port++)
+    {
+        i2sStartExchange(mp45dt02Ports[port].driver);
+    }
 }
 
 void mp45dt02Shutdown(void)
 {
-    i2sStopExchange(&MP45DT02_I2S_DRIVER);
-    i2sStop(&MP45DT02_I2S_DRIVER);
+    uint32_t port = 0;
+
+    for (port = 0; port < MP45DT02_PORTS; port++)
+    {
+        i2sStopExchange(mp45dt02Ports[port].driver);
+        i2sStop(mp45dt02Ports[port].driver);
+    }
 
     chThdTerminate(pMp45dt02ProcessingThd);
     chSemReset(&mp45dt02ProcessingSem, 1);
@@ -258,3 +738,223 @@ void mp45dt02Shutdown(void)
     pMp45dt02ProcessingThd = NULL;
 }
 
+/* Cycle counts cover the current session, as they are reset by
+ * mp45dt02Init() */
+void mp45dt02GetDspStats(mp45dt02DspStats *stats)
+{
+    stats->kernel = audioDspKernelName(CONFIG_AUDIO_DSP_KERNEL);
+    stats->channels = MP45DT02_CHANNELS;
+    stats->ports = MP45DT02_PORTS;
+    stats->worstSkewCycles = mp45dt02Capture.worstSkewCycles;
+    stats->blocks = mp45dt02DspTime.n;
+    stats->overruns = mp45dt02Capture.overruns;
+    stats->desyncs = mp45dt02Capture.desyncs;
+    stats->lastCycles = mp45dt02DspTime.last;
+    stats->bestCycles = mp45dt02DspTime.n ? mp45dt02DspTime.best : 0;
+    stats->worstCycles = mp45dt02DspTime.worst;
+    stats->worstLatencyCycles = mp45dt02WorstLatencyCycles;
+    stats->meanCycles = mp45dt02DspTime.n ?
+                        mp45dt02DspTime.cumulative / mp45dt02DspTime.n : 0;
+#if CONFIG_AUDIO_BEAM
+    stats->beamChannels = MP45DT02_CHANNELS;
+    stats->beamSteerDegrees = mp45dt02Beam.beam.steerDegrees;
+    stats->beamMeanCycles = mp45dt02Beam.time.n ?
+                            mp45dt02Beam.time.cumulative /
+                            mp45dt02Beam.time.n : 0;
+#else
+    stats->beamChannels = 0;
+    stats->beamSteerDegrees = 0;
+    stats->beamMeanCycles = 0;
+#endif
+#if CONFIG_AUDIO_NS
+    audioNsGetStats(&mp45dt02Ns.ns[0], &stats->ns);
+    stats->nsMeanCycles = mp45dt02Ns.time.n ?
+                          mp45dt02Ns.time.cumulative / mp45dt02Ns.time.n : 0;
+    stats->nsWorstCycles = mp45dt02Ns.time.worst;
+#else
+    memset(&stats->ns, 0, sizeof(stats->ns));
+    stats->nsMeanCycles = 0;
+    stats->nsWorstCycles = 0;
+#endif
+#if CONFIG_AUDIO_SLM
+    audioSlmGetLevels(&mp45dt02Slm.slm, &stats->slm);
+    stats->slmMeanCycles = mp45dt02Slm.time.n ?
+                           mp45dt02Slm.time.cumulative / mp45dt02Slm.time.n : 0;
+#else
+    memset(&stats->slm, 0, sizeof(stats->slm));
+    stats->slmMeanCycles = 0;
+#endif
+    stats->eqStages = mp45dt02Eq.eq[0].stages;
+    stats->eqMeanCycles = mp45dt02Eq.time.n ?
+                          mp45dt02Eq.time.cumulative / mp45dt02Eq.time.n : 0;
+    stats->eqWorstCycles = mp45dt02Eq.time.worst;
+    audioMeterGetStats(&mp45dt02Meter.meter, &stats->meter);
+    stats->meterMeanCycles = mp45dt02Meter.time.n ?
+                             mp45dt02Meter.time.cumulative /
+                             mp45dt02Meter.time.n : 0;
+    audioAgcGetStats(&mp45dt02Agc.agc, &stats->agc);
+    stats->agcMeanCycles = mp45dt02Agc.time.n ?
+                           mp45dt02Agc.time.cumulative / mp45dt02Agc.time.n : 0;
+    stats->agcWorstCycles = mp45dt02Agc.time.worst;
+}
+
+/* Interleaved channels passed to the full buffer callback */
+uint32_t mp45dt02GetChannels(void)
+{
+    return MP45DT02_OUTPUT_CHANNELS;
+}
+
+/* Blocks the processing thread has missed since boot */
+uint32_t mp45dt02GetOverruns(void)
+{
+    return mp45dt02Capture.overruns;
+}
+
+/* System time the block being processed finished arriving, i.e. the end of
+ * its capture. For use from the full buffer callback. */
+uint32_t mp45dt02GetBlockTime(void)
+{
+    return mp45dt02BlockTime;
+}
+
+/* Microseconds the processing delays the audio by, after the block arrives.
+ * The audio passed to the full buffer callback was captured this much before
+ * mp45dt02GetBlockTime(). */
+uint32_t mp45dt02GetLatencyUs(void)
+{
+    uint32_t samples = CONFIG_AUDIO_LIMITER_LOOKAHEAD_MS *
+                       MP45DT02_DECIMATED_BUFFER_SIZE /
+                       MP45DT02_RAW_SAMPLE_DURATION_MS;
+
+#if CONFIG_AUDIO_NS
+    samples += audioNsLatencySamples(&mp45dt02Ns.ns[0]);
+#endif
+
+    return samples * 1000 * MP45DT02_RAW_SAMPLE_DURATION_MS /
+           MP45DT02_DECIMATED_BUFFER_SIZE;
+}
+
+/* Nothing clears CCM at startup, and the stats can be read before the first
+ * session sets up what's kept there, so it's all cleared once at boot */
+static void mp45dt02MemoryInit(void)
+{
+    memset(mp45dt02PortDsps, 0, sizeof(mp45dt02PortDsps));
+    memset(mp45dt02DecimatedBuffer, 0, sizeof(mp45dt02DecimatedBuffer));
+#if MP45DT02_OUTPUT_CHANNELS > 1
+    memset(mp45dt02InterleavedBuffer, 0, sizeof(mp45dt02InterleavedBuffer));
+#endif
+#if CONFIG_AUDIO_BEAM
+    memset(&mp45dt02Beam, 0, sizeof(mp45dt02Beam));
+#endif
+    memset(&mp45dt02Eq, 0, sizeof(mp45dt02Eq));
+#if CONFIG_AUDIO_NS
+    memset(&mp45dt02Ns, 0, sizeof(mp45dt02Ns));
+#endif
+#if CONFIG_AUDIO_SLM
+    memset(&mp45dt02Slm, 0, sizeof(mp45dt02Slm));
+#endif
+    memset(&mp45dt02Meter, 0, sizeof(mp45dt02Meter));
+    memset(&mp45dt02Agc, 0, sizeof(mp45dt02Agc));
+}
+
+/* Called once, at boot, before mp45dt02BeamInit(). Band 0 is set up as a DC
+ * blocker, unless dcBlockerHz is 0, and the rest are off. */
+StatusCode mp45dt02EqInit(float dcBlockerHz)
+{
+    audioEqBand band;
+    uint32_t channel = 0;
+
+    mp45dt02MemoryInit();
+
+    chMtxObjectInit(&mp45dt02Eq.mutex);
+    chTMObjectInit(&mp45dt02Eq.time);
+
+    for (channel = 0; channel < MP45DT02_OUTPUT_CHANNELS; channel++)
+    {
+        audioEqInit(&mp45dt02Eq.eq[channel],
+                    MP45DT02_DECIMATED_BUFFER_SIZE * 1000 /
+                    MP45DT02_RAW_SAMPLE_DURATION_MS);
+    }
+
+    if (dcBlockerHz == 0)
+    {
+        return STATUS_OK;
+    }
+
+    memset(&band, 0, sizeof(band));
+    band.type = AUDIO_EQ_HIGHPASS;
+    band.frequency = dcBlockerHz;
+    band.q = 0.707f;
+
+    return mp45dt02SetEqBand(0, &band);
+}
+
+/* Sets the band for every channel */
+StatusCode mp45dt02SetEqBand(uint32_t index, const audioEqBand *band)
+{
+    StatusCode status = STATUS_OK;
+    uint32_t channel = 0;
+
+    chMtxLock(&mp45dt02Eq.mutex);
+
+    for (channel = 0; channel < MP45DT02_OUTPUT_CHANNELS && STATUS_OK == status;
+         channel++)
+    {
+        status = audioEqSetBand(&mp45dt02Eq.eq[channel], index, band);
+    }
+
+    chMtxUnlock(&mp45dt02Eq.mutex);
+
+    return status;
+}
+
+void mp45dt02GetEqBand(uint32_t index, audioEqBand *band)
+{
+    chMtxLock(&mp45dt02Eq.mutex);
+    audioEqGetBand(&mp45dt02Eq.eq[0], index, band);
+    chMtxUnlock(&mp45dt02Eq.mutex);
+}
+
+/* Called once, at boot. The microphones are taken to be in a line,
+ * CONFIG_AUDIO_BEAM_SPACING_MM apart in channel order. Does nothing without
+ * CONFIG_AUDIO_BEAM. */
+StatusCode mp45dt02BeamInit(float steerDegrees)
+{
+#if CONFIG_AUDIO_BEAM
+    float positions[MP45DT02_CHANNELS];
+    uint32_t channel = 0;
+
+    chMtxObjectInit(&mp45dt02Beam.mutex);
+    chTMObjectInit(&mp45dt02Beam.time);
+
+    for (channel = 0; channel < MP45DT02_CHANNELS; channel++)
+    {
+        positions[channel] = channel * CONFIG_AUDIO_BEAM_SPACING_MM / 1000.0f;
+    }
+
+    return audioBeamInit(&mp45dt02Beam.beam,
+                         MP45DT02_CHANNELS,
+                         positions,
+                         steerDegrees);
+#else
+    (void)steerDegrees;
+    return STATUS_OK;
+#endif
+}
+
+/* Degrees from broadside, towards the last channel */
+StatusCode mp45dt02SetBeamSteer(float steerDegrees)
+{
+#if CONFIG_AUDIO_BEAM
+    StatusCode status = STATUS_OK;
+
+    chMtxLock(&mp45dt02Beam.mutex);
+    status = audioBeamSteer(&mp45dt02Beam.beam, steerDegrees);
+    chMtxUnlock(&mp45dt02Beam.mutex);
+
+    return status;
+#else
+    (void)steerDegrees;
+    return STATUS_ERROR_API;
+#endif
+}
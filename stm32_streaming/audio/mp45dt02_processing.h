@@ -27,6 +27,14 @@
 #ifndef __MP45DT02_PDM_H__
 #define __MP45DT02_PDM_H__
 
+#include <stdint.h>
+#include "audio_agc.h"
+#include "audio_eq.h"
+#include "audio_meter.h"
+#include "audio_ns.h"
+#include "audio_slm.h"
+#include "status_code.h"
+
 /* Number of times interrupts are called when filling the buffer.
  * ChibiOS fires twice half full / full */
 #define MP45DT02_INTERRUPTS_PER_BUFFER      2
@@ -37,11 +45,17 @@
 /* Frequency at which the MP45DT02 is being (over) sampled. */
 #define MP45DT02_RAW_FREQ_KHZ               1024
 
-/* One raw sample provided to processing.*/
+/* Duration of each block read over I2S and processed, ms. The processing
+ * thread is woken once a block, so longer blocks spend less on waking it, at
+ * the cost of latency. Must divide the 20 ms payload, so 1, 2, 4, 5 or 10, and
+ * be 1, 2 or 4 for noise suppression and band energies, whose hops must be
+ * whole blocks. Set by the Makefile. */
+#ifndef MP45DT02_RAW_SAMPLE_DURATION_MS
 #define MP45DT02_RAW_SAMPLE_DURATION_MS     1
+#endif
 
 /******************************************************************************/
-/* I2S Buffer - Contains 2 ms of sampled data. Emptied every 1ms */
+/* I2S Buffer - Contains 2 blocks of sampled data. Emptied every block */
 /******************************************************************************/
 
 /* The number of bits in I2S word */
@@ -61,31 +75,93 @@
 /* Expanded Buffer - 1 ms worth of 1 bit samples */
 /******************************************************************************/
 
-/* Every bit in I2S signal needs to be expanded out into a word. */
-/* Note: I2S Interrupts are always fired at half/full buffer point. Thus
- * processed buffers require to be 0.5 * bits in one I2S buffer */
-#define MP45DT02_EXPANDED_BUFFER_SIZE       (MP45DT02_I2S_SAMPLE_SIZE_BITS)
+/* Every bit in I2S signal needs to be expanded out into a word. The CMSIS
+ * kernel expands and filters a block 1 ms at a time, so neither this nor its
+ * FIR state grow with the block. */
+#define MP45DT02_EXPANDED_BUFFER_SIZE       (MP45DT02_RAW_FREQ_KHZ)
 
 /******************************************************************************/
-/* Decimated Buffer - 1 ms worth of processed audio data */
+/* Decimated Buffer - 1 block of processed audio data */
 /******************************************************************************/
 
 /* Desired decimation factor */
 #define MP45DT02_FIR_DECIMATION_FACTOR      64
 
 /* Buffer size of the decimated sample */
-#define MP45DT02_DECIMATED_BUFFER_SIZE      (MP45DT02_EXPANDED_BUFFER_SIZE / \
+#define MP45DT02_DECIMATED_BUFFER_SIZE      (MP45DT02_I2S_SAMPLE_SIZE_BITS / \
                                              MP45DT02_FIR_DECIMATION_FACTOR)
 
+/* length samples, in interleaved frames if there are several channels */
 typedef void (*mp45dt02FullBufferCb) (float *data, uint16_t length);
 
+/* The sound level meter's latest period, each second */
+typedef void (*mp45dt02LevelsCb) (const audioSlmLevels *levels);
+
 typedef struct {
     /* Callback function to be notified when the processing buffer is full. */
     mp45dt02FullBufferCb fullbufferCb;
+    /* Optional, with CONFIG_AUDIO_SLM. Called from the processing thread
+     * before the block is passed on. */
+    mp45dt02LevelsCb levelsCb;
 } mp45dt02Config;
 
+/* Time taken to convert each block of PDM to PCM, in core clock cycles */
+typedef struct {
+    const char *kernel;
+    /* Microphones, each with its own decimator */
+    uint32_t channels;
+    /* I2S ports read at once, and the longest between the first and last of
+     * their blocks arriving */
+    uint32_t ports;
+    uint32_t worstSkewCycles;
+    /* Microphones combined by the beamformer, 0 if there isn't one */
+    uint32_t beamChannels;
+    float beamSteerDegrees;
+    uint32_t beamMeanCycles;
+    uint32_t blocks;
+    /* Blocks overwritten before they could be processed, and those dropped
+     * as one port delivered twice before another delivered once */
+    uint32_t overruns;
+    uint32_t desyncs;
+    uint32_t lastCycles;
+    uint32_t bestCycles;
+    uint32_t worstCycles;
+    uint32_t meanCycles;
+    /* Longest from a block arriving to the end of its processing, including
+     * the callback. Must stay within the block's duration. */
+    uint32_t worstLatencyCycles;
+    /* Equaliser run on the decimated output */
+    uint32_t eqStages;
+    uint32_t eqMeanCycles;
+    uint32_t eqWorstCycles;
+    /* Noise suppression after the EQ, cycles per block */
+    audioNsStats ns;
+    uint32_t nsMeanCycles;
+    uint32_t nsWorstCycles;
+    /* Sound levels of the first channel, before the EQ, cycles per block */
+    audioSlmLevels slm;
+    uint32_t slmMeanCycles;
+    /* Levels from the microphone, after the EQ and before any gain */
+    audioMeterStats meter;
+    uint32_t meterMeanCycles;
+    /* Gain control and limiting, the last stage before the callback */
+    audioAgcStats agc;
+    uint32_t agcMeanCycles;
+    uint32_t agcWorstCycles;
+} mp45dt02DspStats;
+
 void mp45dt02Init(mp45dt02Config *config);
 void mp45dt02Shutdown(void);
+void mp45dt02GetDspStats(mp45dt02DspStats *stats);
+uint32_t mp45dt02GetChannels(void);
+uint32_t mp45dt02GetOverruns(void);
+uint32_t mp45dt02GetBlockTime(void);
+uint32_t mp45dt02GetLatencyUs(void);
+StatusCode mp45dt02EqInit(float dcBlockerHz);
+StatusCode mp45dt02SetEqBand(uint32_t index, const audioEqBand *band);
+void mp45dt02GetEqBand(uint32_t index, audioEqBand *band);
+StatusCode mp45dt02BeamInit(float steerDegrees);
+StatusCode mp45dt02SetBeamSteer(float steerDegrees);
 
 
 #endif
@@ -0,0 +1,431 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include "ch.h"
+#include "hal.h"
+#include "chprintf.h"
+#include "lwip/api.h"
+#include "lwip/ip_addr.h"
+#include "lwip/err.h"
+#include "audio_tx.h"
+#include "random.h"
+#include "sdp.h"
+#include "rtsp_server.h"
+
+/* A minimal RTSP 1.0 (RFC 2326) server. Enough for ffplay, VLC and GStreamer
+ * to DESCRIBE, SETUP, PLAY and TEARDOWN the single audio stream the board
+ * produces, streamed as unicast RTP over UDP. */
+
+#define RTSP_VERSION                "RTSP/1.0"
+
+#define RTSP_RESPONSE_BUFFER_SIZE   1024
+#define RTSP_SDP_BUFFER_SIZE        768
+
+/* a=control of the audio media, relative to the Content-Base */
+#define RTSP_MEDIA_CONTROL          "trackID=0"
+
+#define RTSP_PUBLIC_METHODS         "OPTIONS, DESCRIBE, SETUP, PLAY, PAUSE, " \
+                                    "TEARDOWN, GET_PARAMETER"
+
+typedef enum {
+    RTSP_STATE_INIT,
+    RTSP_STATE_READY,
+    RTSP_STATE_PLAYING
+} rtspSessionState;
+
+static struct {
+    rtspServerConfig config;
+
+    /* Only one stream is available, so only one session at a time */
+    struct {
+        rtspSessionState state;
+        uint32_t id;
+        /* Connection which created the session */
+        struct netconn *owner;
+        audioTxRtpConfig audioCfg;
+    } session;
+
+    char response[RTSP_RESPONSE_BUFFER_SIZE];
+    char sdp[RTSP_SDP_BUFFER_SIZE];
+} rtspData;
+
+/******************************************************************************/
+/* Parsing                                                                    */
+/******************************************************************************/
+
+/* Returns the value of the named header, or NULL if not present. Values run
+ * until the end of the line. */
+static const char *rtspFindHeader(const char *request, const char *name)
+{
+    const char *line = request;
+    size_t nameLength = strlen(name);
+
+    while (NULL != (line = strstr(line, "\r\n")))
+    {
+        line += 2;
+
+        if (strncasecmp(line, name, nameLength) == 0 &&
+            line[nameLength] == ':')
+        {
+            line += nameLength + 1;
+
+            while (*line == ' ')
+            {
+                line++;
+            }
+
+            return line;
+        }
+    }
+
+    return NULL;
+}
+
+/* Finds the client RTP port in a Transport header. Only unicast RTP over UDP
+ * is supported. */
+static StatusCode rtspParseTransport(const char *transport,
+                                     uint16_t *clientRtpPort)
+{
+    const char *end = strstr(transport, "\r\n");
+    const char *clientPort = strstr(transport, "client_port=");
+    unsigned long port = 0;
+
+    if (strncmp(transport, "RTP/AVP", strlen("RTP/AVP")) != 0 ||
+        strncmp(transport, "RTP/AVP/TCP", strlen("RTP/AVP/TCP")) == 0)
+    {
+        return STATUS_ERROR_EXTERNAL_INPUT;
+    }
+
+    if (clientPort == NULL || (end != NULL && clientPort > end))
+    {
+        return STATUS_ERROR_EXTERNAL_INPUT;
+    }
+
+    port = strtoul(clientPort + strlen("client_port="), NULL, 10);
+
+    if (port == 0 || port > UINT16_MAX)
+    {
+        return STATUS_ERROR_EXTERNAL_INPUT;
+    }
+
+    *clientRtpPort = port;
+
+    return STATUS_OK;
+}
+
+/******************************************************************************/
+/* Responses                                                                  */
+/******************************************************************************/
+
+static StatusCode rtspSend(struct netconn *clientConn,
+                           const char *data,
+                           uint32_t length)
+{
+    size_t written = 0;
+
+    /* Never block the control thread on a slow client */
+    if (ERR_OK != netconn_write_partly(clientConn,
+                                       data,
+                                       length,
+                                       NETCONN_COPY | NETCONN_DONTBLOCK,
+                                       &written) ||
+        written != length)
+    {
+        return STATUS_ERROR_LIBRARY_LWIP;
+    }
+
+    return STATUS_OK;
+}
+
+/* Sends a response with the given status and extra header lines, which must
+ * each be terminated with CRLF. */
+static StatusCode rtspRespond(struct netconn *clientConn,
+                              uint32_t cseq,
+                              const char *status,
+                              const char *headers)
+{
+    int length = 0;
+
+    length = chsnprintf(rtspData.response,
+                        sizeof(rtspData.response),
+                        RTSP_VERSION " %s\r\n"
+                        "CSeq: %u\r\n"
+                        "%s"
+                        "\r\n",
+                        status,
+                        cseq,
+                        headers != NULL ? headers : "");
+
+    if (length <= 0 || (uint32_t)length >= sizeof(rtspData.response) - 1)
+    {
+        return STATUS_ERROR_INTERNAL;
+    }
+
+    return rtspSend(clientConn, rtspData.response, length);
+}
+
+static StatusCode rtspHandleDescribe(struct netconn *clientConn,
+                                     uint32_t cseq)
+{
+    sdpDescription description;
+    ip_addr_t localIp;
+    u16_t localPort = 0;
+    uint32_t sdpLength = 0;
+    char headers[128];
+
+    memset(&description, 0, sizeof(description));
+    ip_addr_set_zero(&localIp);
+
+    netconn_addr(clientConn, &localIp, &localPort);
+
+    description.sessionId       = rtspData.session.id;
+    description.sessionVersion  = 1;
+    description.originAddr      = localIp;
+    description.channels        = audioTxGetChannels();
+    description.encoding        = audioTxGetEncoding();
+    description.control         = RTSP_MEDIA_CONTROL;
+    audioTxGetRtpConfig(&description.rtp);
+    description.cnPayloadType = audioTxGetCnPayloadType();
+
+    if (0 == (sdpLength = sdpGenerate(&description,
+                                      rtspData.sdp,
+                                      sizeof(rtspData.sdp))))
+    {
+        return rtspRespond(clientConn, cseq, "500 Internal Server Error", NULL);
+    }
+
+    chsnprintf(headers, sizeof(headers),
+               "Content-Base: rtsp://%u.%u.%u.%u:%u/\r\n"
+               "Content-Type: application/sdp\r\n"
+               "Content-Length: %u\r\n",
+               ip4_addr1(&localIp), ip4_addr2(&localIp),
+               ip4_addr3(&localIp), ip4_addr4(&localIp),
+               localPort,
+               sdpLength);
+
+    SC_ASSERT(rtspRespond(clientConn, cseq, "200 OK", headers));
+
+    return rtspSend(clientConn, rtspData.sdp, sdpLength);
+}
+
+static StatusCode rtspHandleSetup(struct netconn *clientConn,
+                                  const char *request,
+                                  uint32_t cseq)
+{
+    const char *transport = NULL;
+    uint16_t clientRtpPort = 0;
+    ip_addr_t remoteIp;
+    u16_t remotePort = 0;
+    char headers[160];
+
+    if (NULL == (transport = rtspFindHeader(request, "Transport")) ||
+        STATUS_OK != rtspParseTransport(transport, &clientRtpPort))
+    {
+        return rtspRespond(clientConn, cseq, "461 Unsupported Transport", NULL);
+    }
+
+    if (rtspData.session.state != RTSP_STATE_INIT &&
+        rtspData.session.owner != clientConn)
+    {
+        return rtspRespond(clientConn, cseq, "453 Not Enough Bandwidth", NULL);
+    }
+
+    ip_addr_set_zero(&remoteIp);
+    netconn_peer(clientConn, &remoteIp, &remotePort);
+
+    memset(&rtspData.session.audioCfg, 0, sizeof(rtspData.session.audioCfg));
+    rtspData.session.audioCfg.ipDest        = remoteIp;
+    rtspData.session.audioCfg.remoteRtpPort = clientRtpPort;
+    rtspData.session.audioCfg.localRtpPort  = rtspData.config.localAudioSourcePort;
+
+    audioTxRtpSetup(&rtspData.session.audioCfg);
+
+    rtspData.session.state = RTSP_STATE_READY;
+    rtspData.session.owner = clientConn;
+
+    PRINT("RTSP session %08x to: %u.%u.%u.%u:%u",
+          rtspData.session.id,
+          ip4_addr1(&remoteIp), ip4_addr2(&remoteIp),
+          ip4_addr3(&remoteIp), ip4_addr4(&remoteIp),
+          clientRtpPort);
+
+    chsnprintf(headers, sizeof(headers),
+               "Transport: RTP/AVP;unicast;client_port=%u-%u;"
+               "server_port=%u-%u\r\n"
+               "Session: %08x;timeout=%u\r\n",
+               clientRtpPort, clientRtpPort + 1,
+               rtspData.config.localAudioSourcePort,
+               rtspData.config.localAudioSourcePort + 1,
+               rtspData.session.id,
+               rtspData.config.sessionTimeoutS);
+
+    return rtspRespond(clientConn, cseq, "200 OK", headers);
+}
+
+/* Checks the request carries the current session's identifier */
+static bool rtspSessionMatches(const char *request)
+{
+    const char *session = rtspFindHeader(request, "Session");
+
+    if (session == NULL || rtspData.session.state == RTSP_STATE_INIT)
+    {
+        return false;
+    }
+
+    return strtoul(session, NULL, 16) == rtspData.session.id;
+}
+
+static void rtspSessionTeardown(void)
+{
+    uint32_t id = rtspData.session.id;
+
+    if (rtspData.session.state != RTSP_STATE_INIT)
+    {
+        PRINT("RTSP session %08x ended", rtspData.session.id);
+        audioTxRtpTeardown();
+        BOARD_LED_ORANGE_CLEAR();
+    }
+
+    memset(&rtspData.session, 0, sizeof(rtspData.session));
+
+    /* Next session gets a fresh identifier */
+    if (STATUS_OK != randomGet(&rtspData.session.id))
+    {
+        rtspData.session.id = id + 1;
+    }
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+void rtspServerInit(const rtspServerConfig *config)
+{
+    memset(&rtspData, 0, sizeof(rtspData));
+    rtspData.config = *config;
+
+    if (STATUS_OK != randomGet(&rtspData.session.id))
+    {
+        rtspData.session.id = chVTGetSystemTime();
+    }
+}
+
+/* buffer must be NULL terminated and hold a complete request */
+StatusCode rtspServerProcessRx(struct netconn *clientConn,
+                               char *buffer,
+                               uint16_t length)
+{
+    const char *cseqValue = NULL;
+    uint32_t cseq = 0;
+    char headers[64];
+
+    if (length == 0 || strstr(buffer, "\r\n\r\n") == NULL)
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    if (NULL == (cseqValue = rtspFindHeader(buffer, "CSeq")))
+    {
+        SC_ASSERT(STATUS_ERROR_EXTERNAL_INPUT);
+    }
+
+    cseq = strtoul(cseqValue, NULL, 10);
+
+    if (strncmp(buffer, "OPTIONS ", strlen("OPTIONS ")) == 0)
+    {
+        return rtspRespond(clientConn, cseq, "200 OK",
+                           "Public: " RTSP_PUBLIC_METHODS "\r\n");
+    }
+    else if (strncmp(buffer, "DESCRIBE ", strlen("DESCRIBE ")) == 0)
+    {
+        return rtspHandleDescribe(clientConn, cseq);
+    }
+    else if (strncmp(buffer, "SETUP ", strlen("SETUP ")) == 0)
+    {
+        return rtspHandleSetup(clientConn, buffer, cseq);
+    }
+    else if (strncmp(buffer, "GET_PARAMETER ", strlen("GET_PARAMETER ")) == 0)
+    {
+        /* Used by clients as a keep alive */
+        return rtspRespond(clientConn, cseq, "200 OK", NULL);
+    }
+
+    /* Everything else operates on an existing session */
+    if (rtspSessionMatches(buffer) == false)
+    {
+        return rtspRespond(clientConn, cseq, "454 Session Not Found", NULL);
+    }
+
+    chsnprintf(headers, sizeof(headers),
+               "Session: %08x\r\n", rtspData.session.id);
+
+    if (strncmp(buffer, "PLAY ", strlen("PLAY ")) == 0)
+    {
+        audioTxRtpPlay();
+        rtspData.session.state = RTSP_STATE_PLAYING;
+        BOARD_LED_ORANGE_SET();
+        return rtspRespond(clientConn, cseq, "200 OK", headers);
+    }
+    else if (strncmp(buffer, "PAUSE ", strlen("PAUSE ")) == 0)
+    {
+        audioTxRtpPause();
+        rtspData.session.state = RTSP_STATE_READY;
+        BOARD_LED_ORANGE_CLEAR();
+        return rtspRespond(clientConn, cseq, "200 OK", headers);
+    }
+    else if (strncmp(buffer, "TEARDOWN ", strlen("TEARDOWN ")) == 0)
+    {
+        rtspSessionTeardown();
+        return rtspRespond(clientConn, cseq, "200 OK", headers);
+    }
+
+    return rtspRespond(clientConn, cseq, "501 Not Implemented", NULL);
+}
+
+/* A session doesn't outlive the connection which set it up */
+void rtspServerClientClosed(struct netconn *clientConn)
+{
+    if (rtspData.session.state != RTSP_STATE_INIT &&
+        rtspData.session.owner == clientConn)
+    {
+        rtspSessionTeardown();
+    }
+}
+
+/* Ends any session, for when the stream is taken over by the management
+ * server. Its client's later requests find no session, so can't touch the
+ * stream which replaced it. */
+void rtspServerPreempt(void)
+{
+    if (rtspData.session.state != RTSP_STATE_INIT)
+    {
+        PRINT("RTSP session %08x preempted", rtspData.session.id);
+        rtspSessionTeardown();
+    }
+}
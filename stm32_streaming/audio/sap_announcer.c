@@ -0,0 +1,277 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include "ch.h"
+#include "hal.h"
+#include "chprintf.h"
+#include "lwip/api.h"
+#include "lwip/ip_addr.h"
+#include "lwip/netif.h"
+#include "lwip/err.h"
+#include "audio_tx.h"
+#include "random.h"
+#include "sdp.h"
+#include "sap_announcer.h"
+#include "config.h"
+
+/* Periodically multicasts a Session Announcement Protocol (RFC 2974) packet
+ * carrying the SDP of the stream, so receivers can find boards without
+ * knowing their addresses. The SDP points at the RTSP server and management
+ * port which are used to actually start the stream. */
+
+/* Well known SAP address and port for global scope IPv4 sessions */
+#define SAP_MULTICAST_ADDR          IP(224, 2, 127, 254)
+#define SAP_PORT                    9875
+
+/* V=1, IPv4 origin, no encryption or compression */
+#define SAP_FLAGS_VERSION_1         (1 << 5)
+#define SAP_FLAGS_DELETE            (1 << 2)
+
+#define SAP_HEADER_LENGTH           8
+#define SAP_PAYLOAD_TYPE            "application/sdp"
+
+#define SAP_BUFFER_SIZE             768
+
+/* SAP header on the wire */
+typedef struct {
+    uint8_t flags;
+    uint8_t authLength;
+    uint16_t msgIdHash;
+    uint32_t originatingSource;
+} sapHeader;
+
+static struct {
+    sapAnnouncerConfig config;
+    THD_WORKING_AREA(workingArea, 1024);
+    thread_t *thread;
+    /* Set while the thread sleeps between announcements, so shutting down
+     * needn't wait out the interval */
+    thread_reference_t wakeup;
+
+    struct netconn *conn;
+
+    /* SDP session identifier. The version changes whenever the description
+     * does, e.g. the board's address changes. */
+    uint32_t sessionId;
+    uint32_t sessionVersion;
+    ip_addr_t lastAddr;
+
+    uint32_t announcements;
+    uint32_t sendFailures;
+
+    uint8_t buffer[SAP_BUFFER_SIZE];
+} sapData;
+
+static uint32_t sapBuild(const ip_addr_t *localAddr, bool deletion)
+{
+    sapHeader *header = (sapHeader*)sapData.buffer;
+    char *payload = (char*)sapData.buffer + SAP_HEADER_LENGTH;
+    uint32_t payloadSize = SAP_BUFFER_SIZE - SAP_HEADER_LENGTH;
+    uint32_t sdpLength = 0;
+    char control[40];
+    sdpDescription description;
+
+    /* Payload type, including its terminating NULL */
+    memcpy(payload, SAP_PAYLOAD_TYPE, sizeof(SAP_PAYLOAD_TYPE));
+    payload += sizeof(SAP_PAYLOAD_TYPE);
+    payloadSize -= sizeof(SAP_PAYLOAD_TYPE);
+
+    chsnprintf(control, sizeof(control), "rtsp://%u.%u.%u.%u:%u/",
+               ip4_addr1(localAddr), ip4_addr2(localAddr),
+               ip4_addr3(localAddr), ip4_addr4(localAddr),
+               sapData.config.localRtspPort);
+
+    memset(&description, 0, sizeof(description));
+    description.sessionId       = sapData.sessionId;
+    description.sessionVersion  = sapData.sessionVersion;
+    description.originAddr      = *localAddr;
+    description.connectionAddr  = *localAddr;
+    description.mediaPort       = sapData.config.localRtpPort;
+    description.channels        = audioTxGetChannels();
+    description.encoding        = audioTxGetEncoding();
+    description.control         = control;
+    description.mgmtPort        = sapData.config.localMgmtPort;
+    audioTxGetRtpConfig(&description.rtp);
+    description.cnPayloadType = audioTxGetCnPayloadType();
+
+    if (0 == (sdpLength = sdpGenerate(&description, payload, payloadSize)))
+    {
+        return 0;
+    }
+
+    /* The hash identifies this version of the announcement */
+    header->flags             = SAP_FLAGS_VERSION_1 |
+                                (deletion ? SAP_FLAGS_DELETE : 0);
+    header->authLength        = 0;
+    header->msgIdHash         = htons((sapData.sessionId ^
+                                       (sapData.sessionId >> 16) ^
+                                       sapData.sessionVersion) & 0xFFFF);
+    header->originatingSource = localAddr->addr;
+
+    return SAP_HEADER_LENGTH + sizeof(SAP_PAYLOAD_TYPE) + sdpLength;
+}
+
+static void sapSend(bool deletion)
+{
+    struct netbuf *buf = NULL;
+    void *data = NULL;
+    uint32_t length = 0;
+    ip_addr_t localAddr;
+    ip_addr_t multicastAddr;
+
+    if (netif_default == NULL || ip_addr_isany(&netif_default->ip_addr))
+    {
+        return;
+    }
+
+    localAddr = netif_default->ip_addr;
+
+    if (localAddr.addr != sapData.lastAddr.addr)
+    {
+        sapData.lastAddr = localAddr;
+        sapData.sessionVersion++;
+    }
+
+    if (0 == (length = sapBuild(&localAddr, deletion)))
+    {
+        PRINT("SAP announcement too long", 0);
+        return;
+    }
+
+    if (NULL == (buf = netbuf_new()))
+    {
+        return;
+    }
+
+    if (NULL == (data = netbuf_alloc(buf, length)))
+    {
+        netbuf_delete(buf);
+        return;
+    }
+
+    memcpy(data, sapData.buffer, length);
+
+    multicastAddr.addr = SAP_MULTICAST_ADDR;
+
+    if (ERR_OK == netconn_sendto(sapData.conn, buf, &multicastAddr, SAP_PORT))
+    {
+        sapData.announcements++;
+    }
+    else
+    {
+        sapData.sendFailures++;
+    }
+
+    netbuf_delete(buf);
+}
+
+static THD_FUNCTION(sapAnnouncerThd, arg)
+{
+    (void)arg;
+
+    chRegSetThreadName(__FUNCTION__);
+
+    while (chThdShouldTerminateX() == false)
+    {
+        sapSend(false);
+
+        chSysLock();
+        if (chThdShouldTerminateX() == false)
+        {
+            chThdSuspendTimeoutS(&sapData.wakeup,
+                                 S2ST(sapData.config.intervalS));
+        }
+        chSysUnlock();
+    }
+
+    /* Let listeners know the stream is going away */
+    sapSend(true);
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+StatusCode sapAnnouncerInit(const sapAnnouncerConfig *config)
+{
+    memset(&sapData, 0, sizeof(sapData));
+    sapData.config = *config;
+
+    if (sapData.config.intervalS == 0)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    SC_ASSERT(randomGet(&sapData.sessionId));
+
+    if (NULL == (sapData.conn = netconn_new(NETCONN_UDP)))
+    {
+        return STATUS_ERROR_LIBRARY_LWIP;
+    }
+
+    if (ERR_OK != netconn_bind(sapData.conn, IP_ADDR_ANY, SAP_PORT))
+    {
+        netconn_delete(sapData.conn);
+        return STATUS_ERROR_LIBRARY_LWIP;
+    }
+
+    sapData.thread = chThdCreateStatic(sapData.workingArea,
+                                       sizeof(sapData.workingArea),
+                                       LOWPRIO,
+                                       sapAnnouncerThd,
+                                       NULL);
+    return STATUS_OK;
+}
+
+/* Sends the deletion announcement. Does nothing if the announcer was never
+ * started or has already been shut down. */
+StatusCode sapAnnouncerShutdown(void)
+{
+    if (sapData.thread == NULL)
+    {
+        return STATUS_OK;
+    }
+
+    chThdTerminate(sapData.thread);
+    chThdResume(&sapData.wakeup, MSG_OK);
+    chThdWait(sapData.thread);
+
+    if (ERR_OK != netconn_delete(sapData.conn))
+    {
+        return STATUS_ERROR_LIBRARY_LWIP;
+    }
+
+    memset(&sapData, 0, sizeof(sapData));
+
+    return STATUS_OK;
+}
+
+void sapAnnouncerPrintStats(BaseSequentialStream *stream)
+{
+    chprintf(stream, "sap_announcements %u\n", sapData.announcements);
+    chprintf(stream, "sap_send_failures %u\n", sapData.sendFailures);
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "chprintf.h"
+#include "sdp.h"
+
+#define SDP_SESSION_NAME    "STM32F4 Streaming Mic"
+
+/* Writes the SDP for description into buffer. Returns the length written,
+ * 0 if it didn't fit. */
+uint32_t sdpGenerate(const sdpDescription *description,
+                     char *buffer,
+                     uint32_t size)
+{
+    int length = 0;
+    uint32_t ptimeMs = 0;
+    const ip_addr_t *origin = &description->originAddr;
+    const ip_addr_t *connection = &description->connectionAddr;
+    const rtpExtensionElement *extension = NULL;
+    uint32_t index = 0;
+
+    if (description->rtp.clockRate != 0)
+    {
+        ptimeMs = description->rtp.periodicTimestampIncr * 1000 /
+                  description->rtp.clockRate;
+    }
+
+    length = chsnprintf(buffer, size,
+                        "v=0\r\n"
+                        "o=- %u %u IN IP4 %u.%u.%u.%u\r\n"
+                        "s=" SDP_SESSION_NAME "\r\n"
+                        "c=IN IP4 %u.%u.%u.%u\r\n"
+                        "t=0 0\r\n"
+                        "m=audio %u RTP/AVP %u",
+                        description->sessionId,
+                        description->sessionVersion,
+                        ip4_addr1(origin), ip4_addr2(origin),
+                        ip4_addr3(origin), ip4_addr4(origin),
+                        ip4_addr1(connection), ip4_addr2(connection),
+                        ip4_addr3(connection), ip4_addr4(connection),
+                        description->mediaPort,
+                        description->rtp.payloadType);
+
+    if (description->cnPayloadType != 0 && length > 0 && (uint32_t)length < size)
+    {
+        length += chsnprintf(buffer + length, size - length,
+                             " %u",
+                             description->cnPayloadType);
+    }
+
+    if (length > 0 && (uint32_t)length < size)
+    {
+        length += chsnprintf(buffer + length, size - length,
+                             "\r\n"
+                             "a=rtpmap:%u %s/%u/%u\r\n",
+                             description->rtp.payloadType,
+                             description->encoding,
+                             description->rtp.clockRate,
+                             description->channels);
+    }
+
+    if (description->cnPayloadType != 0 && length > 0 && (uint32_t)length < size)
+    {
+        length += chsnprintf(buffer + length, size - length,
+                             "a=rtpmap:%u CN/%u\r\n",
+                             description->cnPayloadType,
+                             description->rtp.clockRate);
+    }
+
+    if (length > 0 && (uint32_t)length < size)
+    {
+        length += chsnprintf(buffer + length, size - length,
+                             "a=ptime:%u\r\n"
+                             "a=sendonly\r\n",
+                             ptimeMs);
+    }
+
+    for (index = 0; index < RTP_EXTENSION_MAX_ELEMENTS; index++)
+    {
+        extension = &description->rtp.extensions[index];
+
+        if (extension->id != 0 && length > 0 && (uint32_t)length < size)
+        {
+            length += chsnprintf(buffer + length, size - length,
+                                 "a=extmap:%u %s%s%s\r\n",
+                                 extension->id,
+                                 extension->uri,
+                                 extension->attributes ? " " : "",
+                                 extension->attributes ?
+                                    extension->attributes : "");
+        }
+    }
+
+    if (description->control != NULL && length > 0 && (uint32_t)length < size)
+    {
+        length += chsnprintf(buffer + length, size - length,
+                             "a=control:%s\r\n",
+                             description->control);
+    }
+
+    if (description->mgmtPort != 0 && length > 0 && (uint32_t)length < size)
+    {
+        length += chsnprintf(buffer + length, size - length,
+                             "a=x-mgmt-port:%u\r\n",
+                             description->mgmtPort);
+    }
+
+    /* chsnprintf truncates silently */
+    if (length <= 0 || (uint32_t)length >= size - 1)
+    {
+        return 0;
+    }
+
+    return length;
+}
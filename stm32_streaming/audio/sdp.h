@@ -0,0 +1,63 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __SDP_H__
+#define __SDP_H__
+
+#include <stdint.h>
+#include "lwip/ip_addr.h"
+#include "rtp.h"
+
+/* Description of the audio stream for the Session Description Protocol. */
+typedef struct {
+    /* Unique identifier of the session and its revision */
+    uint32_t sessionId;
+    uint32_t sessionVersion;
+    /* Address the stream originates from */
+    ip_addr_t originAddr;
+    /* Address the stream is sent to */
+    ip_addr_t connectionAddr;
+    /* Port the stream is sent to. 0 if negotiated elsewhere e.g. RTSP. */
+    uint16_t mediaPort;
+    /* Encoding name of the stream's payload type, e.g. L16 */
+    const char *encoding;
+    /* Number of interleaved audio channels */
+    uint8_t channels;
+    /* Optional media control URL, NULL to omit */
+    const char *control;
+    /* Optional management port of the board, 0 to omit */
+    uint16_t mgmtPort;
+    /* RTP parameters of the stream, including any header extensions */
+    rtpConfig rtp;
+    /* Payload type of RFC 3389 comfort noise, 0 to omit */
+    uint8_t cnPayloadType;
+} sdpDescription;
+
+uint32_t sdpGenerate(const sdpDescription *description,
+                     char *buffer,
+                     uint32_t size);
+
+#endif /* Header Guard */
@@ -0,0 +1,149 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include "vad.h"
+
+/* Noise floor smoothing - the floor drops quickly to quieter frames but only
+ * rises slowly, so speech doesn't drag it up. It does still rise during
+ * "speech" so a persistent change in background noise is eventually
+ * learnt. */
+#define VAD_FLOOR_FALL          0.5f
+#define VAD_FLOOR_RISE          0.02f
+#define VAD_FLOOR_RISE_SPEECH   0.001f
+
+/* Voice activity detection on frames of samples. Has no dependencies, so it
+ * can be run anywhere. Frames are built up with vadAccumulate() and then
+ * classified with vadDecide(). */
+
+void vadInit(vadState *vad, const vadConfig *config)
+{
+    memset(vad, 0, sizeof(*vad));
+    vad->config = *config;
+}
+
+/* Adds every stride'th of count samples to the frame, e.g. 1 for mono or the
+ * number of channels to follow the first of interleaved frames */
+void vadAccumulate(vadState *vad,
+                   const float *samples,
+                   uint32_t count,
+                   uint32_t stride)
+{
+    uint32_t index = 0;
+    float sample = 0;
+
+    for (index = 0; index < count; index += stride)
+    {
+        sample = samples[index];
+
+        vad->energy += sample * sample;
+
+        if ((sample < 0) != (vad->lastSample < 0))
+        {
+            vad->zeroCrossings++;
+        }
+
+        vad->lastSample = sample;
+        vad->samples++;
+    }
+}
+
+/* Classifies the accumulated frame and starts a new one. Returns true if the
+ * frame should be treated as speech. */
+bool vadDecide(vadState *vad)
+{
+    float energy = 0;
+    float zcr = 0;
+    bool speech = false;
+
+    if (vad->samples == 0)
+    {
+        return vad->active;
+    }
+
+    energy = vad->energy / vad->samples;
+    zcr = (float)vad->zeroCrossings / vad->samples;
+
+    /* Assume the first frame is background */
+    if (vad->noiseFloor == 0)
+    {
+        vad->noiseFloor = energy;
+    }
+
+    if (energy >= vad->config.minEnergy)
+    {
+        if (energy > vad->noiseFloor * vad->config.energyRatio)
+        {
+            speech = true;
+        }
+        else if (energy > vad->noiseFloor * vad->config.lowEnergyRatio &&
+                 zcr > vad->config.zcrThreshold)
+        {
+            speech = true;
+        }
+    }
+
+    if (energy < vad->noiseFloor)
+    {
+        vad->noiseFloor += (energy - vad->noiseFloor) * VAD_FLOOR_FALL;
+    }
+    else
+    {
+        vad->noiseFloor += (energy - vad->noiseFloor) *
+                           (speech ? VAD_FLOOR_RISE_SPEECH : VAD_FLOOR_RISE);
+    }
+
+    if (vad->noiseFloor < vad->config.minEnergy)
+    {
+        vad->noiseFloor = vad->config.minEnergy;
+    }
+
+    if (speech)
+    {
+        vad->hangover = vad->config.hangoverFrames;
+    }
+    else
+    {
+        if (vad->hangover > 0)
+        {
+            vad->hangover--;
+            speech = true;
+        }
+    }
+
+    vad->active = speech;
+    vad->energy = 0;
+    vad->zeroCrossings = 0;
+    vad->samples = 0;
+
+    return speech;
+}
+
+/* Mean square of the background noise */
+float vadGetNoiseFloor(const vadState *vad)
+{
+    return vad->noiseFloor;
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __VAD_H__
+#define __VAD_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    /* Frames louder than the noise floor by this ratio (of mean squares) are
+     * speech */
+    float energyRatio;
+    /* Quieter frames, down to this ratio of the noise floor, are speech if
+     * they also have a zero crossing rate above zcrThreshold. Catches
+     * unvoiced consonants e.g. "s", which are quiet but noisy. */
+    float lowEnergyRatio;
+    /* Zero crossings per sample */
+    float zcrThreshold;
+    /* Mean square below which a frame is never speech */
+    float minEnergy;
+    /* Frames to keep reporting speech after the last speech frame, so word
+     * endings and short pauses aren't clipped */
+    uint32_t hangoverFrames;
+} vadConfig;
+
+typedef struct {
+    vadConfig config;
+    /* Accumulated over the current frame */
+    float energy;
+    uint32_t zeroCrossings;
+    uint32_t samples;
+    float lastSample;
+    /* Tracked across frames */
+    float noiseFloor;
+    uint32_t hangover;
+    bool active;
+} vadState;
+
+void vadInit(vadState *vad, const vadConfig *config);
+void vadAccumulate(vadState *vad,
+                   const float *samples,
+                   uint32_t count,
+                   uint32_t stride);
+bool vadDecide(vadState *vad);
+float vadGetNoiseFloor(const vadState *vad);
+
+#endif /* Header Guard */
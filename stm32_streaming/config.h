@@ -32,6 +32,14 @@
 /* Board Networking Configuration */
 /******************************************************************************/
 
+/* Obtain an address with DHCP. The static addresses below are used if no
+ * lease is offered. Overridden by settings stored with the "net" management
+ * command. */
+#define CONFIG_NET_DHCP             1
+
+/* Seconds to wait for a DHCP lease before falling back to a static address */
+#define CONFIG_NET_DHCP_TIMEOUT_S   10
+
 /* The IP address of the board */
 #define CONFIG_NET_IP_ADDR          IP(192, 168, 1, 60)
 
@@ -41,7 +49,12 @@
 /* The subnet the board is attached to */
 #define CONFIG_NET_IP_NETMASK       IP(255, 255, 255, 0)
 
-/* MAC address of the board */
+/* Derive the last five bytes of the MAC address from the MCU's unique ID, so
+ * boards sharing a firmware image can share a network */
+#define CONFIG_NET_MAC_FROM_UID     1
+
+/* MAC address of the board. The first byte must have the locally
+ * administered bit set when CONFIG_NET_MAC_FROM_UID is used. */
 #define CONFIG_NET_ETH_ADDR_0       0xC2
 #define CONFIG_NET_ETH_ADDR_1       0xAF
 #define CONFIG_NET_ETH_ADDR_2       0x51
@@ -56,6 +69,159 @@
 /* TCP port number to accept management connections on */
 #define CONFIG_AUDIO_MGMT_PORT      20000
 
+/* Number of management connections which can be serviced at once. Further
+ * connections are refused until a slot is free. */
+#define CONFIG_AUDIO_MGMT_MAX_CLIENTS   4
+
+/* Seconds a management connection may be idle before it is dropped */
+#define CONFIG_AUDIO_MGMT_TIMEOUT_S     30
+
+/* TCP port number to accept RTSP connections on */
+#define CONFIG_AUDIO_RTSP_PORT      554
+
+/* Seconds between SAP multicast announcements of the stream. 0 disables
+ * announcements. */
+#define CONFIG_AUDIO_SAP_INTERVAL_S 10
+
+/* I2S ports read at once, 1 or 2. SPI2 reads the microphone on the board and
+ * SPI3 further microphones clocked by PC10 with data on PC12. */
+#define CONFIG_AUDIO_I2S_PORTS      1
+
+/* Microphones sharing each I2S data line, 1 or 2. With 2, the I2S clock runs
+ * at twice the rate, so the microphones need their clock from it divided by 2
+ * e.g. by a timer, and their L/R pins set differently. All microphones are
+ * streamed as interleaved L16 channels, those of SPI2 first. */
+#define CONFIG_AUDIO_MICS_PER_PORT  1
+
+/* Combine every microphone into one channel with a delay and sum beamformer,
+ * needing more than one microphone. They must be in a line,
+ * CONFIG_AUDIO_BEAM_SPACING_MM apart in channel order. Steered
+ * CONFIG_AUDIO_BEAM_STEER_DEG from broadside towards the last, and over the
+ * management connection. */
+#define CONFIG_AUDIO_BEAM               0
+#define CONFIG_AUDIO_BEAM_SPACING_MM    20
+#define CONFIG_AUDIO_BEAM_STEER_DEG     0
+
+/* PDM to PCM implementation, one of audioDspKernel in audio/audio_dsp.h.
+ * Kernels not used are left out of the build in the Makefile. */
+#define CONFIG_AUDIO_DSP_KERNEL     AUDIO_DSP_KERNEL_POLYPHASE_LUT
+
+/* Keep the decimators and the processing after them in core coupled memory,
+ * which no DMA can reach, so they don't contend with the Ethernet and I2S DMA
+ * for SRAM. The I2S buffers stay in SRAM regardless. */
+#define CONFIG_AUDIO_DSP_CCM        1
+
+/* Cut off of the high-pass filter removing DC offset and rumble from the
+ * microphone, Hz. 0 disables it. Further EQ bands can be set over the
+ * management connection. */
+#define CONFIG_AUDIO_EQ_DC_BLOCKER_HZ   20
+
+/* Spectral noise suppression after the EQ, for steady background noise such
+ * as air conditioning. Adds 24 ms of latency. */
+#define CONFIG_AUDIO_NS                 0
+
+/* Most the noise suppression turns any frequency down by, dB */
+#define CONFIG_AUDIO_NS_MAX_ATTENUATION_DB  12
+
+/* Automatic gain control, steering speech towards the target level. 0 leaves
+ * a fixed 0 dB gain, with just the limiter. */
+#define CONFIG_AUDIO_AGC            1
+
+/* Mean square level the AGC aims for, dBFS */
+#define CONFIG_AUDIO_AGC_TARGET_DBFS    -20
+
+/* Most the AGC will amplify quiet speech by, dB */
+#define CONFIG_AUDIO_AGC_MAX_GAIN_DB    30
+
+/* Peaks are limited to this before conversion to 16 bit, dBFS */
+#define CONFIG_AUDIO_LIMITER_DBFS       -1
+
+/* Time the limiter looks ahead for peaks, adding to the stream's latency */
+#define CONFIG_AUDIO_LIMITER_LOOKAHEAD_MS   1
+
+/* Suppress payloads while the room is silent, sending RFC 3389 comfort noise
+ * packets instead */
+#define CONFIG_AUDIO_VAD            1
+
+/* Time to keep streaming after speech stops, so word endings and short
+ * pauses are not clipped */
+#define CONFIG_AUDIO_VAD_HANGOVER_MS    300
+
+/* Interval between comfort noise updates during silence */
+#define CONFIG_AUDIO_VAD_CN_INTERVAL_MS 500
+
+/* Send audio only around events, each with a pre-roll of the audio before it
+ * was detected. The settings below can be changed over the management
+ * connection. Needs CONFIG_AUDIO_AGC cleared. */
+#define CONFIG_AUDIO_TRIGGER        0
+
+/* Level of a 20 ms payload which starts an event, dBFS */
+#define CONFIG_AUDIO_TRIGGER_LEVEL_DBFS -30
+
+/* Also start an event on speech, as found by the VAD */
+#define CONFIG_AUDIO_TRIGGER_VAD    0
+
+/* Time to keep sending after the last payload to start or extend an event */
+#define CONFIG_AUDIO_TRIGGER_HANGOVER_MS    2000
+
+/* Audio held back to send ahead of each event */
+#define CONFIG_AUDIO_TRIGGER_PREROLL_MS     2000
+
+/* Hold the pre-roll as 4 bit IMA ADPCM, in a quarter of the RAM of 16 bit
+ * samples, at some loss of quality */
+#define CONFIG_AUDIO_TRIGGER_ADPCM  1
+
+/* Send band energies rather than audio, for acoustic monitoring at a
+ * fraction of the bandwidth. Needs CONFIG_AUDIO_AGC cleared. */
+#define CONFIG_AUDIO_FEATURES       0
+
+/* Bands, one of audioFeaturesScale in audio/audio_features.h */
+#define CONFIG_AUDIO_FEATURES_SCALE AUDIO_FEATURES_SCALE_THIRD_OCTAVE
+
+/* Bands of the mel scale, third octaves being fixed */
+#define CONFIG_AUDIO_FEATURES_MEL_BANDS 24
+
+/* Range the bands cover, Hz */
+#define CONFIG_AUDIO_FEATURES_LOW_HZ    100
+#define CONFIG_AUDIO_FEATURES_HIGH_HZ   6300
+
+/* Time each frame of features is averaged over, rounded down to a multiple
+ * of the 16 ms FFT hop */
+#define CONFIG_AUDIO_FEATURES_INTERVAL_MS   128
+
+/* Sound level meter, A, C and Z weighted levels of the first microphone
+ * each second, in the stats and optionally as RTCP reports */
+#define CONFIG_AUDIO_SLM            0
+
+/* dB SPL of a full scale square wave. The MP45DT02 gives -26 dBFS for a sine
+ * at 94 dB SPL, a full scale square being 3 dB above a full scale sine. */
+#define CONFIG_AUDIO_SLM_CALIBRATION_DB 123
+
+/* Send each second's levels as an RTCP APP packet to the RTP port + 1 */
+#define CONFIG_AUDIO_SLM_RTCP       0
+
+/* Send only the level reports, no audio. Needs CONFIG_AUDIO_SLM_RTCP. */
+#define CONFIG_AUDIO_SLM_ONLY       0
+
+/* RTP header extension IDs, 0 leaves the extension out. IDs up to 14 keep
+ * to the smaller RFC 8285 one-byte header form. */
+
+/* RFC 6464 level of each packet, so receivers can tell which microphone is
+ * loudest without decoding them */
+#define CONFIG_AUDIO_LEVEL_EXT_ID   1
+
+/* Time each packet's audio was captured, relative to boot as the board has
+ * no wall clock */
+#define CONFIG_AUDIO_CAPTURE_TIME_EXT_ID    2
+
+/* Count of 1 ms blocks the DSP failed to process in time */
+#define CONFIG_AUDIO_DSP_OVERRUNS_EXT_ID    3
+
+/* Set to hand packets to the tcpip thread through the lwIP raw API without
+ * waiting for them to be sent. Clear to send with netconn, which blocks the
+ * processing thread for two context switches per packet. */
+#define CONFIG_AUDIO_TX_RAW_API     1
+
 /* UDP port number which will be the source of the audio stream */
 #define CONFIG_AUDIO_SOURCE_PORT    40000
 
@@ -40,35 +40,6 @@
 
 #define LWIP_DEBUG
 
-#if 0
-/* AB TODO 
- * Seems here is the place to override the fixed constatns in 
- * various/lwipthread.h for ChibiOS lwip threads.
- * Not sure why lwipthread.h is being used at all since IP configuration
- * is highly dependant.
- */
-
-
-/* TODO delete me - inital debug */
-#if defined(LWIP_IPADDR)
-    #error "LWIP_IPADDR defined!"
-#endif
-#if defined (LWIP_ETHADDR_0)
-    #error "LWIP_ETHADDR_0 defined!"
-#endif
-
-#define LWIP_IPADDR(p)      IP4_ADDR(p, 192, 168, 1, 20)
-#define LWIP_GATEWAY(p)     IP4_ADDR(p, 192, 168, 1, 1)
-#define LWIP_NETMASK(p)     IP4_ADDR(p, 255, 255, 255, 0)
-
-#define LWIP_ETHADDR_0      0xC2
-#define LWIP_ETHADDR_1      0xAF
-#define LWIP_ETHADDR_2      0x51
-#define LWIP_ETHADDR_3      0x03
-#define LWIP_ETHADDR_4      0xCF
-#define LWIP_ETHADDR_5      0x46
-
-#endif
 /*
    -----------------------------------------------
    ---------- Platform specific locking ----------
@@ -81,7 +52,7 @@
  * allocation and deallocation.
  */
 #ifndef SYS_LIGHTWEIGHT_PROT
-#define SYS_LIGHTWEIGHT_PROT            0
+#define SYS_LIGHTWEIGHT_PROT            1
 #endif
 
 /** 
@@ -264,7 +235,7 @@
  * (requires the LWIP_UDP option)
  */
 #ifndef MEMP_NUM_UDP_PCB
-#define MEMP_NUM_UDP_PCB                4
+#define MEMP_NUM_UDP_PCB                5
 #endif
 
 /**
@@ -353,7 +324,7 @@
  * (only needed if you use the sequential API, like api_lib.c)
  */
 #ifndef MEMP_NUM_NETCONN
-#define MEMP_NUM_NETCONN                8
+#define MEMP_NUM_NETCONN                10
 #endif
 
 /**
@@ -703,7 +674,7 @@
  * LWIP_DHCP==1: Enable DHCP module.
  */
 #ifndef LWIP_DHCP
-#define LWIP_DHCP                       0
+#define LWIP_DHCP                       1
 #endif
 
 /**
@@ -1145,7 +1116,7 @@
  * LWIP_NETIF_API==1: Support netif api (in netifapi.c)
  */
 #ifndef LWIP_NETIF_API
-#define LWIP_NETIF_API                  0
+#define LWIP_NETIF_API                  1
 #endif
 
 /**
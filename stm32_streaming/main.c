@@ -28,13 +28,16 @@
 #include "ch.h"
 #include "hal.h"
 #include "debug.h"
-#include "lwipthread.h"
 #include "lwip/ip_addr.h"
 #include "lwip/api.h"
 #include "lwip/err.h"
 #include "random.h"
+#include "settings.h"
+#include "network.h"
 #include "audio_control_server.h"
+#include "sap_announcer.h"
 #include "audio_tx.h"
+#include "mp45dt02_processing.h"
 #include "config.h"
 
 static THD_WORKING_AREA(waBinkingThread, 128);
@@ -53,13 +56,15 @@ static THD_FUNCTION(blinkingThread, arg)
 int main(void) 
 {
     AudioControlConfig audioControlConfig;
-    struct lwipthread_opts opts;
-    uint8_t optsMAC[6] = {CONFIG_NET_ETH_ADDR_0,
-                          CONFIG_NET_ETH_ADDR_1,
-                          CONFIG_NET_ETH_ADDR_2,
-                          CONFIG_NET_ETH_ADDR_3,
-                          CONFIG_NET_ETH_ADDR_4,
-                          CONFIG_NET_ETH_ADDR_5};
+    sapAnnouncerConfig sapConfig;
+    settingsNetwork defaultNetwork;
+    networkConfig netConfig;
+    uint8_t defaultMAC[6] = {CONFIG_NET_ETH_ADDR_0,
+                             CONFIG_NET_ETH_ADDR_1,
+                             CONFIG_NET_ETH_ADDR_2,
+                             CONFIG_NET_ETH_ADDR_3,
+                             CONFIG_NET_ETH_ADDR_4,
+                             CONFIG_NET_ETH_ADDR_5};
     halInit();
     chSysInit();
     debugInit();
@@ -70,38 +75,45 @@ int main(void)
                       blinkingThread,
                       NULL);
 
-    memset(&opts, 0, sizeof(opts));
-    opts.macaddress = optsMAC;
-    opts.address    = CONFIG_NET_IP_ADDR;
-    opts.netmask    = CONFIG_NET_IP_NETMASK;
-    opts.gateway    = CONFIG_NET_IP_GATEWAY;
-    lwipInit(&opts);
+    /* Settings stored in flash override the compile time defaults */
+    memset(&defaultNetwork, 0, sizeof(defaultNetwork));
+    defaultNetwork.dhcp    = CONFIG_NET_DHCP;
+    defaultNetwork.ipAddr  = CONFIG_NET_IP_ADDR;
+    defaultNetwork.netmask = CONFIG_NET_IP_NETMASK;
+    defaultNetwork.gateway = CONFIG_NET_IP_GATEWAY;
+    SC_ASSERT(settingsInit(&defaultNetwork));
 
     SC_ASSERT(randomInit());
 
-    while (macPollLinkStatus(&ETHD1) == false)
-    {
-        chThdSleep(1);
-    }
+    memset(&netConfig, 0, sizeof(netConfig));
+    settingsGetNetwork(&netConfig.addressing);
+    netConfig.dhcpTimeoutS = CONFIG_NET_DHCP_TIMEOUT_S;
+    netConfig.macFromUid   = CONFIG_NET_MAC_FROM_UID;
+    memcpy(netConfig.macAddress, defaultMAC, sizeof(netConfig.macAddress));
+    SC_ASSERT(networkInit(&netConfig));
+
+    SC_ASSERT(mp45dt02EqInit(CONFIG_AUDIO_EQ_DC_BLOCKER_HZ));
+    SC_ASSERT(mp45dt02BeamInit(CONFIG_AUDIO_BEAM_STEER_DEG));
+    SC_ASSERT(audioTxInit());
 
     memset(&audioControlConfig, 0, sizeof(audioControlConfig));
     audioControlConfig.localAudioSourcePort = CONFIG_AUDIO_SOURCE_PORT;
     audioControlConfig.localMgmtPort        = CONFIG_AUDIO_MGMT_PORT;
+    audioControlConfig.localRtspPort        = CONFIG_AUDIO_RTSP_PORT;
     SC_ASSERT(audioControlInit(&audioControlConfig));
 
-    PRINT("Device MAC: %02x:%02x:%02x:%02x:%02x:%02x",
-          optsMAC[0],
-          optsMAC[1],
-          optsMAC[2],
-          optsMAC[3],
-          optsMAC[4],
-          optsMAC[5]);
-    PRINT("Device IP:  %u.%u.%u.%u",
-          ip4_addr1(&opts.address),
-          ip4_addr2(&opts.address),
-          ip4_addr3(&opts.address),
-          ip4_addr4(&opts.address));
+    if (CONFIG_AUDIO_SAP_INTERVAL_S != 0)
+    {
+        memset(&sapConfig, 0, sizeof(sapConfig));
+        sapConfig.localMgmtPort = CONFIG_AUDIO_MGMT_PORT;
+        sapConfig.localRtspPort = CONFIG_AUDIO_RTSP_PORT;
+        sapConfig.localRtpPort  = CONFIG_AUDIO_SOURCE_PORT;
+        sapConfig.intervalS     = CONFIG_AUDIO_SAP_INTERVAL_S;
+        SC_ASSERT(sapAnnouncerInit(&sapConfig));
+    }
+
     PRINT("Mgmt Port:  %u", audioControlConfig.localMgmtPort);
+    PRINT("RTSP Port:  %u", audioControlConfig.localRtspPort);
 
     while (1)
     {
@@ -30,9 +30,11 @@
 
 #define STM32F4xx_MCUCONF
 
+/* For CONFIG_AUDIO_I2S_PORTS */
+#include "config.h"
 
 #define STM32_I2S_USE_SPI2                  TRUE
-#define STM32_I2S_USE_SPI3                  FALSE
+#define STM32_I2S_USE_SPI3                  (CONFIG_AUDIO_I2S_PORTS > 1)
 #define STM32_I2S_SPI2_IRQ_PRIORITY         10
 #define STM32_I2S_SPI3_IRQ_PRIORITY         10
 #define STM32_I2S_SPI2_DMA_PRIORITY         1
@@ -43,6 +45,7 @@
 #define STM32_I2S_SPI3_TX_DMA_STREAM        STM32_DMA_STREAM_ID(1, 7)
 #define STM32_I2S_DMA_ERROR_HOOK(i2sp)      osalSysHalt("DMA failure")
 #define STM32_I2S_SPI2_MODE                 (STM32_I2S_MODE_MASTER | STM32_I2S_MODE_RX) //XXX
+#define STM32_I2S_SPI3_MODE                 (STM32_I2S_MODE_MASTER | STM32_I2S_MODE_RX)
 
 /*
  * HAL driver system settings.
@@ -0,0 +1,234 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include "ch.h"
+#include "hal.h"
+#include "chprintf.h"
+#include "lwipthread.h"
+#include "lwip/ip_addr.h"
+#include "lwip/netif.h"
+#include "lwip/netifapi.h"
+#include "crc32.h"
+#include "network.h"
+
+/* Location of the STM32F4's 96 bit unique device ID */
+#define NETWORK_UID_ADDRESS         0x1FFF7A10
+#define NETWORK_UID_LENGTH          12
+
+/* How often to check on the interface while waiting for it */
+#define NETWORK_POLL_MS             10
+
+static struct {
+    uint8_t macAddress[6];
+    bool dhcpConfigured;
+    bool dhcpBound;
+    /* System time the link came up and an address was in use */
+    systime_t linkUpTime;
+    systime_t addressTime;
+} networkData;
+
+/* The first byte is kept from the configured MAC as it carries the locally
+ * administered and unicast bits. The unique ID is mostly lot and wafer
+ * information common to a batch of parts, so all 12 bytes are hashed to
+ * spread the die specific bits over the remaining 5. The second CRC carries
+ * on over the ID again, so it differs from the first but still depends on
+ * every byte. */
+static void networkMacFromUid(uint8_t *mac)
+{
+    const uint8_t *uid = (const uint8_t *)NETWORK_UID_ADDRESS;
+    uint32_t crc = crc32(0, uid, NETWORK_UID_LENGTH);
+    uint32_t extra = crc32(crc, uid, NETWORK_UID_LENGTH);
+
+    mac[1] = crc >> 24;
+    mac[2] = crc >> 16;
+    mac[3] = crc >> 8;
+    mac[4] = crc;
+    mac[5] = extra;
+}
+
+static bool networkHasAddress(void)
+{
+    return netif_default != NULL &&
+           !ip_addr_isany(&netif_default->ip_addr);
+}
+
+static StatusCode networkUseStatic(const settingsNetwork *addressing)
+{
+    ip_addr_t ipAddr;
+    ip_addr_t netmask;
+    ip_addr_t gateway;
+
+    ipAddr.addr  = addressing->ipAddr;
+    netmask.addr = addressing->netmask;
+    gateway.addr = addressing->gateway;
+
+    if (ERR_OK != netifapi_netif_set_addr(netif_default,
+                                          &ipAddr,
+                                          &netmask,
+                                          &gateway))
+    {
+        return STATUS_ERROR_LIBRARY_LWIP;
+    }
+
+    return STATUS_OK;
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+/* Brings up the interface and blocks until it has an address */
+StatusCode networkInit(const networkConfig *config)
+{
+    struct lwipthread_opts opts;
+    systime_t dhcpStart = 0;
+
+    memset(&networkData, 0, sizeof(networkData));
+    memcpy(networkData.macAddress,
+           config->macAddress,
+           sizeof(networkData.macAddress));
+
+    if (config->macFromUid)
+    {
+        networkMacFromUid(networkData.macAddress);
+    }
+
+    /* With DHCP the interface starts without an address */
+    memset(&opts, 0, sizeof(opts));
+    opts.macaddress = networkData.macAddress;
+
+    if (!config->addressing.dhcp)
+    {
+        opts.address = config->addressing.ipAddr;
+        opts.netmask = config->addressing.netmask;
+        opts.gateway = config->addressing.gateway;
+    }
+
+    lwipInit(&opts);
+
+    while (netif_default == NULL || macPollLinkStatus(&ETHD1) == false)
+    {
+        chThdSleep(MS2ST(NETWORK_POLL_MS));
+    }
+
+    networkData.linkUpTime = chVTGetSystemTimeX();
+
+    if (config->addressing.dhcp)
+    {
+        networkData.dhcpConfigured = true;
+
+        if (ERR_OK != netifapi_dhcp_start(netif_default))
+        {
+            return STATUS_ERROR_LIBRARY_LWIP;
+        }
+
+        dhcpStart = chVTGetSystemTimeX();
+
+        while (!networkHasAddress() &&
+               (systime_t)(chVTGetSystemTimeX() - dhcpStart) <
+                    S2ST(config->dhcpTimeoutS))
+        {
+            chThdSleep(MS2ST(NETWORK_POLL_MS));
+        }
+
+        networkData.dhcpBound = networkHasAddress();
+
+        if (!networkData.dhcpBound)
+        {
+            PRINT("No DHCP lease after %u s, using static address",
+                  config->dhcpTimeoutS);
+
+            if (ERR_OK != netifapi_dhcp_stop(netif_default))
+            {
+                return STATUS_ERROR_LIBRARY_LWIP;
+            }
+
+            SC_ASSERT(networkUseStatic(&config->addressing));
+        }
+    }
+
+    networkData.addressTime = chVTGetSystemTimeX();
+
+    PRINT("Device MAC: %02x:%02x:%02x:%02x:%02x:%02x",
+          networkData.macAddress[0],
+          networkData.macAddress[1],
+          networkData.macAddress[2],
+          networkData.macAddress[3],
+          networkData.macAddress[4],
+          networkData.macAddress[5]);
+    PRINT("Device IP:  %u.%u.%u.%u (%s)",
+          ip4_addr1(&netif_default->ip_addr),
+          ip4_addr2(&netif_default->ip_addr),
+          ip4_addr3(&netif_default->ip_addr),
+          ip4_addr4(&netif_default->ip_addr),
+          networkData.dhcpBound ? "DHCP" : "static");
+    PRINT("Link up after %u ms, addressed after %u ms",
+          ST2MS(networkData.linkUpTime),
+          ST2MS(networkData.addressTime));
+
+    return STATUS_OK;
+}
+
+/* Writes statistics as "key value" lines */
+void networkPrintStats(BaseSequentialStream *stream)
+{
+    ip_addr_t ipAddr;
+    ip_addr_t netmask;
+    ip_addr_t gateway;
+
+    ip_addr_set_zero(&ipAddr);
+    ip_addr_set_zero(&netmask);
+    ip_addr_set_zero(&gateway);
+
+    if (netif_default != NULL)
+    {
+        ipAddr  = netif_default->ip_addr;
+        netmask = netif_default->netmask;
+        gateway = netif_default->gw;
+    }
+
+    chprintf(stream, "net_mac %02x:%02x:%02x:%02x:%02x:%02x\n",
+             networkData.macAddress[0],
+             networkData.macAddress[1],
+             networkData.macAddress[2],
+             networkData.macAddress[3],
+             networkData.macAddress[4],
+             networkData.macAddress[5]);
+    chprintf(stream, "net_ip %u.%u.%u.%u\n",
+             ip4_addr1(&ipAddr), ip4_addr2(&ipAddr),
+             ip4_addr3(&ipAddr), ip4_addr4(&ipAddr));
+    chprintf(stream, "net_netmask %u.%u.%u.%u\n",
+             ip4_addr1(&netmask), ip4_addr2(&netmask),
+             ip4_addr3(&netmask), ip4_addr4(&netmask));
+    chprintf(stream, "net_gateway %u.%u.%u.%u\n",
+             ip4_addr1(&gateway), ip4_addr2(&gateway),
+             ip4_addr3(&gateway), ip4_addr4(&gateway));
+    chprintf(stream, "net_dhcp_configured %u\n", networkData.dhcpConfigured);
+    chprintf(stream, "net_dhcp_bound %u\n", networkData.dhcpBound);
+    chprintf(stream, "net_link_up_ms %u\n", ST2MS(networkData.linkUpTime));
+    chprintf(stream, "net_address_ms %u\n", ST2MS(networkData.addressTime));
+}
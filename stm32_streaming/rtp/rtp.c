@@ -27,7 +27,24 @@
 #include <string.h>
 #include "rtp.h"
 
-#define RTP_VERSION         2
+#define RTP_VERSION             2
+#define RTP_MARKER              0x80
+#define RTP_PAYLOAD_TYPE_MASK   0x7F
+#define RTP_EXTENSION           0x10
+
+/* RFC 8285 header extensions. The block starts with the profile and its
+ * length in 32 bit words, each element then has a one or two byte header. */
+#define RTP_EXTENSION_HEADER_LENGTH 4
+#define RTP_ONE_BYTE_PROFILE    0xBEDE
+#define RTP_ONE_BYTE_ID_MAX     14
+#define RTP_TWO_BYTE_PROFILE    0x1000
+
+#define RTCP_RR_PACKET_TYPE     201
+#define RTCP_APP_PACKET_TYPE    204
+#define RTCP_SUBTYPE_MASK       0x1F
+
+#define RTP_AUDIO_LEVEL_VOICE   0x80
+#define RTP_AUDIO_LEVEL_MASK    0x7F
 
 #define HTON32(H32)         (__builtin_bswap32(H32))
 #define HTON16(H16)         (__builtin_bswap16(H16))
@@ -66,6 +83,15 @@ static struct
 
     uint32_t ssrc;
 
+    /* Header extension layout, fixed for the session */
+    struct {
+        bool twoByte;
+        /* Bytes following the fixed header, 0 if there are no elements */
+        uint32_t length;
+        /* Offset of each element's data from the start of the packet */
+        uint32_t offsets[RTP_EXTENSION_MAX_ELEMENTS];
+    } extension;
+
 } rtpDataStore;
 
 StatusCode rtpGetRand(uint32_t *random)
@@ -73,6 +99,127 @@ StatusCode rtpGetRand(uint32_t *random)
     return rtpDataStore.config.getRandomCb(random);
 }
 
+/* Works out where each extension element goes. The one-byte form is used
+ * unless an element needs the two-byte one. */
+static StatusCode rtpLayoutExtensions(void)
+{
+    const rtpExtensionElement *elements = rtpDataStore.config.extensions;
+    uint32_t offset = 0;
+    uint32_t index = 0;
+    uint32_t other = 0;
+
+    memset(&rtpDataStore.extension, 0, sizeof(rtpDataStore.extension));
+
+    for (index = 0; index < RTP_EXTENSION_MAX_ELEMENTS; index++)
+    {
+        if (elements[index].id == 0)
+        {
+            continue;
+        }
+
+        /* IDs must be unique */
+        for (other = 0; other < index; other++)
+        {
+            if (elements[other].id == elements[index].id)
+            {
+                return STATUS_ERROR_API;
+            }
+        }
+
+        /* One-byte elements can't be empty */
+        if (elements[index].id > RTP_ONE_BYTE_ID_MAX ||
+            elements[index].length == 0 ||
+            elements[index].length > RTP_EXTENSION_ONE_BYTE_MAX)
+        {
+            rtpDataStore.extension.twoByte = true;
+        }
+    }
+
+    offset = RTP_HEADER_LENGTH + RTP_EXTENSION_HEADER_LENGTH;
+
+    for (index = 0; index < RTP_EXTENSION_MAX_ELEMENTS; index++)
+    {
+        if (elements[index].id == 0)
+        {
+            continue;
+        }
+
+        offset += rtpDataStore.extension.twoByte ? 2 : 1;
+        rtpDataStore.extension.offsets[index] = offset;
+        offset += elements[index].length;
+    }
+
+    if (offset == RTP_HEADER_LENGTH + RTP_EXTENSION_HEADER_LENGTH)
+    {
+        return STATUS_OK;
+    }
+
+    /* Padded to a whole number of words */
+    rtpDataStore.extension.length = (offset - RTP_HEADER_LENGTH + 3) & ~3U;
+
+    return STATUS_OK;
+}
+
+/* Writes the extension block, with each element's data zeroed ready to be
+ * filled in */
+static void rtpWriteExtensions(uint8_t *data)
+{
+    const rtpExtensionElement *elements = rtpDataStore.config.extensions;
+    uint8_t *extension = data + RTP_HEADER_LENGTH;
+    uint16_t profile = rtpDataStore.extension.twoByte ? RTP_TWO_BYTE_PROFILE :
+                                                        RTP_ONE_BYTE_PROFILE;
+    uint16_t words = (rtpDataStore.extension.length -
+                      RTP_EXTENSION_HEADER_LENGTH) / 4;
+    uint32_t index = 0;
+    uint8_t *element = NULL;
+
+    memset(extension, 0, rtpDataStore.extension.length);
+
+    extension[0] = profile >> 8;
+    extension[1] = profile & 0xFF;
+    extension[2] = words >> 8;
+    extension[3] = words & 0xFF;
+
+    for (index = 0; index < RTP_EXTENSION_MAX_ELEMENTS; index++)
+    {
+        if (elements[index].id == 0)
+        {
+            continue;
+        }
+
+        element = data + rtpDataStore.extension.offsets[index];
+
+        if (rtpDataStore.extension.twoByte)
+        {
+            element[-2] = elements[index].id;
+            element[-1] = elements[index].length;
+        }
+        else
+        {
+            element[-1] = elements[index].id << 4 |
+                          (elements[index].length - 1);
+        }
+    }
+}
+
+/* Finds an element of the session's header extension, checking it has the
+ * expected length */
+static uint8_t *rtpGetElement(uint8_t *data, uint8_t id, uint8_t length)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < RTP_EXTENSION_MAX_ELEMENTS; index++)
+    {
+        if (rtpDataStore.config.extensions[index].id == id &&
+            rtpDataStore.config.extensions[index].length != length)
+        {
+            return NULL;
+        }
+    }
+
+    return rtpGetExtension(data, id);
+}
+
 StatusCode rtpInit(const rtpConfig *config)
 {
     StatusCode status = STATUS_ERROR_INTERNAL;
@@ -85,6 +232,11 @@ StatusCode rtpInit(const rtpConfig *config)
 
     memcpy(&rtpDataStore.config, config, sizeof(rtpDataStore.config));
 
+    if (STATUS_OK != (status = rtpLayoutExtensions()))
+    {
+        return status;
+    }
+
     if (STATUS_OK != (status = rtpGetRand(&rtpDataStore.ssrc)))
     {
         return status;
@@ -112,13 +264,26 @@ StatusCode rtpShutdown(void)
     return STATUS_OK;
 }
 
-/* data should be a buffer with payload already in the correct place. */
+/* data should be a buffer with payload already in the correct place, i.e.
+ * rtpGetHeaderLength() bytes in. */
 StatusCode rtpAddHeader(uint8_t *data,
                         uint32_t length)
+{
+    return rtpAddHeaderEx(data, length, rtpDataStore.config.payloadType, false);
+}
+
+/* As rtpAddHeader(), for a payload type other than the configured one, e.g.
+ * comfort noise. marker flags the start of a talkspurt. Any header extension
+ * is written with its elements zeroed, for the rtpSet...() functions to fill
+ * in. */
+StatusCode rtpAddHeaderEx(uint8_t *data,
+                          uint32_t length,
+                          uint8_t payloadType,
+                          bool marker)
 {
     rtpDataHeader *header = (rtpDataHeader*)data;
 
-    if (data == NULL || length < RTP_HEADER_LENGTH)
+    if (data == NULL || length < rtpGetHeaderLength())
     {
         return STATUS_ERROR_API;
     }
@@ -127,11 +292,160 @@ StatusCode rtpAddHeader(uint8_t *data,
     rtpDataStore.sequenceNumber++;
 
     header->verPadExCC          = RTP_VERSION << 6;
-    header->markerPayloadType   = rtpDataStore.config.payloadType;
+    header->markerPayloadType   = (marker ? RTP_MARKER : 0) |
+                                  (payloadType & RTP_PAYLOAD_TYPE_MASK);
     header->timestamp           = HTON32(rtpDataStore.periodicTimestamp);
     header->sequenceNumber      = HTON16(rtpDataStore.sequenceNumber);
     header->ssrc                = HTON32(rtpDataStore.ssrc);
 
+    if (rtpDataStore.extension.length != 0)
+    {
+        header->verPadExCC |= RTP_EXTENSION;
+        rtpWriteExtensions(data);
+    }
+
+    return STATUS_OK;
+}
+
+/* Accounts for a period which isn't being transmitted, e.g. suppressed
+ * silence. The timestamp keeps advancing but the sequence number doesn't, so
+ * receivers can tell intentional gaps from loss. */
+void rtpSkip(void)
+{
+    rtpDataStore.periodicTimestamp += rtpDataStore.config.periodicTimestampIncr;
+}
+
+/* Length of the fixed header and the extension of every packet in the
+ * session, i.e. where the payload starts */
+uint32_t rtpGetHeaderLength(void)
+{
+    return RTP_HEADER_LENGTH + rtpDataStore.extension.length;
+}
+
+/* Data of a header extension element in a packet built by rtpAddHeader(), to
+ * be written in place. NULL if the session doesn't have element id. */
+uint8_t *rtpGetExtension(uint8_t *data, uint8_t id)
+{
+    uint32_t index = 0;
+
+    if (data == NULL || id == 0)
+    {
+        return NULL;
+    }
+
+    for (index = 0; index < RTP_EXTENSION_MAX_ELEMENTS; index++)
+    {
+        if (rtpDataStore.config.extensions[index].id == id)
+        {
+            return data + rtpDataStore.extension.offsets[index];
+        }
+    }
+
+    return NULL;
+}
+
+/* level in -dBov, 127 being silence. voice flags it as speech. */
+StatusCode rtpSetAudioLevel(uint8_t *data,
+                            uint8_t id,
+                            uint8_t level,
+                            bool voice)
+{
+    uint8_t *element = rtpGetElement(data, id, RTP_AUDIO_LEVEL_LENGTH);
+
+    if (element == NULL)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    element[0] = (voice ? RTP_AUDIO_LEVEL_VOICE : 0) |
+                 (level & RTP_AUDIO_LEVEL_MASK);
+
     return STATUS_OK;
 }
 
+/* ntpTime is 32.32 fixed point seconds */
+StatusCode rtpSetAbsCaptureTime(uint8_t *data, uint8_t id, uint64_t ntpTime)
+{
+    uint8_t *element = rtpGetElement(data, id, RTP_ABS_CAPTURE_TIME_LENGTH);
+    uint32_t index = 0;
+
+    if (element == NULL)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    for (index = 0; index < RTP_ABS_CAPTURE_TIME_LENGTH; index++)
+    {
+        element[index] = ntpTime >> (8 * (RTP_ABS_CAPTURE_TIME_LENGTH - 1 -
+                                          index));
+    }
+
+    return STATUS_OK;
+}
+
+StatusCode rtpSetDspOverruns(uint8_t *data, uint8_t id, uint16_t overruns)
+{
+    uint8_t *element = rtpGetElement(data, id, RTP_DSP_OVERRUNS_LENGTH);
+
+    if (element == NULL)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    element[0] = overruns >> 8;
+    element[1] = overruns & 0xFF;
+
+    return STATUS_OK;
+}
+
+/* A compound RTCP packet must start with a report (RFC 3550 section 6.1).
+ * This writes one with no report blocks, RTCP_RR_LENGTH bytes, for packets
+ * only carrying an APP packet after it. */
+StatusCode rtcpAddEmptyReceiverReport(uint8_t *data)
+{
+    if (data == NULL)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    data[0] = RTP_VERSION << 6;
+    data[1] = RTCP_RR_PACKET_TYPE;
+    data[2] = 0;
+    data[3] = RTCP_RR_LENGTH / 4 - 1;
+    data[4] = rtpDataStore.ssrc >> 24;
+    data[5] = rtpDataStore.ssrc >> 16;
+    data[6] = rtpDataStore.ssrc >> 8;
+    data[7] = rtpDataStore.ssrc & 0xFF;
+
+    return STATUS_OK;
+}
+
+/* data should be a buffer of length bytes, a multiple of 4, with the
+ * application dependent data already RTCP_APP_HEADER_LENGTH bytes in. name is
+ * the four ASCII characters identifying the application. The session's SSRC
+ * is used, so receivers can match the packet to the stream. */
+StatusCode rtcpAddAppHeader(uint8_t *data,
+                            uint32_t length,
+                            uint8_t subtype,
+                            const char *name)
+{
+    uint16_t words = length / 4 - 1;
+
+    if (data == NULL || name == NULL || length < RTCP_APP_HEADER_LENGTH ||
+        length % 4 != 0)
+    {
+        return STATUS_ERROR_API;
+    }
+
+    data[0] = RTP_VERSION << 6 | (subtype & RTCP_SUBTYPE_MASK);
+    data[1] = RTCP_APP_PACKET_TYPE;
+    data[2] = words >> 8;
+    data[3] = words & 0xFF;
+    data[4] = rtpDataStore.ssrc >> 24;
+    data[5] = rtpDataStore.ssrc >> 16;
+    data[6] = rtpDataStore.ssrc >> 8;
+    data[7] = rtpDataStore.ssrc & 0xFF;
+    memcpy(data + 8, name, RTCP_APP_NAME_LENGTH);
+
+    return STATUS_OK;
+}
@@ -28,20 +28,70 @@
 #define __RTP_H__
 
 #include <stdint.h>
-#include "debug.h"
+#include <stdbool.h>
+#include "status_code.h"
 
+/* Fixed header. Longer if header extensions are used, see
+ * rtpGetHeaderLength(). */
 #define RTP_HEADER_LENGTH       12
 
+/* RFC 8285 header extension elements a session can carry */
+#define RTP_EXTENSION_MAX_ELEMENTS  4
+
+/* Most data an element can have in the one-byte form. Longer elements, or IDs
+ * above 14, switch every element to the two-byte form. */
+#define RTP_EXTENSION_ONE_BYTE_MAX  16
+
+/* Extensions with helpers below */
+
+/* RFC 6464 client to mixer audio level */
+#define RTP_AUDIO_LEVEL_URI         "urn:ietf:params:rtp-hdrext:ssrc-audio-level"
+#define RTP_AUDIO_LEVEL_LENGTH      1
+
+/* Absolute capture time, a 64 bit NTP format timestamp of the first sample */
+#define RTP_ABS_CAPTURE_TIME_URI    "http://www.webrtc.org/experiments/" \
+                                    "rtp-hdrext/abs-capture-time"
+#define RTP_ABS_CAPTURE_TIME_LENGTH 8
+
+/* Count of blocks the sender failed to process in time, so a receiver can
+ * tell gaps in the audio from network loss */
+#define RTP_DSP_OVERRUNS_URI        "http://github.com/alanbarr/" \
+                                    "STM32F4_Streaming_Mic/rtp-hdrext/" \
+                                    "dsp-overruns"
+#define RTP_DSP_OVERRUNS_LENGTH     2
+
+/* RTCP receiver report without any report blocks */
+#define RTCP_RR_LENGTH          8
+
+/* RTCP APP packet header, before its application dependent data. RFC 3550
+ * section 6.7. */
+#define RTCP_APP_HEADER_LENGTH  12
+#define RTCP_APP_NAME_LENGTH    4
+
 typedef StatusCode (*rtpGetRandom)(uint32_t *random);
 
+typedef struct {
+    /* 0 if unused. Up to 14 for the one-byte form, 255 for the two-byte. */
+    uint8_t id;
+    /* Bytes of data */
+    uint8_t length;
+    /* Identify the extension in SDP. attributes may be NULL. */
+    const char *uri;
+    const char *attributes;
+} rtpExtensionElement;
+
 typedef struct {
     /* Value to increment the period time stamp by per RTP packet 
      * transmitted */
     uint32_t periodicTimestampIncr;
     /* Payload type of RTP packet */
     uint8_t payloadType;
+    /* Rate of the clock the timestamp is derived from, Hz */
+    uint32_t clockRate;
     /* Callback to obtain random numbers */
     rtpGetRandom getRandomCb;
+    /* Header extension elements carried by every packet */
+    rtpExtensionElement extensions[RTP_EXTENSION_MAX_ELEMENTS];
 } rtpConfig;
 
 
@@ -51,5 +101,23 @@ StatusCode rtpInit(const rtpConfig *config);
 StatusCode rtpShutdown(void);
 StatusCode rtpAddHeader(uint8_t *data,
                        uint32_t length);
+StatusCode rtpAddHeaderEx(uint8_t *data,
+                          uint32_t length,
+                          uint8_t payloadType,
+                          bool marker);
+void rtpSkip(void);
+uint32_t rtpGetHeaderLength(void);
+uint8_t *rtpGetExtension(uint8_t *data, uint8_t id);
+StatusCode rtpSetAudioLevel(uint8_t *data,
+                            uint8_t id,
+                            uint8_t level,
+                            bool voice);
+StatusCode rtpSetAbsCaptureTime(uint8_t *data, uint8_t id, uint64_t ntpTime);
+StatusCode rtpSetDspOverruns(uint8_t *data, uint8_t id, uint16_t overruns);
+StatusCode rtcpAddEmptyReceiverReport(uint8_t *data);
+StatusCode rtcpAddAppHeader(uint8_t *data,
+                            uint32_t length,
+                            uint8_t subtype,
+                            const char *name);
 
 #endif /* Header Guard */
@@ -0,0 +1,177 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "ch.h"
+#include "hal.h"
+#include "crc32.h"
+#include "settings.h"
+
+/* Settings are kept in the last 128 KB sector of the STM32F407's 1 MB of
+ * flash, well clear of the firmware image. Writing erases the whole sector,
+ * stalling anything executing from flash for a second or two. */
+#define SETTINGS_FLASH_SECTOR       11
+#define SETTINGS_FLASH_ADDRESS      0x080E0000
+
+#define SETTINGS_FLASH_KEY1         0x45670123
+#define SETTINGS_FLASH_KEY2         0xCDEF89AB
+#define SETTINGS_FLASH_SNB_SHIFT    3
+#define SETTINGS_FLASH_SR_ERRORS    (FLASH_SR_PGSERR | FLASH_SR_PGPERR | \
+                                     FLASH_SR_PGAERR | FLASH_SR_WRPERR | \
+                                     FLASH_SR_OPERR)
+
+/* Identifies a settings block and its layout */
+#define SETTINGS_MAGIC              0x53544E47
+#define SETTINGS_VERSION            1
+
+/* Settings as stored in flash */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t dhcp;
+    uint32_t ipAddr;
+    uint32_t netmask;
+    uint32_t gateway;
+    /* CRC-32 of everything above */
+    uint32_t crc;
+} settingsBlock;
+
+static struct {
+    settingsNetwork network;
+    bool loadedFromFlash;
+} settingsData;
+
+static void settingsFlashWait(void)
+{
+    while (FLASH->SR & FLASH_SR_BSY)
+    {
+        ;
+    }
+}
+
+static StatusCode settingsFlashWrite(const settingsBlock *block)
+{
+    volatile uint32_t *destination = (volatile uint32_t *)SETTINGS_FLASH_ADDRESS;
+    const uint32_t *source = (const uint32_t *)block;
+    uint32_t index = 0;
+    StatusCode rtn = STATUS_OK;
+
+    settingsFlashWait();
+
+    FLASH->KEYR = SETTINGS_FLASH_KEY1;
+    FLASH->KEYR = SETTINGS_FLASH_KEY2;
+
+    /* Clear any stale status */
+    FLASH->SR = SETTINGS_FLASH_SR_ERRORS | FLASH_SR_EOP;
+
+    /* Erase the sector, 32 bit parallelism suits a 2.7 - 3.6 V supply */
+    FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_SER |
+                (SETTINGS_FLASH_SECTOR << SETTINGS_FLASH_SNB_SHIFT);
+    FLASH->CR |= FLASH_CR_STRT;
+    settingsFlashWait();
+
+    if (FLASH->SR & SETTINGS_FLASH_SR_ERRORS)
+    {
+        rtn = STATUS_ERROR_HW;
+        goto lock;
+    }
+
+    FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_PG;
+
+    for (index = 0; index < sizeof(*block) / sizeof(uint32_t); index++)
+    {
+        destination[index] = source[index];
+        settingsFlashWait();
+
+        if (FLASH->SR & SETTINGS_FLASH_SR_ERRORS)
+        {
+            rtn = STATUS_ERROR_HW;
+            break;
+        }
+    }
+
+lock:
+    FLASH->CR = FLASH_CR_LOCK;
+
+    return rtn;
+}
+
+/* Loads settings from flash, otherwise the provided defaults are used */
+StatusCode settingsInit(const settingsNetwork *defaults)
+{
+    const settingsBlock *block = (const settingsBlock *)SETTINGS_FLASH_ADDRESS;
+
+    memset(&settingsData, 0, sizeof(settingsData));
+    settingsData.network = *defaults;
+
+    if (block->magic != SETTINGS_MAGIC ||
+        block->version != SETTINGS_VERSION ||
+        block->crc != crc32(0, block, offsetof(settingsBlock, crc)))
+    {
+        return STATUS_OK;
+    }
+
+    settingsData.network.dhcp    = block->dhcp != 0;
+    settingsData.network.ipAddr  = block->ipAddr;
+    settingsData.network.netmask = block->netmask;
+    settingsData.network.gateway = block->gateway;
+    settingsData.loadedFromFlash = true;
+
+    return STATUS_OK;
+}
+
+void settingsGetNetwork(settingsNetwork *network)
+{
+    *network = settingsData.network;
+}
+
+/* Stores new network settings. They take effect from the next boot. */
+StatusCode settingsSetNetwork(const settingsNetwork *network)
+{
+    settingsBlock block;
+
+    memset(&block, 0, sizeof(block));
+    block.magic     = SETTINGS_MAGIC;
+    block.version   = SETTINGS_VERSION;
+    block.dhcp      = network->dhcp;
+    block.ipAddr    = network->ipAddr;
+    block.netmask   = network->netmask;
+    block.gateway   = network->gateway;
+    block.crc       = crc32(0, &block, offsetof(settingsBlock, crc));
+
+    SC_ASSERT(settingsFlashWrite(&block));
+
+    settingsData.network = *network;
+    settingsData.loadedFromFlash = true;
+
+    return STATUS_OK;
+}
+
+bool settingsLoadedFromFlash(void)
+{
+    return settingsData.loadedFromFlash;
+}
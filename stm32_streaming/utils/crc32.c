@@ -0,0 +1,52 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "crc32.h"
+
+/* Reflected polynomial of the IEEE 802.3 CRC-32 */
+#define CRC32_POLYNOMIAL    0xEDB88320
+
+/* Bitwise CRC-32, as used by Ethernet and zlib. Only used on small blocks of
+ * data, so isn't worth the flash for a table. Pass 0 as crc to start. */
+uint32_t crc32(uint32_t crc, const void *data, uint32_t length)
+{
+    const uint8_t *bytes = data;
+    uint32_t bit = 0;
+
+    crc = ~crc;
+
+    while (length--)
+    {
+        crc ^= *bytes++;
+
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & -(crc & 1));
+        }
+    }
+
+    return ~crc;
+}
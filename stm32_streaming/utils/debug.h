@@ -29,6 +29,7 @@
 #include "ch.h"
 #include "hal.h"
 #include <stdarg.h>
+#include "status_code.h"
 
 #if 1
 #define PRINT(FMT, ...)                                                     \
@@ -74,33 +75,6 @@
 
 extern mutex_t serialPrintMtx;
 
-typedef enum 
-{
-    /* Success */
-    STATUS_OK,
-    /* Argument provided to API was bad */
-    STATUS_ERROR_API,
-    /* Callback failed */
-    STATUS_ERROR_CALLBACK,
-    /* Internal error */
-    STATUS_ERROR_INTERNAL,
-    /* Some form of system input was out of expected range. */
-    STATUS_ERROR_EXTERNAL_INPUT,
-    /* OS returned Error */
-    STATUS_ERROR_OS,
-    /* Library returned error */
-    STATUS_ERROR_LIBRARY,
-    /* LWIP Library returned error */
-    STATUS_ERROR_LIBRARY_LWIP,
-    /* Error interfacing with HW */
-    STATUS_ERROR_HW,
-    /* Unexpected timeout */
-    STATUS_ERROR_TIMEOUT,
-    /* Placeholder for bounds checking */
-    STATUS_CODE_ENUM_MAX
-} StatusCode;
-
-
 void debugInit(void);
 void debugShutdown(void);
 void debugSerialPrint(const char * fmt, ...);
@@ -0,0 +1,209 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "analysis.h"
+
+/* A sin and cos per harmonic, plus DC */
+#define ANALYSIS_MAX_TERMS      (2 * ANALYSIS_MAX_HARMONICS + 1)
+
+/* Solves the n x n system in place. Returns 0 on success. */
+static int analysisSolve(double matrix[ANALYSIS_MAX_TERMS][ANALYSIS_MAX_TERMS],
+                         double *vector,
+                         uint32_t n)
+{
+    uint32_t pivot = 0;
+    uint32_t row = 0;
+    uint32_t col = 0;
+    uint32_t best = 0;
+    double factor = 0;
+    double swap = 0;
+
+    for (pivot = 0; pivot < n; pivot++)
+    {
+        best = pivot;
+
+        for (row = pivot + 1; row < n; row++)
+        {
+            if (fabs(matrix[row][pivot]) > fabs(matrix[best][pivot]))
+            {
+                best = row;
+            }
+        }
+
+        if (matrix[best][pivot] == 0)
+        {
+            return -1;
+        }
+
+        for (col = 0; col < n; col++)
+        {
+            swap = matrix[pivot][col];
+            matrix[pivot][col] = matrix[best][col];
+            matrix[best][col] = swap;
+        }
+
+        swap = vector[pivot];
+        vector[pivot] = vector[best];
+        vector[best] = swap;
+
+        for (row = pivot + 1; row < n; row++)
+        {
+            factor = matrix[row][pivot] / matrix[pivot][pivot];
+
+            for (col = pivot; col < n; col++)
+            {
+                matrix[row][col] -= factor * matrix[pivot][col];
+            }
+
+            vector[row] -= factor * vector[pivot];
+        }
+    }
+
+    for (row = n; row > 0; row--)
+    {
+        for (col = row; col < n; col++)
+        {
+            vector[row - 1] -= matrix[row - 1][col] * vector[col];
+        }
+
+        vector[row - 1] /= matrix[row - 1][row - 1];
+    }
+
+    return 0;
+}
+
+static uint32_t analysisBasis(double frequency,
+                              uint32_t harmonics,
+                              uint32_t n,
+                              double *basis)
+{
+    uint32_t terms = 0;
+    uint32_t harmonic = 0;
+
+    basis[terms++] = 1;
+
+    for (harmonic = 1; harmonic <= harmonics; harmonic++)
+    {
+        basis[terms++] = sin(2 * M_PI * frequency * harmonic * n);
+        basis[terms++] = cos(2 * M_PI * frequency * harmonic * n);
+    }
+
+    return terms;
+}
+
+/* Least squares fit of a tone, its harmonics and DC to samples. Everything
+ * left over is noise.
+ * frequency:   of the fundamental, relative to the sampling rate
+ * harmonics:   to fit, including the fundamental. Those at or above the
+ *              Nyquist frequency are ignored.
+ * Returns 0 on success. */
+int analyseTone(const float *samples,
+                uint32_t count,
+                double frequency,
+                uint32_t harmonics,
+                toneAnalysis *result)
+{
+    double matrix[ANALYSIS_MAX_TERMS][ANALYSIS_MAX_TERMS];
+    double fit[ANALYSIS_MAX_TERMS];
+    double basis[ANALYSIS_MAX_TERMS];
+    double fundamental = 0;
+    double harmonic = 0;
+    double residual = 0;
+    uint32_t terms = 0;
+    uint32_t n = 0;
+    uint32_t row = 0;
+    uint32_t col = 0;
+
+    memset(result, 0, sizeof(*result));
+    memset(matrix, 0, sizeof(matrix));
+    memset(fit, 0, sizeof(fit));
+
+    if (harmonics == 0 || harmonics > ANALYSIS_MAX_HARMONICS || count == 0)
+    {
+        return -1;
+    }
+
+    while (harmonics > 1 && frequency * harmonics >= 0.5)
+    {
+        harmonics--;
+    }
+
+    /* Normal equations */
+    for (n = 0; n < count; n++)
+    {
+        terms = analysisBasis(frequency, harmonics, n, basis);
+
+        for (row = 0; row < terms; row++)
+        {
+            fit[row] += basis[row] * samples[n];
+
+            for (col = 0; col < terms; col++)
+            {
+                matrix[row][col] += basis[row] * basis[col];
+            }
+        }
+    }
+
+    if (0 != analysisSolve(matrix, fit, terms))
+    {
+        return -1;
+    }
+
+    for (n = 0; n < count; n++)
+    {
+        analysisBasis(frequency, harmonics, n, basis);
+
+        fundamental = fit[1] * basis[1] + fit[2] * basis[2];
+        harmonic = 0;
+
+        for (row = 3; row < terms; row++)
+        {
+            harmonic += fit[row] * basis[row];
+        }
+
+        residual = samples[n] - fit[0] - fundamental - harmonic;
+
+        result->signalPower += fundamental * fundamental;
+        result->harmonicPower += harmonic * harmonic;
+        result->noisePower += residual * residual;
+    }
+
+    result->signalPower /= count;
+    result->harmonicPower /= count;
+    result->noisePower /= count;
+    result->dc = fit[0];
+    result->amplitude = hypot(fit[1], fit[2]);
+    result->phase = atan2(fit[2], fit[1]);
+
+    return 0;
+}
+
+double analysisDb(double ratio)
+{
+    return 10 * log10(ratio);
+}
@@ -0,0 +1,683 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* Measures each of the decimation kernels in audio/audio_dsp.c over the same
+ * simulated MP45DT02 output, so changes to the DSP can be judged on numbers.
+ * Results are printed and optionally written as JSON or CSV. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "audio_dsp.h"
+#include "analysis.h"
+#include "sigma_delta.h"
+
+#define PDM_RATE_HZ             (MP45DT02_RAW_FREQ_KHZ * 1000)
+#define PCM_RATE_HZ             (PDM_RATE_HZ / MP45DT02_FIR_DECIMATION_FACTOR)
+
+/* Filter settling time excluded from every measurement */
+#define SETTLE_BLOCKS           50
+
+/* Full scale of the PCM output, which is in the int16_t range */
+#define PCM_FULL_SCALE          32768.0
+
+/* Every tone, other than the idle channel, is at this level */
+#define TONE_AMPLITUDE          0.5
+
+/* SNR and THD+N are measured at this frequency. It is also the 0 dB
+ * reference for the frequency response. */
+#define REFERENCE_HZ            1000.0
+
+/* Ripple is measured up to here */
+#define PASSBAND_EDGE_HZ        4000.0
+
+/* Tones from here up alias into the passband. Rejection is the worst of
+ * these. */
+#define STOPBAND_EDGE_HZ        12000.0
+
+/* The group delay is taken from the phase difference between these */
+#define GROUP_DELAY_LOW_HZ      500.0
+#define GROUP_DELAY_HIGH_HZ     REFERENCE_HZ
+
+#define NS_PER_S                1000000000.0
+
+static const double passbandHz[] = {
+    50, 100, 200, 300, 500, 700, 1000, 1500, 2000, 2500, 3000, 3500, 4000,
+    5000, 6000, 7000
+};
+
+/* None of these alias to DC or the Nyquist frequency of the output */
+static const double stopbandHz[] = {
+    9000, 12000, 15000, 17000, 20000, 25000, 31000, 47000, 63000
+};
+
+#define PASSBAND_TONES          (sizeof(passbandHz) / sizeof(passbandHz[0]))
+#define STOPBAND_TONES          (sizeof(stopbandHz) / sizeof(stopbandHz[0]))
+
+/* Stimulus shared by all the kernels */
+typedef struct {
+    double frequency;
+    double amplitude;
+    uint16_t *pdm;
+} testSignal;
+
+typedef struct {
+    double frequency;
+    double gainDb;
+} responsePoint;
+
+typedef struct {
+    audioDspKernel kernel;
+    double snrDb;
+    double thdnDb;
+    double idleNoiseDbfs;
+    double passbandRippleDb;
+    double stopbandRejectionDb;
+    double groupDelayUs;
+    /* Largest difference from the CMSIS kernel, for the reference tone */
+    double maxDeviation;
+    double nsPerSample;
+    /* CMSIS kernel's time over this kernel's */
+    double speedup;
+    responsePoint passband[PASSBAND_TONES];
+    responsePoint stopband[STOPBAND_TONES];
+} kernelResults;
+
+static struct {
+    float durationS;
+    uint32_t blocks;
+    /* Only run this kernel, AUDIO_DSP_KERNEL_COUNT for all */
+    audioDspKernel kernel;
+    const char *jsonPath;
+    const char *csvPath;
+    /* Fail if any kernel's SNR is below this, dB */
+    float minSnrDb;
+    sigmaDeltaConfig modulator;
+} options;
+
+/******************************************************************************/
+/* Measurement                                                                */
+/******************************************************************************/
+
+static double elapsedS(const struct timespec *start, const struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) +
+           (end->tv_nsec - start->tv_nsec) / NS_PER_S;
+}
+
+/* Wraps to -pi to pi */
+static double wrapPhase(double phase)
+{
+    return phase - 2 * M_PI * floor((phase + M_PI) / (2 * M_PI));
+}
+
+/* Where a tone at frequency ends up after decimation */
+static double aliasHz(double frequency)
+{
+    return fabs(frequency - PCM_RATE_HZ * floor(frequency / PCM_RATE_HZ + 0.5));
+}
+
+static int generate(testSignal *signal, double frequency, double amplitude)
+{
+    static float samples[MP45DT02_I2S_SAMPLE_SIZE_BITS];
+    sigmaDelta modulator;
+    uint64_t n = 0;
+    uint32_t block = 0;
+    uint32_t index = 0;
+
+    signal->frequency = frequency;
+    signal->amplitude = amplitude;
+    signal->pdm = malloc(options.blocks * MP45DT02_I2S_SAMPLE_SIZE_2B *
+                         sizeof(uint16_t));
+
+    if (signal->pdm == NULL || 0 != sigmaDeltaInit(&modulator, &options.modulator))
+    {
+        return -1;
+    }
+
+    for (block = 0; block < options.blocks; block++)
+    {
+        for (index = 0; index < MP45DT02_I2S_SAMPLE_SIZE_BITS; index++, n++)
+        {
+            samples[index] = amplitude *
+                             sin(2 * M_PI * frequency * (double)n / PDM_RATE_HZ);
+        }
+
+        sigmaDeltaProcess(&modulator,
+                          samples,
+                          MP45DT02_I2S_SAMPLE_SIZE_BITS,
+                          signal->pdm + block * MP45DT02_I2S_SAMPLE_SIZE_2B);
+    }
+
+    return 0;
+}
+
+/* Runs a fresh instance of the kernel over the signal. Returns the time spent
+ * in the kernel. */
+static double run(audioDspKernel kernel, const testSignal *signal, float *pcm)
+{
+    static audioDsp dsp;
+    struct timespec start;
+    struct timespec end;
+    uint32_t block = 0;
+
+    audioDspInit(&dsp, kernel);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (block = 0; block < options.blocks; block++)
+    {
+        audioDspProcess(&dsp,
+                        signal->pdm + block * MP45DT02_I2S_SAMPLE_SIZE_2B,
+                        pcm + block * MP45DT02_DECIMATED_BUFFER_SIZE);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return elapsedS(&start, &end);
+}
+
+/* Fits the tone, as it appears at the output, to the settled samples.
+ * The amplitude is made relative to the input and the phase, relative to that
+ * of the input, becomes -2 pi f x delay. */
+static int measure(const testSignal *signal,
+                   const float *pcm,
+                   toneAnalysis *tone)
+{
+    const uint32_t skip = SETTLE_BLOCKS * MP45DT02_DECIMATED_BUFFER_SIZE;
+    const uint32_t count = options.blocks * MP45DT02_DECIMATED_BUFFER_SIZE;
+    double alias = aliasHz(signal->frequency);
+    double inputPhase = 0;
+
+    if (0 != analyseTone(pcm + skip, count - skip, alias / PCM_RATE_HZ,
+                         signal->frequency < PCM_RATE_HZ / 2 ?
+                         ANALYSIS_MAX_HARMONICS : 1,
+                         tone))
+    {
+        return -1;
+    }
+
+    /* As with CMSIS, the newest input used for output sample i is
+     * i * decimation. Only meaningful for tones below the output's Nyquist
+     * frequency. */
+    inputPhase = 2 * M_PI * signal->frequency *
+                 fmod((double)skip * MP45DT02_FIR_DECIMATION_FACTOR,
+                      PDM_RATE_HZ / signal->frequency) / PDM_RATE_HZ;
+
+    tone->phase = wrapPhase(tone->phase - inputPhase);
+    tone->amplitude /= signal->amplitude * PCM_FULL_SCALE;
+
+    return 0;
+}
+
+static int benchmark(audioDspKernel kernel,
+                     const float *referencePcm,
+                     const testSignal *reference,
+                     const testSignal *idle,
+                     const testSignal *passband,
+                     const testSignal *stopband,
+                     float *pcm,
+                     kernelResults *results)
+{
+    const uint32_t skip = SETTLE_BLOCKS * MP45DT02_DECIMATED_BUFFER_SIZE;
+    const uint32_t count = options.blocks * MP45DT02_DECIMATED_BUFFER_SIZE;
+    toneAnalysis tone;
+    double referenceGain = 0;
+    double referencePhase = 0;
+    double lowPhase = 0;
+    double maxDb = -INFINITY;
+    double minDb = INFINITY;
+    double seconds = INFINITY;
+    double mean = 0;
+    double power = 0;
+    uint32_t index = 0;
+
+    memset(results, 0, sizeof(*results));
+    results->kernel = kernel;
+
+    /* Reference tone */
+    seconds = fmin(seconds, run(kernel, reference, pcm));
+
+    if (0 != measure(reference, pcm, &tone))
+    {
+        return -1;
+    }
+
+    for (index = skip; index < count; index++)
+    {
+        results->maxDeviation = fmax(results->maxDeviation,
+                                     fabs(pcm[index] - referencePcm[index]));
+    }
+
+    referenceGain = tone.amplitude;
+    referencePhase = tone.phase;
+    results->snrDb = analysisDb(tone.signalPower / tone.noisePower);
+    results->thdnDb = analysisDb((tone.harmonicPower + tone.noisePower) /
+                                 tone.signalPower);
+
+    /* Idle channel, DC removed as a microphone's would be further on */
+    seconds = fmin(seconds, run(kernel, idle, pcm));
+
+    for (index = skip; index < count; index++)
+    {
+        mean += pcm[index];
+    }
+
+    mean /= count - skip;
+
+    for (index = skip; index < count; index++)
+    {
+        power += (pcm[index] - mean) * (pcm[index] - mean);
+    }
+
+    results->idleNoiseDbfs = analysisDb(power / (count - skip) /
+                                        (PCM_FULL_SCALE * PCM_FULL_SCALE));
+
+    /* Frequency response */
+    for (index = 0; index < PASSBAND_TONES; index++)
+    {
+        seconds = fmin(seconds, run(kernel, &passband[index], pcm));
+
+        if (0 != measure(&passband[index], pcm, &tone))
+        {
+            return -1;
+        }
+
+        results->passband[index].frequency = passband[index].frequency;
+        results->passband[index].gainDb =
+                20 * log10(tone.amplitude / referenceGain);
+
+        if (passband[index].frequency <= PASSBAND_EDGE_HZ)
+        {
+            maxDb = fmax(maxDb, results->passband[index].gainDb);
+            minDb = fmin(minDb, results->passband[index].gainDb);
+        }
+
+        if (passband[index].frequency == GROUP_DELAY_LOW_HZ)
+        {
+            lowPhase = tone.phase;
+        }
+    }
+
+    results->passbandRippleDb = maxDb - minDb;
+    results->groupDelayUs = -wrapPhase(referencePhase - lowPhase) /
+                            (2 * M_PI * (GROUP_DELAY_HIGH_HZ - GROUP_DELAY_LOW_HZ)) *
+                            1e6;
+
+    /* Aliasing */
+    results->stopbandRejectionDb = INFINITY;
+
+    for (index = 0; index < STOPBAND_TONES; index++)
+    {
+        seconds = fmin(seconds, run(kernel, &stopband[index], pcm));
+
+        if (0 != measure(&stopband[index], pcm, &tone))
+        {
+            return -1;
+        }
+
+        results->stopband[index].frequency = stopband[index].frequency;
+        results->stopband[index].gainDb =
+                20 * log10(tone.amplitude / referenceGain);
+
+        if (stopband[index].frequency >= STOPBAND_EDGE_HZ)
+        {
+            results->stopbandRejectionDb = fmin(results->stopbandRejectionDb,
+                                                -results->stopband[index].gainDb);
+        }
+    }
+
+    /* The fastest run is the least disturbed by the host */
+    results->nsPerSample = seconds * NS_PER_S / count;
+
+    return 0;
+}
+
+/******************************************************************************/
+/* Output                                                                     */
+/******************************************************************************/
+
+static void printResults(const kernelResults *results)
+{
+    printf("kernel %s\n", audioDspKernelName(results->kernel));
+    printf("snr_db %.1f\n", results->snrDb);
+    printf("thd_n_db %.1f\n", results->thdnDb);
+    printf("idle_noise_dbfs %.1f\n", results->idleNoiseDbfs);
+    printf("passband_ripple_db %.3f\n", results->passbandRippleDb);
+    printf("stopband_rejection_db %.1f\n", results->stopbandRejectionDb);
+    printf("group_delay_us %.1f\n", results->groupDelayUs);
+    printf("max_deviation %.3g\n", results->maxDeviation);
+    printf("ns_per_sample %.1f\n", results->nsPerSample);
+    printf("speedup %.2f\n", results->speedup);
+}
+
+static void writeResponse(FILE *file,
+                          const char *name,
+                          const responsePoint *points,
+                          uint32_t count)
+{
+    uint32_t index = 0;
+
+    fprintf(file, "      \"%s\": [\n", name);
+
+    for (index = 0; index < count; index++)
+    {
+        fprintf(file, "        {\"frequency_hz\": %.0f, \"gain_db\": %.3f}%s\n",
+                points[index].frequency,
+                points[index].gainDb,
+                index + 1 < count ? "," : "");
+    }
+
+    fprintf(file, "      ]");
+}
+
+static int writeJson(const char *path,
+                     const kernelResults *results,
+                     uint32_t count)
+{
+    FILE *file = fopen(path, "w");
+    uint32_t index = 0;
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"pdm_rate_hz\": %u,\n", PDM_RATE_HZ);
+    fprintf(file, "  \"pcm_rate_hz\": %u,\n", PCM_RATE_HZ);
+    fprintf(file, "  \"tone_dbfs\": %.1f,\n", 20 * log10(TONE_AMPLITUDE));
+    fprintf(file, "  \"duration_s\": %.3f,\n", options.durationS);
+    fprintf(file, "  \"modulator_order\": %u,\n", options.modulator.order);
+    fprintf(file, "  \"kernels\": [\n");
+
+    for (index = 0; index < count; index++)
+    {
+        fprintf(file, "    {\n");
+        fprintf(file, "      \"name\": \"%s\",\n",
+                audioDspKernelName(results[index].kernel));
+        fprintf(file, "      \"snr_db\": %.2f,\n", results[index].snrDb);
+        fprintf(file, "      \"thd_n_db\": %.2f,\n", results[index].thdnDb);
+        fprintf(file, "      \"idle_noise_dbfs\": %.2f,\n",
+                results[index].idleNoiseDbfs);
+        fprintf(file, "      \"passband_ripple_db\": %.4f,\n",
+                results[index].passbandRippleDb);
+        fprintf(file, "      \"stopband_rejection_db\": %.2f,\n",
+                results[index].stopbandRejectionDb);
+        fprintf(file, "      \"group_delay_us\": %.2f,\n",
+                results[index].groupDelayUs);
+        fprintf(file, "      \"max_deviation\": %.4g,\n",
+                results[index].maxDeviation);
+        fprintf(file, "      \"ns_per_sample\": %.2f,\n",
+                results[index].nsPerSample);
+        fprintf(file, "      \"speedup\": %.3f,\n", results[index].speedup);
+        writeResponse(file, "passband", results[index].passband, PASSBAND_TONES);
+        fprintf(file, ",\n");
+        writeResponse(file, "stopband", results[index].stopband, STOPBAND_TONES);
+        fprintf(file, "\n    }%s\n", index + 1 < count ? "," : "");
+    }
+
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+static int writeCsv(const char *path,
+                    const kernelResults *results,
+                    uint32_t count)
+{
+    FILE *file = fopen(path, "w");
+    uint32_t index = 0;
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    fprintf(file, "kernel,snr_db,thd_n_db,idle_noise_dbfs,passband_ripple_db,"
+                  "stopband_rejection_db,group_delay_us,max_deviation,"
+                  "ns_per_sample,speedup\n");
+
+    for (index = 0; index < count; index++)
+    {
+        fprintf(file, "%s,%.2f,%.2f,%.2f,%.4f,%.2f,%.2f,%.4g,%.2f,%.3f\n",
+                audioDspKernelName(results[index].kernel),
+                results[index].snrDb,
+                results[index].thdnDb,
+                results[index].idleNoiseDbfs,
+                results[index].passbandRippleDb,
+                results[index].stopbandRejectionDb,
+                results[index].groupDelayUs,
+                results[index].maxDeviation,
+                results[index].nsPerSample,
+                results[index].speedup);
+    }
+
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+/******************************************************************************/
+/* Main                                                                       */
+/******************************************************************************/
+
+static void usage(const char *name)
+{
+    audioDspKernel kernel = 0;
+
+    printf("Usage: %s [options]\n"
+           "  -k <name>  Only benchmark this kernel, default all of:",
+           name);
+
+    for (kernel = 0; kernel < AUDIO_DSP_KERNEL_COUNT; kernel++)
+    {
+        printf(" %s", audioDspKernelName(kernel));
+    }
+
+    printf("\n"
+           "  -d <s>     Duration of each test signal, default 0.5\n"
+           "  -m <n>     Modulator order, 1 - %u, default 4\n"
+           "  -j <file>  Write the results as JSON\n"
+           "  -c <file>  Write the results as CSV\n"
+           "  -s <db>    Fail if any kernel's SNR is below this\n",
+           SIGMA_DELTA_MAX_ORDER);
+}
+
+int main(int argc, char **argv)
+{
+    static testSignal passband[PASSBAND_TONES];
+    static testSignal stopband[STOPBAND_TONES];
+    static kernelResults results[AUDIO_DSP_KERNEL_COUNT];
+    kernelResults cmsisResult;
+    testSignal reference;
+    testSignal idle;
+    float *pcm = NULL;
+    float *referencePcm = NULL;
+    audioDspKernel kernel = 0;
+    uint32_t count = 0;
+    uint32_t index = 0;
+    int rtn = 0;
+    int opt = 0;
+
+    options.durationS = 0.5f;
+    options.kernel = AUDIO_DSP_KERNEL_COUNT;
+    options.minSnrDb = -INFINITY;
+    options.modulator.order = 4;
+    options.modulator.outOfBandGain = 1.5f;
+    options.modulator.seed = 1;
+
+    while (-1 != (opt = getopt(argc, argv, "k:d:m:j:c:s:h")))
+    {
+        switch (opt)
+        {
+            case 'k':
+                for (kernel = 0; kernel < AUDIO_DSP_KERNEL_COUNT; kernel++)
+                {
+                    if (0 == strcmp(optarg, audioDspKernelName(kernel)))
+                    {
+                        break;
+                    }
+                }
+
+                if (kernel == AUDIO_DSP_KERNEL_COUNT)
+                {
+                    fprintf(stderr, "Unknown decimation kernel %s\n", optarg);
+                    return 2;
+                }
+
+                options.kernel = kernel;
+                break;
+            case 'd': options.durationS = atof(optarg); break;
+            case 'm': options.modulator.order = atoi(optarg); break;
+            case 'j': options.jsonPath = optarg; break;
+            case 'c': options.csvPath = optarg; break;
+            case 's': options.minSnrDb = atof(optarg); break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    options.blocks = options.durationS * 1000 / MP45DT02_RAW_SAMPLE_DURATION_MS;
+
+    if (options.blocks <= 2 * SETTLE_BLOCKS)
+    {
+        fprintf(stderr, "Duration too short\n");
+        return 2;
+    }
+
+    /**************************************************************************/
+    /* Generate the PDM once, the modulator is slower than any kernel         */
+    /**************************************************************************/
+    if (0 != generate(&reference, REFERENCE_HZ, TONE_AMPLITUDE) ||
+        0 != generate(&idle, 0, 0))
+    {
+        fprintf(stderr, "Failed to generate test signals\n");
+        return 2;
+    }
+
+    for (index = 0; index < PASSBAND_TONES; index++)
+    {
+        if (0 != generate(&passband[index], passbandHz[index], TONE_AMPLITUDE))
+        {
+            fprintf(stderr, "Failed to generate test signals\n");
+            return 2;
+        }
+    }
+
+    for (index = 0; index < STOPBAND_TONES; index++)
+    {
+        if (0 != generate(&stopband[index], stopbandHz[index], TONE_AMPLITUDE))
+        {
+            fprintf(stderr, "Failed to generate test signals\n");
+            return 2;
+        }
+    }
+
+    pcm = malloc(options.blocks * MP45DT02_DECIMATED_BUFFER_SIZE * sizeof(float));
+    referencePcm = malloc(options.blocks * MP45DT02_DECIMATED_BUFFER_SIZE *
+                          sizeof(float));
+
+    /* CMSIS is both the reference output and the speedup baseline, timed the
+     * same way as every other kernel */
+    (void)run(AUDIO_DSP_KERNEL_CMSIS_F32, &reference, referencePcm);
+
+    if (0 != benchmark(AUDIO_DSP_KERNEL_CMSIS_F32, referencePcm, &reference, &idle,
+                       passband, stopband, pcm, &cmsisResult))
+    {
+        fprintf(stderr, "Failed to analyse %s\n",
+                audioDspKernelName(AUDIO_DSP_KERNEL_CMSIS_F32));
+        return 2;
+    }
+
+    /**************************************************************************/
+    /* Run                                                                    */
+    /**************************************************************************/
+    for (kernel = 0; kernel < AUDIO_DSP_KERNEL_COUNT; kernel++)
+    {
+        if (options.kernel != AUDIO_DSP_KERNEL_COUNT && options.kernel != kernel)
+        {
+            continue;
+        }
+
+        if (kernel == AUDIO_DSP_KERNEL_CMSIS_F32)
+        {
+            results[count] = cmsisResult;
+        }
+        else if (0 != benchmark(kernel, referencePcm, &reference, &idle, passband,
+                                stopband, pcm, &results[count]))
+        {
+            fprintf(stderr, "Failed to analyse %s\n", audioDspKernelName(kernel));
+            return 2;
+        }
+
+        results[count].speedup = cmsisResult.nsPerSample / results[count].nsPerSample;
+
+        printResults(&results[count]);
+
+        if (results[count].snrDb < options.minSnrDb)
+        {
+            fprintf(stderr, "%s SNR %.1f dB below %.1f dB\n",
+                    audioDspKernelName(kernel),
+                    results[count].snrDb,
+                    options.minSnrDb);
+            rtn = 1;
+        }
+
+        count++;
+    }
+
+    if (options.jsonPath != NULL && 0 != writeJson(options.jsonPath, results, count))
+    {
+        fprintf(stderr, "Failed to write %s\n", options.jsonPath);
+        rtn = 2;
+    }
+
+    if (options.csvPath != NULL && 0 != writeCsv(options.csvPath, results, count))
+    {
+        fprintf(stderr, "Failed to write %s\n", options.csvPath);
+        rtn = 2;
+    }
+
+    free(pcm);
+    free(referencePcm);
+    free(reference.pdm);
+    free(idle.pdm);
+
+    for (index = 0; index < PASSBAND_TONES; index++)
+    {
+        free(passband[index].pdm);
+    }
+
+    for (index = 0; index < STOPBAND_TONES; index++)
+    {
+        free(stopband[index].pdm);
+    }
+
+    return rtn;
+}
@@ -0,0 +1,494 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* Measures the cost of the board's processing chain per block, for the block
+ * duration MP45DT02_RAW_SAMPLE_DURATION_MS it was built with. The chain is
+ * timed on its own, then run by a thread woken for every block as the I2S
+ * interrupt wakes the processing thread on the board. The difference is the
+ * cost of the wake up, which longer blocks pay less often. Built for each
+ * duration by "make block-benchmark". */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "audio_agc.h"
+#include "audio_dsp.h"
+#include "audio_eq.h"
+#include "audio_meter.h"
+#include "audio_packetizer.h"
+#include "rtp.h"
+#include "sigma_delta.h"
+
+#define PDM_RATE_HZ             (MP45DT02_RAW_FREQ_KHZ * 1000)
+#define PCM_RATE_HZ             AUDIO_PACKETIZER_SAMPLE_RATE_HZ
+
+#define TONE_HZ                 1000.0
+#define TONE_AMPLITUDE          0.5
+
+#define RTP_PAYLOAD_TYPE        96
+#define RTP_CN_PAYLOAD_TYPE     97
+#define RTP_AUDIO_LEVEL_ID      1
+
+/* Each way of running the chain is timed this many times, and the fastest
+ * taken as the least disturbed by the host */
+#define RUNS                    5
+
+#define NS_PER_S                1000000000.0
+
+typedef struct {
+    double blockMs;
+    double processNsPerBlock;
+    double wakeNsPerBlock;
+    /* Share of the CPU taken by the chain and waking it */
+    double loadPercent;
+    /* Share of that taken by waking the chain */
+    double wakePercent;
+} blockResults;
+
+static struct {
+    float durationS;
+    uint32_t blocks;
+    audioDspKernel kernel;
+    const char *csvPath;
+} options;
+
+/* As on the board, with its default configuration */
+static struct {
+    audioDsp dsp;
+    audioEq eq;
+    audioMeter meter;
+    audioAgc agc;
+    audioPacketizer packetizer;
+    /* An Ethernet frame's worth, more than any packet needs */
+    uint8_t packet[1500];
+    float pcm[MP45DT02_DECIMATED_BUFFER_SIZE];
+} chain;
+
+/* Stands in for the I2S interrupt and the processing thread */
+static struct {
+    pthread_t thread;
+    sem_t ready;
+    sem_t done;
+    const uint16_t *pdm;
+    bool stop;
+} waker;
+
+/******************************************************************************/
+/* Chain                                                                      */
+/******************************************************************************/
+
+static StatusCode rtpGetRandomCb(uint32_t *random)
+{
+    *random = (uint32_t)rand() << 16 ^ (uint32_t)rand();
+    return STATUS_OK;
+}
+
+static uint8_t *getBufferCb(void *arg, uint32_t length, void **handle)
+{
+    (void)arg;
+    *handle = chain.packet;
+    return length <= sizeof(chain.packet) ? chain.packet : NULL;
+}
+
+static bool sendCb(void *arg, void *handle, uint8_t *data, uint32_t length)
+{
+    (void)arg;
+    (void)handle;
+    (void)data;
+    (void)length;
+    return true;
+}
+
+static void releaseCb(void *arg, void *handle)
+{
+    (void)arg;
+    (void)handle;
+}
+
+static int chainInit(void)
+{
+    audioPacketizerConfig packetizerConfig;
+    audioAgcConfig agcConfig;
+    audioEqBand band;
+    rtpConfig rtp;
+
+    memset(&rtp, 0, sizeof(rtp));
+    rtp.getRandomCb = rtpGetRandomCb;
+    rtp.payloadType = RTP_PAYLOAD_TYPE;
+    rtp.clockRate = PCM_RATE_HZ;
+    rtp.periodicTimestampIncr = AUDIO_PACKETIZER_PAYLOAD_SAMPLES;
+    rtp.extensions[0].id = RTP_AUDIO_LEVEL_ID;
+    rtp.extensions[0].length = RTP_AUDIO_LEVEL_LENGTH;
+
+    memset(&packetizerConfig, 0, sizeof(packetizerConfig));
+    packetizerConfig.getBufferCb        = getBufferCb;
+    packetizerConfig.sendCb             = sendCb;
+    packetizerConfig.releaseCb          = releaseCb;
+    packetizerConfig.payloadType        = RTP_PAYLOAD_TYPE;
+    packetizerConfig.channels           = 1;
+    packetizerConfig.vadEnabled         = true;
+    packetizerConfig.vad.energyRatio    = 4.0f;
+    packetizerConfig.vad.lowEnergyRatio = 2.0f;
+    packetizerConfig.vad.zcrThreshold   = 0.25f;
+    packetizerConfig.vad.minEnergy      = 4.0f;
+    packetizerConfig.vad.hangoverFrames = 15;
+    packetizerConfig.cnPayloadType      = RTP_CN_PAYLOAD_TYPE;
+    packetizerConfig.cnIntervalPayloads = 25;
+    packetizerConfig.audioLevelId       = RTP_AUDIO_LEVEL_ID;
+
+    memset(&agcConfig, 0, sizeof(agcConfig));
+    agcConfig.sampleRate = PCM_RATE_HZ;
+    agcConfig.blockSamples = MP45DT02_DECIMATED_BUFFER_SIZE;
+    agcConfig.targetDbfs = -20;
+    agcConfig.minGainDb = -10;
+    agcConfig.maxGainDb = 30;
+    agcConfig.gateDbfs = -60;
+    agcConfig.attackMs = 20;
+    agcConfig.releaseMs = 300;
+    agcConfig.limiterDbfs = -1;
+    agcConfig.lookaheadSamples = PCM_RATE_HZ / 1000;
+    agcConfig.limiterReleaseMs = 50;
+
+    memset(&band, 0, sizeof(band));
+    band.type = AUDIO_EQ_HIGHPASS;
+    band.frequency = 20;
+    band.q = 0.707f;
+
+    if (STATUS_OK != rtpInit(&rtp) ||
+        STATUS_OK != audioDspInit(&chain.dsp, options.kernel) ||
+        STATUS_OK != audioAgcInit(&chain.agc, &agcConfig))
+    {
+        return -1;
+    }
+
+    audioEqInit(&chain.eq, PCM_RATE_HZ);
+
+    if (STATUS_OK != audioEqSetBand(&chain.eq, 0, &band))
+    {
+        return -1;
+    }
+
+    audioMeterInit(&chain.meter, PCM_RATE_HZ, MP45DT02_DECIMATED_BUFFER_SIZE);
+    audioPacketizerInit(&chain.packetizer, &packetizerConfig);
+
+    return 0;
+}
+
+/* What the processing thread does with each block */
+static void chainProcess(const uint16_t *pdm)
+{
+    audioDspProcess(&chain.dsp, pdm, chain.pcm);
+    audioEqProcess(&chain.eq, chain.pcm, MP45DT02_DECIMATED_BUFFER_SIZE);
+    audioMeterProcess(&chain.meter, chain.pcm, MP45DT02_DECIMATED_BUFFER_SIZE);
+    audioAgcProcess(&chain.agc, chain.pcm, MP45DT02_DECIMATED_BUFFER_SIZE);
+    audioPacketizerProcess(&chain.packetizer,
+                           chain.pcm,
+                           MP45DT02_DECIMATED_BUFFER_SIZE);
+}
+
+/******************************************************************************/
+/* Measurement                                                                */
+/******************************************************************************/
+
+static double elapsedS(const struct timespec *start, const struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) +
+           (end->tv_nsec - start->tv_nsec) / NS_PER_S;
+}
+
+static uint16_t *generate(void)
+{
+    static float samples[MP45DT02_I2S_SAMPLE_SIZE_BITS];
+    sigmaDeltaConfig config;
+    sigmaDelta modulator;
+    uint16_t *pdm = NULL;
+    uint64_t n = 0;
+    uint32_t block = 0;
+    uint32_t index = 0;
+
+    memset(&config, 0, sizeof(config));
+    config.order = 4;
+    config.outOfBandGain = 1.5f;
+    config.seed = 1;
+
+    pdm = malloc(options.blocks * MP45DT02_I2S_SAMPLE_SIZE_2B * sizeof(uint16_t));
+
+    if (pdm == NULL || 0 != sigmaDeltaInit(&modulator, &config))
+    {
+        return NULL;
+    }
+
+    for (block = 0; block < options.blocks; block++)
+    {
+        for (index = 0; index < MP45DT02_I2S_SAMPLE_SIZE_BITS; index++, n++)
+        {
+            samples[index] = TONE_AMPLITUDE *
+                             sin(2 * M_PI * TONE_HZ * (double)n / PDM_RATE_HZ);
+        }
+
+        sigmaDeltaProcess(&modulator,
+                          samples,
+                          MP45DT02_I2S_SAMPLE_SIZE_BITS,
+                          pdm + block * MP45DT02_I2S_SAMPLE_SIZE_2B);
+    }
+
+    return pdm;
+}
+
+/* Every block processed straight after the last */
+static double runInline(const uint16_t *pdm)
+{
+    struct timespec start;
+    struct timespec end;
+    uint32_t block = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (block = 0; block < options.blocks; block++)
+    {
+        chainProcess(pdm + block * MP45DT02_I2S_SAMPLE_SIZE_2B);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return elapsedS(&start, &end);
+}
+
+static void *wakerThread(void *arg)
+{
+    (void)arg;
+
+    while (true)
+    {
+        sem_wait(&waker.ready);
+
+        if (waker.stop)
+        {
+            break;
+        }
+
+        chainProcess(waker.pdm);
+        sem_post(&waker.done);
+    }
+
+    return NULL;
+}
+
+/* Every block handed to the thread, which is woken for it, and waited for */
+static double runWoken(const uint16_t *pdm)
+{
+    struct timespec start;
+    struct timespec end;
+    uint32_t block = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (block = 0; block < options.blocks; block++)
+    {
+        waker.pdm = pdm + block * MP45DT02_I2S_SAMPLE_SIZE_2B;
+        sem_post(&waker.ready);
+        sem_wait(&waker.done);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return elapsedS(&start, &end);
+}
+
+static int benchmark(const uint16_t *pdm, blockResults *results)
+{
+    double inlineS = INFINITY;
+    double wokenS = INFINITY;
+    uint32_t run = 0;
+
+    if (0 != sem_init(&waker.ready, 0, 0) ||
+        0 != sem_init(&waker.done, 0, 0) ||
+        0 != pthread_create(&waker.thread, NULL, wakerThread, NULL))
+    {
+        return -1;
+    }
+
+    /* Alternated, so both see the host in the same state */
+    for (run = 0; run < RUNS; run++)
+    {
+        inlineS = fmin(inlineS, runInline(pdm));
+        wokenS = fmin(wokenS, runWoken(pdm));
+    }
+
+    waker.stop = true;
+    sem_post(&waker.ready);
+    pthread_join(waker.thread, NULL);
+
+    memset(results, 0, sizeof(*results));
+    results->blockMs = MP45DT02_RAW_SAMPLE_DURATION_MS;
+    results->processNsPerBlock = inlineS * NS_PER_S / options.blocks;
+    results->wakeNsPerBlock = fmax(0, wokenS - inlineS) * NS_PER_S /
+                              options.blocks;
+    results->loadPercent = 100 * fmax(inlineS, wokenS) / options.durationS;
+    results->wakePercent = 100 * results->wakeNsPerBlock /
+                           (results->processNsPerBlock +
+                            results->wakeNsPerBlock);
+
+    return 0;
+}
+
+/******************************************************************************/
+/* Output                                                                     */
+/******************************************************************************/
+
+static void printResults(const blockResults *results)
+{
+    printf("kernel %s\n", audioDspKernelName(options.kernel));
+    printf("block_ms %.0f\n", results->blockMs);
+    printf("blocks_per_s %.0f\n", 1000 / results->blockMs);
+    printf("process_ns_per_block %.0f\n", results->processNsPerBlock);
+    printf("wake_ns_per_block %.0f\n", results->wakeNsPerBlock);
+    printf("load_percent %.3f\n", results->loadPercent);
+    printf("wake_percent %.1f\n", results->wakePercent);
+}
+
+/* Appends a row, so one file collects every block duration */
+static int writeCsv(const char *path, const blockResults *results)
+{
+    FILE *file = fopen(path, "a");
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if (ftell(file) == 0)
+    {
+        fprintf(file, "kernel,block_ms,process_ns_per_block,wake_ns_per_block,"
+                      "load_percent,wake_percent\n");
+    }
+
+    fprintf(file, "%s,%.0f,%.0f,%.0f,%.4f,%.2f\n",
+            audioDspKernelName(options.kernel),
+            results->blockMs,
+            results->processNsPerBlock,
+            results->wakeNsPerBlock,
+            results->loadPercent,
+            results->wakePercent);
+
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+/******************************************************************************/
+/* Main                                                                       */
+/******************************************************************************/
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [options]\n"
+           "  -k <name>  Decimation kernel, default %s\n"
+           "  -d <s>     Duration of audio processed, default 2\n"
+           "  -c <file>  Append the results to a CSV file\n",
+           name,
+           audioDspKernelName(AUDIO_DSP_KERNEL_POLYPHASE_LUT));
+}
+
+int main(int argc, char **argv)
+{
+    blockResults results;
+    audioDspKernel kernel = 0;
+    uint16_t *pdm = NULL;
+    int opt = 0;
+
+    options.durationS = 2;
+    options.kernel = AUDIO_DSP_KERNEL_POLYPHASE_LUT;
+
+    while (-1 != (opt = getopt(argc, argv, "k:d:c:h")))
+    {
+        switch (opt)
+        {
+            case 'k':
+                for (kernel = 0; kernel < AUDIO_DSP_KERNEL_COUNT; kernel++)
+                {
+                    if (0 == strcmp(optarg, audioDspKernelName(kernel)))
+                    {
+                        break;
+                    }
+                }
+
+                if (kernel == AUDIO_DSP_KERNEL_COUNT)
+                {
+                    fprintf(stderr, "Unknown decimation kernel %s\n", optarg);
+                    return 2;
+                }
+
+                options.kernel = kernel;
+                break;
+            case 'd': options.durationS = atof(optarg); break;
+            case 'c': options.csvPath = optarg; break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    options.blocks = options.durationS * 1000 / MP45DT02_RAW_SAMPLE_DURATION_MS;
+
+    if (options.blocks == 0)
+    {
+        fprintf(stderr, "Duration too short\n");
+        return 2;
+    }
+
+    if (NULL == (pdm = generate()))
+    {
+        fprintf(stderr, "Failed to generate test signal\n");
+        return 2;
+    }
+
+    if (0 != chainInit())
+    {
+        fprintf(stderr, "Initialisation failed\n");
+        return 2;
+    }
+
+    if (0 != benchmark(pdm, &results))
+    {
+        fprintf(stderr, "Failed to start the processing thread\n");
+        return 2;
+    }
+
+    printResults(&results);
+
+    if (options.csvPath != NULL && 0 != writeCsv(options.csvPath, &results))
+    {
+        fprintf(stderr, "Failed to write %s\n", options.csvPath);
+        return 2;
+    }
+
+    free(pdm);
+
+    return 0;
+}
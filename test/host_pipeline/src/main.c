@@ -0,0 +1,1705 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* Runs the stm32_streaming audio pipeline on the host: a simulated MP45DT02
+ * feeds PDM words through the same DSP and packetization code as the board,
+ * and the resulting RTP packets are checked and decoded back to a WAV. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "audio_agc.h"
+#include "audio_beam.h"
+#include "audio_dsp.h"
+#include "audio_eq.h"
+#include "audio_features.h"
+#include "audio_slm.h"
+#include "audio_trigger.h"
+#include "audio_meter.h"
+#include "audio_ns.h"
+#include "audio_packetizer.h"
+#include "analysis.h"
+#include "sigma_delta.h"
+#include "rtp.h"
+#include "wav.h"
+
+#define PDM_RATE_HZ             (MP45DT02_RAW_FREQ_KHZ * 1000)
+#define PCM_RATE_HZ             AUDIO_PACKETIZER_SAMPLE_RATE_HZ
+
+#define RTP_PAYLOAD_TYPE        96
+#define RTP_CN_PAYLOAD_TYPE     97
+/* RFC 8285 header extension elements, as on the board */
+#define RTP_AUDIO_LEVEL_ID      1
+#define RTP_CAPTURE_TIME_ID     2
+#define RTP_DSP_OVERRUNS_ID     3
+/* Past the one-byte form, to test the two-byte one */
+#define RTP_DSP_OVERRUNS_ID_TWO_BYTE    255
+#define RTP_EXTENSION_IDS       256
+
+/* Filter settling time excluded from the SNR measurement */
+#define SNR_SKIP_MS             100
+#define SNR_SKIP_FRAMES         (SNR_SKIP_MS * PCM_RATE_HZ / 1000)
+
+#define NS_PER_S                1000000000.0
+
+/* Microphones simulated, two on one data line or an array */
+#define MAX_CHANNELS            AUDIO_BEAM_MAX_CHANNELS
+
+/* Features as the board's defaults */
+#define FEATURES_INTERVAL_MS    128
+#define FEATURES_MEL_BANDS      24
+#define FEATURES_LOW_HZ         100
+#define FEATURES_HIGH_HZ        6300
+
+/* Sound level meter, as the board but uncalibrated so levels are relative to
+ * full scale */
+#define SLM_PERIOD_MS           1000
+
+/* Most the meter's frequency weighting may differ from IEC 61672's, and a
+ * sine's peak from 3 dB above its Leq */
+#define SLM_TOLERANCE_DB        0.5
+
+/* Trigger pre-roll and hangover, as the board's defaults */
+#define TRIGGER_PREROLL_MS      2000
+#define TRIGGER_HANGOVER_MS     2000
+#define TRIGGER_STORAGE_LENGTH  (TRIGGER_PREROLL_MS /                         \
+                                 AUDIO_PACKETIZER_PAYLOAD_DURATION_MS *       \
+                                 AUDIO_TRIGGER_SLOT_LENGTH(                   \
+                                    AUDIO_PACKETIZER_PAYLOAD_SAMPLES,         \
+                                    AUDIO_TRIGGER_MAX_CHANNELS, false))
+
+/* Margin between the tone's level and the trigger's for the outcome to be
+ * checked */
+#define TRIGGER_MARGIN_DB       6
+
+/* Noise is held for each PCM sample, so it is all in band */
+#define NOISE_HOLD_SAMPLES      (PDM_RATE_HZ / PCM_RATE_HZ)
+
+static struct {
+    float toneHz;
+    float amplitude;
+    const char *inputPath;
+    const char *outputPath;
+    float durationS;
+    bool vad;
+    /* Fail if the tone SNR is below this, dB */
+    float minSnrDb;
+    /* Write the PDM words to this file */
+    const char *pdmPath;
+    sigmaDeltaConfig modulator;
+    audioDspKernel kernel;
+    /* Band 0 of the EQ, 0 for off */
+    float dcBlockerHz;
+    /* The remaining bands, as audioEqParseBand() takes them */
+    char *eqBands[AUDIO_EQ_MAX_BANDS - 1];
+    uint32_t eqBandCount;
+    /* AGC target level, dBFS. NAN leaves just the limiter. */
+    float agcTargetDbfs;
+    uint8_t dspOverrunsId;
+    /* Tone of a second microphone on the same data line, 0 for none */
+    float secondToneHz;
+    /* Microphones in a line for the beamformer, 0 for none */
+    uint32_t arrayMics;
+    float arraySpacingMm;
+    /* The source's direction and the beamformer's, from broadside towards
+     * the last microphone */
+    float arrivalDegrees;
+    float steerDegrees;
+    /* Uncorrelated noise at each microphone, RMS relative to full scale */
+    float noiseRms;
+    /* Seconds of noise alone before the source starts */
+    float onsetS;
+    /* Most the noise suppression attenuates by, NAN for none */
+    float nsAttenuationDb;
+    /* Fail if the gain in SNR over the first microphone alone, without noise
+     * suppression, is outside these, dB */
+    float minSnrGainDb;
+    float maxSnrGainDb;
+    /* Band energies computed from the stream, as with CONFIG_AUDIO_FEATURES,
+     * -1 for none */
+    int32_t featuresScale;
+    /* Run the sound level meter on the first channel, as CONFIG_AUDIO_SLM */
+    bool slm;
+    /* Send only around events, as CONFIG_AUDIO_TRIGGER, firing on this level
+     * or the VAD. The pre-roll is held as ADPCM unless uncompressed. */
+    bool trigger;
+    audioTriggerSettings triggerSettings;
+    bool triggerUncompressed;
+    /* Simulated, and streamed */
+    uint32_t mics;
+    uint32_t channels;
+} options;
+
+/* Each microphone's own noise */
+static struct {
+    uint32_t random;
+    float sample;
+} noise[MAX_CHANNELS];
+
+/* Decoded stream and the checks made on it */
+static struct {
+    /* Interleaved frames of options.channels */
+    int16_t *pcm;
+    uint32_t capacity;
+    uint32_t samples;
+
+    bool started;
+    uint16_t sequenceNumber;
+    uint32_t firstTimestamp;
+    /* Of the first packet, in samples */
+    uint64_t firstCaptureTime;
+    uint32_t lastTimestamp;
+
+    uint32_t audioPackets;
+    uint32_t cnPackets;
+    uint32_t errors;
+    /* Audio packets whose RFC 6464 level doesn't match their payload */
+    uint32_t levelErrors;
+    /* Packets whose other header extension elements are wrong */
+    uint32_t extensionErrors;
+} sink;
+
+/* Frames of features decoded, as a receiver would, and checked */
+static struct {
+    uint32_t frames;
+    uint32_t length;
+    uint32_t bands;
+    /* Frames whose loudest band doesn't hold the tone */
+    uint32_t errors;
+    /* Of the latest frame */
+    float peakHz;
+    float peakDbfs;
+} featureSink;
+
+/* Block being processed, for the capture time */
+static uint32_t currentBlock;
+
+static audioTrigger trigger;
+static uint8_t triggerStorage[TRIGGER_STORAGE_LENGTH];
+
+static wavAudio input;
+
+/******************************************************************************/
+/* Signal Source                                                              */
+/******************************************************************************/
+
+static float noiseGaussian(uint32_t channel)
+{
+    float u[2];
+    uint32_t index = 0;
+
+    for (index = 0; index < 2; index++)
+    {
+        /* xorshift32 */
+        noise[channel].random ^= noise[channel].random << 13;
+        noise[channel].random ^= noise[channel].random >> 17;
+        noise[channel].random ^= noise[channel].random << 5;
+        u[index] = (noise[channel].random + 1.0f) / 4294967296.0f;
+    }
+
+    return sqrtf(-2 * logf(u[0])) * cosf(2 * (float)M_PI * u[1]);
+}
+
+/* Seconds sound from the source reaches the array microphone before it
+ * reaches the first */
+static double arrayLeadS(uint32_t channel)
+{
+    return channel * options.arraySpacingMm / 1000 *
+           sin(options.arrivalDegrees * M_PI / 180) /
+           AUDIO_BEAM_SPEED_OF_SOUND;
+}
+
+/* The source at time seconds */
+static float sourceAt(double time)
+{
+    double position = 0;
+    uint32_t index = 0;
+    float fraction = 0;
+
+    time -= options.onsetS;
+
+    if (time < 0)
+    {
+        return 0;
+    }
+
+    if (options.inputPath == NULL)
+    {
+        return options.amplitude * sin(2 * M_PI * options.toneHz * time);
+    }
+
+    /* Linear interpolation is plenty given the anti aliasing filter follows */
+    position = time * input.sampleRate;
+    index = (uint32_t)position;
+    fraction = position - index;
+
+    if (position < 0 || index + 1 >= input.samples)
+    {
+        return 0;
+    }
+
+    return options.amplitude *
+           (input.data[index] * (1 - fraction) +
+            input.data[index + 1] * fraction) / 32768.0f;
+}
+
+/* Sample n at the PDM rate, of the given microphone, with noise of its own.
+ * The second on a data line only ever hears a tone. Each microphone of an
+ * array hears the source as a plane wave. */
+static float sourceSample(uint32_t channel, uint64_t n)
+{
+    double time = (double)n / PDM_RATE_HZ;
+
+    if (n % NOISE_HOLD_SAMPLES == 0)
+    {
+        noise[channel].sample = options.noiseRms * noiseGaussian(channel);
+    }
+
+    if (options.arrayMics != 0)
+    {
+        return sourceAt(time + arrayLeadS(channel)) + noise[channel].sample;
+    }
+
+    if (channel == 1)
+    {
+        return options.amplitude *
+               sin(2 * M_PI * options.secondToneHz * time) +
+               noise[channel].sample;
+    }
+
+    return sourceAt(time) + noise[channel].sample;
+}
+
+/* Two microphones on one line, as read with the I2S clock at twice theirs:
+ * one bit from each in turn, first then second, MSB first. Bit by bit, to
+ * check the deinterleaving on the board against. */
+static void interleavePdm(const uint16_t *first,
+                          const uint16_t *second,
+                          uint32_t words,
+                          uint16_t *interleaved)
+{
+    uint32_t bit = 0;
+    uint32_t in = 0;
+    uint32_t out = 0;
+
+    memset(interleaved, 0, 2 * words * sizeof(uint16_t));
+
+    for (bit = 0; bit < words * 16; bit++)
+    {
+        in = (first[bit / 16] >> (15 - bit % 16)) & 1;
+        out = 2 * bit;
+        interleaved[out / 16] |= in << (15 - out % 16);
+
+        in = (second[bit / 16] >> (15 - bit % 16)) & 1;
+        out = 2 * bit + 1;
+        interleaved[out / 16] |= in << (15 - out % 16);
+    }
+}
+
+/******************************************************************************/
+/* Packetizer Callbacks                                                       */
+/******************************************************************************/
+
+static StatusCode rtpGetRandomCb(uint32_t *random)
+{
+    *random = (uint32_t)rand() << 16 ^ (uint32_t)rand();
+    return STATUS_OK;
+}
+
+static uint8_t *getBufferCb(void *arg, uint32_t length, void **handle)
+{
+    (void)arg;
+    *handle = malloc(length);
+    return *handle;
+}
+
+static void releaseCb(void *arg, void *handle)
+{
+    (void)arg;
+    free(handle);
+}
+
+/* (audioPacketizerExtensionCb) The payload started a payload's duration
+ * before the end of the current block, and any held back by the trigger */
+static void extensionCb(void *arg, uint8_t *data)
+{
+    uint64_t captured = (currentBlock + 1) * MP45DT02_DECIMATED_BUFFER_SIZE -
+                        AUDIO_PACKETIZER_PAYLOAD_SAMPLES;
+
+    (void)arg;
+
+    if (options.trigger)
+    {
+        captured -= audioTriggerGetDelaySamples(&trigger);
+    }
+
+    rtpSetAbsCaptureTime(data,
+                         RTP_CAPTURE_TIME_ID,
+                         (captured << 32) / PCM_RATE_HZ);
+    rtpSetDspOverruns(data, options.dspOverrunsId, 0);
+}
+
+/* (audioTriggerOutputCb) */
+static void triggerOutputCb(void *arg,
+                            const float *samples,
+                            uint32_t count,
+                            bool start)
+{
+    audioPacketizer *packetizer = arg;
+
+    if (start)
+    {
+        audioPacketizerStartTalkspurt(packetizer);
+    }
+
+    audioPacketizerProcess(packetizer, samples, count);
+}
+
+/* (audioTriggerDropCb) */
+static void triggerDropCb(void *arg)
+{
+    (void)arg;
+
+    rtpSkip();
+}
+
+/* Parses the RFC 8285 header extension independently of rtp.c. Fills in the
+ * data and length of each element by ID. Returns the length of the header,
+ * 0 if it is malformed. */
+static uint32_t sinkParseHeader(const uint8_t *data,
+                                uint32_t length,
+                                const uint8_t **elements,
+                                uint8_t *lengths)
+{
+    uint32_t headerLength = RTP_HEADER_LENGTH + 4 * (data[0] & 0x0F);
+    uint32_t profile = 0;
+    uint32_t position = 0;
+    uint32_t end = 0;
+    uint8_t id = 0;
+    uint8_t size = 0;
+
+    memset(elements, 0, RTP_EXTENSION_IDS * sizeof(*elements));
+
+    if (length < headerLength || !(data[0] & 0x10))
+    {
+        return length < headerLength ? 0 : headerLength;
+    }
+
+    if (length < headerLength + 4)
+    {
+        return 0;
+    }
+
+    profile = data[headerLength] << 8 | data[headerLength + 1];
+    position = headerLength + 4;
+    end = position + 4 * (data[headerLength + 2] << 8 | data[headerLength + 3]);
+
+    if (end > length || (profile != 0xBEDE && (profile & 0xFFF0) != 0x1000))
+    {
+        return 0;
+    }
+
+    while (position < end)
+    {
+        if (profile == 0xBEDE)
+        {
+            id = data[position] >> 4;
+            size = (data[position] & 0x0F) + 1;
+
+            /* Padding, or the reserved ID which ends the elements */
+            if (data[position] == 0)
+            {
+                position++;
+                continue;
+            }
+            else if (id == 15)
+            {
+                break;
+            }
+
+            position++;
+        }
+        else
+        {
+            id = data[position];
+
+            if (id == 0)
+            {
+                position++;
+                continue;
+            }
+
+            if (position + 2 > end)
+            {
+                return 0;
+            }
+
+            size = data[position + 1];
+            position += 2;
+        }
+
+        if (position + size > end)
+        {
+            return 0;
+        }
+
+        elements[id] = &data[position];
+        lengths[id] = size;
+        position += size;
+    }
+
+    return end;
+}
+
+/* Level of the decoded payload in -dBov, as RFC 6464 */
+static double sinkPayloadLevel(const int16_t *pcm, uint32_t samples)
+{
+    double energy = 0;
+    uint32_t index = 0;
+
+    for (index = 0; index < samples; index++)
+    {
+        energy += (double)pcm[index] * pcm[index];
+    }
+
+    if (energy == 0)
+    {
+        return 127;
+    }
+
+    return fmin(127, -10 * log10(energy / samples / (32768.0 * 32768.0)));
+}
+
+/* Decodes a frame of features as a receiver would, from its header alone,
+ * and checks the tone is in the loudest band. Frames before the source has
+ * started and the filters settled aren't checked. */
+static void featuresReceive(const uint8_t *data, uint32_t length)
+{
+    uint32_t bands = data[1];
+    uint32_t intervalMs = data[2] << 8 | data[3];
+    float lowHz = data[4] << 8 | data[5];
+    float highHz = data[6] << 8 | data[7];
+    float lowerHz = 0;
+    float upperHz = 0;
+    float lowMel = 0;
+    float highMel = 0;
+    uint32_t loudest = 0;
+    uint32_t band = 0;
+    int32_t first = 0;
+
+    featureSink.length = length;
+    featureSink.bands = bands;
+
+    if (length != AUDIO_FEATURES_HEADER_LENGTH + bands || bands == 0)
+    {
+        featureSink.errors++;
+        return;
+    }
+
+    for (band = 1; band < bands; band++)
+    {
+        if (data[AUDIO_FEATURES_HEADER_LENGTH + band] <
+            data[AUDIO_FEATURES_HEADER_LENGTH + loudest])
+        {
+            loudest = band;
+        }
+    }
+
+    if (data[0] == AUDIO_FEATURES_SCALE_MEL)
+    {
+        lowMel = 2595 * log10f(1 + lowHz / 700);
+        highMel = 2595 * log10f(1 + highHz / 700);
+        lowerHz = 700 * (powf(10, (lowMel + (highMel - lowMel) * loudest /
+                                            bands) / 2595) - 1);
+        upperHz = 700 * (powf(10, (lowMel + (highMel - lowMel) *
+                                            (loudest + 1) / bands) / 2595) - 1);
+    }
+    else
+    {
+        first = (int32_t)ceilf(3 * log2f(lowHz / 1000) - 0.05f);
+        lowerHz = 1000 * powf(2, (first + (int32_t)loudest - 0.5f) / 3);
+        upperHz = 1000 * powf(2, (first + (int32_t)loudest + 0.5f) / 3);
+    }
+
+    featureSink.peakHz = sqrtf(lowerHz * upperHz);
+    featureSink.peakDbfs = -data[AUDIO_FEATURES_HEADER_LENGTH + loudest] *
+                           AUDIO_FEATURES_STEP_DB;
+
+    if (options.inputPath == NULL &&
+        featureSink.frames * intervalMs > SNR_SKIP_MS + options.onsetS * 1000 &&
+        (options.toneHz < lowerHz || options.toneHz > upperHz))
+    {
+        featureSink.errors++;
+    }
+
+    featureSink.frames++;
+}
+
+/* Plays the part of the receiver */
+static bool sendCb(void *arg, void *handle, uint8_t *data, uint32_t length)
+{
+    uint16_t sequenceNumber = data[2] << 8 | data[3];
+    uint32_t timestamp = (uint32_t)data[4] << 24 | data[5] << 16 |
+                         data[6] << 8 | data[7];
+    uint8_t payloadType = data[1] & 0x7F;
+    const uint8_t *elements[RTP_EXTENSION_IDS];
+    uint8_t lengths[RTP_EXTENSION_IDS];
+    uint32_t headerLength = sinkParseHeader(data, length, elements, lengths);
+    uint64_t captureTime = 0;
+    uint32_t position = 0;
+    uint32_t index = 0;
+
+    (void)arg;
+
+    if (data[0] >> 6 != 2 || headerLength == 0 ||
+        elements[RTP_AUDIO_LEVEL_ID] == NULL ||
+        lengths[RTP_AUDIO_LEVEL_ID] != RTP_AUDIO_LEVEL_LENGTH)
+    {
+        sink.errors++;
+        free(handle);
+        return true;
+    }
+
+    if (!sink.started)
+    {
+        sink.started = true;
+        sink.firstTimestamp = timestamp - AUDIO_PACKETIZER_PAYLOAD_SAMPLES;
+    }
+    else if (sequenceNumber != (uint16_t)(sink.sequenceNumber + 1) ||
+             (timestamp - sink.lastTimestamp) %
+                AUDIO_PACKETIZER_PAYLOAD_SAMPLES != 0)
+    {
+        sink.errors++;
+    }
+
+    sink.sequenceNumber = sequenceNumber;
+    sink.lastTimestamp = timestamp;
+
+    /* The timestamp is that of the end of the payload */
+    position = timestamp - sink.firstTimestamp - AUDIO_PACKETIZER_PAYLOAD_SAMPLES;
+
+    /* Capture time of the first sample should advance with its position */
+    if (elements[RTP_CAPTURE_TIME_ID] == NULL ||
+        lengths[RTP_CAPTURE_TIME_ID] != RTP_ABS_CAPTURE_TIME_LENGTH ||
+        elements[options.dspOverrunsId] == NULL ||
+        lengths[options.dspOverrunsId] != RTP_DSP_OVERRUNS_LENGTH ||
+        elements[options.dspOverrunsId][0] != 0 ||
+        elements[options.dspOverrunsId][1] != 0)
+    {
+        sink.extensionErrors++;
+    }
+    else
+    {
+        for (index = 0; index < RTP_ABS_CAPTURE_TIME_LENGTH; index++)
+        {
+            captureTime = captureTime << 8 | elements[RTP_CAPTURE_TIME_ID][index];
+        }
+
+        /* In samples */
+        captureTime = (captureTime * PCM_RATE_HZ + (1ULL << 31)) >> 32;
+
+        if (position == 0)
+        {
+            sink.firstCaptureTime = captureTime;
+        }
+
+        if (llabs((int64_t)(captureTime - sink.firstCaptureTime) -
+                  (int64_t)position) > 1)
+        {
+            sink.extensionErrors++;
+        }
+    }
+
+    if (payloadType == RTP_CN_PAYLOAD_TYPE)
+    {
+        sink.cnPackets++;
+    }
+    else if (payloadType == RTP_PAYLOAD_TYPE &&
+             length == headerLength + AUDIO_PACKETIZER_PAYLOAD_SAMPLES *
+                                      options.channels * sizeof(int16_t))
+    {
+        sink.audioPackets++;
+
+        /* Now in samples of all channels */
+        position *= options.channels;
+
+        for (index = 0;
+             index < AUDIO_PACKETIZER_PAYLOAD_SAMPLES * options.channels &&
+                position + index < sink.capacity;
+             index++)
+        {
+            sink.pcm[position + index] =
+                (int16_t)(data[headerLength + index * 2] << 8 |
+                          data[headerLength + index * 2 + 1]);
+        }
+
+        if (index == AUDIO_PACKETIZER_PAYLOAD_SAMPLES * options.channels &&
+            fabs((elements[RTP_AUDIO_LEVEL_ID][0] & 0x7F) -
+                 sinkPayloadLevel(sink.pcm + position, index)) > 1)
+        {
+            sink.levelErrors++;
+        }
+
+        if (position + index > sink.samples)
+        {
+            sink.samples = position + index;
+        }
+    }
+    else
+    {
+        sink.errors++;
+    }
+
+    free(handle);
+
+    return true;
+}
+
+/******************************************************************************/
+/* Analysis                                                                   */
+/******************************************************************************/
+
+/* Everything other than the tone at the known frequency, including its
+ * harmonics and anything leaking from the other channel, counts as noise.
+ * samples of the channel, from interleaved frames. */
+static double toneSnrDb(const int16_t *pcm,
+                        uint32_t samples,
+                        uint32_t channel,
+                        float toneHz)
+{
+    toneAnalysis tone;
+    float *converted = malloc(samples * sizeof(float));
+    uint32_t n = 0;
+
+    for (n = 0; n < samples; n++)
+    {
+        converted[n] = pcm[n * options.channels + channel];
+    }
+
+    if (0 != analyseTone(converted, samples, toneHz / PCM_RATE_HZ, 1, &tone))
+    {
+        free(converted);
+        return -INFINITY;
+    }
+
+    free(converted);
+
+    return analysisDb(tone.signalPower / tone.noisePower);
+}
+
+static double rmsDbfs(const int16_t *pcm, uint32_t samples)
+{
+    double energy = 0;
+    uint32_t n = 0;
+
+    for (n = 0; n < samples; n++)
+    {
+        energy += (double)pcm[n] * pcm[n];
+    }
+
+    return analysisDb(energy / samples / (32768.0 * 32768.0));
+}
+
+/* A or C frequency weighting from the IEC 61672 pole frequencies, 0 dB at
+ * 1 kHz */
+static double weightingDb(double frequency, bool aWeighting)
+{
+    const double poles[] = {20.598997, 107.65265, 737.86223, 12194.217};
+    double response[2] = {0, 0};
+    double f = frequency;
+    uint32_t index = 0;
+
+    for (index = 0; index < 2; index++)
+    {
+        response[index] = 20 * log10(poles[3] * poles[3] * f * f /
+                                     ((f * f + poles[0] * poles[0]) *
+                                      (f * f + poles[3] * poles[3])));
+
+        if (aWeighting)
+        {
+            response[index] += 10 * log10(f * f /
+                                          (f * f + poles[1] * poles[1]) *
+                                          f * f /
+                                          (f * f + poles[2] * poles[2]));
+        }
+
+        f = 1000;
+    }
+
+    return response[0] - response[1];
+}
+
+static double elapsedS(const struct timespec *start, const struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) +
+           (end->tv_nsec - start->tv_nsec) / NS_PER_S;
+}
+
+/******************************************************************************/
+/* Main                                                                       */
+/******************************************************************************/
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [options]\n"
+           "  -t <hz>    Tone frequency, default 1000\n"
+           "  -a <gain>  Tone amplitude or WAV gain, relative to full scale, "
+                        "default 0.5\n"
+           "  -i <wav>   16 bit PCM WAV input instead of a tone\n"
+           "  -o <wav>   Write the decoded stream\n"
+           "  -d <s>     Duration, defaults to 5 or the length of the input\n"
+           "  -v         Enable voice activity detection\n"
+           "  -s <db>    Fail if the tone SNR is below this\n"
+           "  -m <n>     Modulator order, 1 - %u, default 4\n"
+           "  -g <gain>  Modulator out of band gain, default 1.5\n"
+           "  -c <dc>    Modulator DC offset, relative to full scale\n"
+           "  -j <rms>   Modulator clock jitter, fraction of a clock period\n"
+           "  -p <file>  Write the PDM words, as read over I2S, to file\n"
+           "  -k <name>  Decimation kernel, default %s\n"
+           "  -b <hz>    DC blocker cut off, 0 to disable, default 20\n"
+           "  -e <band>  EQ band e.g. \"peaking 1000 6 0.7\", up to %u times\n"
+           "  -l <dbfs>  Enable the AGC, with this target level\n"
+           "  -x         Use the two-byte RTP header extension form\n"
+           "  -2 <hz>    Add a second microphone on the data line, hearing "
+                        "a tone\n"
+           "  -r <n>     Beamform an array of n microphones, up to %u\n"
+           "  -y <mm>    Array spacing, default 20\n"
+           "  -f <deg>   Direction of the source, from broadside, default 0\n"
+           "  -w <deg>   Direction the beam is steered, default 0\n"
+           "  -n <rms>   Noise at each microphone, relative to full scale\n"
+           "  -O <s>     Noise alone for this long before the source starts\n"
+           "  -N <db>    Enable noise suppression, attenuating by at most "
+                        "this\n"
+           "  -q <db>    Fail if the SNR gain is below this\n"
+           "  -Q <db>    Fail if the SNR gain is above this\n"
+           "  -F <bands> Compute third_octave or mel band energies\n"
+           "  -L         Run the sound level meter on the first microphone\n"
+           "  -T <dbfs>  Send only around events at this level, or vad\n"
+           "  -u         Hold the trigger's pre-roll as 16 bit, not ADPCM\n",
+           name, SIGMA_DELTA_MAX_ORDER,
+           audioDspKernelName(AUDIO_DSP_KERNEL_CMSIS_F32),
+           AUDIO_EQ_MAX_BANDS - 1, AUDIO_BEAM_MAX_CHANNELS);
+}
+
+/* As mp45dt02EqInit(), then the bands given. Returns 0 on success. */
+static int eqSetup(audioEq *eq)
+{
+    audioEqBand band;
+    char text[128];
+    uint32_t index = 0;
+
+    audioEqInit(eq, PCM_RATE_HZ);
+
+    if (options.dcBlockerHz != 0)
+    {
+        memset(&band, 0, sizeof(band));
+        band.type = AUDIO_EQ_HIGHPASS;
+        band.frequency = options.dcBlockerHz;
+        band.q = 0.707f;
+
+        if (STATUS_OK != audioEqSetBand(eq, 0, &band))
+        {
+            fprintf(stderr, "Invalid DC blocker\n");
+            return -1;
+        }
+    }
+
+    for (index = 0; index < options.eqBandCount; index++)
+    {
+        /* Parsing consumes the text */
+        snprintf(text, sizeof(text), "%s", options.eqBands[index]);
+
+        if (STATUS_OK != audioEqParseBand(text, &band) ||
+            STATUS_OK != audioEqSetBand(eq, index + 1, &band))
+        {
+            fprintf(stderr, "Invalid EQ band %u\n", index + 1);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Returns AUDIO_DSP_KERNEL_COUNT if there is no kernel called name */
+static audioDspKernel kernelFromName(const char *name)
+{
+    audioDspKernel kernel = 0;
+
+    for (kernel = 0; kernel < AUDIO_DSP_KERNEL_COUNT; kernel++)
+    {
+        if (0 == strcmp(name, audioDspKernelName(kernel)))
+        {
+            break;
+        }
+    }
+
+    return kernel;
+}
+
+int main(int argc, char **argv)
+{
+    static float pdmSamples[MP45DT02_I2S_SAMPLE_SIZE_BITS];
+    /* Each microphone's words, then as read from the shared line */
+    static uint16_t pdmWords[MAX_CHANNELS][MP45DT02_I2S_SAMPLE_SIZE_2B];
+    static uint16_t lineWords[MAX_CHANNELS * MP45DT02_I2S_SAMPLE_SIZE_2B];
+    static uint16_t splitWords[MAX_CHANNELS][MP45DT02_I2S_SAMPLE_SIZE_2B];
+    static float32_t decimated[MAX_CHANNELS][MP45DT02_DECIMATED_BUFFER_SIZE];
+    static float32_t pcm[MAX_CHANNELS * MP45DT02_DECIMATED_BUFFER_SIZE];
+    float32_t *channels[MAX_CHANNELS];
+    /* The first microphone on its own, without noise suppression, to measure
+     * the SNR gain of the array and suppression against */
+    static float32_t referenceBlock[MP45DT02_DECIMATED_BUFFER_SIZE];
+    static audioEq referenceEq;
+    float *reference = NULL;
+    static audioBeam beam;
+    static audioNs ns[MAX_CHANNELS];
+    static audioFeatures features;
+    audioFeaturesConfig featuresConfig;
+    static audioSlm slm;
+    audioSlmConfig slmConfig;
+    audioSlmLevels slmLevels;
+    double expectedDb = 0;
+    audioTriggerConfig triggerConfig;
+    audioTriggerStats triggerStats;
+    uint32_t firstFrame = 0;
+    uint32_t prerollFrames = 0;
+    uint8_t featureFrame[AUDIO_FEATURES_MAX_LENGTH];
+    audioNsConfig nsConfig;
+    audioNsStats nsStats;
+    uint32_t skipFrames = 0;
+    bool compare = false;
+    float positions[MAX_CHANNELS];
+    const uint16_t *steered = NULL;
+    double referenceSnr = 0;
+    const uint16_t *line = NULL;
+    uint32_t lineLength = 0;
+    uint32_t blockSamples = 0;
+    uint32_t deinterleaveErrors = 0;
+    uint32_t overloads = 0;
+    uint32_t frames = 0;
+    uint32_t channel = 0;
+    static audioDsp dsp[MAX_CHANNELS];
+    static audioEq eq[MAX_CHANNELS];
+    static audioAgc agc;
+    static audioMeter meter;
+    audioMeterStats meterStats;
+    audioAgcConfig agcConfig;
+    audioAgcStats agcStats;
+    static audioPacketizer packetizer;
+    sigmaDelta modulator[MAX_CHANNELS];
+    sigmaDeltaConfig modulatorConfig;
+    FILE *pdmFile = NULL;
+    audioPacketizerConfig packetizerConfig;
+    rtpConfig rtp;
+    wavAudio output;
+    struct timespec start;
+    struct timespec end;
+    double processingS = 0;
+    uint64_t pdmIndex = 0;
+    uint32_t blocks = 0;
+    uint32_t block = 0;
+    uint32_t index = 0;
+    double snr = 0;
+    double rms = 0;
+    toneAnalysis tone;
+    int rtn = 0;
+    int opt = 0;
+
+    options.toneHz = 1000;
+    options.amplitude = 0.5f;
+    options.durationS = 0;
+    options.minSnrDb = -INFINITY;
+    options.modulator.order = 4;
+    options.modulator.outOfBandGain = 1.5f;
+    options.modulator.seed = 1;
+    options.kernel = AUDIO_DSP_KERNEL_CMSIS_F32;
+    options.dcBlockerHz = 20;
+    options.agcTargetDbfs = NAN;
+    options.dspOverrunsId = RTP_DSP_OVERRUNS_ID;
+    options.arraySpacingMm = 20;
+    options.nsAttenuationDb = NAN;
+    options.featuresScale = -1;
+    options.minSnrGainDb = -INFINITY;
+    options.maxSnrGainDb = INFINITY;
+
+    while (-1 != (opt = getopt(argc, argv,
+                               "t:a:i:o:d:vs:m:g:c:j:p:k:b:e:l:x2:r:y:f:w:n:O:N:q:Q:F:LT:uh")))
+    {
+        switch (opt)
+        {
+            case 't': options.toneHz = atof(optarg); break;
+            case 'a': options.amplitude = atof(optarg); break;
+            case 'i': options.inputPath = optarg; break;
+            case 'o': options.outputPath = optarg; break;
+            case 'd': options.durationS = atof(optarg); break;
+            case 'v': options.vad = true; break;
+            case 's': options.minSnrDb = atof(optarg); break;
+            case 'm': options.modulator.order = atoi(optarg); break;
+            case 'g': options.modulator.outOfBandGain = atof(optarg); break;
+            case 'c': options.modulator.dcOffset = atof(optarg); break;
+            case 'j': options.modulator.jitterRms = atof(optarg); break;
+            case 'p': options.pdmPath = optarg; break;
+            case 'k': options.kernel = kernelFromName(optarg); break;
+            case 'b': options.dcBlockerHz = atof(optarg); break;
+            case 'e':
+                if (options.eqBandCount == AUDIO_EQ_MAX_BANDS - 1)
+                {
+                    fprintf(stderr, "Too many EQ bands\n");
+                    return 2;
+                }
+
+                options.eqBands[options.eqBandCount++] = optarg;
+                break;
+            case 'l': options.agcTargetDbfs = atof(optarg); break;
+            case 'x': options.dspOverrunsId = RTP_DSP_OVERRUNS_ID_TWO_BYTE; break;
+            case '2': options.secondToneHz = atof(optarg); break;
+            case 'r': options.arrayMics = atoi(optarg); break;
+            case 'y': options.arraySpacingMm = atof(optarg); break;
+            case 'f': options.arrivalDegrees = atof(optarg); break;
+            case 'w': options.steerDegrees = atof(optarg); break;
+            case 'n': options.noiseRms = atof(optarg); break;
+            case 'O': options.onsetS = atof(optarg); break;
+            case 'N': options.nsAttenuationDb = atof(optarg); break;
+            case 'F':
+                options.featuresScale = 0 == strcmp(optarg, "mel") ?
+                                        AUDIO_FEATURES_SCALE_MEL :
+                                        AUDIO_FEATURES_SCALE_THIRD_OCTAVE;
+                break;
+            case 'L': options.slm = true; break;
+            case 'T':
+                options.trigger = true;
+                options.triggerSettings.vad = 0 == strcmp(optarg, "vad");
+                options.triggerSettings.levelDbfs =
+                            options.triggerSettings.vad ? NAN : atof(optarg);
+                break;
+            case 'u': options.triggerUncompressed = true; break;
+            case 'q': options.minSnrGainDb = atof(optarg); break;
+            case 'Q': options.maxSnrGainDb = atof(optarg); break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    if (options.kernel == AUDIO_DSP_KERNEL_COUNT)
+    {
+        fprintf(stderr, "Unknown decimation kernel\n");
+        return 2;
+    }
+
+    if (options.inputPath != NULL)
+    {
+        if (0 != wavRead(options.inputPath, &input) || input.sampleRate == 0)
+        {
+            fprintf(stderr, "Failed to read %s\n", options.inputPath);
+            return 2;
+        }
+
+        if (options.durationS == 0)
+        {
+            options.durationS = (float)input.samples / input.sampleRate;
+        }
+    }
+    else if (options.durationS == 0)
+    {
+        options.durationS = 5;
+    }
+
+    if (options.arrayMics > MAX_CHANNELS ||
+        (options.arrayMics != 0 && options.secondToneHz != 0))
+    {
+        fprintf(stderr, "Invalid number of microphones\n");
+        return 2;
+    }
+
+    /* The array is beamformed into one channel */
+    options.mics = options.arrayMics != 0 ? options.arrayMics :
+                   options.secondToneHz != 0 ? 2 : 1;
+    options.channels = options.arrayMics != 0 ? 1 : options.mics;
+    blockSamples = MP45DT02_DECIMATED_BUFFER_SIZE * options.channels;
+    compare = options.arrayMics != 0 || !isnan(options.nsAttenuationDb);
+    skipFrames = SNR_SKIP_FRAMES + options.onsetS * PCM_RATE_HZ;
+
+    blocks = options.durationS * 1000 / MP45DT02_RAW_SAMPLE_DURATION_MS;
+
+    sink.capacity = blocks * blockSamples;
+    sink.pcm = calloc(sink.capacity, sizeof(int16_t));
+    reference = calloc(blocks * MP45DT02_DECIMATED_BUFFER_SIZE, sizeof(float));
+
+    /**************************************************************************/
+    /* Same configuration as the board                                        */
+    /**************************************************************************/
+    memset(&rtp, 0, sizeof(rtp));
+    rtp.getRandomCb = rtpGetRandomCb;
+    rtp.payloadType = RTP_PAYLOAD_TYPE;
+    rtp.clockRate = PCM_RATE_HZ;
+    rtp.periodicTimestampIncr = AUDIO_PACKETIZER_PAYLOAD_SAMPLES;
+    rtp.extensions[0].id = RTP_AUDIO_LEVEL_ID;
+    rtp.extensions[0].length = RTP_AUDIO_LEVEL_LENGTH;
+    rtp.extensions[1].id = RTP_CAPTURE_TIME_ID;
+    rtp.extensions[1].length = RTP_ABS_CAPTURE_TIME_LENGTH;
+    rtp.extensions[2].id = options.dspOverrunsId;
+    rtp.extensions[2].length = RTP_DSP_OVERRUNS_LENGTH;
+
+    memset(&packetizerConfig, 0, sizeof(packetizerConfig));
+    packetizerConfig.getBufferCb        = getBufferCb;
+    packetizerConfig.sendCb             = sendCb;
+    packetizerConfig.releaseCb          = releaseCb;
+    packetizerConfig.extensionCb        = extensionCb;
+    packetizerConfig.payloadType        = RTP_PAYLOAD_TYPE;
+    packetizerConfig.channels           = options.channels;
+    packetizerConfig.vadEnabled         = options.vad && !options.trigger;
+    packetizerConfig.vad.energyRatio    = 4.0f;
+    packetizerConfig.vad.lowEnergyRatio = 2.0f;
+    packetizerConfig.vad.zcrThreshold   = 0.25f;
+    packetizerConfig.vad.minEnergy      = 4.0f;
+    packetizerConfig.vad.hangoverFrames = 15;
+    packetizerConfig.cnPayloadType      = RTP_CN_PAYLOAD_TYPE;
+    packetizerConfig.cnIntervalPayloads = 25;
+    packetizerConfig.audioLevelId       = RTP_AUDIO_LEVEL_ID;
+
+    if (STATUS_OK != rtpInit(&rtp))
+    {
+        fprintf(stderr, "Initialisation failed\n");
+        return 2;
+    }
+
+    audioPacketizerInit(&packetizer, &packetizerConfig);
+
+    memset(&triggerConfig, 0, sizeof(triggerConfig));
+    triggerConfig.sampleRate = PCM_RATE_HZ;
+    triggerConfig.payloadSamples = AUDIO_PACKETIZER_PAYLOAD_SAMPLES;
+    triggerConfig.channels = options.channels;
+    triggerConfig.adpcm = !options.triggerUncompressed;
+    triggerConfig.storage = triggerStorage;
+    triggerConfig.storageLength = TRIGGER_PREROLL_MS /
+                                  AUDIO_PACKETIZER_PAYLOAD_DURATION_MS *
+                                  AUDIO_TRIGGER_SLOT_LENGTH(
+                                        AUDIO_PACKETIZER_PAYLOAD_SAMPLES,
+                                        options.channels,
+                                        triggerConfig.adpcm);
+    triggerConfig.vad = packetizerConfig.vad;
+    triggerConfig.settings = options.triggerSettings;
+    triggerConfig.settings.hangoverMs = TRIGGER_HANGOVER_MS;
+    triggerConfig.outputCb = triggerOutputCb;
+    triggerConfig.dropCb = triggerDropCb;
+    triggerConfig.cbArg = &packetizer;
+
+    if (options.trigger && STATUS_OK != audioTriggerInit(&trigger,
+                                                         &triggerConfig))
+    {
+        fprintf(stderr, "Invalid trigger\n");
+        return 2;
+    }
+
+    for (channel = 0; channel < options.mics; channel++)
+    {
+        channels[channel] = decimated[channel];
+        positions[channel] = channel * options.arraySpacingMm / 1000;
+        noise[channel].random = options.modulator.seed + channel;
+
+        if (STATUS_OK != audioDspInit(&dsp[channel], options.kernel))
+        {
+            fprintf(stderr, "Initialisation failed\n");
+            return 2;
+        }
+    }
+
+    /* The EQ follows the beamformer, as on the board */
+    for (channel = 0; channel < options.channels; channel++)
+    {
+        if (0 != eqSetup(&eq[channel]))
+        {
+            return 2;
+        }
+    }
+
+    if (0 != eqSetup(&referenceEq))
+    {
+        return 2;
+    }
+
+    /* As the board */
+    memset(&nsConfig, 0, sizeof(nsConfig));
+    nsConfig.sampleRate = PCM_RATE_HZ;
+    nsConfig.blockSamples = MP45DT02_DECIMATED_BUFFER_SIZE;
+    nsConfig.maxAttenuationDb = options.nsAttenuationDb;
+    nsConfig.noiseRiseDbS = 3;
+
+    /* As the board */
+    memset(&featuresConfig, 0, sizeof(featuresConfig));
+    featuresConfig.sampleRate = PCM_RATE_HZ;
+    featuresConfig.blockSamples = MP45DT02_DECIMATED_BUFFER_SIZE;
+    featuresConfig.channels = options.channels;
+    featuresConfig.scale = (audioFeaturesScale)options.featuresScale;
+    featuresConfig.bands = FEATURES_MEL_BANDS;
+    featuresConfig.lowHz = FEATURES_LOW_HZ;
+    featuresConfig.highHz = FEATURES_HIGH_HZ;
+    featuresConfig.hopsPerFrame = FEATURES_INTERVAL_MS * PCM_RATE_HZ / 1000 /
+                                  AUDIO_FEATURES_HOP;
+
+    if (options.featuresScale >= 0 &&
+        STATUS_OK != audioFeaturesInit(&features, &featuresConfig))
+    {
+        fprintf(stderr, "Invalid features\n");
+        return 2;
+    }
+
+    /* As the board */
+    memset(&slmConfig, 0, sizeof(slmConfig));
+    slmConfig.sampleRate = PCM_RATE_HZ;
+    slmConfig.blockSamples = MP45DT02_DECIMATED_BUFFER_SIZE;
+    slmConfig.periodMs = SLM_PERIOD_MS;
+
+    if (options.slm && STATUS_OK != audioSlmInit(&slm, &slmConfig))
+    {
+        fprintf(stderr, "Invalid sound level meter\n");
+        return 2;
+    }
+
+    for (channel = 0;
+         channel < options.channels && !isnan(options.nsAttenuationDb);
+         channel++)
+    {
+        if (STATUS_OK != audioNsInit(&ns[channel], &nsConfig))
+        {
+            fprintf(stderr, "Invalid noise suppression\n");
+            return 2;
+        }
+    }
+
+    if (options.arrayMics != 0 &&
+        STATUS_OK != audioBeamInit(&beam,
+                                   options.arrayMics,
+                                   positions,
+                                   options.steerDegrees))
+    {
+        fprintf(stderr, "Invalid array\n");
+        return 2;
+    }
+
+    /* Interleaved frames are treated as a single channel at a multiple of the
+     * rate, as on the board */
+    audioMeterInit(&meter, PCM_RATE_HZ * options.channels, blockSamples);
+
+    /* As the board's defaults */
+    memset(&agcConfig, 0, sizeof(agcConfig));
+    agcConfig.sampleRate = PCM_RATE_HZ * options.channels;
+    agcConfig.blockSamples = blockSamples;
+    agcConfig.targetDbfs = isnan(options.agcTargetDbfs) ?
+                           0 : options.agcTargetDbfs;
+    agcConfig.minGainDb = isnan(options.agcTargetDbfs) ? 0 : -10;
+    agcConfig.maxGainDb = isnan(options.agcTargetDbfs) ? 0 : 30;
+    agcConfig.gateDbfs = -60;
+    agcConfig.attackMs = 20;
+    agcConfig.releaseMs = 300;
+    agcConfig.limiterDbfs = -1;
+    agcConfig.lookaheadSamples = PCM_RATE_HZ * options.channels / 1000;
+    agcConfig.limiterReleaseMs = 50;
+
+    if (STATUS_OK != audioAgcInit(&agc, &agcConfig))
+    {
+        fprintf(stderr, "Invalid AGC configuration\n");
+        return 2;
+    }
+
+    /* Each microphone has its own noise */
+    for (channel = 0; channel < options.mics; channel++)
+    {
+        modulatorConfig = options.modulator;
+        modulatorConfig.seed += channel;
+
+        if (0 != sigmaDeltaInit(&modulator[channel], &modulatorConfig))
+        {
+            fprintf(stderr, "Invalid modulator configuration\n");
+            return 2;
+        }
+    }
+
+    if (options.pdmPath != NULL &&
+        NULL == (pdmFile = fopen(options.pdmPath, "wb")))
+    {
+        fprintf(stderr, "Failed to open %s\n", options.pdmPath);
+        return 2;
+    }
+
+    /**************************************************************************/
+    /* Run, timing only the code shared with the board                        */
+    /**************************************************************************/
+    for (block = 0; block < blocks; block++)
+    {
+        currentBlock = block;
+
+        for (channel = 0; channel < options.mics; channel++)
+        {
+            for (index = 0; index < MP45DT02_I2S_SAMPLE_SIZE_BITS; index++)
+            {
+                pdmSamples[index] = sourceSample(channel, pdmIndex + index);
+            }
+
+            sigmaDeltaProcess(&modulator[channel],
+                              pdmSamples,
+                              MP45DT02_I2S_SAMPLE_SIZE_BITS,
+                              pdmWords[channel]);
+        }
+
+        pdmIndex += MP45DT02_I2S_SAMPLE_SIZE_BITS;
+
+        line = pdmWords[0];
+        lineLength = MP45DT02_I2S_SAMPLE_SIZE_2B;
+
+        /* Array microphones each have a data line, as on their own I2S
+         * ports. Only the first is written to the PDM file. */
+        if (options.arrayMics == 0 && options.mics == 2)
+        {
+            interleavePdm(pdmWords[0],
+                          pdmWords[1],
+                          MP45DT02_I2S_SAMPLE_SIZE_2B,
+                          lineWords);
+            line = lineWords;
+            lineLength = 2 * MP45DT02_I2S_SAMPLE_SIZE_2B;
+        }
+
+        if (pdmFile != NULL)
+        {
+            fwrite(line, lineLength * sizeof(uint16_t), 1, pdmFile);
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        if (line == lineWords)
+        {
+            audioDspDeinterleave(line, lineLength, splitWords[0], splitWords[1]);
+        }
+        else
+        {
+            memcpy(splitWords, pdmWords, sizeof(splitWords));
+        }
+
+        for (channel = 0; channel < options.mics; channel++)
+        {
+            steered = splitWords[channel];
+
+            if (options.arrayMics != 0)
+            {
+                steered = audioBeamDelay(&beam, channel, steered);
+            }
+
+            audioDspProcess(&dsp[channel], steered, channels[channel]);
+        }
+
+        memcpy(referenceBlock, channels[0], sizeof(referenceBlock));
+
+        if (options.arrayMics != 0)
+        {
+            audioBeamSum(&beam,
+                         channels,
+                         MP45DT02_DECIMATED_BUFFER_SIZE,
+                         channels[0]);
+        }
+
+        if (options.slm)
+        {
+            audioSlmProcess(&slm, channels[0], MP45DT02_DECIMATED_BUFFER_SIZE);
+        }
+
+        for (channel = 0; channel < options.channels; channel++)
+        {
+            audioEqProcess(&eq[channel],
+                           channels[channel],
+                           MP45DT02_DECIMATED_BUFFER_SIZE);
+
+            if (!isnan(options.nsAttenuationDb))
+            {
+                audioNsProcess(&ns[channel],
+                               channels[channel],
+                               MP45DT02_DECIMATED_BUFFER_SIZE);
+            }
+        }
+
+        audioDspInterleave(channels,
+                           options.channels,
+                           MP45DT02_DECIMATED_BUFFER_SIZE,
+                           pcm);
+        audioMeterProcess(&meter, pcm, blockSamples);
+        audioAgcProcess(&agc, pcm, blockSamples);
+
+        if (options.trigger)
+        {
+            audioTriggerProcess(&trigger, pcm, blockSamples);
+        }
+        else
+        {
+            audioPacketizerProcess(&packetizer, pcm, blockSamples);
+        }
+
+        if (options.featuresScale >= 0 &&
+            audioFeaturesProcess(&features,
+                                 pcm,
+                                 MP45DT02_DECIMATED_BUFFER_SIZE))
+        {
+            featuresReceive(featureFrame,
+                            audioFeaturesWrite(&features,
+                                               featureFrame,
+                                               sizeof(featureFrame)));
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        processingS += elapsedS(&start, &end);
+
+        if (compare)
+        {
+            audioEqProcess(&referenceEq,
+                           referenceBlock,
+                           MP45DT02_DECIMATED_BUFFER_SIZE);
+            memcpy(&reference[block * MP45DT02_DECIMATED_BUFFER_SIZE],
+                   referenceBlock,
+                   sizeof(referenceBlock));
+        }
+
+        /* Every word must come back to the microphone it came from */
+        for (channel = 0; channel < options.mics; channel++)
+        {
+            for (index = 0; index < MP45DT02_I2S_SAMPLE_SIZE_2B; index++)
+            {
+                deinterleaveErrors += splitWords[channel][index] !=
+                                      pdmWords[channel][index];
+            }
+        }
+    }
+
+    audioPacketizerReset(&packetizer);
+
+    if (pdmFile != NULL)
+    {
+        fclose(pdmFile);
+    }
+
+    /**************************************************************************/
+    /* Results                                                                */
+    /**************************************************************************/
+    printf("duration_s %.3f\n", options.durationS);
+    printf("blocks %u\n", blocks);
+    printf("processing_s %.6f\n", processingS);
+    printf("ns_per_block %.0f\n", processingS * NS_PER_S / blocks);
+    printf("realtime_factor %.1f\n", options.durationS / processingS);
+    printf("audio_packets %u\n", sink.audioPackets);
+    printf("cn_packets %u\n", sink.cnPackets);
+    printf("suppressed_payloads %u\n", packetizer.stats.suppressedPayloads);
+    printf("rtp_errors %u\n", sink.errors);
+    printf("audio_level_errors %u\n", sink.levelErrors);
+    printf("extension_errors %u\n", sink.extensionErrors);
+    printf("microphones %u\n", options.mics);
+    printf("channels %u\n", options.channels);
+    printf("deinterleave_errors %u\n", deinterleaveErrors);
+    printf("kernel %s\n", audioDspKernelName(options.kernel));
+    printf("eq_stages %u\n", eq[0].stages);
+
+    if (!isnan(options.nsAttenuationDb))
+    {
+        audioNsGetStats(&ns[0], &nsStats);
+        printf("ns_frames %u\n", nsStats.frames);
+        printf("ns_noise_dbfs %.1f\n", nsStats.noiseDbfs);
+        printf("ns_gain_db %.1f\n", nsStats.gainDb);
+        printf("ns_latency_ms %.1f\n",
+               nsStats.latencySamples * 1000.0 / PCM_RATE_HZ);
+    }
+
+    if (options.featuresScale >= 0)
+    {
+        printf("features_frames %u\n", featureSink.frames);
+        printf("features_bands %u\n", featureSink.bands);
+        printf("features_bytes %u\n", featureSink.length);
+        /* Of the L16 payloads that would otherwise be sent */
+        printf("features_bandwidth_ratio %.0f\n",
+               (double)PCM_RATE_HZ * options.channels * sizeof(int16_t) *
+               FEATURES_INTERVAL_MS / 1000 / featureSink.length);
+        printf("features_peak_hz %.0f\n", featureSink.peakHz);
+        printf("features_peak_dbfs %.1f\n", featureSink.peakDbfs);
+        printf("features_errors %u\n", featureSink.errors);
+    }
+
+    if (options.trigger)
+    {
+        audioTriggerGetStats(&trigger, &triggerStats);
+        printf("trigger_events %u\n", triggerStats.events);
+        printf("trigger_level_fires %u\n", triggerStats.levelFires);
+        printf("trigger_vad_fires %u\n", triggerStats.vadFires);
+        printf("trigger_sent_payloads %u\n", triggerStats.sentPayloads);
+        printf("trigger_dropped_payloads %u\n", triggerStats.droppedPayloads);
+        printf("trigger_held_payloads %u\n", triggerStats.heldSlots);
+        printf("trigger_first_capture_ms %.0f\n",
+               sink.firstCaptureTime * 1000.0 / PCM_RATE_HZ);
+        printf("talkspurts %u\n", packetizer.stats.talkspurts);
+    }
+
+    if (options.slm)
+    {
+        audioSlmGetLevels(&slm, &slmLevels);
+        printf("slm_periods %u\n", slmLevels.periods);
+        printf("slm_laeq_db %.2f\n", slmLevels.laeq);
+        printf("slm_lceq_db %.2f\n", slmLevels.lceq);
+        printf("slm_lzeq_db %.2f\n", slmLevels.lzeq);
+        printf("slm_lafmax_db %.2f\n", slmLevels.lafmax);
+        printf("slm_lasmax_db %.2f\n", slmLevels.lasmax);
+        printf("slm_lcpeak_db %.2f\n", slmLevels.lcpeak);
+        printf("slm_laeq_total_db %.2f\n", slmLevels.laeqTotal);
+    }
+
+    audioMeterGetStats(&meter, &meterStats);
+    printf("meter_rms_dbfs %.1f\n", meterStats.rmsDbfs);
+    printf("meter_peak_dbfs %.1f\n", meterStats.peakDbfs);
+    printf("meter_max_peak_dbfs %.1f\n", meterStats.maxPeakDbfs);
+    printf("meter_clipped_samples %u\n", meterStats.clippedSamples);
+    audioAgcGetStats(&agc, &agcStats);
+    printf("agc_gain_db %.1f\n", agcStats.gainDb);
+    printf("limiter_percent %.1f\n",
+           100.0 * agcStats.limitedBlocks / agcStats.blocks);
+    printf("limiter_engagements %u\n", agcStats.limiterEngagements);
+    printf("limiter_max_reduction_db %.1f\n", agcStats.maxReductionDb);
+    printf("clipped_samples %u\n", packetizer.stats.clippedSamples);
+    printf("modulator_order %u\n", options.modulator.order);
+    for (channel = 0; channel < options.mics; channel++)
+    {
+        overloads += modulator[channel].overloads;
+    }
+
+    printf("modulator_overloads %u\n", overloads);
+
+    /* The limiter should leave nothing to clip */
+    if (sink.errors != 0 || sink.levelErrors != 0 ||
+        sink.extensionErrors != 0 || deinterleaveErrors != 0 ||
+        featureSink.errors != 0 ||
+        packetizer.stats.clippedSamples != 0)
+    {
+        rtn = 1;
+    }
+
+    frames = sink.samples / options.channels;
+
+    /* The stream may start part way through, with the trigger's pre-roll */
+    firstFrame = sink.firstCaptureTime;
+    skipFrames = skipFrames > firstFrame ? skipFrames - firstFrame : 0;
+
+    /* Every channel hearing a tone, the second always does */
+    for (channel = options.inputPath == NULL ? 0 : 1;
+         channel < options.channels && frames > skipFrames;
+         channel++)
+    {
+        snr = toneSnrDb(sink.pcm + skipFrames * options.channels,
+                        frames - skipFrames,
+                        channel,
+                        channel == 0 ? options.toneHz : options.secondToneHz);
+        printf("snr_db%s %.1f\n", channel == 0 ? "" : "_1", snr);
+
+        if (snr < options.minSnrDb)
+        {
+            fprintf(stderr, "SNR %.1f dB below %.1f dB\n", snr, options.minSnrDb);
+            rtn = 1;
+        }
+    }
+
+    /* Improvement in SNR over the first microphone on its own */
+    if (compare && options.inputPath == NULL && frames > skipFrames)
+    {
+        referenceSnr = 0;
+
+        if (0 == analyseTone(reference + firstFrame + skipFrames,
+                             frames - skipFrames,
+                             options.toneHz / PCM_RATE_HZ,
+                             1,
+                             &tone))
+        {
+            referenceSnr = analysisDb(tone.signalPower / tone.noisePower);
+        }
+
+        if (options.arrayMics != 0)
+        {
+            printf("beam_delay_bits");
+
+            for (channel = 0; channel < options.arrayMics; channel++)
+            {
+                printf(" %u", beam.delayBits[channel]);
+            }
+
+            printf("\n");
+        }
+
+        printf("reference_snr_db %.1f\n", referenceSnr);
+        printf("snr_gain_db %.1f\n", snr - referenceSnr);
+
+        if (snr - referenceSnr < options.minSnrGainDb ||
+            snr - referenceSnr > options.maxSnrGainDb)
+        {
+            fprintf(stderr, "SNR gain %.1f dB outside %.1f to %.1f dB\n",
+                    snr - referenceSnr,
+                    options.minSnrGainDb,
+                    options.maxSnrGainDb);
+            rtn = 1;
+        }
+    }
+
+    if (options.inputPath == NULL && frames > SNR_SKIP_FRAMES)
+    {
+        rms = rmsDbfs(sink.pcm + sink.samples / 2, sink.samples / 2);
+        printf("rms_dbfs %.1f\n", rms);
+
+        /* A lone tone is all in the one band */
+        if (options.featuresScale >= 0 && options.noiseRms == 0 &&
+            options.secondToneHz == 0 &&
+            fabs(featureSink.peakDbfs - rms) > 1)
+        {
+            fprintf(stderr, "Loudest band %.1f dBFS, tone %.1f dBFS\n",
+                    featureSink.peakDbfs, rms);
+            rtn = 1;
+        }
+    }
+
+    /* Every payload is sent, held or dropped once. A lone tone clearly louder
+     * than the trigger fires it, with a full pre-roll of the noise before it.
+     * A quieter one sends nothing. */
+    if (options.trigger)
+    {
+        if (triggerStats.sentPayloads + triggerStats.droppedPayloads +
+                triggerStats.heldSlots != blocks * MP45DT02_DECIMATED_BUFFER_SIZE /
+                                          AUDIO_PACKETIZER_PAYLOAD_SAMPLES ||
+            sink.audioPackets != triggerStats.sentPayloads ||
+            packetizer.stats.talkspurts != triggerStats.events)
+        {
+            fprintf(stderr, "Trigger payloads don't add up\n");
+            rtn = 1;
+        }
+
+        expectedDb = analysisDb(options.amplitude * options.amplitude / 2);
+        prerollFrames = options.onsetS * PCM_RATE_HZ - firstFrame;
+
+        if (options.secondToneHz != 0 || options.inputPath != NULL)
+        {
+            /* Not checked */
+        }
+        else if (options.triggerSettings.vad ||
+                 expectedDb > options.triggerSettings.levelDbfs +
+                              TRIGGER_MARGIN_DB)
+        {
+            if (triggerStats.events != 1 ||
+                fabs(prerollFrames * 1000.0 / PCM_RATE_HZ -
+                     TRIGGER_PREROLL_MS) > 2 * AUDIO_PACKETIZER_PAYLOAD_DURATION_MS)
+            {
+                fprintf(stderr, "Expected one event with a %u ms pre-roll\n",
+                        TRIGGER_PREROLL_MS);
+                rtn = 1;
+            }
+
+            /* The pre-roll of noise keeps its level through the ADPCM, that
+             * of the noise under the live tone */
+            if (options.noiseRms > 0 && options.channels == 1 &&
+                prerollFrames <= frames)
+            {
+                expectedDb = rms - snr;
+                rms = rmsDbfs(sink.pcm, prerollFrames);
+                printf("trigger_preroll_rms_dbfs %.1f\n", rms);
+
+                if (fabs(rms - expectedDb) > 1)
+                {
+                    fprintf(stderr, "Pre-roll at %.1f dBFS, noise %.1f dBFS\n",
+                            rms, expectedDb);
+                    rtn = 1;
+                }
+            }
+        }
+        else if (expectedDb < options.triggerSettings.levelDbfs -
+                              TRIGGER_MARGIN_DB &&
+                 (triggerStats.events != 0 || sink.audioPackets != 0))
+        {
+            fprintf(stderr, "Expected no events\n");
+            rtn = 1;
+        }
+    }
+
+    /* A lone tone is weighted as IEC 61672 has it, and peaks 3 dB above its
+     * Leq */
+    if (options.slm && options.inputPath == NULL && options.noiseRms == 0 &&
+        options.arrayMics == 0)
+    {
+        if (slmLevels.periods == 0)
+        {
+            fprintf(stderr, "No sound level meter periods\n");
+            rtn = 1;
+        }
+
+        expectedDb = weightingDb(options.toneHz, true);
+        printf("slm_a_weighting_db %.2f\n", expectedDb);
+
+        if (fabs(slmLevels.laeq - slmLevels.lzeq - expectedDb) >
+            SLM_TOLERANCE_DB)
+        {
+            fprintf(stderr, "A weighting %.2f dB, expected %.2f dB\n",
+                    slmLevels.laeq - slmLevels.lzeq, expectedDb);
+            rtn = 1;
+        }
+
+        expectedDb = weightingDb(options.toneHz, false);
+        printf("slm_c_weighting_db %.2f\n", expectedDb);
+
+        if (fabs(slmLevels.lceq - slmLevels.lzeq - expectedDb) >
+            SLM_TOLERANCE_DB)
+        {
+            fprintf(stderr, "C weighting %.2f dB, expected %.2f dB\n",
+                    slmLevels.lceq - slmLevels.lzeq, expectedDb);
+            rtn = 1;
+        }
+
+        if (fabs(slmLevels.lcpeak - slmLevels.lceq - 10 * log10(2)) >
+            SLM_TOLERANCE_DB)
+        {
+            fprintf(stderr, "Peak %.2f dB above Leq, expected 3 dB\n",
+                    slmLevels.lcpeak - slmLevels.lceq);
+            rtn = 1;
+        }
+    }
+
+    if (options.outputPath != NULL)
+    {
+        output.sampleRate = PCM_RATE_HZ;
+        output.channels = options.channels;
+        output.samples = frames;
+        output.data = sink.pcm;
+
+        if (0 != wavWrite(options.outputPath, &output))
+        {
+            fprintf(stderr, "Failed to write %s\n", options.outputPath);
+            rtn = 2;
+        }
+    }
+
+    free(sink.pcm);
+    free(reference);
+    wavFree(&input);
+
+    return rtn;
+}
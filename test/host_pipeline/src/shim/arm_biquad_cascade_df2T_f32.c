@@ -0,0 +1,75 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* Reference version of the CMSIS transposed direct form II biquad cascade.
+ * Coefficients are b0, b1, b2, a1, a2 per stage, with a1 and a2 negated, and
+ * there are 2 state variables per stage. */
+
+#include <string.h>
+#include "arm_math.h"
+
+void arm_biquad_cascade_df2T_init_f32(arm_biquad_cascade_df2T_instance_f32 *S,
+                                      uint8_t numStages,
+                                      float32_t *pCoeffs,
+                                      float32_t *pState)
+{
+    S->numStages = numStages;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+
+    memset(pState, 0, 2 * numStages * sizeof(float32_t));
+}
+
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S,
+                                 float32_t *pSrc,
+                                 float32_t *pDst,
+                                 uint32_t blockSize)
+{
+    const float32_t *coeffs = S->pCoeffs;
+    float32_t *state = S->pState;
+    float32_t *input = pSrc;
+    float32_t in = 0;
+    float32_t out = 0;
+    uint32_t stage = 0;
+    uint32_t sample = 0;
+
+    for (stage = 0; stage < S->numStages; stage++)
+    {
+        for (sample = 0; sample < blockSize; sample++)
+        {
+            in = input[sample];
+            out = coeffs[0] * in + state[0];
+            state[0] = coeffs[1] * in + coeffs[3] * out + state[1];
+            state[1] = coeffs[2] * in + coeffs[4] * out;
+            pDst[sample] = out;
+        }
+
+        /* Later stages work on the output of the earlier */
+        input = pDst;
+        coeffs += 5;
+        state += 2;
+    }
+}
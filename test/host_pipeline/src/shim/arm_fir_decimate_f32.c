@@ -0,0 +1,85 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* Straightforward reference versions of the CMSIS functions in arm_math.h.
+ * They follow the CMSIS conventions, coefficients in time reversed order and
+ * a state buffer of numTaps + blockSize - 1 samples, so give the same results
+ * as the optimised originals to within float rounding. */
+
+#include <string.h>
+#include "arm_math.h"
+
+arm_status arm_fir_decimate_init_f32(arm_fir_decimate_instance_f32 *S,
+                                     uint16_t numTaps,
+                                     uint8_t M,
+                                     float32_t *pCoeffs,
+                                     float32_t *pState,
+                                     uint32_t blockSize)
+{
+    if (M == 0 || blockSize % M != 0)
+    {
+        return ARM_MATH_LENGTH_ERROR;
+    }
+
+    memset(pState, 0, (numTaps + blockSize - 1) * sizeof(float32_t));
+
+    S->M = M;
+    S->numTaps = numTaps;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+
+    return ARM_MATH_SUCCESS;
+}
+
+void arm_fir_decimate_f32(const arm_fir_decimate_instance_f32 *S,
+                          float32_t *pSrc,
+                          float32_t *pDst,
+                          uint32_t blockSize)
+{
+    float32_t *history = S->pState + S->numTaps - 1;
+    uint32_t output = 0;
+    uint32_t tap = 0;
+    float32_t acc = 0;
+
+    /* The oldest numTaps - 1 samples are kept at the start of the state */
+    memcpy(history, pSrc, blockSize * sizeof(float32_t));
+
+    for (output = 0; output < blockSize / S->M; output++)
+    {
+        acc = 0;
+
+        for (tap = 0; tap < S->numTaps; tap++)
+        {
+            acc += S->pState[output * S->M + tap] * S->pCoeffs[tap];
+        }
+
+        pDst[output] = acc;
+    }
+
+    memmove(S->pState,
+            S->pState + blockSize,
+            (S->numTaps - 1) * sizeof(float32_t));
+}
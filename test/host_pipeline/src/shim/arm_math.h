@@ -0,0 +1,92 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* Host stand in for the parts of CMSIS DSP used by stm32_streaming. The real
+ * arm_math.h pulls in the Cortex-M core headers, which won't build for the
+ * host. */
+
+#ifndef __ARM_MATH_H__
+#define __ARM_MATH_H__
+
+#include <stdint.h>
+
+typedef float float32_t;
+
+typedef enum {
+    ARM_MATH_SUCCESS = 0,
+    ARM_MATH_ARGUMENT_ERROR = -1,
+    ARM_MATH_LENGTH_ERROR = -2
+} arm_status;
+
+typedef struct {
+    uint8_t M;
+    uint16_t numTaps;
+    float32_t *pCoeffs;
+    float32_t *pState;
+} arm_fir_decimate_instance_f32;
+
+arm_status arm_fir_decimate_init_f32(arm_fir_decimate_instance_f32 *S,
+                                     uint16_t numTaps,
+                                     uint8_t M,
+                                     float32_t *pCoeffs,
+                                     float32_t *pState,
+                                     uint32_t blockSize);
+
+void arm_fir_decimate_f32(const arm_fir_decimate_instance_f32 *S,
+                          float32_t *pSrc,
+                          float32_t *pDst,
+                          uint32_t blockSize);
+
+typedef struct {
+    uint8_t numStages;
+    float32_t *pState;
+    float32_t *pCoeffs;
+} arm_biquad_cascade_df2T_instance_f32;
+
+void arm_biquad_cascade_df2T_init_f32(arm_biquad_cascade_df2T_instance_f32 *S,
+                                      uint8_t numStages,
+                                      float32_t *pCoeffs,
+                                      float32_t *pState);
+
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S,
+                                 float32_t *pSrc,
+                                 float32_t *pDst,
+                                 uint32_t blockSize);
+
+/* Only the length is needed here, the target's also holds the twiddles */
+typedef struct {
+    uint16_t fftLenRFFT;
+} arm_rfft_fast_instance_f32;
+
+arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *S,
+                                  uint16_t fftLen);
+
+void arm_rfft_fast_f32(arm_rfft_fast_instance_f32 *S,
+                       float32_t *p,
+                       float32_t *pOut,
+                       uint8_t ifftFlag);
+
+#endif /* Header Guard */
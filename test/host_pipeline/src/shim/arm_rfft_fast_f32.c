@@ -0,0 +1,157 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* Reference version of the CMSIS real FFT. The spectrum is packed as
+ * re[0], re[N/2], then re and im of bins 1 to N/2 - 1. The inverse takes the
+ * same and scales by 1/N, so round trips are exact. Like the target's, the
+ * input is used as scratch. */
+
+#include <math.h>
+#include <string.h>
+#include "arm_math.h"
+
+#define RFFT_MAX_LENGTH     4096
+
+/* In place radix 2, of length a power of 2. sign -1 forward, 1 inverse. */
+static void complexFft(double *re, double *im, uint32_t length, int sign)
+{
+    uint32_t span = 0;
+    uint32_t start = 0;
+    uint32_t index = 0;
+    uint32_t reversed = 0;
+    uint32_t bit = 0;
+    double angle = 0;
+    double wr = 0;
+    double wi = 0;
+    double tr = 0;
+    double ti = 0;
+    double swap = 0;
+
+    for (index = 1, reversed = 0; index < length; index++)
+    {
+        for (bit = length >> 1; reversed & bit; bit >>= 1)
+        {
+            reversed ^= bit;
+        }
+
+        reversed |= bit;
+
+        if (index < reversed)
+        {
+            swap = re[index]; re[index] = re[reversed]; re[reversed] = swap;
+            swap = im[index]; im[index] = im[reversed]; im[reversed] = swap;
+        }
+    }
+
+    for (span = 1; span < length; span <<= 1)
+    {
+        for (start = 0; start < length; start += 2 * span)
+        {
+            for (index = 0; index < span; index++)
+            {
+                angle = sign * M_PI * index / span;
+                wr = cos(angle);
+                wi = sin(angle);
+                tr = wr * re[start + index + span] - wi * im[start + index + span];
+                ti = wr * im[start + index + span] + wi * re[start + index + span];
+                re[start + index + span] = re[start + index] - tr;
+                im[start + index + span] = im[start + index] - ti;
+                re[start + index] += tr;
+                im[start + index] += ti;
+            }
+        }
+    }
+}
+
+arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *S,
+                                  uint16_t fftLen)
+{
+    /* The lengths the target supports */
+    if (fftLen < 32 || fftLen > RFFT_MAX_LENGTH || (fftLen & (fftLen - 1)))
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    S->fftLenRFFT = fftLen;
+
+    return ARM_MATH_SUCCESS;
+}
+
+void arm_rfft_fast_f32(arm_rfft_fast_instance_f32 *S,
+                       float32_t *p,
+                       float32_t *pOut,
+                       uint8_t ifftFlag)
+{
+    static double re[RFFT_MAX_LENGTH];
+    static double im[RFFT_MAX_LENGTH];
+    const uint32_t length = S->fftLenRFFT;
+    uint32_t bin = 0;
+    uint32_t index = 0;
+
+    if (ifftFlag == 0)
+    {
+        for (index = 0; index < length; index++)
+        {
+            re[index] = p[index];
+            im[index] = 0;
+        }
+
+        complexFft(re, im, length, -1);
+
+        pOut[0] = re[0];
+        pOut[1] = re[length / 2];
+
+        for (bin = 1; bin < length / 2; bin++)
+        {
+            pOut[2 * bin] = re[bin];
+            pOut[2 * bin + 1] = im[bin];
+        }
+    }
+    else
+    {
+        re[0] = p[0];
+        im[0] = 0;
+        re[length / 2] = p[1];
+        im[length / 2] = 0;
+
+        for (bin = 1; bin < length / 2; bin++)
+        {
+            re[bin] = p[2 * bin];
+            im[bin] = p[2 * bin + 1];
+            re[length - bin] = p[2 * bin];
+            im[length - bin] = -p[2 * bin + 1];
+        }
+
+        complexFft(re, im, length, 1);
+
+        for (index = 0; index < length; index++)
+        {
+            pOut[index] = re[index] / length;
+        }
+    }
+
+    memset(p, 0, length * sizeof(*p));
+}
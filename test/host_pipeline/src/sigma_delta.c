@@ -0,0 +1,281 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include "sigma_delta.h"
+
+#define SIGMA_DELTA_WORD_SIZE_BITS  16
+
+/* Loop filter output beyond which the modulator is considered unstable */
+#define SIGMA_DELTA_OVERLOAD        64.0
+
+/* Bisection steps when designing the NTF */
+#define SIGMA_DELTA_DESIGN_STEPS    60
+/* Frequencies the NTF's gain is checked at */
+#define SIGMA_DELTA_DESIGN_POINTS   256
+
+/******************************************************************************/
+/* NTF Design                                                                 */
+/******************************************************************************/
+
+/* The noise transfer function has all its zeros at DC, to push quantisation
+ * noise out of the audio band, and the poles of a Butterworth high pass
+ * filter. The cutoff is chosen so the NTF's peak gain is outOfBandGain - the
+ * Lee criterion for the stability of single bit modulators. */
+
+static void sigmaDeltaPoles(uint32_t order, double cutoff, double *denominator)
+{
+    double complex poly[SIGMA_DELTA_MAX_ORDER + 1];
+    double complex pole = 0;
+    double complex analog = 0;
+    /* Prewarped, for a sampling period of 1 */
+    double warped = 2 * tan(M_PI * cutoff);
+    uint32_t k = 0;
+    uint32_t i = 0;
+
+    memset(poly, 0, sizeof(poly));
+    poly[0] = 1;
+
+    for (k = 0; k < order; k++)
+    {
+        /* Butterworth low pass prototype, mapped to high pass */
+        analog = cexp(I * M_PI * (2.0 * k + order + 1) / (2.0 * order));
+        analog = warped / analog;
+        /* Bilinear transform */
+        pole = (1 + analog / 2) / (1 - analog / 2);
+
+        /* Multiply in (1 - pole z^-1) */
+        for (i = k + 1; i > 0; i--)
+        {
+            poly[i] -= pole * poly[i - 1];
+        }
+    }
+
+    for (i = 0; i <= order; i++)
+    {
+        denominator[i] = creal(poly[i]);
+    }
+}
+
+static double sigmaDeltaPeakGain(uint32_t order,
+                                 const double *numerator,
+                                 const double *denominator)
+{
+    double complex z = 0;
+    double complex num = 0;
+    double complex den = 0;
+    double peak = 0;
+    double gain = 0;
+    uint32_t point = 0;
+    uint32_t i = 0;
+
+    for (point = 0; point <= SIGMA_DELTA_DESIGN_POINTS; point++)
+    {
+        z = cexp(-I * M_PI * point / SIGMA_DELTA_DESIGN_POINTS);
+        num = 0;
+        den = 0;
+
+        for (i = order + 1; i > 0; i--)
+        {
+            num = num * z + numerator[i - 1];
+            den = den * z + denominator[i - 1];
+        }
+
+        gain = cabs(num / den);
+
+        if (gain > peak)
+        {
+            peak = gain;
+        }
+    }
+
+    return peak;
+}
+
+static void sigmaDeltaDesign(sigmaDelta *modulator)
+{
+    uint32_t order = modulator->config.order;
+    double low = 0;
+    double high = 0.5;
+    double cutoff = 0;
+    uint32_t step = 0;
+    uint32_t i = 0;
+    uint32_t k = 0;
+
+    /* (1 - z^-1)^order */
+    memset(modulator->numerator, 0, sizeof(modulator->numerator));
+    modulator->numerator[0] = 1;
+
+    for (k = 0; k < order; k++)
+    {
+        for (i = k + 1; i > 0; i--)
+        {
+            modulator->numerator[i] -= modulator->numerator[i - 1];
+        }
+    }
+
+    /* Gain rises with the cutoff */
+    for (step = 0; step < SIGMA_DELTA_DESIGN_STEPS; step++)
+    {
+        cutoff = (low + high) / 2;
+        sigmaDeltaPoles(order, cutoff, modulator->denominator);
+
+        if (sigmaDeltaPeakGain(order,
+                               modulator->numerator,
+                               modulator->denominator) >
+            modulator->config.outOfBandGain)
+        {
+            high = cutoff;
+        }
+        else
+        {
+            low = cutoff;
+        }
+    }
+
+    sigmaDeltaPoles(order, low, modulator->denominator);
+}
+
+/******************************************************************************/
+/* Jitter                                                                     */
+/******************************************************************************/
+
+static float sigmaDeltaUniform(sigmaDelta *modulator)
+{
+    /* xorshift32 */
+    modulator->random ^= modulator->random << 13;
+    modulator->random ^= modulator->random >> 17;
+    modulator->random ^= modulator->random << 5;
+
+    return (modulator->random + 1.0f) / 4294967296.0f;
+}
+
+static float sigmaDeltaGaussian(sigmaDelta *modulator)
+{
+    float u1 = sigmaDeltaUniform(modulator);
+    float u2 = sigmaDeltaUniform(modulator);
+
+    return sqrtf(-2 * logf(u1)) * cosf(2 * (float)M_PI * u2);
+}
+
+/******************************************************************************/
+/* External Functions                                                         */
+/******************************************************************************/
+
+/* Returns 0 on success */
+int sigmaDeltaInit(sigmaDelta *modulator, const sigmaDeltaConfig *config)
+{
+    if (config->order == 0 || config->order > SIGMA_DELTA_MAX_ORDER ||
+        config->outOfBandGain <= 1)
+    {
+        return -1;
+    }
+
+    memset(modulator, 0, sizeof(*modulator));
+    modulator->config = *config;
+    modulator->random = config->seed ? config->seed : 1;
+
+    sigmaDeltaDesign(modulator);
+
+    return 0;
+}
+
+/* samples: count samples at the modulator's clock rate, relative to full
+ *          scale. Higher orders overload above around 0.5 - 0.7.
+ * words:   count / 16 words of output. */
+void sigmaDeltaProcess(sigmaDelta *modulator,
+                       const float *samples,
+                       uint32_t count,
+                       uint16_t *words)
+{
+    uint32_t order = modulator->config.order;
+    const double *num = modulator->numerator;
+    const double *den = modulator->denominator;
+    double *error = modulator->error;
+    double *feedback = modulator->feedback;
+    double filtered = 0;
+    double quantiserIn = 0;
+    float input = 0;
+    float output = 0;
+    uint32_t index = 0;
+    uint32_t k = 0;
+    uint16_t word = 0;
+
+    for (index = 0; index < count; index++)
+    {
+        input = samples[index];
+
+        /* Sampling early or late, approximated from the slope */
+        if (modulator->config.jitterRms != 0)
+        {
+            input += (input - modulator->lastSample) *
+                     modulator->config.jitterRms *
+                     sigmaDeltaGaussian(modulator);
+        }
+
+        modulator->lastSample = samples[index];
+        input += modulator->config.dcOffset;
+
+        /* Error feedback form: the quantisation error is filtered by
+         * NTF(z) - 1, which has no delay free term, giving
+         * Y(z) = X(z) + NTF(z)E(z) */
+        filtered = 0;
+
+        for (k = 0; k < order; k++)
+        {
+            filtered += (num[k + 1] - den[k + 1]) * error[k] -
+                        den[k + 1] * feedback[k];
+        }
+
+        quantiserIn = input + filtered;
+        output = quantiserIn >= 0 ? 1 : -1;
+
+        if (fabs(filtered) > SIGMA_DELTA_OVERLOAD)
+        {
+            memset(modulator->error, 0, sizeof(modulator->error));
+            memset(modulator->feedback, 0, sizeof(modulator->feedback));
+            modulator->overloads++;
+        }
+        else
+        {
+            memmove(&error[1], &error[0], (order - 1) * sizeof(error[0]));
+            memmove(&feedback[1], &feedback[0],
+                    (order - 1) * sizeof(feedback[0]));
+            error[0] = output - quantiserIn;
+            feedback[0] = filtered;
+        }
+
+        word = (word << 1) | (output > 0);
+
+        if (index % SIGMA_DELTA_WORD_SIZE_BITS == SIGMA_DELTA_WORD_SIZE_BITS - 1)
+        {
+            *words++ = word;
+            word = 0;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __SIGMA_DELTA_H__
+#define __SIGMA_DELTA_H__
+
+#include <stdint.h>
+
+#define SIGMA_DELTA_MAX_ORDER   5
+
+/* Models a PDM microphone such as the MP45DT02: a single bit sigma-delta
+ * modulator, output packed MSB first into 16 bit words as read over I2S. */
+typedef struct {
+    /* Noise shaping order, 1 - SIGMA_DELTA_MAX_ORDER */
+    uint32_t order;
+    /* Peak gain of the noise transfer function. Lower is more stable but
+     * shapes less noise out of band. 1.5 is a safe choice for one bit. */
+    float outOfBandGain;
+    /* Added to the input, relative to full scale */
+    float dcOffset;
+    /* RMS clock jitter, as a fraction of a clock period */
+    float jitterRms;
+    /* For the jitter, so runs are repeatable */
+    uint32_t seed;
+} sigmaDeltaConfig;
+
+typedef struct {
+    sigmaDeltaConfig config;
+    /* Noise transfer function, NTF(z) = numerator(z) / denominator(z), in
+     * powers of z^-1 */
+    double numerator[SIGMA_DELTA_MAX_ORDER + 1];
+    double denominator[SIGMA_DELTA_MAX_ORDER + 1];
+    /* Past quantisation errors and loop filter outputs, newest first */
+    double error[SIGMA_DELTA_MAX_ORDER];
+    double feedback[SIGMA_DELTA_MAX_ORDER];
+    float lastSample;
+    uint32_t random;
+    /* Times the loop went unstable and had to be reset */
+    uint32_t overloads;
+} sigmaDelta;
+
+int sigmaDeltaInit(sigmaDelta *modulator, const sigmaDeltaConfig *config);
+void sigmaDeltaProcess(sigmaDelta *modulator,
+                       const float *samples,
+                       uint32_t count,
+                       uint16_t *words);
+
+#endif /* Header Guard */
@@ -0,0 +1,192 @@
+/*******************************************************************************
+* Copyright (c) 2017, Alan Barr
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wav.h"
+
+#define WAV_FORMAT_PCM      1
+#define WAV_BITS            16
+
+typedef struct {
+    char id[4];
+    uint32_t size;
+} wavChunk;
+
+typedef struct {
+    uint16_t format;
+    uint16_t channels;
+    uint32_t sampleRate;
+    uint32_t byteRate;
+    uint16_t blockAlign;
+    uint16_t bits;
+} wavFormat;
+
+/* Returns 0 on success. Assumes a little endian host, as WAV is. */
+int wavRead(const char *path, wavAudio *audio)
+{
+    FILE *file = NULL;
+    wavChunk chunk;
+    wavFormat format;
+    char wave[4];
+    int16_t *frames = NULL;
+    uint32_t index = 0;
+    int rtn = -1;
+
+    memset(audio, 0, sizeof(*audio));
+    memset(&format, 0, sizeof(format));
+
+    if (NULL == (file = fopen(path, "rb")))
+    {
+        return -1;
+    }
+
+    if (1 != fread(&chunk, sizeof(chunk), 1, file) ||
+        0 != memcmp(chunk.id, "RIFF", 4) ||
+        1 != fread(wave, sizeof(wave), 1, file) ||
+        0 != memcmp(wave, "WAVE", 4))
+    {
+        goto close;
+    }
+
+    while (1 == fread(&chunk, sizeof(chunk), 1, file))
+    {
+        if (0 == memcmp(chunk.id, "fmt ", 4) && chunk.size >= sizeof(format))
+        {
+            if (1 != fread(&format, sizeof(format), 1, file))
+            {
+                goto close;
+            }
+
+            fseek(file, chunk.size - sizeof(format), SEEK_CUR);
+        }
+        else if (0 == memcmp(chunk.id, "data", 4))
+        {
+            if (format.format != WAV_FORMAT_PCM ||
+                format.bits != WAV_BITS ||
+                format.channels == 0)
+            {
+                goto close;
+            }
+
+            frames = malloc(chunk.size);
+
+            if (frames == NULL ||
+                1 != fread(frames, chunk.size, 1, file))
+            {
+                goto close;
+            }
+
+            audio->sampleRate = format.sampleRate;
+            audio->channels = 1;
+            audio->samples = chunk.size / format.blockAlign;
+            audio->data = malloc(audio->samples * sizeof(int16_t));
+
+            if (audio->data == NULL)
+            {
+                goto close;
+            }
+
+            for (index = 0; index < audio->samples; index++)
+            {
+                audio->data[index] = frames[index * format.channels];
+            }
+
+            rtn = 0;
+            break;
+        }
+        else
+        {
+            /* Chunks are padded to an even length */
+            fseek(file, (chunk.size + 1) & ~1u, SEEK_CUR);
+        }
+    }
+
+close:
+    free(frames);
+    fclose(file);
+
+    if (rtn != 0)
+    {
+        wavFree(audio);
+    }
+
+    return rtn;
+}
+
+/* Returns 0 on success */
+int wavWrite(const char *path, const wavAudio *audio)
+{
+    FILE *file = NULL;
+    wavChunk chunk;
+    wavFormat format;
+    uint16_t channels = audio->channels ? audio->channels : 1;
+    uint32_t dataSize = audio->samples * channels * sizeof(int16_t);
+    int rtn = 0;
+
+    if (NULL == (file = fopen(path, "wb")))
+    {
+        return -1;
+    }
+
+    memset(&format, 0, sizeof(format));
+    format.format       = WAV_FORMAT_PCM;
+    format.channels     = channels;
+    format.sampleRate   = audio->sampleRate;
+    format.byteRate     = audio->sampleRate * channels * sizeof(int16_t);
+    format.blockAlign   = channels * sizeof(int16_t);
+    format.bits         = WAV_BITS;
+
+    memcpy(chunk.id, "RIFF", 4);
+    chunk.size = 4 + sizeof(chunk) + sizeof(format) + sizeof(chunk) + dataSize;
+    rtn |= 1 != fwrite(&chunk, sizeof(chunk), 1, file);
+    rtn |= 1 != fwrite("WAVE", 4, 1, file);
+
+    memcpy(chunk.id, "fmt ", 4);
+    chunk.size = sizeof(format);
+    rtn |= 1 != fwrite(&chunk, sizeof(chunk), 1, file);
+    rtn |= 1 != fwrite(&format, sizeof(format), 1, file);
+
+    memcpy(chunk.id, "data", 4);
+    chunk.size = dataSize;
+    rtn |= 1 != fwrite(&chunk, sizeof(chunk), 1, file);
+
+    if (dataSize != 0)
+    {
+        rtn |= 1 != fwrite(audio->data, dataSize, 1, file);
+    }
+
+    fclose(file);
+
+    return rtn ? -1 : 0;
+}
+
+void wavFree(wavAudio *audio)
+{
+    free(audio->data);
+    memset(audio, 0, sizeof(*audio));
+}
@@ -104,6 +104,39 @@ plot.close()
 
 fir_coeff_reversed = fir_coeff[::-1]
 
+# firwin designs are linear phase, so symmetric. The folded kernels only need
+# the first half, and sum the mirrored taps before multiplying.
+if not np.allclose(fir_coeff, fir_coeff_reversed):
+    raise ValueError("FIR coefficients are not symmetric")
+
+fir_coeff_folded = fir_coeff_reversed[0:taps_n // 2]
+
+# For each 4 taps, in the order of firCoeffs, the output for every value of a
+# nibble of PDM, MSB first, each bit being INT16_MAX when set and INT16_MIN
+# when clear.
+fir_nibble_sums = []
+for nibble in range(taps_n // 4):
+    sums = []
+    for value in range(16):
+        sums.append(sum(fir_coeff_reversed[nibble * 4 + bit] *
+                        (32767 if value & (0x8 >> bit) else -32768)
+                        for bit in range(4)))
+    fir_nibble_sums.append(sums)
+
+# For each 4 taps of the folded coefficients, the output for every
+# combination of their mirrored pairs of bits. Each pair is 0, 1 or 2 bits
+# set, a ternary digit, the first tap's the most significant. Two bits set
+# are 2 * INT16_MAX, none 2 * INT16_MIN and one INT16_MAX + INT16_MIN.
+pair_values = [-65536, -1, 65534]
+fir_folded_ternary_sums = []
+for group in range(len(fir_coeff_folded) // 4):
+    sums = []
+    for value in range(81):
+        digits = [(value // 3 ** (3 - tap)) % 3 for tap in range(4)]
+        sums.append(sum(fir_coeff_folded[group * 4 + tap] *
+                        pair_values[digits[tap]] for tap in range(4)))
+    fir_folded_ternary_sums.append(sums)
+
 if not os.path.exists(dir_text):
     os.makedirs(dir_text)
     
@@ -118,7 +151,14 @@ h_file_handle.write("#include \"arm_math.h\"\n\n")
 
 h_file_handle.write("#define FIR_COEFFS_LEN    %s\n" %taps_n)
 
+h_file_handle.write("#define FIR_COEFFS_FOLDED_LEN    %s\n" %(taps_n // 2))
+
 h_file_handle.write("extern float32_t firCoeffs[FIR_COEFFS_LEN];\n")
+h_file_handle.write("extern const float32_t "
+                    "firNibbleSums[FIR_COEFFS_LEN / 4][16];\n")
+h_file_handle.write("extern const float32_t firCoeffsFolded[FIR_COEFFS_FOLDED_LEN];\n")
+h_file_handle.write("extern const float32_t "
+                    "firFoldedTernarySums[FIR_COEFFS_FOLDED_LEN / 4][81];\n")
 
 h_file_handle.write("\n#endif\n")
 h_file_handle.close()
@@ -135,6 +175,29 @@ for f in fir_coeff_reversed:
     file_handle.write("    %.23f,\n" %f)
 file_handle.write("};\n\n")
 
+file_handle.write("const float32_t firNibbleSums[FIR_COEFFS_LEN / 4][16] = {\n")
+for sums in fir_nibble_sums:
+    file_handle.write("    {\n")
+    for f in sums:
+        file_handle.write("        %.23f,\n" %f)
+    file_handle.write("    },\n")
+file_handle.write("};\n\n")
+
+# Folded Coeffs
+file_handle.write("const float32_t firCoeffsFolded[FIR_COEFFS_FOLDED_LEN] = {\n")
+for f in fir_coeff_folded:
+    file_handle.write("    %.23f,\n" %f)
+file_handle.write("};\n\n")
+
+file_handle.write("const float32_t "
+                  "firFoldedTernarySums[FIR_COEFFS_FOLDED_LEN / 4][81] = {\n")
+for sums in fir_folded_ternary_sums:
+    file_handle.write("    {\n")
+    for f in sums:
+        file_handle.write("        %.23f,\n" %f)
+    file_handle.write("    },\n")
+file_handle.write("};\n\n")
+
 file_handle.close()
 
 